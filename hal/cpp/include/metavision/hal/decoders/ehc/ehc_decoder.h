@@ -12,7 +12,10 @@
 #ifndef METAVISION_HAL_EHC_DECODER_H
 #define METAVISION_HAL_EHC_DECODER_H
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
+#include <vector>
 
 #include "metavision/sdk/base/events/raw_event_frame_diff.h"
 #include "metavision/sdk/base/events/raw_event_frame_histo.h"
@@ -29,32 +32,56 @@ class EHCDecoder : public I_EventFrameDecoder<FrameType> {
 
 public:
     EHCDecoder(int height, int width, int bytes_per_pixel) :
-        I_EventFrameDecoder<FrameType>(height, width), size_full_(height * width * bytes_per_pixel) {
-        event_frame_data_.reserve(size_full_);
-    }
+        I_EventFrameDecoder<FrameType>(height, width), size_full_(height * width * bytes_per_pixel) {}
 
     void decode(const RawData *const raw_data_begin, const RawData *const raw_data_end) override {
-        const RawData *cur_raw_data = raw_data_begin;
-
-        for (; cur_raw_data != raw_data_end;) {
-            unsigned elems_to_add = std::min(static_cast<size_t>(std::distance(cur_raw_data, raw_data_end)),
-                                             size_full_ - event_frame_data_.size());
-            event_frame_data_.insert(event_frame_data_.end(), reinterpret_cast<const T *>(cur_raw_data),
-                                     reinterpret_cast<const T *>(cur_raw_data + elems_to_add));
-            if (event_frame_data_.size() == size_full_) {
-                finalize_event_frame(event_frame_data_);
-                event_frame_data_.clear();
-                event_frame_data_.reserve(size_full_);
+        const T *cur_raw_data         = reinterpret_cast<const T *>(raw_data_begin);
+        const T *const raw_data_end_t = reinterpret_cast<const T *>(raw_data_end);
+
+        // Raw data is copied once, directly in the storage of a frame taken from the pool, whether the frame is fully
+        // contained in the input buffer or straddles several buffers
+        while (cur_raw_data != raw_data_end_t) {
+            if (!current_frame_) {
+                current_frame_ = acquire_frame();
+                current_size_  = 0;
             }
+            const size_t elems_to_add =
+                std::min(static_cast<size_t>(std::distance(cur_raw_data, raw_data_end_t)), size_full_ - current_size_);
+            std::copy(cur_raw_data, cur_raw_data + elems_to_add, current_frame_->get_data().data() + current_size_);
+            current_size_ += elems_to_add;
             cur_raw_data += elems_to_add;
+            if (current_size_ == size_full_) {
+                this->add_event_frame(std::shared_ptr<const FrameType>(std::move(current_frame_)));
+            }
         }
     }
 
 protected:
-    virtual void finalize_event_frame(std::vector<T> &frame_data) = 0;
+    /// @brief Creates a frame with the decoder configuration, whose data has the size of a full frame
+    virtual std::shared_ptr<FrameType> make_frame() const = 0;
 
 private:
-    std::vector<T> event_frame_data_;
+    // Returns a frame from the pool which is not referenced anymore outside of the pool, or a new one if none is
+    // available. Frames are referenced by the last frame of the decoder and by users who retrieved it, so that a
+    // small pool is enough to avoid any allocation when frames are consumed from the callbacks.
+    std::shared_ptr<FrameType> acquire_frame() {
+        for (auto &frame : frame_pool_) {
+            if (frame.use_count() == 1) {
+                return frame;
+            }
+        }
+        auto frame = make_frame();
+        if (frame_pool_.size() < max_pool_size_) {
+            frame_pool_.push_back(frame);
+        }
+        return frame;
+    }
+
+    static constexpr size_t max_pool_size_ = 4;
+
+    std::vector<std::shared_ptr<FrameType>> frame_pool_;
+    std::shared_ptr<FrameType> current_frame_;
+    size_t current_size_ = 0;
     const size_t size_full_;
 };
 
@@ -68,9 +95,8 @@ public:
     }
 
 private:
-    virtual void finalize_event_frame(std::vector<uint8_t> &frame_data) override {
-        frame_histo_.get_data().swap(frame_data);
-        add_event_frame(frame_histo_);
+    virtual std::shared_ptr<RawEventFrameHisto> make_frame() const override {
+        return std::make_shared<RawEventFrameHisto>(frame_histo_);
     }
 
     RawEventFrameHisto frame_histo_;
@@ -86,9 +112,8 @@ public:
     }
 
 private:
-    virtual void finalize_event_frame(std::vector<int8_t> &frame_data) override {
-        frame_diff_.get_data().swap(frame_data);
-        add_event_frame(frame_diff_);
+    virtual std::shared_ptr<RawEventFrameDiff> make_frame() const override {
+        return std::make_shared<RawEventFrameDiff>(frame_diff_);
     }
 
     RawEventFrameDiff frame_diff_;
@@ -0,0 +1,85 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_EVT3_ENCODER_H
+#define METAVISION_HAL_EVT3_ENCODER_H
+
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <vector>
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+#include "metavision/hal/decoders/evt3/evt3_event_types.h"
+
+namespace Metavision {
+
+/// @brief Class to encode events in EVT3 format
+///
+/// CD events sharing the same timestamp are buffered and encoded together: they are grouped by row and polarity, and
+/// runs of nearby events on a row are encoded as a VECT_12/VECT_12/VECT_8 vector covering 32 pixels instead of one
+/// EVT_ADDR_X word per event. The events of a timestamp are thus written once an event with a later timestamp is
+/// encoded, or when @ref flush is called.
+///
+/// EVT3 timestamps are coded on 24 bits: across a time gap, the time high words are only written at the end of each
+/// time loop and at the start of the next one, so that the decoder can track the time loops without the time high
+/// words in between. The time base of the first encoded event is kept modulo 2^24 us.
+class Evt3Encoder {
+public:
+    /// @brief Constructor
+    /// @param width Width of the sensor, vectors are only written where they fit in the sensor's width
+    explicit Evt3Encoder(int width);
+
+    /// @brief Resets the internal time and address state of the encoder, dropping the events not yet written
+    void reset_state();
+
+    /// @brief Encodes a CD event
+    ///
+    /// The event is written to the output stream once all the events with the same timestamp are known.
+    /// @param ofs Output stream to write the encoded events to
+    /// @param ev CD event to encode
+    void encode_event_cd(std::ofstream &ofs, const EventCD &ev);
+
+    /// @brief Encodes a trigger event and writes it to the output stream
+    /// @param ofs Output stream to write the encoded event to
+    /// @param ev Trigger event to encode
+    void encode_event_trigger(std::ofstream &ofs, const EventExtTrigger &ev);
+
+    /// @brief Writes the CD events buffered by the encoder to the output stream
+    /// @param ofs Output stream to write the encoded events to
+    void flush(std::ofstream &ofs);
+
+private:
+    void check_event_order(timestamp ts) const;
+    void encode_pending_cd_events();
+    void encode_row_events(const EventCD *begin, const EventCD *end);
+    void write_time(timestamp ts);
+    void write_word(Evt3EventTypes_4bits type, std::uint16_t content);
+    void write_words(std::ofstream &ofs);
+
+    static constexpr int kVectorSize = 32;
+
+    const int width_;
+    std::vector<EventCD> pending_cd_events_;
+    std::vector<std::uint16_t> words_;
+    timestamp ts_last_ev_        = std::numeric_limits<timestamp>::min();
+    bool first_timehigh_written_ = false;
+    timestamp last_timehigh_     = 0;
+    int last_timelow_            = -1;
+    int last_y_                  = -1;
+    int vect_base_x_             = -1;
+    int vect_base_p_             = -1;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_EVT3_ENCODER_H
@@ -80,6 +80,7 @@ public:
 protected:
     /// @cond DEV
     void add_event_frame(const FrameType &frame);
+    void add_event_frame(std::shared_ptr<const FrameType> frame);
     /// @endcond
 
     const unsigned height_;
@@ -116,14 +117,18 @@ std::shared_ptr<const FrameType> I_EventFrameDecoder<FrameType>::get_last_frame(
 /// @cond DEV
 template<class FrameType>
 void I_EventFrameDecoder<FrameType>::add_event_frame(const FrameType &frame) {
+    add_event_frame(std::make_shared<const FrameType>(frame));
+}
+
+template<class FrameType>
+void I_EventFrameDecoder<FrameType>::add_event_frame(std::shared_ptr<const FrameType> frame) {
     {
-        auto new_frame = std::make_shared<FrameType>(std::move(frame));
         std::lock_guard<std::mutex> lock(last_frame_lock_);
-        last_frame_ = new_frame;
+        last_frame_ = frame;
     }
 
     for (auto &it : cbs_map_) {
-        it.second(*last_frame_);
+        it.second(*frame);
     }
 }
 /// @endcond
@@ -12,6 +12,7 @@
 #ifndef METAVISION_HAL_I_EVENTS_STREAM_H
 #define METAVISION_HAL_I_EVENTS_STREAM_H
 
+#include <chrono>
 #include <exception>
 #include <filesystem>
 #include <string>
@@ -33,6 +34,7 @@ class Device;
 class I_HW_Identification;
 
 class I_EventsStreamDecoder;
+class RawIndexTrailerWriter;
 
 /// @brief Class for getting buffers from cameras or files.
 class I_EventsStream : public I_RegistrableFacility<I_EventsStream> {
@@ -81,12 +83,64 @@ public:
     /// log_raw_data
     DataTransfer::BufferPtr get_latest_raw_data();
 
+    /// @brief Gets the time at which the buffer last returned by @ref get_latest_raw_data was received from the data
+    /// transfer
+    ///
+    /// The difference between this time and the time at which the buffer is processed is the time the buffer spent
+    /// waiting in the queue of available buffers.
+    ///
+    /// @return Arrival time of the latest buffer, or a default constructed time point if no buffer was returned yet
+    /// @warning This function must be called from the thread calling @ref get_latest_raw_data
+    std::chrono::steady_clock::time_point get_latest_raw_data_arrival_time() const;
+
+    /// @brief Checks if some data was dropped right before the buffer last returned by @ref get_latest_raw_data
+    ///
+    /// The data may have been dropped by the events stream (see @ref set_max_queued_buffers), or by the data producer
+    /// (see @ref DataTransfer::RawDataProducer::transferred_buffer_follows_dropped_data). When it is the case, the buffer does not follow the previously returned one in the stream, and the decoder state
+    /// must be reset (see @ref I_EventsStreamDecoder::reset_last_timestamp) before decoding it.
+    ///
+    /// @return true if buffers were dropped before the latest buffer, false otherwise
+    /// @warning This function must be called from the thread calling @ref get_latest_raw_data
+    bool latest_raw_data_follows_dropped_data() const;
+
+    /// @brief Sets the maximum number of buffers waiting to be retrieved by @ref get_latest_raw_data
+    ///
+    /// When a buffer is transferred while the queue of available buffers is full, the oldest queued buffers are
+    /// dropped, so that the memory used and the latency stay bounded when the consumer falls behind. The dropped data
+    /// is not written in the RAW file being logged, if any.
+    ///
+    /// @param max_queued_buffers Maximum number of queued buffers, or 0 for an unbounded queue (default)
+    void set_max_queued_buffers(std::size_t max_queued_buffers);
+
+    /// @brief Gets the maximum number of buffers waiting to be retrieved by @ref get_latest_raw_data
+    /// @return Maximum number of queued buffers, or 0 if the queue is unbounded
+    std::size_t get_max_queued_buffers() const;
+
+    /// @brief Gets the number of buffers waiting to be retrieved by @ref get_latest_raw_data
+    /// @return Number of queued buffers
+    std::size_t get_num_queued_buffers() const;
+
+    /// @brief Amount of data dropped because the queue of available buffers was full
+    struct DroppedData {
+        uint64_t buffers_{0}; ///< Number of dropped buffers
+        uint64_t bytes_{0};   ///< Number of dropped bytes
+    };
+
+    /// @brief Gets the amount of data dropped since the construction of the events stream
+    /// @return The dropped data
+    /// @sa @ref set_max_queued_buffers
+    DroppedData get_dropped_data() const;
+
     /// @brief Enables the logging of the stream of events in the input file @a f
     ///
     /// This methods first writes the header retrieved through @ref I_HW_Identification.
     /// Buffers of data are then written each time @ref get_latest_raw_data is called (i.e. in the same thread it is
     /// called).
     ///
+    /// For the EVT2, EVT2.1 and EVT3 formats, the index of the file is built while the data is logged, and appended to
+    /// the file as a trailer when the logging stops (see @ref RawIndexTrailerWriter), so that the file can be seeked
+    /// without being indexed first.
+    ///
     /// @param f The file to log into
     /// @return true if the file could be opened for writing, false otherwise or if the file name @a f is the same
     /// as the one read from
@@ -151,6 +205,16 @@ public:
     /// @return a status (@ref SeekStatus) holding the result of the seek
     SeekStatus seek(timestamp target_ts_us, timestamp &reached_ts_us);
 
+    /// @brief Gets the bookmark @ref seek would reach for the input @a target_ts_us, without seeking
+    ///
+    /// The byte offset of the bookmark is the position in the RAW file from which the data can be decoded, after the
+    /// decoder has been reset to the timestamp of the bookmark.
+    /// @param target_ts_us The target timestamp to reach in the RAW file
+    /// @param bookmark The bookmark, with a timestamp in the same time reference as @a target_ts_us, if the call
+    /// succeeds
+    /// @return a status (@ref SeekStatus) holding the result of the look up
+    SeekStatus get_bookmark(timestamp target_ts_us, Bookmark &bookmark) const;
+
     /// @brief Gets the range of timestamp reachable through the @ref seek method.
     /// @param event_start_ts_us The timestamp of the first valid data in the file
     /// @param event_end_ts_us The timestamp of the last valid data in the file
@@ -181,9 +245,12 @@ private:
     /// @brief Builds and loads the index in memory
     virtual Index index_impl(Device &device);
 
+    SeekStatus find_bookmark(timestamp target_ts_us, size_t &bookmark_index) const;
+
     void release_data_transfer_buffers();
     void start_device();
     void stop_device();
+    void close_log_raw_data();
 
     std::shared_ptr<I_HW_Identification> hw_identification_;
     std::shared_ptr<I_EventsStreamDecoder> decoder_;
@@ -192,15 +259,25 @@ private:
     std::filesystem::path underlying_file_;
 
     std::unique_ptr<std::ofstream> log_raw_data_;
+    std::unique_ptr<RawIndexTrailerWriter> log_raw_index_;
     std::mutex log_raw_safety_;
 
     DataTransfer data_transfer_;
     std::exception_ptr data_transfer_connection_error_;
     std::shared_ptr<DeviceControl> device_control_;
-    std::mutex new_buffer_safety_;
+    mutable std::mutex new_buffer_safety_;
     std::condition_variable new_buffer_cond_;
-    std::queue<DataTransfer::BufferPtr> available_buffers_;
+    struct AvailableBuffer {
+        DataTransfer::BufferPtr buffer;
+        std::chrono::steady_clock::time_point arrival_time;
+        bool follows_dropped_data{false};
+    };
+    std::queue<AvailableBuffer> available_buffers_;
     DataTransfer::BufferPtr returned_buffer_;
+    std::chrono::steady_clock::time_point returned_buffer_arrival_time_;
+    bool returned_buffer_follows_dropped_data_{false};
+    std::size_t max_queued_buffers_{0};
+    DroppedData dropped_data_;
 
     // For some data transfer, we should not release already transferred buffers when streaming is stopped
     // To achieve this, we copy buffers internally in a temporary buffer pool to always leave the data transfer
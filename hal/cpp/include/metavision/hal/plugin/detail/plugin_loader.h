@@ -9,7 +9,11 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -21,6 +25,20 @@ namespace Metavision {
 class Plugin;
 class PluginLoader {
 public:
+    /// @brief Information about a plugin that is known without loading its library
+    ///
+    /// The description is filled when the library is loaded for the first time and then kept in the plugins manifest,
+    /// so that subsequent processes can select the plugins to load without opening every library.
+    struct PluginDescription {
+        std::string name;
+        std::string integrator_name;
+        size_t camera_discovery_count = 0;
+        size_t file_discovery_count   = 0;
+    };
+
+    /// @brief Predicate used to select plugins from their description
+    using PluginFilter = std::function<bool(const PluginDescription &)>;
+
     PluginLoader();
     ~PluginLoader();
 
@@ -29,29 +47,64 @@ public:
     void insert_folders(const std::vector<std::string> &folders);
     void insert_folders(const std::vector<std::filesystem::path> &folders);
 
+    /// @brief Sets the path of the plugins manifest
+    ///
+    /// The manifest caches the description of each library found in the plugin folders, keyed by its path, size and
+    /// modification time. Plugins described in an up-to-date manifest entry are only loaded when they are first
+    /// accessed, and libraries known not to be plugins are not loaded at all.
+    /// @param manifest_path Path of the manifest file, an empty path disables the manifest
+    void set_manifest_path(const std::filesystem::path &manifest_path);
+
     void load_plugins();
     void unload_plugins();
 
     class PluginList;
     PluginList get_plugin_list();
 
+    /// @brief Gets the list of plugins whose description matches a filter
+    ///
+    /// Plugins rejected by the filter are not loaded.
+    /// @param filter Predicate selecting the plugins to list
+    PluginList get_plugin_list(const PluginFilter &filter);
+
+    /// @brief Gets the description of all the plugins, without loading them
+    std::vector<PluginDescription> get_plugin_descriptions() const;
+
+    /// @brief Returns true if the library of a plugin has been loaded
+    /// @param plugin_name Name of the plugin
+    bool is_plugin_loaded(const std::string &plugin_name) const;
+
 private:
     struct PluginInfo;
     struct Library;
+    struct ManifestEntry {
+        std::int64_t mtime = 0;
+        std::uintmax_t size = 0;
+        bool is_plugin      = false;
+        PluginDescription description;
+    };
 
     void insert_plugin(const std::string &name, const std::filesystem::path &library_path);
     void insert_plugin(const PluginInfo &info);
 
+    void read_manifest();
+    void write_manifest();
+
     std::vector<std::filesystem::path> folders_;
     std::vector<std::unique_ptr<Library>> libraries_;
 
+    std::filesystem::path manifest_path_;
+    std::map<std::string, ManifestEntry> manifest_;
+    bool manifest_read_  = false;
+    bool manifest_dirty_ = false;
+
     static std::unique_ptr<Plugin> make_plugin(const std::string &plugin_name);
 
 public:
     class PluginList {
-        using container = typename std::vector<std::unique_ptr<Library>>;
-
     public:
+        using container = typename std::vector<Library *>;
+
         class iterator {
         public:
             using difference_type   = typename container::difference_type;
@@ -71,14 +124,14 @@ public:
             typename container::iterator it_;
         };
 
-        PluginList(std::vector<std::unique_ptr<Library>> &);
+        PluginList(container libraries);
         iterator begin();
         iterator end();
         size_t size() const;
         bool empty() const;
 
     private:
-        container &libraries_;
+        container libraries_;
     };
 }; // namespace Metavision
 
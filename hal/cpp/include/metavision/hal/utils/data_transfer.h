@@ -87,6 +87,17 @@ public:
         /// @warning Resources should not be clean up in this method as run_impl could still try to use them. It is
         /// advised to do so in the scope of the run_impl method to avoid concurrent calls
         virtual void stop_impl() {}
+
+        /// @brief Checks if the buffer being transferred follows data lost by the producer
+        ///
+        /// When it is the case, the buffer does not follow the previously transferred one in the stream, and the
+        /// decoder state must be reset before decoding it.
+        ///
+        /// @return true if data was lost right before the buffer being transferred, false otherwise
+        /// @warning This method must be called from the callbacks of the transfer, while the buffer is transferred
+        virtual bool transferred_buffer_follows_dropped_data() const {
+            return false;
+        }
     };
 
     /// Alias for a shared pointer to a RawDataProducer
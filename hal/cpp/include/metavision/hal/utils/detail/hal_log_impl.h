@@ -19,6 +19,11 @@ namespace detail {
 namespace hal {
 static std::string PrefixFmt("[HAL][<LEVEL>] ");
 
+template<Metavision::LogLevel Level>
+Metavision::LoggingOperation<Level> log(const char *file, int line, const char *function) {
+    return Metavision::detail::makeLoggingOperation<Level>(PrefixFmt, file, line, function);
+}
+
 template<Metavision::LogLevel Level>
 Metavision::LoggingOperation<Level> log(const std::string &file, int line, const std::string &function) {
     return Metavision::LoggingOperation<Level>(getLogOptions(), PrefixFmt, file, line, function);
@@ -0,0 +1,102 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_DETAIL_NETWORK_RAW_STREAM_PROTOCOL_H
+#define METAVISION_HAL_DETAIL_NETWORK_RAW_STREAM_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace Metavision {
+namespace detail {
+
+/// @brief Protocol used to stream RAW data over TCP
+///
+/// Upon connection, the server sends a handshake made of the magic number, the protocol version and the size of the
+/// RAW header, followed by the RAW header itself. The RAW data is then sent as frames, each made of a frame header
+/// followed by the payload. All the integers are little endian.
+namespace RawStreamProtocol {
+
+constexpr uint32_t kMagic             = 0x5352564d; // "MVRS"
+constexpr uint32_t kVersion           = 1;
+constexpr std::size_t kHandshakeSize  = 12;
+constexpr std::size_t kMaxHeaderSize  = 1 << 16;
+constexpr std::size_t kMaxPayloadSize = 1 << 26;
+
+enum FrameFlags : uint32_t {
+    /// The payload is compressed with @ref lz_compress
+    Compressed = 1,
+    /// Data was dropped for this client before the payload, which thus does not follow the previous frame's one
+    FollowsDroppedData = 2,
+};
+
+struct FrameHeader {
+    static constexpr std::size_t kEncodedSize = 32;
+
+    uint32_t flags        = 0;
+    uint32_t payload_size = 0; ///< Size of the payload, as sent
+    uint32_t raw_size     = 0; ///< Size of the RAW data, once decompressed
+    uint64_t sequence     = 0; ///< Index of the frame since the connection of the client
+    int64_t send_time_us  = 0; ///< Time at which the frame was sent, in us since the epoch of the system clock
+
+    void encode(uint8_t *buffer) const;
+
+    /// @return false if the header is not valid
+    bool decode(const uint8_t *buffer);
+};
+
+void encode_handshake(uint32_t header_size, uint8_t *buffer);
+
+/// @return false if the handshake is not valid
+bool decode_handshake(const uint8_t *buffer, uint32_t &header_size);
+
+/// @brief Gets the maximum size of the data compressed by @ref lz_compress
+std::size_t lz_compress_bound(std::size_t size);
+
+/// @brief Compresses data with a byte oriented LZ77 scheme
+///
+/// The compression is lightweight: it only looks for repetitions of at least 4 bytes, within the last 64 KiB, which
+/// is enough to take advantage of the redundancy of the RAW event formats without slowing down the stream.
+/// @param src Data to compress
+/// @param size Size of the data to compress
+/// @param dst Output buffer, of at least @ref lz_compress_bound(size) bytes
+/// @return Size of the compressed data
+std::size_t lz_compress(const uint8_t *src, std::size_t size, uint8_t *dst);
+
+/// @brief Decompresses data compressed by @ref lz_compress
+/// @param src Compressed data
+/// @param size Size of the compressed data
+/// @param dst Output buffer
+/// @param dst_size Size of the decompressed data
+/// @return false if the compressed data is corrupted or does not decompress to exactly @p dst_size bytes
+bool lz_decompress(const uint8_t *src, std::size_t size, uint8_t *dst, std::size_t dst_size);
+
+#ifndef _WIN32
+/// @brief Sends all the data on a socket
+/// @return false if the connection was closed or failed
+bool send_all(int socket, const void *data, std::size_t size);
+
+/// @brief Receives exactly @p size bytes from a socket
+///
+/// The socket is polled periodically, so that the call can be interrupted.
+/// @param should_stop Function called between two polls, the call returns false when it returns true
+/// @return false if the connection was closed or failed, or if the call was interrupted
+bool recv_all(int socket, void *data, std::size_t size, const std::function<bool()> &should_stop);
+#endif
+
+} // namespace RawStreamProtocol
+
+} // namespace detail
+} // namespace Metavision
+
+#endif // METAVISION_HAL_DETAIL_NETWORK_RAW_STREAM_PROTOCOL_H
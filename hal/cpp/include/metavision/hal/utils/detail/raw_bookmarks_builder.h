@@ -0,0 +1,88 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_DETAIL_RAW_BOOKMARKS_BUILDER_H
+#define METAVISION_HAL_DETAIL_RAW_BOOKMARKS_BUILDER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "metavision/hal/facilities/i_events_stream.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+class I_EventsStreamDecoder;
+
+namespace detail {
+
+/// @brief Computes the bookmarks of the index of RAW data, decoding it event per event
+///
+/// This is shared by the indexing of RAW files (see @ref I_EventsStream::index) and the index trailer written while
+/// recording (see @ref RawIndexTrailerWriter), so that both produce the same bookmarks.
+///
+/// The number of CD events is not counted by the builder: @ref add_cd_events must be called from a callback of the CD
+/// decoder fed by @p decoder.
+class RawBookmarksBuilder {
+public:
+    /// @brief Callback called for each bookmark, in order
+    /// @return false to stop the building, for instance if the bookmark could not be written
+    using BookmarkCallback = std::function<bool(const I_EventsStream::Bookmark &)>;
+
+    /// @brief Constructor
+    /// @param decoder Decoder of the RAW data, used to decode the events one by one
+    /// @param bookmark_period_us Period of the bookmarks, in us
+    /// @param data_start_pos Position in the file of the first byte of RAW data
+    /// @param bookmark_cb Callback called for each bookmark
+    RawBookmarksBuilder(I_EventsStreamDecoder &decoder, uint32_t bookmark_period_us, uint64_t data_start_pos,
+                        const BookmarkCallback &bookmark_cb);
+
+    /// @brief Counts CD events decoded from the data
+    void add_cd_events(std::size_t count);
+
+    /// @brief Decodes a single event, following the previously added ones
+    /// @param raw_event Pointer to the first byte of the event, of the raw event size of the decoder
+    /// @return false if the bookmark callback failed, true otherwise
+    bool add_event(const uint8_t *raw_event);
+
+    /// @brief Gets the bookmark of the last timestamp, which ends the index once all the data has been added
+    I_EventsStream::Bookmark get_last_bookmark() const;
+
+    /// @brief Checks if the timestamp shift has been found in the data added so far
+    bool is_ts_shift_computed() const;
+
+    /// @brief Gets the timestamp shift of the data, valid if @ref is_ts_shift_computed returns true
+    timestamp get_ts_shift() const;
+
+    /// @brief Gets the position in the file of the end of the data added so far
+    uint64_t get_byte_offset() const;
+
+private:
+    I_EventsStreamDecoder &decoder_;
+    const std::size_t raw_event_size_bytes_;
+    const uint32_t bookmark_period_us_;
+    const BookmarkCallback bookmark_cb_;
+
+    uint64_t byte_offset_;
+    bool ts_shift_computed_ = false;
+    timestamp ts_shift_us_  = 0;
+    timestamp prev_ts_;
+    std::size_t last_bookmark_index_ = 0;
+    uint32_t cd_event_count_         = 0;
+    // bookmark of the last timestamp starting a new period
+    I_EventsStream::Bookmark last_bookmark_;
+};
+
+} // namespace detail
+} // namespace Metavision
+
+#endif // METAVISION_HAL_DETAIL_RAW_BOOKMARKS_BUILDER_H
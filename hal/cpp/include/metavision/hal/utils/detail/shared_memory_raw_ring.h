@@ -0,0 +1,146 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_DETAIL_SHARED_MEMORY_RAW_RING_H
+#define METAVISION_HAL_DETAIL_SHARED_MEMORY_RAW_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Metavision {
+namespace detail {
+
+/// @brief Ring of RAW data buffers living in a named POSIX shared memory object
+///
+/// The shared memory object starts with a control block, holding the RAW header of the published stream, the write
+/// position of the publisher and the read positions of the consumers, followed by the data area. The data area is a
+/// byte ring whose capacity is a power of two, indexed by monotonic positions. Each record is made of a
+/// @ref RecordHeader followed by the data, padded to @ref kRecordAlignment bytes. Records never wrap around the end of
+/// the data area: a padding record is written instead, telling the consumers to continue at the beginning of the area.
+///
+/// The publisher never overwrites the records that an active consumer has not released yet.
+class SharedMemoryRawRing {
+public:
+    static constexpr std::size_t kMaxConsumers    = 16;
+    static constexpr std::size_t kMaxHeaderSize   = 4096;
+    static constexpr std::size_t kRecordAlignment = 8;
+    static constexpr std::size_t kMinCapacity     = 4096;
+
+    enum ConsumerState : uint32_t { Free = 0, Joining = 1, Active = 2 };
+
+    struct Consumer {
+        std::atomic<uint32_t> state;
+        /// Process of the consumer, 0 while the slot is free or until the joining process sets it
+        std::atomic<int64_t> pid;
+        /// Position of the oldest record not released by the consumer
+        std::atomic<uint64_t> read_pos;
+    };
+
+    struct Control {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t slow_consumer_policy;
+        uint64_t capacity;
+        int64_t publisher_pid;
+        std::atomic<uint32_t> closed;
+        std::atomic<uint64_t> write_pos;
+        std::atomic<uint64_t> dropped_bytes;
+        alignas(64) Consumer consumers[kMaxConsumers];
+        uint64_t header_size;
+        char header[kMaxHeaderSize];
+    };
+
+    struct RecordHeader {
+        uint32_t size;
+        uint32_t padding;
+    };
+
+    /// @brief Creates a shared memory ring, owned by the caller
+    ///
+    /// A ring left behind by a publisher that did not exit cleanly is replaced.
+    /// @param name Name of the published stream
+    /// @param capacity Minimum size in bytes of the data area, rounded up to a power of two of at least
+    /// @ref kMinCapacity
+    /// @param header RAW header of the published stream
+    /// @param slow_consumer_policy Policy of the publisher, stored for the consumers' information
+    /// @param permissions Access permissions of the shared memory object
+    /// @throw HalException if the shared memory object can not be created, or if a stream is already published with
+    /// this name
+    static std::unique_ptr<SharedMemoryRawRing> create(const std::string &name, std::size_t capacity,
+                                                       const std::string &header, uint32_t slow_consumer_policy,
+                                                       uint32_t permissions);
+
+    /// @brief Opens a shared memory ring created by another process
+    ///
+    /// The control block is checked, and the capacity is read once, so that a corrupted control block can not make
+    /// the caller access memory out of the mapping.
+    /// @param name Name of the published stream
+    /// @throw HalException if there is no valid ring with this name
+    static std::unique_ptr<SharedMemoryRawRing> open(const std::string &name);
+
+    /// @brief Lists the names of the streams currently published
+    static std::vector<std::string> list();
+
+    /// @brief Checks if a process is still running
+    static bool is_process_alive(int64_t pid);
+
+    /// @brief Gets the identifier of the calling process
+    static int64_t get_current_pid();
+
+    /// @brief Frees the slot of a consumer whose process exited, whether it is active or still joining
+    /// @return true if the slot was freed
+    static bool release_dead_consumer(Consumer &consumer);
+
+    /// @brief Destructor
+    ///
+    /// Unmaps the ring, and removes its name if it is owned by the caller. The processes that opened the ring keep it
+    /// mapped until they close it.
+    ~SharedMemoryRawRing();
+
+    Control &control() const {
+        return *control_;
+    }
+
+    char *data() const {
+        return data_;
+    }
+
+    uint64_t capacity() const {
+        return capacity_;
+    }
+
+    static uint64_t record_size(std::size_t data_size) {
+        return (sizeof(RecordHeader) + data_size + kRecordAlignment - 1) & ~uint64_t(kRecordAlignment - 1);
+    }
+
+private:
+    SharedMemoryRawRing(const std::string &object_name, void *mapping, std::size_t mapping_size, bool owner,
+                        uint64_t capacity);
+
+    static std::size_t get_control_size();
+
+    std::string object_name_;
+    void *mapping_;
+    std::size_t mapping_size_;
+    bool owner_;
+    Control *control_;
+    char *data_;
+    uint64_t capacity_;
+};
+
+} // namespace detail
+} // namespace Metavision
+
+#endif // METAVISION_HAL_DETAIL_SHARED_MEMORY_RAW_RING_H
@@ -0,0 +1,101 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_NETWORK_RAW_DATA_PRODUCER_H
+#define METAVISION_HAL_NETWORK_RAW_DATA_PRODUCER_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "metavision/hal/utils/data_transfer.h"
+#include "metavision/hal/utils/raw_file_header.h"
+
+namespace Metavision {
+
+/// @brief Reads a RAW data stream sent over TCP by a @ref NetworkRawStreamServer
+///
+/// The connection is made, and the RAW header received, upon construction. The stream is read live: the data sent
+/// while the transfer is suspended is received when it is resumed, within the limits of the server's queue. The
+/// transfer stops by itself when the server closes the connection. When the server drops data because the client is
+/// too slow, the next transferred buffer is flagged (see @ref transferred_buffer_follows_dropped_data).
+///
+/// @note Only available on POSIX systems
+class NetworkRawDataProducer : public DataTransfer::RawDataProducer {
+public:
+    /// @brief Statistics of the received stream
+    struct Statistics {
+        /// Number of bytes of RAW data received
+        uint64_t received_raw_bytes = 0;
+        /// Number of bytes received from the network, which is lower than the RAW data when compressed
+        uint64_t received_bytes = 0;
+        /// Number of frames received
+        uint64_t received_frames = 0;
+        /// Number of frames received after data was dropped by the server, because the client was too slow
+        uint64_t frames_following_dropped_data = 0;
+        /// Mean throughput of RAW data in bytes per second, since the first frame was received
+        double throughput = 0.;
+        /// Latency of the last frame in us, from the time it was sent by the server to the time it was received
+        /// @note The latency is computed from the system clocks of both machines, it is only meaningful if they are
+        /// synchronized
+        int64_t last_latency_us = 0;
+        /// Mean latency of the frames in us
+        double mean_latency_us = 0.;
+        /// Maximum latency of the frames in us
+        int64_t max_latency_us = 0;
+    };
+
+    /// @brief Constructor
+    ///
+    /// Connects to the server and receives the RAW header of the stream.
+    /// @param host Host name or address of the server
+    /// @param port Port the server listens on
+    /// @throw HalException if the connection fails or if the server does not send a valid stream
+    NetworkRawDataProducer(const std::string &host, uint16_t port);
+
+    /// @brief Destructor
+    ~NetworkRawDataProducer() override;
+
+    /// @brief Parses a URI of the form "tcp://<host>:<port>"
+    /// @param uri URI to parse
+    /// @param host Parsed host name or address
+    /// @param port Parsed port
+    /// @return true if the URI is valid
+    static bool parse_uri(const std::string &uri, std::string &host, uint16_t &port);
+
+    /// @brief Gets the RAW header of the stream
+    const RawFileHeader &get_header() const;
+
+    /// @brief Gets the statistics of the stream since the connection
+    Statistics get_statistics() const;
+
+    /// @brief Checks if the server dropped data before the buffer being transferred
+    bool transferred_buffer_follows_dropped_data() const override;
+
+private:
+    void run_impl(const DataTransfer &data_transfer) override final;
+
+    int socket_ = -1;
+    bool connected_;
+    RawFileHeader header_;
+    DataTransfer::DefaultBufferPool buffer_pool_;
+    std::vector<uint8_t> payload_;
+    bool buffer_follows_dropped_data_ = false;
+
+    mutable std::mutex statistics_mutex_;
+    Statistics statistics_;
+    int64_t first_frame_time_us_ = 0;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_NETWORK_RAW_DATA_PRODUCER_H
@@ -0,0 +1,120 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_NETWORK_RAW_STREAM_SERVER_H
+#define METAVISION_HAL_NETWORK_RAW_STREAM_SERVER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "metavision/hal/utils/data_transfer.h"
+#include "metavision/hal/utils/raw_file_header.h"
+
+namespace Metavision {
+
+/// @brief Network RAW stream server's options
+class NetworkRawStreamServerConfig {
+public:
+    /// Address of the interface to listen on, all the interfaces by default
+    std::string address_ = "0.0.0.0";
+
+    /// Port to listen on, if 0 a free port is chosen (see @ref NetworkRawStreamServer::get_port)
+    uint16_t port_ = 0;
+
+    /// Buffers are batched in frames of up to this size in bytes before being sent
+    std::size_t batch_size_ = 256 * 1024;
+
+    /// Maximum time a buffer waits for other buffers to be batched with
+    std::chrono::microseconds max_batch_delay_{1000};
+
+    /// True if the frames should be compressed. Frames that do not get smaller are sent uncompressed.
+    bool compression_ = false;
+
+    /// Maximum amount of data in bytes queued for a client, the buffers published when it is reached are dropped as a
+    /// whole for this client
+    std::size_t max_queued_bytes_ = 64 * 1024 * 1024;
+};
+
+/// @brief Streams RAW data to clients connected over TCP
+///
+/// Each client gets the RAW header of the stream upon connection, then the buffers published from then on. The
+/// buffers are queued per client without being copied, and sent by a dedicated thread per client, batched in frames
+/// that are optionally compressed. A client too slow to keep up loses the buffers that do not fit in its queue,
+/// without slowing down the other clients. The published buffers are dropped as a whole, so they must hold complete
+/// RAW events, and the client is notified of the discontinuity so that it resets its decoder.
+///
+/// The stream is read with a @ref NetworkRawDataProducer, for instance by opening the camera of serial
+/// "tcp://<host>:<port>".
+///
+/// @note Only available on POSIX systems
+class NetworkRawStreamServer {
+public:
+    /// @brief Server statistics
+    struct Statistics {
+        /// Number of bytes of RAW data published
+        uint64_t published_bytes = 0;
+        /// Number of bytes of RAW data sent, summed over the clients
+        uint64_t sent_raw_bytes = 0;
+        /// Number of bytes sent on the network, summed over the clients
+        uint64_t sent_bytes = 0;
+        /// Number of frames sent, summed over the clients
+        uint64_t sent_frames = 0;
+        /// Number of bytes of RAW data dropped because a client was too slow, summed over the clients
+        uint64_t dropped_bytes = 0;
+        /// Number of published buffers dropped because a client was too slow, summed over the clients
+        uint64_t dropped_buffers = 0;
+    };
+
+    /// @brief Constructor
+    ///
+    /// Starts listening for clients.
+    /// @param header RAW header of the stream, sent to the clients so that they can decode it
+    /// @param config Configuration of the server
+    /// @throw HalException if the server can not listen on the configured address and port
+    NetworkRawStreamServer(const RawFileHeader &header,
+                           const NetworkRawStreamServerConfig &config = NetworkRawStreamServerConfig());
+
+    /// @brief Destructor
+    ///
+    /// Sends the queued data and disconnects the clients.
+    ~NetworkRawStreamServer();
+
+    /// @brief Gets the port the server listens on
+    uint16_t get_port() const;
+
+    /// @brief Publishes a buffer of RAW data to the connected clients
+    ///
+    /// The buffer is queued without being copied, it must not be modified afterwards.
+    /// @param buffer Buffer to publish
+    void publish(const DataTransfer::BufferPtr &buffer);
+
+    /// @brief Publishes a copy of a range of RAW data to the connected clients
+    /// @param begin Pointer to the first byte to publish
+    /// @param end Pointer after the last byte to publish
+    void publish(const DataTransfer::Data *begin, const DataTransfer::Data *end);
+
+    /// @brief Gets the number of clients currently connected
+    std::size_t get_num_clients() const;
+
+    /// @brief Gets the statistics of the server since its creation
+    Statistics get_statistics() const;
+
+private:
+    class Private;
+    std::unique_ptr<Private> pimpl_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_NETWORK_RAW_STREAM_SERVER_H
@@ -37,6 +37,10 @@ public:
     /// True if indexing should be performed when opening the file
     /// Alternatively, indexing can still be requested by calling I_EventsStream::index directly
     bool build_index_ = true;
+
+    /// True if the CD events of EVT2.1 files should be decoded as vectors, i.e. with an I_EventDecoder<EventCDVector>
+    /// facility instead of an I_EventDecoder<EventCD> one
+    bool evt21_keep_vectors_ = false;
 };
 
 } // namespace Metavision
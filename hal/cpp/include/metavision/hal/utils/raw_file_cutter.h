@@ -0,0 +1,58 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_RAW_FILE_CUTTER_H
+#define METAVISION_HAL_RAW_FILE_CUTTER_H
+
+#include <filesystem>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+class Device;
+
+/// @brief Result of @ref cut_raw_file
+enum class RawFileCutStatus {
+    Success,      ///< The output file was written
+    NothingToCut, ///< There is no event at or after the start timestamp, no output file was written
+    Failed        ///< The file can not be cut without decoding it, or the output file could not be written
+};
+
+/// @brief Cuts a RAW file between two timestamps, copying the data in between instead of decoding it
+///
+/// The index of the RAW file (see @ref I_EventsStream::index) gives the position of the bookmarks preceding the cut
+/// points, so that only the data between those bookmarks and the first events at or after @p start_ts and @p end_ts is
+/// decoded. The data between the two cut points is then copied as is (with copy_file_range when available), after the
+/// header of the RAW file and a prologue holding the time base of the first copied event, so that the output file can
+/// be decoded on its own. In EVT3, the row address is not repeated after each time base change, so the last row address
+/// before each bookmark is looked for backwards in the file, and the one of the first copied event is added to the
+/// prologue.
+///
+/// When @p start_ts is before the first event of the file, the data is copied from the beginning of the file and no
+/// prologue is added, so that the output file has the same time origin as the input one.
+///
+/// Only the EVT2, EVT2.1 and EVT3 formats are supported.
+///
+/// @param device Device opened from the RAW file to cut, whose events stream must not be started. If the index of the
+/// file is being built, the call blocks until it is available.
+/// @param output_path Path of the output RAW file
+/// @param start_ts Timestamp of the first event to keep, in the time reference of the decoder of the device
+/// @param end_ts Timestamp after the last event to keep, in the time reference of the decoder of the device
+/// @return @ref RawFileCutStatus::Success if the file was cut, @ref RawFileCutStatus::NothingToCut if there is no
+/// event at or after @p start_ts, and @ref RawFileCutStatus::Failed if the format of the file is not supported, if the
+/// file is not indexed or if the output file could not be written
+RawFileCutStatus cut_raw_file(Device &device, const std::filesystem::path &output_path, timestamp start_ts,
+                              timestamp end_ts);
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_RAW_FILE_CUTTER_H
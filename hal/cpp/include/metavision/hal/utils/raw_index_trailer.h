@@ -0,0 +1,95 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_RAW_INDEX_TRAILER_H
+#define METAVISION_HAL_RAW_INDEX_TRAILER_H
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+
+#include "metavision/hal/facilities/i_events_stream.h"
+#include "metavision/hal/utils/raw_file_header.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Index of a RAW file, as stored in the trailer appended to the file when it was recorded
+struct RawIndexTrailer {
+    /// Position in the file of the end of the RAW data, where the trailer starts
+    uint64_t data_end_pos_{0};
+
+    /// Period of the bookmarks, in us
+    uint32_t bookmark_period_us_{0};
+
+    /// Timestamp shift of the data, in us
+    timestamp ts_shift_us_{0};
+
+    /// Bookmarks of the file, with the same semantic as the ones of @ref I_EventsStream::Index
+    I_EventsStream::Bookmarks bookmarks_;
+};
+
+/// @brief Builds the index of RAW data while it is recorded, and appends it to the RAW file as a trailer
+///
+/// The bookmarks are the ones that would be computed when indexing the file after the recording (see
+/// @ref I_EventsStream::index), so that the recording can be seeked right away without an indexing pass, even when
+/// stored where no index file can be written next to it.
+///
+/// The trailer is encoded as CONTINUED words, which are ignored by the decoders, so that the files stay readable by
+/// readers not knowing about it. Only the EVT2, EVT2.1 and EVT3 formats are supported.
+class RawIndexTrailerWriter {
+public:
+    /// @brief Constructor
+    /// @param header Header of the RAW file, from which the format of the data is read
+    /// @param data_start_pos Position in the file of the first byte of RAW data, i.e. the size of the header
+    /// @param bookmark_period_us Period of the bookmarks, in us
+    RawIndexTrailerWriter(const RawFileHeader &header, uint64_t data_start_pos, uint32_t bookmark_period_us = 2000);
+
+    /// @brief Destructor
+    ~RawIndexTrailerWriter();
+
+    /// @brief Checks if the format of the data supports an index trailer
+    /// @return true if the format is supported, false otherwise in which case the data is not indexed
+    bool is_supported() const;
+
+    /// @brief Updates the index with RAW data written in the file after the data previously added
+    /// @param begin Pointer to the first byte of the data
+    /// @param end Pointer after the last byte of the data
+    void add_data(const uint8_t *begin, const uint8_t *end);
+
+    /// @brief Gets the number of bytes of RAW data added so far
+    uint64_t get_data_size() const;
+
+    /// @brief Writes the trailer, once all the RAW data has been written in @p stream
+    /// @param stream Stream of the RAW file
+    /// @return true if the trailer was written, false if the format is not supported, if no timestamp was found in the
+    /// data or if the writing failed
+    bool write(std::ostream &stream);
+
+private:
+    class Private;
+    std::unique_ptr<Private> pimpl_;
+};
+
+/// @brief Reads the index trailer of a RAW file
+///
+/// The position of @p stream is restored before returning.
+///
+/// @param stream Stream of the RAW file
+/// @param trailer Index read from the trailer
+/// @param read_bookmarks If false, only the position of the trailer is read, and not the bookmarks
+/// @return true if the file ends with a valid index trailer, false otherwise
+bool read_raw_index_trailer(std::istream &stream, RawIndexTrailer &trailer, bool read_bookmarks = true);
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_RAW_INDEX_TRAILER_H
@@ -0,0 +1,60 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_SHARED_MEMORY_RAW_DATA_PRODUCER_H
+#define METAVISION_HAL_SHARED_MEMORY_RAW_DATA_PRODUCER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "metavision/hal/utils/data_transfer.h"
+#include "metavision/hal/utils/raw_file_header.h"
+
+namespace Metavision {
+
+/// @brief Reads a RAW data stream published by a @ref SharedMemoryRawPublisher
+///
+/// The transferred buffers point directly into the shared memory ring, they are not copied. The consumer joins the
+/// stream live: each time the transfer is started, it reads the data published from then on. The records of the ring
+/// are released when the transferred buffers pointing to them are destroyed, so that a consumer holding buffers for a
+/// long time may make the publisher drop data or wait, depending on its policy.
+///
+/// The transfer stops by itself when the publisher closes the stream or exits.
+///
+/// @note Only available on POSIX systems
+class SharedMemoryRawDataProducer : public DataTransfer::RawDataProducer {
+public:
+    /// @brief Constructor
+    /// @param name Name of the published stream to read
+    /// @throw HalException if no stream is published with this name
+    explicit SharedMemoryRawDataProducer(const std::string &name);
+
+    /// @brief Destructor
+    ~SharedMemoryRawDataProducer() override;
+
+    /// @brief Gets the RAW header of the published stream
+    const RawFileHeader &get_header() const;
+
+    /// @brief Lists the names of the streams currently published
+    static std::vector<std::string> list();
+
+private:
+    void run_impl(const DataTransfer &data_transfer) override final;
+
+    struct State;
+    std::shared_ptr<State> state_;
+    RawFileHeader header_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_SHARED_MEMORY_RAW_DATA_PRODUCER_H
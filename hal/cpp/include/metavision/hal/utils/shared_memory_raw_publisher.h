@@ -0,0 +1,100 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_SHARED_MEMORY_RAW_PUBLISHER_H
+#define METAVISION_HAL_SHARED_MEMORY_RAW_PUBLISHER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "metavision/hal/utils/data_transfer.h"
+#include "metavision/hal/utils/raw_file_header.h"
+
+namespace Metavision {
+
+namespace detail {
+class SharedMemoryRawRing;
+} // namespace detail
+
+/// @brief Publishes a RAW data stream through a shared memory ring, so that several processes can read it
+///
+/// The published buffers are copied once in a named shared memory ring. Other processes read them in place with a
+/// @ref SharedMemoryRawDataProducer, for instance by opening the camera of serial "shm:<name>", so that a single live
+/// camera can feed any number of consumers.
+///
+/// Each consumer has its own read position in the ring, and the records it has not released are never overwritten.
+/// When a consumer is too slow and the ring is full, the @ref SlowConsumerPolicy decides whether the new data is
+/// dropped for all the consumers or whether the publisher waits. The consumers whose process exited are ignored.
+///
+/// Typical usage, from the process owning the camera:
+/// @code
+/// SharedMemoryRawPublisher publisher("front", device.get_facility<I_HW_Identification>()->get_header());
+/// // then, from the RAW data callback of the camera
+/// publisher.publish(data, data + size);
+/// @endcode
+///
+/// @note Only available on POSIX systems
+class SharedMemoryRawPublisher {
+public:
+    /// @brief Behavior of the publisher when a consumer is too slow to release its data
+    enum class SlowConsumerPolicy {
+        /// The buffers that do not fit in the ring are dropped, for all the consumers
+        Drop = 0,
+        /// The publisher waits until the slowest consumer releases enough data
+        Block = 1,
+    };
+
+    /// @brief Constructor
+    /// @param name Name of the published stream, a shared memory object with a derived name is created
+    /// @param header RAW header of the published stream, read by the consumers to decode it
+    /// @param capacity Size in bytes of the shared memory ring, rounded up to a power of two of at least 4 KiB
+    /// @param policy Behavior when a consumer is too slow
+    /// @param permissions Access permissions of the shared memory object, as in chmod. By default, only the processes
+    /// of the same user can read the stream
+    /// @throw HalException if the ring can not be created, or if a stream is already published with this name
+    SharedMemoryRawPublisher(const std::string &name, const RawFileHeader &header,
+                             std::size_t capacity = 64 * 1024 * 1024,
+                             SlowConsumerPolicy policy = SlowConsumerPolicy::Drop, uint32_t permissions = 0600);
+
+    /// @brief Destructor
+    ///
+    /// Closes the stream: the consumers reach its end once they have read the published data.
+    ~SharedMemoryRawPublisher();
+
+    /// @brief Publishes a buffer of RAW data
+    /// @param buffer Buffer to publish
+    void publish(const DataTransfer::BufferPtr &buffer);
+
+    /// @brief Publishes a range of RAW data
+    /// @param begin Pointer to the first byte to publish
+    /// @param end Pointer after the last byte to publish
+    void publish(const DataTransfer::Data *begin, const DataTransfer::Data *end);
+
+    /// @brief Gets the number of consumers currently reading the stream
+    std::size_t get_num_consumers() const;
+
+    /// @brief Gets the number of bytes dropped because a consumer was too slow
+    uint64_t get_num_dropped_bytes() const;
+
+private:
+    bool wait_for_room(uint64_t end_pos);
+    void write_record(const DataTransfer::Data *data, std::size_t size);
+
+    std::unique_ptr<detail::SharedMemoryRawRing> ring_;
+    SlowConsumerPolicy policy_;
+    uint64_t write_pos_ = 0;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_SHARED_MEMORY_RAW_PUBLISHER_H
@@ -20,13 +20,69 @@
 #include <metavision/hal/device/device_discovery.h>
 #include <metavision/hal/facilities/i_events_stream.h>
 #include <metavision/hal/utils/raw_file_config.h>
+#include <metavision/hal/utils/raw_file_cutter.h>
 
 namespace po = boost::program_options;
 
+namespace {
+
+// Cuts the RAW file by decoding it up to the end of the cut, and logging the RAW data read in between
+bool cut_by_decoding(const std::string &in_raw_file_path, const std::string &out_raw_file_path,
+                     Metavision::timestamp start_ts, Metavision::timestamp end_ts) {
+    Metavision::RawFileConfig file_config;
+    file_config.n_events_to_read_ = 1024; // Small amount of events per read to have a sufficient time precision and
+                                          // decode efficiency to match the request
+    file_config.build_index_ = false;
+
+    std::unique_ptr<Metavision::Device> device =
+        Metavision::DeviceDiscovery::open_raw_file(in_raw_file_path, file_config);
+
+    // Get the decoder and event stream
+    Metavision::I_EventsStreamDecoder *i_eventsstreamdecoder =
+        device->get_facility<Metavision::I_EventsStreamDecoder>();
+    Metavision::I_EventsStream *i_eventsstream = device->get_facility<Metavision::I_EventsStream>();
+    i_eventsstream->start();
+
+    bool recording                = false;
+    Metavision::timestamp last_ts = 0;
+    while (true) {
+        if (!recording) {
+            if (last_ts >= start_ts) {
+                i_eventsstream->log_raw_data(out_raw_file_path);
+                recording = true;
+            }
+        } else {
+            if (last_ts >= end_ts) {
+                i_eventsstream->stop_log_raw_data();
+                break;
+            }
+        }
+
+        if (i_eventsstream->wait_next_buffer() < 0) {
+            // No more events available (end of file reached)
+            break;
+        }
+
+        // Retrieves raw buffer
+        auto ev_buffer = i_eventsstream->get_latest_raw_data();
+
+        // Decode the raw buffer
+        i_eventsstreamdecoder->decode(ev_buffer);
+
+        // Update last timestamp
+        last_ts = i_eventsstreamdecoder->get_last_timestamp();
+    }
+
+    return recording;
+}
+
+} // namespace
+
 int main(int argc, char *argv[]) {
     std::string in_raw_file_path;
     std::string out_raw_file_path;
     double start, end;
+    bool decode_all = false;
 
     const std::string program_desc(
         "Sample code that demonstrates how to use Metavision HAL API to cut a RAW file.\n"
@@ -41,6 +97,8 @@ int main(int argc, char *argv[]) {
         ("output-raw-file,o",   po::value<std::string>(&out_raw_file_path)->required(), "Path to output RAW file.")
         ("start,s",   po::value<double>(&start)->required(), "The start of the required sequence in seconds.")
         ("end,e",     po::value<double>(&end)->required(), "The end of the required sequence in seconds.")
+        ("decode-all", po::bool_switch(&decode_all), "Decode the whole file to find the cut points, instead of using "
+                                                     "the index of the file to only decode the data around them.")
         ;
     // clang-format on
 
@@ -70,55 +128,28 @@ int main(int argc, char *argv[]) {
     Metavision::timestamp end_ts   = static_cast<Metavision::timestamp>(end * 1000000);
 
     // Start processing
-    std::unique_ptr<Metavision::Device> device;
-    Metavision::RawFileConfig file_config;
-    file_config.n_events_to_read_ = 1024; // Small amount of events per read to have a sufficient time precision and
-                                          // decode efficiency to match the request
-
+    bool saved = false;
     try {
-        device = Metavision::DeviceDiscovery::open_raw_file(in_raw_file_path, file_config);
-    } catch (Metavision::BaseException &e) {
-        MV_LOG_ERROR() << "Error exception:" << e.what();
-        return 1;
-    }
-
-    // Get the decoder and event stream
-    Metavision::I_EventsStreamDecoder *i_eventsstreamdecoder =
-        device->get_facility<Metavision::I_EventsStreamDecoder>();
-    Metavision::I_EventsStream *i_eventsstream = device->get_facility<Metavision::I_EventsStream>();
-    i_eventsstream->start();
-
-    bool recording                = false;
-    Metavision::timestamp last_ts = 0;
-    while (true) {
-        if (!recording) {
-            if (last_ts >= start_ts) {
-                i_eventsstream->log_raw_data(out_raw_file_path);
-                recording = true;
-            }
-        } else {
-            if (last_ts >= end_ts) {
-                i_eventsstream->stop_log_raw_data();
-                break;
+        if (!decode_all) {
+            // The index of the file is used to only decode the data around the cut points, the data in between is
+            // copied as is
+            std::unique_ptr<Metavision::Device> device = Metavision::DeviceDiscovery::open_raw_file(in_raw_file_path);
+            const auto status = Metavision::cut_raw_file(*device, out_raw_file_path, start_ts, end_ts);
+            saved             = status == Metavision::RawFileCutStatus::Success;
+            if (status == Metavision::RawFileCutStatus::Failed) {
+                MV_LOG_INFO() << "Unable to cut the file using its index, decoding the whole file instead";
+                decode_all = true;
             }
         }
-
-        if (i_eventsstream->wait_next_buffer() < 0) {
-            // No more events available (end of file reached)
-            break;
+        if (decode_all) {
+            saved = cut_by_decoding(in_raw_file_path, out_raw_file_path, start_ts, end_ts);
         }
-
-        // Retrieves raw buffer
-        auto ev_buffer = i_eventsstream->get_latest_raw_data();
-
-        // Decode the raw buffer
-        i_eventsstreamdecoder->decode(ev_buffer);
-
-        // Update last timestamp
-        last_ts = i_eventsstreamdecoder->get_last_timestamp();
+    } catch (Metavision::BaseException &e) {
+        MV_LOG_ERROR() << "Error exception:" << e.what();
+        return 1;
     }
 
-    if (!recording) {
+    if (!saved) {
         MV_LOG_WARNING() << "No file saved because the start time provided is after the end of the input file";
     } else {
         MV_LOG_INFO() << "Output saved in file" << out_raw_file_path;
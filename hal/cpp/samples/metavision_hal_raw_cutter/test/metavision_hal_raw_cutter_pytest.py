@@ -16,7 +16,7 @@ import re
 from metavision_utils import os_tools, pytest_tools
 
 
-def cut_and_check_info(input_raw, start, end, expected_output_info=None):
+def cut_and_check_info(input_raw, start, end, expected_output_info=None, extra_args=""):
     """"Runs metavision_hal_raw_cutter on input file and checks the output
 
     Args:
@@ -25,6 +25,7 @@ def cut_and_check_info(input_raw, start, end, expected_output_info=None):
         expected_output_info : expected output on running metavision_file_info on the output file
                                If none is provided, we assume that we have to get the same info as
                                the input file (which is the case when the range covers all the input file)
+        extra_args (str): additional command line arguments
     """
 
     # Before launching the app, check the dataset file exists
@@ -35,8 +36,8 @@ def cut_and_check_info(input_raw, start, end, expected_output_info=None):
     output_file_name = "raw_cut_{}_{}.raw".format(start, end)
     output_file_path = os.path.join(tmp_dir.temporary_directory(), output_file_name)
 
-    cmd = "./metavision_hal_raw_cutter -i \"{}\" --start {} --end {} -o {}".format(input_raw, start, end,
-                                                                                   output_file_path)
+    cmd = "./metavision_hal_raw_cutter -i \"{}\" --start {} --end {} -o {} {}".format(input_raw, start, end, output_file_path,
+                                                                                      extra_args)
     output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
 
     # Check app exited without error
@@ -151,6 +152,12 @@ def pytestcase_test_metavision_hal_raw_cutter_invalid_range(dataset_dir):
     assert re.search("end time {} is less than or equal to start {}".format(end, start), output)
 
 
+# The RAW files are cut from their index, at the exact cut times: the cuts hold the same events as the cuts of the HDF5
+# conversions of the recordings. The timestamps of the events are shifted by the time base of the first copied event,
+# so they are equal to the ones of the HDF5 cuts modulo 64us in EVT2 and modulo 4096us, plus 4096us, in EVT3 (they are
+# unchanged when the cut starts at 0). In EVT2, the duration includes the time high event preceding the first event
+# after the cut.
+# With --decode-all, the events are decoded and cut at the boundaries of the RAW buffers instead.
 def pytestcase_test_metavision_hal_raw_cutter_on_gen31_recording_full_cut(dataset_dir):
     """
     Checks output of metavision_hal_raw_cutter application when the range given spans through the whole file
@@ -179,6 +186,39 @@ def pytestcase_test_metavision_hal_raw_cutter_on_gen31_recording_from_0s_to_6s(d
     expected_output_info = r"""
 ====================================================================================================
 
+Name                {}
+Path                {}
+Duration            6s 0ms 0us
+Integrator          Prophesee
+Plugin name         hal_plugin_gen31_fx3
+Data encoding       EVT2
+Camera generation   3.1
+Camera serial       00001621
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  14067262            16                  5999996             2.3 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info)
+
+
+def pytestcase_test_metavision_hal_raw_cutter_on_gen31_recording_from_0s_to_6s_decoding_all_events(dataset_dir):
+    """
+    Checks output of metavision_hal_raw_cutter on dataset gen31_timer.raw, cutting from 0s to 6s, decoding
+    all the events
+    """
+
+    filename = "gen31_timer.raw"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 0
+    end = 6
+
+    expected_output_info = r"""
+====================================================================================================
+
 Name                {}
 Path                {}
 Duration            6s 0ms 187us
@@ -194,7 +234,7 @@ Type of event       Number of events    First timestamp     Last timestamp
 ----------------------------------------------------------------------------------------------------
 CD                  14067447            16                  6000187             2.3 Mev/s
 """
-    cut_and_check_info(filename_full, start, end, expected_output_info)
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
 
 
 def pytestcase_test_metavision_hal_raw_cutter_on_gen31_recording_from_8s_to_11s(dataset_dir):
@@ -211,6 +251,39 @@ def pytestcase_test_metavision_hal_raw_cutter_on_gen31_recording_from_8s_to_11s(
     expected_output_info = r"""
 ====================================================================================================
 
+Name                {}
+Path                {}
+Duration            3s 0ms 0us
+Integrator          Prophesee
+Plugin name         hal_plugin_gen31_fx3
+Data encoding       EVT2
+Camera generation   3.1
+Camera serial       00001621
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  5590599             2                   2999999             1.9 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info)
+
+
+def pytestcase_test_metavision_hal_raw_cutter_on_gen31_recording_from_8s_to_11s_decoding_all_events(dataset_dir):
+    """
+    Checks output of metavision_hal_raw_cutter on dataset gen31_timer.raw, cutting from 8s to 11s, decoding
+    all the events
+    """
+
+    filename = "gen31_timer.raw"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 8
+    end = 11
+
+    expected_output_info = r"""
+====================================================================================================
+
 Name                {}
 Path                {}
 Duration            3s 0ms 210us
@@ -226,7 +299,7 @@ Type of event       Number of events    First timestamp     Last timestamp
 ----------------------------------------------------------------------------------------------------
 CD                  5590919             16                  3000210             1.9 Mev/s
 """
-    cut_and_check_info(filename_full, start, end, expected_output_info)
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
 
 
 def pytestcase_test_metavision_hal_raw_cutter_on_gen4_evt2_recording_full_cut(dataset_dir):
@@ -275,6 +348,39 @@ def pytestcase_test_metavision_hal_raw_cutter_on_gen4_evt2_recording_from_2s_to_
     expected_output_info = r"""
 ====================================================================================================
 
+Name                {}
+Path                {}
+Duration            1s 0ms 0us
+Integrator          Prophesee
+Plugin name         hal_plugin_gen41_evk3
+Data encoding       EVT2
+Camera generation   4.0
+Camera serial       00001495
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  1985546             0                   999999              2.0 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info)
+
+
+def pytestcase_test_metavision_hal_raw_cutter_on_gen4_evt2_recording_from_2s_to_3s_decoding_all_events(dataset_dir):
+    """
+    Checks output of metavision_hal_raw_cutter on dataset gen4_evt2_hand.raw, cutting from 2s to 3s, decoding
+    all the events
+    """
+
+    filename = "gen4_evt2_hand.raw"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 2
+    end = 3
+
+    expected_output_info = r"""
+====================================================================================================
+
 Name                {}
 Path                {}
 Duration            999ms 977us
@@ -290,7 +396,7 @@ Type of event       Number of events    First timestamp     Last timestamp
 ----------------------------------------------------------------------------------------------------
 CD                  1985451             16                  999977              2.0 Mev/s
 """
-    cut_and_check_info(filename_full, start, end, expected_output_info)
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
 
 
 def pytestcase_test_metavision_hal_raw_cutter_on_gen4_evt2_recording_from_4s_to_10s(dataset_dir):
@@ -307,6 +413,39 @@ def pytestcase_test_metavision_hal_raw_cutter_on_gen4_evt2_recording_from_4s_to_
     expected_output_info = r"""
 ====================================================================================================
 
+Name                {}
+Path                {}
+Duration            6s 0ms 0us
+Integrator          Prophesee
+Plugin name         hal_plugin_gen41_evk3
+Data encoding       EVT2
+Camera generation   4.0
+Camera serial       00001495
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  9468511             0                   5999998             1.6 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info)
+
+
+def pytestcase_test_metavision_hal_raw_cutter_on_gen4_evt2_recording_from_4s_to_10s_decoding_all_events(dataset_dir):
+    """
+    Checks output of metavision_hal_raw_cutter on dataset gen4_evt2_hand.raw, cutting from 4s to 10s, decoding
+    all the events
+    """
+
+    filename = "gen4_evt2_hand.raw"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 4
+    end = 10
+
+    expected_output_info = r"""
+====================================================================================================
+
 Name                {}
 Path                {}
 Duration            6s 0ms 53us
@@ -322,7 +461,7 @@ Type of event       Number of events    First timestamp     Last timestamp
 ----------------------------------------------------------------------------------------------------
 CD                  9468423             0                   6000053             1.6 Mev/s
 """
-    cut_and_check_info(filename_full, start, end, expected_output_info)
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
 
 
 def pytestcase_test_metavision_hal_raw_cutter_on_gen4_evt3_recording_full_cut(dataset_dir):
@@ -371,6 +510,39 @@ def pytestcase_test_metavision_hal_raw_cutter_on_gen4_evt3_recording_from_3s_to_
     expected_output_info = r"""
 ====================================================================================================
 
+Name                {}
+Path                {}
+Duration            4s 5ms 822us
+Integrator          Prophesee
+Plugin name         hal_plugin_gen41_evk3
+Data encoding       EVT3
+Camera generation   4.0
+Camera serial       00001495
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  4884485             5824                4005822             1.2 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info)
+
+
+def pytestcase_test_metavision_hal_raw_cutter_on_gen4_evt3_recording_from_3s_to_7s_decoding_all_events(dataset_dir):
+    """
+    Checks output of metavision_hal_raw_cutter on dataset gen4_evt3_hand.raw, cutting from 3s to 7s, decoding
+    all the events
+    """
+
+    filename = "gen4_evt3_hand.raw"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 3
+    end = 7
+
+    expected_output_info = r"""
+====================================================================================================
+
 Name                {}
 Path                {}
 Duration            4s 6ms 217us
@@ -386,7 +558,7 @@ Type of event       Number of events    First timestamp     Last timestamp
 ----------------------------------------------------------------------------------------------------
 CD                  4884793             5841                4006217             1.2 Mev/s
 """
-    cut_and_check_info(filename_full, start, end, expected_output_info)
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
 
 
 def pytestcase_test_metavision_hal_raw_cutter_on_gen4_evt3_recording_from_8s_to_9s(dataset_dir):
@@ -403,6 +575,39 @@ def pytestcase_test_metavision_hal_raw_cutter_on_gen4_evt3_recording_from_8s_to_
     expected_output_info = r"""
 ====================================================================================================
 
+Name                {}
+Path                {}
+Duration            1s 4ms 607us
+Integrator          Prophesee
+Plugin name         hal_plugin_gen41_evk3
+Data encoding       EVT3
+Camera generation   4.0
+Camera serial       00001495
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  1319961             4608                1004607             1.3 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info)
+
+
+def pytestcase_test_metavision_hal_raw_cutter_on_gen4_evt3_recording_from_8s_to_9s_decoding_all_events(dataset_dir):
+    """
+    Checks output of metavision_hal_raw_cutter on dataset gen4_evt3_hand.raw, cutting from 8s to 9s, decoding
+    all the events
+    """
+
+    filename = "gen4_evt3_hand.raw"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 8
+    end = 9
+
+    expected_output_info = r"""
+====================================================================================================
+
 Name                {}
 Path                {}
 Duration            1s 4ms 655us
@@ -418,7 +623,7 @@ Type of event       Number of events    First timestamp     Last timestamp
 ----------------------------------------------------------------------------------------------------
 CD                  1319855             4753                1004655             1.3 Mev/s
 """
-    cut_and_check_info(filename_full, start, end, expected_output_info)
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
 
 
 def pytestcase_test_metavision_hal_raw_cutter_on_gen4_evt3_recording_from_4s_to_15s(dataset_dir):
@@ -435,6 +640,39 @@ def pytestcase_test_metavision_hal_raw_cutter_on_gen4_evt3_recording_from_4s_to_
     expected_output_info = r"""
 ====================================================================================================
 
+Name                {}
+Path                {}
+Duration            11s 6ms 397us
+Integrator          Prophesee
+Plugin name         hal_plugin_gen41_evk3
+Data encoding       EVT3
+Camera generation   4.0
+Camera serial       00001495
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  12759018            6400                11006397            1.2 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info)
+
+
+def pytestcase_test_metavision_hal_raw_cutter_on_gen4_evt3_recording_from_4s_to_15s_decoding_all_events(dataset_dir):
+    """
+    Checks output of metavision_hal_raw_cutter on dataset gen4_evt3_hand.raw, cutting from 4s to 15s, decoding
+    all the events
+    """
+
+    filename = "gen4_evt3_hand.raw"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 4
+    end = 15
+
+    expected_output_info = r"""
+====================================================================================================
+
 Name                {}
 Path                {}
 Duration            11s 6ms 525us
@@ -450,4 +688,27 @@ Type of event       Number of events    First timestamp     Last timestamp
 ----------------------------------------------------------------------------------------------------
 CD                  12759106            6464                11006525            1.2 Mev/s
 """
-    cut_and_check_info(filename_full, start, end, expected_output_info)
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
+
+
+def pytestcase_test_metavision_hal_raw_cutter_start_after_the_end_of_the_file(dataset_dir):
+    """
+    Checks that metavision_hal_raw_cutter does not write any file when the cut starts after the end of the input file
+    """
+
+    input_raw_file = os.path.join(dataset_dir, "openeb", "gen4_evt3_hand.raw")
+    assert os.path.exists(input_raw_file)
+
+    # Create temporary directory for output RAW file
+    tmp_dir = os_tools.TemporaryDirectoryHandler()
+    output_raw_file = os.path.join(tmp_dir.temporary_directory(), "data_out.raw")
+
+    # This recording is ~15s, so 20 is after its end
+    cmd = "./metavision_hal_raw_cutter -i {} --start {} --end {} -o {}".format(input_raw_file, 20, 25, output_raw_file)
+    output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
+
+    # Check app exited without error
+    assert error_code == 0, "******\nError while executing cmd '{}':{}\n******".format(cmd, output)
+
+    assert "No file saved because the start time provided is after the end of the input file" in output
+    assert not os.path.exists(output_raw_file)
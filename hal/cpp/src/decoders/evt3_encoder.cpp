@@ -0,0 +1,187 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+#include "metavision/hal/decoders/evt3/evt3_encoder.h"
+
+namespace Metavision {
+
+Evt3Encoder::Evt3Encoder(int width) : width_(width) {}
+
+void Evt3Encoder::reset_state() {
+    pending_cd_events_.clear();
+    words_.clear();
+    ts_last_ev_             = std::numeric_limits<timestamp>::min();
+    first_timehigh_written_ = false;
+    last_timehigh_          = 0;
+    last_timelow_           = -1;
+    last_y_                 = -1;
+    vect_base_x_            = -1;
+    vect_base_p_            = -1;
+}
+
+void Evt3Encoder::encode_event_cd(std::ofstream &ofs, const EventCD &ev) {
+    check_event_order(ev.t);
+    if (!pending_cd_events_.empty() && pending_cd_events_.front().t != ev.t) {
+        encode_pending_cd_events();
+        write_words(ofs);
+    }
+    pending_cd_events_.push_back(ev);
+    ts_last_ev_ = ev.t;
+}
+
+void Evt3Encoder::encode_event_trigger(std::ofstream &ofs, const EventExtTrigger &ev) {
+    check_event_order(ev.t);
+    encode_pending_cd_events();
+    write_time(ev.t);
+
+    Evt3Raw::Event_ExtTrigger raw_evt{0};
+    raw_evt.pol  = ev.p;
+    raw_evt.id   = ev.id;
+    raw_evt.type = static_cast<std::uint16_t>(Evt3EventTypes_4bits::EXT_TRIGGER);
+    words_.push_back(*reinterpret_cast<const std::uint16_t *>(&raw_evt));
+    write_words(ofs);
+    ts_last_ev_ = ev.t;
+}
+
+void Evt3Encoder::flush(std::ofstream &ofs) {
+    encode_pending_cd_events();
+    write_words(ofs);
+}
+
+void Evt3Encoder::check_event_order(timestamp ts) const {
+    if (ts < ts_last_ev_) {
+        throw std::runtime_error("Input events must be encoded in increasing temporal order!");
+    }
+}
+
+void Evt3Encoder::encode_pending_cd_events() {
+    if (pending_cd_events_.empty()) {
+        return;
+    }
+    write_time(pending_cd_events_.front().t);
+
+    // Events of the same timestamp are encoded row by row, and by polarity then increasing x in a row, so that runs
+    // of events can be encoded as vectors
+    std::sort(pending_cd_events_.begin(), pending_cd_events_.end(), [](const EventCD &ev1, const EventCD &ev2) {
+        return std::tie(ev1.y, ev1.p, ev1.x) < std::tie(ev2.y, ev2.p, ev2.x);
+    });
+    const EventCD *row_begin      = pending_cd_events_.data();
+    const EventCD *const data_end = row_begin + pending_cd_events_.size();
+    while (row_begin != data_end) {
+        const EventCD *row_end = row_begin;
+        while (row_end != data_end && row_end->y == row_begin->y && row_end->p == row_begin->p) {
+            ++row_end;
+        }
+        encode_row_events(row_begin, row_end);
+        row_begin = row_end;
+    }
+    pending_cd_events_.clear();
+}
+
+void Evt3Encoder::encode_row_events(const EventCD *begin, const EventCD *end) {
+    if (begin->y != last_y_) {
+        write_word(Evt3EventTypes_4bits::EVT_ADDR_Y, begin->y);
+        last_y_ = begin->y;
+    }
+
+    const int p = begin->p ? 1 : 0;
+    for (auto it = begin; it != end;) {
+        // A vector covers the 32 pixels from its base, which must fit in the sensor width
+        const int base_x = std::min<int>(it->x, width_ - kVectorSize);
+        std::uint32_t valid = 0;
+        int num_valid       = 0;
+        auto it_vect_end    = it;
+        if (base_x >= 0) {
+            for (; it_vect_end != end && it_vect_end->x < base_x + kVectorSize; ++it_vect_end) {
+                const std::uint32_t bit = std::uint32_t(1) << (it_vect_end->x - base_x);
+                num_valid += (valid & bit) ? 0 : 1;
+                valid |= bit;
+            }
+        }
+
+        // The vector replaces one EVT_ADDR_X word per event by three words, plus one if the base must be written
+        const bool has_base   = vect_base_x_ == base_x && vect_base_p_ == p;
+        const int vector_cost = has_base ? 3 : 4;
+        if (num_valid <= vector_cost) {
+            write_word(Evt3EventTypes_4bits::EVT_ADDR_X, static_cast<std::uint16_t>(it->x | (p << 11)));
+            ++it;
+            continue;
+        }
+
+        if (!has_base) {
+            write_word(Evt3EventTypes_4bits::VECT_BASE_X, static_cast<std::uint16_t>(base_x | (p << 11)));
+        }
+        write_word(Evt3EventTypes_4bits::VECT_12, static_cast<std::uint16_t>(valid & 0xFFF));
+        write_word(Evt3EventTypes_4bits::VECT_12, static_cast<std::uint16_t>((valid >> 12) & 0xFFF));
+        write_word(Evt3EventTypes_4bits::VECT_8, static_cast<std::uint16_t>((valid >> 24) & 0xFF));
+        // The decoder moves the base to the next 32 pixels after each vector
+        vect_base_x_ = base_x + kVectorSize;
+        vect_base_p_ = p;
+
+        // Duplicated events at a pixel can't be encoded in the vector, they are written one by one
+        for (auto it_dup = std::next(it); it_dup != it_vect_end; ++it_dup) {
+            if (it_dup->x == std::prev(it_dup)->x) {
+                write_word(Evt3EventTypes_4bits::EVT_ADDR_X, static_cast<std::uint16_t>(it_dup->x | (p << 11)));
+            }
+        }
+        it = it_vect_end;
+    }
+}
+
+void Evt3Encoder::write_time(timestamp ts) {
+    const timestamp timehigh = ts >> 12;
+    const int timelow        = static_cast<int>(ts & 0xFFF);
+    if (!first_timehigh_written_ || timehigh != last_timehigh_) {
+        if (!first_timehigh_written_) {
+            first_timehigh_written_ = true;
+            last_timehigh_          = timehigh;
+            write_word(Evt3EventTypes_4bits::EVT_TIME_HIGH, static_cast<std::uint16_t>(last_timehigh_ & 0xFFF));
+        }
+        // Across a time gap, only the last time high of each time loop and the first one of the next loop are
+        // written, so that the decoder detects each loop as a regular time high overflow
+        while (last_timehigh_ < timehigh) {
+            const timestamp loop_last_timehigh = last_timehigh_ | 0xFFF;
+            if (timehigh <= loop_last_timehigh) {
+                last_timehigh_ = timehigh;
+            } else if (last_timehigh_ < loop_last_timehigh) {
+                last_timehigh_ = loop_last_timehigh;
+            } else {
+                last_timehigh_ = loop_last_timehigh + 1;
+            }
+            write_word(Evt3EventTypes_4bits::EVT_TIME_HIGH, static_cast<std::uint16_t>(last_timehigh_ & 0xFFF));
+        }
+        // The decoder resets the time low when the time high changes
+        last_timelow_ = -1;
+    }
+    if (timelow != last_timelow_) {
+        write_word(Evt3EventTypes_4bits::EVT_TIME_LOW, static_cast<std::uint16_t>(timelow));
+        last_timelow_ = timelow;
+    }
+}
+
+void Evt3Encoder::write_word(Evt3EventTypes_4bits type, std::uint16_t content) {
+    Evt3Raw::RawEvent raw_evt;
+    raw_evt.content = content;
+    raw_evt.type    = static_cast<std::uint16_t>(type);
+    words_.push_back(*reinterpret_cast<const std::uint16_t *>(&raw_evt));
+}
+
+void Evt3Encoder::write_words(std::ofstream &ofs) {
+    if (!words_.empty()) {
+        ofs.write(reinterpret_cast<const char *>(words_.data()), words_.size() * sizeof(std::uint16_t));
+        words_.clear();
+    }
+}
+
+} // namespace Metavision
@@ -60,7 +60,24 @@ static bool plugins_loaded                 = false;
 static char *last_plugin_path              = nullptr;
 static const char *last_plugin_search_mode = nullptr;
 
-Metavision::PluginLoader::PluginList get_plugins() {
+// Returns the path of the plugins manifest, which can be overridden (or disabled, when set to an empty string) with
+// the MV_HAL_PLUGIN_MANIFEST environment variable
+std::filesystem::path get_plugin_manifest_path() {
+    const char *manifest_path = getenv("MV_HAL_PLUGIN_MANIFEST");
+    if (manifest_path) {
+        return manifest_path;
+    }
+#ifndef __ANDROID__
+    try {
+        return Metavision::ResourcesFolder::get_user_path() / "plugins_manifest.txt";
+    } catch (const std::exception &e) {
+        MV_HAL_LOG_TRACE() << "  Plugins manifest disabled, could not get user path:" << e.what();
+    }
+#endif
+    return {};
+}
+
+Metavision::PluginLoader::PluginList get_plugins(const Metavision::PluginLoader::PluginFilter &filter = {}) {
     MV_HAL_LOG_TRACE() << "Loading plugins";
 
     char *plugin_path              = getenv("MV_HAL_PLUGIN_PATH");
@@ -80,11 +97,12 @@ Metavision::PluginLoader::PluginList get_plugins() {
         (last_plugin_search_mode && strcmp(plugin_search_mode, last_plugin_search_mode) == 0)) {
         MV_HAL_LOG_TRACE()
             << "  MV_HAL_PLUGIN_PATH did not change and plugins are already loaded, no need to reload plugins";
-        return plugin_loader.get_plugin_list();
+        return filter ? plugin_loader.get_plugin_list(filter) : plugin_loader.get_plugin_list();
     }
     last_plugin_path        = plugin_path;
     last_plugin_search_mode = plugin_search_mode;
 
+    plugin_loader.set_manifest_path(get_plugin_manifest_path());
     plugin_loader.clear_folders();
     MV_HAL_LOG_TRACE() << "  Setting up search paths";
     if (plugin_path && strcmp(plugin_search_mode, "SYSTEM_PATHS_ONLY") != 0) {
@@ -129,21 +147,21 @@ Metavision::PluginLoader::PluginList get_plugins() {
     MV_HAL_LOG_TRACE() << "  Loading plugins...";
     bool has_camera_discovery = false;
     bool has_file_discovery   = false;
-    auto plugin_list          = plugin_loader.get_plugin_list();
-    for (auto &plugin : plugin_list) {
-        if (plugin.get_camera_discovery_list().size() != 0) {
+    auto plugin_descriptions  = plugin_loader.get_plugin_descriptions();
+    for (auto &description : plugin_descriptions) {
+        if (description.camera_discovery_count != 0) {
             has_camera_discovery = true;
         }
-        if (plugin.get_file_discovery_list().size() != 0) {
+        if (description.file_discovery_count != 0) {
             has_file_discovery = true;
         }
-        MV_HAL_LOG_TRACE() << Metavision::Log::no_space << "    [" << plugin.get_plugin_name() << "] ("
-                           << plugin.get_integrator_name() << ") " << plugin.get_camera_discovery_list().size()
-                           << " camera discoveries " << plugin.get_file_discovery_list().size() << " file discoveries";
+        MV_HAL_LOG_TRACE() << Metavision::Log::no_space << "    [" << description.name << "] ("
+                           << description.integrator_name << ") " << description.camera_discovery_count
+                           << " camera discoveries " << description.file_discovery_count << " file discoveries";
     }
 
     if (!has_camera_discovery || !has_file_discovery) {
-        if (plugin_list.empty()) {
+        if (plugin_descriptions.empty()) {
             MV_HAL_LOG_WARNING() << "    no plugin found";
         } else if (!has_camera_discovery && !has_file_discovery) {
             MV_HAL_LOG_WARNING() << "    no plugin provides either camera or file discovery functionality";
@@ -153,11 +171,15 @@ Metavision::PluginLoader::PluginList get_plugins() {
             MV_HAL_LOG_TRACE() << "    no plugin provides file discovery functionality";
         }
     } else {
-        MV_HAL_LOG_TRACE() << "  Found" << plugin_list.size() << "plugins";
+        MV_HAL_LOG_TRACE() << "  Found" << plugin_descriptions.size() << "plugins";
     }
     plugins_loaded = true;
 
-    return plugin_loader.get_plugin_list();
+    return filter ? plugin_loader.get_plugin_list(filter) : plugin_loader.get_plugin_list();
+}
+
+bool has_camera_discovery(const Metavision::PluginLoader::PluginDescription &description) {
+    return description.camera_discovery_count != 0;
 }
 
 std::string get_full_serial(const std::string &integrator, const std::string &plugin, const std::string &serial) {
@@ -215,11 +237,9 @@ DeviceDiscovery::SerialList list_serial_camera(CameraType flag = ANY) {
 
     MV_HAL_LOG_TRACE() << "Listing cameras of" << CameraTypeLabels[flag - 1] << "type";
 
-    for (auto &plugin : get_plugins()) {
+    for (auto &plugin : get_plugins(has_camera_discovery)) {
         MV_HAL_LOG_TRACE() << Log::no_space << "  Plugin [" << plugin.get_plugin_name() << "] ("
                            << plugin.get_integrator_name() << ")";
-        if (plugin.get_camera_discovery_list().empty() && plugin.get_file_discovery_list().empty())
-            continue;
         for (auto &camera_discovery : plugin.get_camera_discovery_list()) {
             if (camera_discovery.is_for_local_camera()) {
                 // Check local camera
@@ -252,7 +272,7 @@ DeviceDiscovery::SystemList list_systems_camera(CameraType flag = ANY) {
 
     MV_HAL_LOG_TRACE() << "Listing cameras of" << CameraTypeLabels[flag - 1] << "type";
 
-    for (auto &plugin : get_plugins()) {
+    for (auto &plugin : get_plugins(has_camera_discovery)) {
         MV_HAL_LOG_TRACE() << Log::no_space << "  Plugin [" << plugin.get_plugin_name() << "] ("
                            << plugin.get_integrator_name() << ")";
         bool has_serial = false;
@@ -335,22 +355,20 @@ std::unique_ptr<Device> DeviceDiscovery::open(const std::string &input_serial, c
     MV_HAL_LOG_TRACE() << "Opening camera with serial:" << input_serial;
 
     std::unique_ptr<Device> device;
-    std::string integrator_name;
-    std::string plugin_name;
 
-    // split name plugin_name:integrator:serial
+    // split name integrator:plugin_name:serial, without splitting URIs such as "tcp://<host>:<port>"
     size_t pos             = 0;
     std::string tmp_serial = input_serial;
     std::string delimiter  = ":";
     std::vector<std::string> fields;
-    while ((pos = tmp_serial.find(delimiter)) != std::string::npos) {
+    while (fields.size() < 2 && (pos = tmp_serial.find(delimiter)) != std::string::npos &&
+           tmp_serial.compare(pos, 3, "://") != 0) {
         auto field = tmp_serial.substr(0, pos);
         fields.push_back(field);
         tmp_serial.erase(0, pos + delimiter.length());
     }
     std::string serial = tmp_serial;
 
-    assert(fields.size() <= 2);
     std::string input_integrator_name;
     std::string input_plugin_name;
     std::string input_common_name;
@@ -362,26 +380,40 @@ std::unique_ptr<Device> DeviceDiscovery::open(const std::string &input_serial, c
         input_plugin_name     = fields[1];
     }
 
-    for (auto &plugin : get_plugins()) {
-        if (device) {
-            break;
-        }
-
-        plugin_name     = plugin.get_plugin_name();
-        integrator_name = plugin.get_integrator_name();
-        if ((!input_integrator_name.empty() && input_integrator_name != integrator_name) ||
-            (!input_plugin_name.empty() && input_plugin_name != plugin_name)) {
-            MV_HAL_LOG_TRACE() << Log::no_space << "  Plugin [" << plugin_name << "] (" << integrator_name
-                               << ") does not match the serial";
-            continue;
+    // Only the plugins matching the serial are loaded
+    auto matches_serial = [&](const PluginLoader::PluginDescription &description) {
+        bool matches = description.camera_discovery_count != 0;
+        if ((!input_integrator_name.empty() && input_integrator_name != description.integrator_name) ||
+            (!input_plugin_name.empty() && input_plugin_name != description.name)) {
+            matches = false;
         }
         if (!input_common_name.empty()) {
-            if (input_common_name != integrator_name && input_common_name != plugin_name) {
-                MV_HAL_LOG_TRACE() << Log::no_space << "  Plugin [" << plugin_name << "] (" << integrator_name
-                                   << ") does not match the serial";
-                continue;
+            if (input_common_name != description.integrator_name && input_common_name != description.name) {
+                matches = false;
             }
         }
+        if (!matches) {
+            MV_HAL_LOG_TRACE() << Log::no_space << "  Plugin [" << description.name << "] ("
+                               << description.integrator_name << ") does not match the serial";
+        }
+        return matches;
+    };
+
+    auto plugins = get_plugins(matches_serial);
+    if (plugins.empty() && !fields.empty()) {
+        // The prefix names no plugin nor integrator, so it is part of the serial (e.g. "synthetic:<options>")
+        MV_HAL_LOG_TRACE() << "  No plugin matches the prefix of the serial, trying the full serial";
+        input_common_name.clear();
+        input_integrator_name.clear();
+        input_plugin_name.clear();
+        serial  = input_serial;
+        plugins = get_plugins(matches_serial);
+    }
+
+    for (auto &plugin : plugins) {
+        if (device) {
+            break;
+        }
 
         MV_HAL_LOG_TRACE() << Log::no_space << "  Plugin [" << plugin.get_plugin_name() << "] ("
                            << plugin.get_integrator_name() << ") matches the serial";
@@ -490,43 +522,56 @@ std::unique_ptr<Device> DeviceDiscovery::open_stream(std::unique_ptr<std::istrea
                        << (input_plugin_integrator_name.empty() ? "Unknown" : input_plugin_integrator_name) << ")] ("
                        << (input_camera_integrator_name.empty() ? "Unknown" : input_camera_integrator_name) << ")";
 
-    auto list_plugins = get_plugins();
-
     // The lookup is done in several rounds, with different acceptance rules, to first try to get the best matching
     // plugin, until it checks indiscriminately any FileDiscovery that it may handle a recording created by a
-    // different plugin
-    using Check    = std::function<bool(const RawFileHeader &, const Plugin &, const FileDiscovery &)>;
+    // different plugin. The rules only depend on the plugin description, so that plugins not matching a round are not
+    // loaded.
+    using Check    = std::function<bool(const RawFileHeader &, const PluginLoader::PluginDescription &)>;
     using Strategy = std::pair<std::string, Check>;
     std::vector<Strategy> strategies;
 
-    strategies.push_back({"created the recording",
-                          [](const RawFileHeader &header, const Plugin &plugin, const FileDiscovery &discovery) {
-                              if (header.get_plugin_integrator_name() != plugin.get_integrator_name()) {
-                                  return false;
-                              }
-                              if (header.get_plugin_name() != plugin.get_plugin_name()) {
-                                  return false;
-                              }
-                              return true;
-                          }});
-
-    strategies.push_back({"same plugin integrator",
-                          [](const RawFileHeader &header, const Plugin &plugin, const FileDiscovery &discovery) {
-                              if (header.get_plugin_integrator_name() != plugin.get_integrator_name()) {
-                                  return false;
-                              }
-                              return true;
-                          }});
-
-    strategies.push_back({"any plugin", [](const RawFileHeader &header, const Plugin &plugin,
-                                           const FileDiscovery &discovery) { return true; }});
+    strategies.push_back(
+        {"created the recording", [](const RawFileHeader &header, const PluginLoader::PluginDescription &description) {
+             if (header.get_plugin_integrator_name() != description.integrator_name) {
+                 return false;
+             }
+             if (header.get_plugin_name() != description.name) {
+                 return false;
+             }
+             return true;
+         }});
+
+    strategies.push_back(
+        {"same plugin integrator", [](const RawFileHeader &header, const PluginLoader::PluginDescription &description) {
+             if (header.get_plugin_integrator_name() != description.integrator_name) {
+                 return false;
+             }
+             return true;
+         }});
+
+    strategies.push_back(
+        {"any plugin", [](const RawFileHeader &header, const PluginLoader::PluginDescription &description) {
+             return true;
+         }});
 
     for (auto &strategy : strategies) {
         if (device) {
             break;
         }
 
-        for (auto &plugin : list_plugins) {
+        auto matches_strategy = [&](const PluginLoader::PluginDescription &description) {
+            if (description.file_discovery_count == 0) {
+                return false;
+            }
+            if (!strategy.second(header, description)) {
+                MV_HAL_LOG_DEBUG() << "  Plugin" << description.name << "-" << description.integrator_name;
+                MV_HAL_LOG_DEBUG() << "      -> Does not match:" << strategy.first;
+                return false;
+            }
+            return true;
+        };
+
+        for (auto &plugin : get_plugins(matches_strategy)) {
             if (device) {
                 break;
             }
@@ -538,12 +583,6 @@ std::unique_ptr<Device> DeviceDiscovery::open_stream(std::unique_ptr<std::istrea
                 if (device) {
                     break;
                 }
-                if (!strategy.second(header, plugin, file_discovery)) {
-                    MV_HAL_LOG_DEBUG() << "  Plugin" << plugin_name << "-" << integrator_name;
-                    MV_HAL_LOG_DEBUG() << "    File discovery" << file_discovery.get_name();
-                    MV_HAL_LOG_DEBUG() << "      -> Does not match:" << strategy.first;
-                    continue;
-                }
                 MV_HAL_LOG_TRACE() << Log::no_space << "  Plugin [" << plugin_name << "] (" << integrator_name << ")";
                 MV_HAL_LOG_TRACE() << "    File discovery" << file_discovery.get_name();
                 MV_HAL_LOG_TRACE() << "      -> Match:" << strategy.first;
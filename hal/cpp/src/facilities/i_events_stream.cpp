@@ -20,11 +20,14 @@
 #include "metavision/hal/facilities/i_hw_identification.h"
 #include "metavision/hal/facilities/i_hal_software_info.h"
 #include "metavision/hal/facilities/i_plugin_software_info.h"
+#include "metavision/hal/utils/detail/raw_bookmarks_builder.h"
 #include "metavision/hal/utils/file_raw_data_producer.h"
 #include "metavision/hal/utils/hal_connection_exception.h"
 #include "metavision/hal/utils/hal_error_code.h"
 #include "metavision/hal/utils/hal_exception.h"
 #include "metavision/hal/utils/hal_log.h"
+#include "metavision/hal/utils/raw_index_trailer.h"
+#include "metavision/sdk/base/utils/trace_recorder.h"
 
 namespace Metavision {
 
@@ -102,21 +105,6 @@ bool deserialize_bookmark(I_EventsStream::Bookmark &bookmark, std::ifstream &inp
     return true;
 }
 
-bool add_bookmarks(size_t last_bookmark_index, size_t bookmark_index, I_EventsStream::Bookmark &bookmark,
-                   I_EventsStream::Index &index, std::ofstream &output_index_file) {
-    for (; last_bookmark_index < bookmark_index; ++last_bookmark_index) {
-        index.bookmarks_.push_back(bookmark);
-        if (output_index_file) {
-            if (!serialize_bookmark(bookmark, output_index_file)) {
-                return false;
-            }
-        }
-        // reset event count
-        bookmark.cd_event_count_ = 0;
-    }
-    return true;
-}
-
 bool add_magic_number(std::ofstream &output_index_file) {
     BookmarkOrMagicNumber m = BookmarkOrMagicNumber::magic_number();
     if (output_index_file) {
@@ -167,12 +155,9 @@ bool build_and_try_writing_bookmarks(Device &device, I_EventsStream::Index &inde
                                 "the index from scratch again next time";
     }
 
-    I_EventsStream::Bookmark bookmark;
-
     // Grabs the facilities
     auto file_events_stream = device.get_facility<I_EventsStream>();
     auto decoder            = device.get_facility<I_EventsStreamDecoder>();
-    auto hw_identification  = device.get_facility<I_HW_Identification>();
 
     // Gets a raw events size in bytes to be able to decode event per event
     const long raw_event_size_bytes = decoder->get_raw_event_size_bytes();
@@ -185,20 +170,31 @@ bool build_and_try_writing_bookmarks(Device &device, I_EventsStream::Index &inde
     }
 
     GenericHeader raw_file_header(raw_file);
-    size_t current_byte_offset = raw_file.tellg();
+    const size_t data_start_pos = raw_file.tellg();
     raw_file.close();
 
-    // Gets the decoder default timestamp so that we know when a valid timestamp has been decoded
-    timestamp prev_ts = decoder->get_last_timestamp(), last_ts = -1;
-    bool ts_shift_computed     = false;
-    size_t last_bookmark_index = 0;
-    size_t last_byte_offset    = current_byte_offset;
-    size_t last_event_count    = 0;
+    // Adds the bookmarks to the index and writes them, after the header which needs the timestamp shift
+    bool index_file_header_written = false;
+    auto add_bookmark              = [&](I_EventsStream::Bookmark bookmark) {
+        index.bookmarks_.push_back(bookmark);
+        if (output_index_file) {
+            if (!index_file_header_written) {
+                timestamp ts_shift_us = 0;
+                decoder->get_timestamp_shift(ts_shift_us);
+                index_file_header.set_field(ts_shift_key, std::to_string(ts_shift_us));
+                output_index_file << index_file_header;
+                index_file_header_written = true;
+            }
+            return serialize_bookmark(bookmark, output_index_file);
+        }
+        return true;
+    };
+    detail::RawBookmarksBuilder builder(*decoder, bookmark_period_us, data_start_pos, add_bookmark);
 
     // Sets a cd callback to compute the event counts
     auto cd_decoder = device.get_facility<I_EventDecoder<EventCD>>();
     cd_decoder->add_event_buffer_callback(
-        [&bookmark](auto begin, auto end) { bookmark.cd_event_count_ += std::distance(begin, end); });
+        [&builder](auto begin, auto end) { builder.add_cd_events(std::distance(begin, end)); });
 
     // start the streaming
     file_events_stream->start();
@@ -214,54 +210,17 @@ bool build_and_try_writing_bookmarks(Device &device, I_EventsStream::Index &inde
 
         auto buffer = file_events_stream->get_latest_raw_data();
         // Decode the buffer events per events
-        for (size_t idx = 0; idx < buffer.size();
-             idx += raw_event_size_bytes, current_byte_offset += raw_event_size_bytes) {
-            // Decode single event
-            decoder->decode(buffer.data() + idx, buffer.data() + idx + raw_event_size_bytes);
-
-            // Wait for timestamp shift to be computed before logging any bookmark
-            if (!ts_shift_computed) {
-                timestamp ts_shift_us;
-                if (!decoder->get_timestamp_shift(ts_shift_us)) {
-                    continue;
-                }
-                index.ts_shift_us_ = ts_shift_us;
-                if (output_index_file) {
-                    index_file_header.set_field(ts_shift_key, std::to_string(ts_shift_us));
-                    output_index_file << index_file_header;
-                }
-                ts_shift_computed = true;
-            }
-
-            const auto new_ts = decoder->get_last_timestamp();
-            // Same ts: nothing to do
-            if (prev_ts == new_ts) {
-                continue;
-            }
-            prev_ts = new_ts;
-
-            const size_t bookmark_index = new_ts / bookmark_period_us + 1;
-            if (bookmark_index > last_bookmark_index) {
-                size_t event_count       = bookmark.cd_event_count_;
-                bookmark.cd_event_count_ = last_event_count;
-                bookmark.timestamp_      = last_ts;
-                bookmark.byte_offset_    = last_byte_offset;
-                if (!add_bookmarks(last_bookmark_index, bookmark_index, bookmark, index, output_index_file)) {
-                    MV_HAL_LOG_ERROR() << "Could not write index to the file" << raw_file_path;
-                    return false;
-                }
-                last_byte_offset    = current_byte_offset;
-                last_ts             = new_ts;
-                last_event_count    = event_count;
-                last_bookmark_index = bookmark_index;
+        for (size_t idx = 0; idx < buffer.size(); idx += raw_event_size_bytes) {
+            if (!builder.add_event(buffer.data() + idx)) {
+                MV_HAL_LOG_ERROR() << "Could not write index to the file" << raw_file_path;
+                return false;
             }
         }
     }
+    index.ts_shift_us_ = builder.get_ts_shift();
 
-    bookmark.cd_event_count_ = last_event_count;
-    bookmark.timestamp_      = last_ts;
-    bookmark.byte_offset_    = last_byte_offset;
-    if (!add_bookmarks(last_bookmark_index, last_bookmark_index + 1, bookmark, index, output_index_file)) {
+    // the bookmark of the last timestamp ends the index
+    if (!add_bookmark(builder.get_last_bookmark())) {
         MV_HAL_LOG_ERROR() << "Could not write index to the file" << raw_file_path;
         return false;
     }
@@ -314,6 +273,19 @@ I_EventsStream::Index build_index(Device &device, const std::filesystem::path &r
     }
 
     GenericHeader raw_file_header(raw_file);
+
+    // ------------------------------
+    // Loads the index from the trailer of the RAW file, if it was appended to the file when recording it
+    RawIndexTrailer trailer;
+    if (read_raw_index_trailer(raw_file, trailer)) {
+        index.bookmark_period_ = trailer.bookmark_period_us_;
+        index.ts_shift_us_     = trailer.ts_shift_us_;
+        index.bookmarks_       = std::move(trailer.bookmarks_);
+        index.status_          = I_EventsStream::IndexStatus::Good;
+        MV_HAL_LOG_TRACE() << "Index for input RAW file" << raw_file_path << "loaded from its trailer";
+        return index;
+    }
+
     raw_file.clear();
     raw_file.seekg(0, std::ios::end);
     const auto data_end_pos = std::to_string(raw_file.tellg());
@@ -481,17 +453,36 @@ I_EventsStream::I_EventsStream(std::unique_ptr<DataTransfer::RawDataProducer> da
     if (!hw_identification_) {
         throw(HalException(HalErrorCode::FailedInitialization, "HW identification facility is null."));
     }
-    data_transfer_.add_new_buffer_callback([this](const DataTransfer::BufferPtr &buffer) {
+    data_transfer_.add_new_buffer_callback([this, producer = data_transfer_.get_data_producer().get()](
+                                               const DataTransfer::BufferPtr &buffer) {
+        const auto arrival_time = std::chrono::steady_clock::now();
         std::unique_lock<std::mutex> lock(new_buffer_safety_);
         if (seeking_) {
-            available_buffers_.push(buffer.clone());
+            available_buffers_.push({buffer.clone(), arrival_time});
         } else {
             if (!stop_) {
                 auto buff_ptr = buffer.data();
                 if (data_transfer_buffer_ptrs_.count(buff_ptr) == 0) {
                     data_transfer_buffer_ptrs_.insert(buff_ptr);
                 }
-                available_buffers_.push(buffer);
+                // the producer itself may have lost data before this buffer
+                bool follows_dropped_data = producer && producer->transferred_buffer_follows_dropped_data();
+                if (max_queued_buffers_ > 0 && available_buffers_.size() >= max_queued_buffers_) {
+                    // the consumer falls behind, the oldest buffers are dropped to bound the latency and memory usage
+                    while (available_buffers_.size() >= max_queued_buffers_) {
+                        ++dropped_data_.buffers_;
+                        dropped_data_.bytes_ += available_buffers_.front().buffer.size() * sizeof(RawData);
+                        available_buffers_.pop();
+                    }
+                    if (available_buffers_.empty()) {
+                        follows_dropped_data = true;
+                    } else {
+                        available_buffers_.front().follows_dropped_data = true;
+                    }
+                    MV_TRACE_COUNTER("I_EventsStream dropped buffers", dropped_data_.buffers_);
+                }
+                available_buffers_.push({buffer, arrival_time, follows_dropped_data});
+                MV_TRACE_COUNTER("I_EventsStream queue depth", available_buffers_.size());
                 new_buffer_cond_.notify_all();
             } else {
                 if (!stop_should_release_buffers_) {
@@ -499,7 +490,7 @@ I_EventsStream::I_EventsStream(std::unique_ptr<DataTransfer::RawDataProducer> da
                     // transferred buffers, so we need to copy this buffer in a temporary buffer pool to make sure the
                     // data transfer buffer pool is empty when streaming is resumed
                     auto tmp_buffer = buffer.clone();
-                    available_buffers_.push(tmp_buffer);
+                    available_buffers_.push({tmp_buffer, arrival_time});
                 }
             }
         }
@@ -549,17 +540,17 @@ I_EventsStream::~I_EventsStream() {
 }
 
 void I_EventsStream::release_data_transfer_buffers() {
-    std::queue<DataTransfer::BufferPtr> tmp_queue;
+    std::queue<AvailableBuffer> tmp_queue;
     std::swap(tmp_queue, available_buffers_);
     while (!tmp_queue.empty()) {
-        auto buffer = tmp_queue.front();
-        if (data_transfer_buffer_ptrs_.count(buffer.data())) {
+        auto &available_buffer = tmp_queue.front();
+        if (data_transfer_buffer_ptrs_.count(available_buffer.buffer.data())) {
             // we only copy buffers that are coming from the data transfer pool
             // those are the ones we need to release
-            auto tmp_buffer = buffer.clone();
-            available_buffers_.push(tmp_buffer);
+            auto tmp_buffer = available_buffer.buffer.clone();
+            available_buffers_.push({tmp_buffer, available_buffer.arrival_time, available_buffer.follows_dropped_data});
         } else {
-            available_buffers_.push(buffer);
+            available_buffers_.push(available_buffer);
         }
         tmp_queue.pop();
     }
@@ -650,22 +641,54 @@ DataTransfer::BufferPtr I_EventsStream::get_latest_raw_data() {
 
         // Reset potential reference from last call
         returned_buffer_.reset();
-        res = available_buffers_.front();
+        res                                   = available_buffers_.front().buffer;
+        returned_buffer_arrival_time_         = available_buffers_.front().arrival_time;
+        returned_buffer_follows_dropped_data_ = available_buffers_.front().follows_dropped_data;
         available_buffers_.pop();
+        MV_TRACE_COUNTER("I_EventsStream queue depth", available_buffers_.size());
     }
 
     {
         std::lock_guard<std::mutex> log_lock(log_raw_safety_);
         if (log_raw_data_) {
             log_raw_data_->write(reinterpret_cast<const char *>(res.data()), res.size() * sizeof(RawData));
+            if (log_raw_index_) {
+                log_raw_index_->add_data(res.data(), res.data() + res.size());
+            }
         }
     }
     return res;
 }
 
-I_EventsStream::SeekStatus I_EventsStream::seek(timestamp target_ts_us, timestamp &reached_ts_us) {
-    std::lock_guard<std::mutex> lock(index_safety_);
+std::chrono::steady_clock::time_point I_EventsStream::get_latest_raw_data_arrival_time() const {
+    return returned_buffer_arrival_time_;
+}
+
+bool I_EventsStream::latest_raw_data_follows_dropped_data() const {
+    return returned_buffer_follows_dropped_data_;
+}
+
+void I_EventsStream::set_max_queued_buffers(std::size_t max_queued_buffers) {
+    std::lock_guard<std::mutex> lock(new_buffer_safety_);
+    max_queued_buffers_ = max_queued_buffers;
+}
+
+std::size_t I_EventsStream::get_max_queued_buffers() const {
+    std::lock_guard<std::mutex> lock(new_buffer_safety_);
+    return max_queued_buffers_;
+}
+
+std::size_t I_EventsStream::get_num_queued_buffers() const {
+    std::lock_guard<std::mutex> lock(new_buffer_safety_);
+    return available_buffers_.size();
+}
+
+I_EventsStream::DroppedData I_EventsStream::get_dropped_data() const {
+    std::lock_guard<std::mutex> lock(new_buffer_safety_);
+    return dropped_data_;
+}
 
+I_EventsStream::SeekStatus I_EventsStream::find_bookmark(timestamp target_ts_us, size_t &bookmark_index) const {
     switch (index_.status_) {
     case I_EventsStream::IndexStatus::Bad:
         return SeekStatus::SeekCapabilityNotAvailable;
@@ -676,8 +699,7 @@ I_EventsStream::SeekStatus I_EventsStream::seek(timestamp target_ts_us, timestam
         break;
     }
 
-    auto file_raw_data_producer = std::dynamic_pointer_cast<FileRawDataProducer>(data_transfer_.get_data_producer());
-    if (!file_raw_data_producer || !decoder_) {
+    if (!decoder_) {
         // should never happen, we check that seeking is possible before indexing...
         return SeekStatus::SeekCapabilityNotAvailable;
     }
@@ -686,13 +708,32 @@ I_EventsStream::SeekStatus I_EventsStream::seek(timestamp target_ts_us, timestam
         target_ts_us -= index_.ts_shift_us_;
     }
 
-    size_t bookmark_index = target_ts_us / index_.bookmark_period_;
+    bookmark_index = target_ts_us / index_.bookmark_period_;
     if (target_ts_us < 0 || bookmark_index >= index_.bookmarks_.size()) {
         return SeekStatus::InputTimestampNotReachable;
     }
     // do not seek before first valid timestamp
     while (index_.bookmarks_[bookmark_index].timestamp_ < 0) {
-        bookmark_index++;
+        if (++bookmark_index == index_.bookmarks_.size()) {
+            return SeekStatus::InputTimestampNotReachable;
+        }
+    }
+    return SeekStatus::Success;
+}
+
+I_EventsStream::SeekStatus I_EventsStream::seek(timestamp target_ts_us, timestamp &reached_ts_us) {
+    std::lock_guard<std::mutex> lock(index_safety_);
+
+    size_t bookmark_index;
+    const auto status = find_bookmark(target_ts_us, bookmark_index);
+    if (status != SeekStatus::Success) {
+        return status;
+    }
+
+    auto file_raw_data_producer = std::dynamic_pointer_cast<FileRawDataProducer>(data_transfer_.get_data_producer());
+    if (!file_raw_data_producer) {
+        // should never happen, we check that seeking is possible before indexing...
+        return SeekStatus::SeekCapabilityNotAvailable;
     }
 
     // after this point, we make sure next received buffers are released and stored in the
@@ -754,6 +795,22 @@ I_EventsStream::SeekStatus I_EventsStream::seek(timestamp target_ts_us, timestam
     return seek_status;
 }
 
+I_EventsStream::SeekStatus I_EventsStream::get_bookmark(timestamp target_ts_us, Bookmark &bookmark) const {
+    std::lock_guard<std::mutex> lock(index_safety_);
+
+    size_t bookmark_index;
+    const auto status = find_bookmark(target_ts_us, bookmark_index);
+    if (status != SeekStatus::Success) {
+        return status;
+    }
+
+    bookmark = index_.bookmarks_[bookmark_index];
+    if (!decoder_->is_time_shifting_enabled()) {
+        bookmark.timestamp_ += index_.ts_shift_us_;
+    }
+    return SeekStatus::Success;
+}
+
 I_EventsStream::IndexStatus I_EventsStream::get_seek_range(timestamp &data_start_ts, timestamp &data_end_ts) const {
     std::lock_guard<std::mutex> lock(index_safety_);
     switch (index_.status_) {
@@ -841,6 +898,14 @@ I_EventsStream::Index I_EventsStream::index_impl(Device &device) {
 
 void I_EventsStream::stop_log_raw_data() {
     std::lock_guard<std::mutex> guard(log_raw_safety_);
+    close_log_raw_data();
+}
+
+void I_EventsStream::close_log_raw_data() {
+    if (log_raw_data_ && log_raw_index_ && !log_raw_index_->write(*log_raw_data_)) {
+        MV_HAL_LOG_TRACE() << "No index trailer appended to the logged RAW data";
+    }
+    log_raw_index_.reset();
     log_raw_data_.reset(nullptr);
 }
 
@@ -853,6 +918,7 @@ bool I_EventsStream::log_raw_data(const std::string &f) {
     header.add_date();
 
     std::lock_guard<std::mutex> guard(log_raw_safety_);
+    close_log_raw_data();
     log_raw_data_.reset(new std::ofstream(f, std::ios::binary));
     if (!log_raw_data_->is_open()) {
         log_raw_data_ = nullptr;
@@ -860,6 +926,10 @@ bool I_EventsStream::log_raw_data(const std::string &f) {
     }
 
     (*log_raw_data_) << header;
+    log_raw_index_ = std::make_unique<RawIndexTrailerWriter>(header, log_raw_data_->tellp());
+    if (!log_raw_index_->is_supported()) {
+        log_raw_index_.reset();
+    }
     return true;
 }
 
@@ -11,6 +11,7 @@
 
 #include "metavision/hal/facilities/i_events_stream_decoder.h"
 #include "metavision/hal/utils/hal_exception.h"
+#include "metavision/sdk/base/utils/trace_recorder.h"
 
 namespace Metavision {
 
@@ -57,6 +58,8 @@ bool I_EventsStreamDecoder::is_time_shifting_enabled() const {
 }
 
 void I_EventsStreamDecoder::decode(const RawData *const raw_data_begin, const RawData *const raw_data_end) {
+    MV_TRACE_SCOPE("I_EventsStreamDecoder::decode");
+    MV_TRACE_COUNTER("I_EventsStreamDecoder decoded bytes", std::distance(raw_data_begin, raw_data_end));
     const RawData *cur_raw_data = raw_data_begin;
 
     // We first decode incomplete data from previous decode call
@@ -9,8 +9,13 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <system_error>
 #include <dirent.h>
 #ifdef _WIN32
 #include <windows.h>
@@ -22,6 +27,8 @@
 #include "metavision/hal/plugin/detail/plugin_loader.h"
 #include "metavision/hal/plugin/plugin.h"
 #include "metavision/hal/plugin/plugin_entrypoint.h"
+#include "metavision/hal/utils/camera_discovery.h"
+#include "metavision/hal/utils/file_discovery.h"
 #include "metavision/hal/utils/hal_log.h"
 #include "metavision/sdk/base/utils/string.h"
 
@@ -101,6 +108,13 @@ std::string get_plugin_name(const std::string &filename, const std::string &ext,
 
 using PluginEntry = decltype(&initialize_plugin);
 
+// Version of the plugins manifest format, to be bumped whenever the layout of an entry changes
+constexpr const char *manifest_header = "# Metavision HAL plugins manifest v1";
+
+std::int64_t get_modification_time(const std::filesystem::path &path, std::error_code &ec) {
+    return static_cast<std::int64_t>(std::filesystem::last_write_time(path, ec).time_since_epoch().count());
+}
+
 struct dlcloser {
     void operator()(void *handle) {
         if (handle) {
@@ -134,11 +148,45 @@ struct PluginLoader::PluginInfo {
 
 struct PluginLoader::Library {
     Library(const std::string &entrypoint_name, const std::string &name, const std::filesystem::path &path) :
-        handle(load_library(path)) {
+        entrypoint_name(entrypoint_name), path(path) {
+        description.name = name;
+        load();
+        if (plugin) {
+            description.integrator_name        = plugin->get_integrator_name();
+            description.camera_discovery_count = plugin->get_camera_discovery_list().size();
+            description.file_discovery_count   = plugin->get_file_discovery_list().size();
+        }
+    }
+
+    Library(const std::string &entrypoint_name, const std::filesystem::path &path,
+            const PluginDescription &description) :
+        entrypoint_name(entrypoint_name), path(path), description(description), loaded(false) {}
+
+    Plugin &get_plugin() {
+        // The plugins may be listed from several threads at once, the library must be loaded only once
+        std::call_once(load_flag, [this]() {
+            if (loaded) {
+                return;
+            }
+            load();
+            if (!plugin) {
+                // The manifest said this library was a plugin, but it can not be loaded anymore : we expose an
+                // empty plugin, which will simply not be able to open anything
+                showErrorMsg("Failed to load plugin " + path.string() + " described in the plugins manifest");
+                plugin = PluginLoader::make_plugin(description.name);
+                plugin->set_integrator_name(description.integrator_name);
+            }
+        });
+        return *plugin;
+    }
+
+    void load() {
+        loaded = true;
+        handle.reset(load_library(path));
         if (handle && !entrypoint_name.empty()) {
             auto entrypoint = reinterpret_cast<PluginEntry>(load_entrypoint(handle.get(), entrypoint_name.c_str()));
             if (entrypoint) {
-                plugin = PluginLoader::make_plugin(name);
+                plugin = PluginLoader::make_plugin(description.name);
                 entrypoint(plugin.get());
             }
         }
@@ -207,6 +255,12 @@ struct PluginLoader::Library {
     }
 #endif
 
+    std::string entrypoint_name;
+    std::filesystem::path path;
+    PluginDescription description;
+    std::atomic<bool> loaded{true};
+    std::once_flag load_flag;
+
     // order is important here, we need to delete the plugin before we delete the handle which will
     // close the shared library
     std::unique_ptr<void, dlcloser> handle;
@@ -239,7 +293,17 @@ void PluginLoader::insert_folders(const std::vector<std::filesystem::path> &fold
     }
 }
 
+void PluginLoader::set_manifest_path(const std::filesystem::path &manifest_path) {
+    if (manifest_path != manifest_path_) {
+        manifest_path_  = manifest_path;
+        manifest_read_  = false;
+        manifest_dirty_ = false;
+        manifest_.clear();
+    }
+}
+
 void PluginLoader::load_plugins() {
+    read_manifest();
     for (auto folder : folders_) {
         if (std::filesystem::is_directory(folder)) {
             for (auto const &dir_entry : std::filesystem::directory_iterator(folder)) {
@@ -248,6 +312,7 @@ void PluginLoader::load_plugins() {
             }
         }
     }
+    write_manifest();
 }
 
 void PluginLoader::unload_plugins() {
@@ -256,11 +321,52 @@ void PluginLoader::unload_plugins() {
 }
 
 void PluginLoader::insert_plugin(const std::string &name, const std::filesystem::path &library_path) {
-    if (!name.empty() && !library_path.empty()) {
+    if (name.empty() || library_path.empty()) {
+        return;
+    }
+
+    std::error_code ec;
+    std::string key;
+    std::int64_t mtime  = 0;
+    std::uintmax_t size = 0;
+    if (!manifest_path_.empty()) {
+        key = std::filesystem::absolute(library_path, ec).lexically_normal().string();
+        if (!ec) {
+            mtime = get_modification_time(library_path, ec);
+        }
+        if (!ec) {
+            size = std::filesystem::file_size(library_path, ec);
+        }
+    }
+
+    if (manifest_path_.empty() || ec) {
         auto library = std::make_unique<Library>(get_plugin_entry_point(), name, library_path);
         if (library->plugin) {
             libraries_.push_back(std::move(library));
         }
+        return;
+    }
+
+    auto it = manifest_.find(key);
+    if (it != manifest_.end() && it->second.mtime == mtime && it->second.size == size &&
+        it->second.description.name == name) {
+        if (it->second.is_plugin) {
+            libraries_.push_back(
+                std::make_unique<Library>(get_plugin_entry_point(), library_path, it->second.description));
+        }
+        return;
+    }
+
+    auto library = std::make_unique<Library>(get_plugin_entry_point(), name, library_path);
+    ManifestEntry entry;
+    entry.mtime       = mtime;
+    entry.size        = size;
+    entry.is_plugin   = library->plugin != nullptr;
+    entry.description = library->description;
+    manifest_[key]    = entry;
+    manifest_dirty_   = true;
+    if (library->plugin) {
+        libraries_.push_back(std::move(library));
     }
 }
 
@@ -268,6 +374,66 @@ void PluginLoader::insert_plugin(const PluginInfo &info) {
     insert_plugin(info.name, info.path);
 }
 
+void PluginLoader::read_manifest() {
+    if (manifest_read_ || manifest_path_.empty()) {
+        return;
+    }
+    manifest_read_ = true;
+
+    std::ifstream ifs(manifest_path_);
+    std::string line;
+    if (!ifs || !std::getline(ifs, line) || line != manifest_header) {
+        return;
+    }
+
+    // Each entry is a tab separated line : mtime, size, is_plugin, camera discoveries, file discoveries, plugin name,
+    // integrator name and finally the library path, which is the key of the entry
+    while (std::getline(ifs, line)) {
+        std::istringstream iss(line);
+        ManifestEntry entry;
+        std::string path;
+        iss >> entry.mtime >> entry.size >> entry.is_plugin >> entry.description.camera_discovery_count >>
+            entry.description.file_discovery_count;
+        if (!iss || iss.get() != '\t' || !std::getline(iss, entry.description.name, '\t') ||
+            !std::getline(iss, entry.description.integrator_name, '\t') || !std::getline(iss, path) || path.empty()) {
+            continue;
+        }
+        manifest_[path] = entry;
+    }
+}
+
+void PluginLoader::write_manifest() {
+    if (!manifest_dirty_ || manifest_path_.empty()) {
+        return;
+    }
+    manifest_dirty_ = false;
+
+    // Write to a temporary file first, so that concurrent processes never read a partially written manifest
+    std::error_code ec;
+    std::filesystem::create_directories(manifest_path_.parent_path(), ec);
+    auto tmp_path = manifest_path_;
+    tmp_path += ".tmp" + std::to_string(reinterpret_cast<std::uintptr_t>(this));
+    {
+        std::ofstream ofs(tmp_path, std::ios::out | std::ios::trunc);
+        if (!ofs) {
+            showErrorMsg("Could not write plugins manifest " + manifest_path_.string());
+            return;
+        }
+        ofs << manifest_header << "\n";
+        for (const auto &p : manifest_) {
+            const auto &entry = p.second;
+            ofs << entry.mtime << "\t" << entry.size << "\t" << entry.is_plugin << "\t"
+                << entry.description.camera_discovery_count << "\t" << entry.description.file_discovery_count << "\t"
+                << entry.description.name << "\t" << entry.description.integrator_name << "\t" << p.first << "\n";
+        }
+    }
+    std::filesystem::rename(tmp_path, manifest_path_, ec);
+    if (ec) {
+        showErrorMsg("Could not write plugins manifest " + manifest_path_.string() + ": " + ec.message());
+        std::filesystem::remove(tmp_path, ec);
+    }
+}
+
 std::unique_ptr<Plugin> PluginLoader::make_plugin(const std::string &plugin_name) {
     return std::unique_ptr<Plugin>(new Plugin(plugin_name));
 }
@@ -284,11 +450,11 @@ PluginLoader::PluginList::iterator &PluginLoader::PluginList::iterator::operator
 }
 
 PluginLoader::PluginList::iterator::reference PluginLoader::PluginList::iterator::operator*() const {
-    return *(*it_)->plugin;
+    return (*it_)->get_plugin();
 }
 
 PluginLoader::PluginList::iterator::pointer PluginLoader::PluginList::iterator::operator->() const {
-    return (*it_)->plugin.get();
+    return &(*it_)->get_plugin();
 }
 
 PluginLoader::PluginList::iterator PluginLoader::PluginList::begin() {
@@ -299,7 +465,7 @@ PluginLoader::PluginList::iterator PluginLoader::PluginList::end() {
     return iterator(libraries_.end());
 }
 
-PluginLoader::PluginList::PluginList(container &libraries) : libraries_(libraries) {}
+PluginLoader::PluginList::PluginList(container libraries) : libraries_(std::move(libraries)) {}
 
 bool PluginLoader::PluginList::empty() const {
     return libraries_.empty();
@@ -310,7 +476,34 @@ size_t PluginLoader::PluginList::size() const {
 }
 
 PluginLoader::PluginList PluginLoader::get_plugin_list() {
-    return PluginList(libraries_);
+    return get_plugin_list([](const PluginDescription &) { return true; });
+}
+
+PluginLoader::PluginList PluginLoader::get_plugin_list(const PluginFilter &filter) {
+    PluginList::container libraries;
+    for (auto &library : libraries_) {
+        if (filter(library->description)) {
+            libraries.push_back(library.get());
+        }
+    }
+    return PluginList(std::move(libraries));
+}
+
+bool PluginLoader::is_plugin_loaded(const std::string &plugin_name) const {
+    for (auto &library : libraries_) {
+        if (library->description.name == plugin_name && library->loaded) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<PluginLoader::PluginDescription> PluginLoader::get_plugin_descriptions() const {
+    std::vector<PluginDescription> descriptions;
+    for (auto &library : libraries_) {
+        descriptions.push_back(library->description);
+    }
+    return descriptions;
 }
 
 } // namespace Metavision
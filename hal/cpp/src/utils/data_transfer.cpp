@@ -13,6 +13,7 @@
 #include "metavision/hal/utils/hal_connection_exception.h"
 #include "metavision/hal/utils/hal_exception.h"
 #include "metavision/hal/utils/data_transfer.h"
+#include "metavision/sdk/base/utils/trace_recorder.h"
 
 namespace Metavision {
 
@@ -48,6 +49,9 @@ void DataTransfer::start() {
 
     run_transfers_thread_ = std::thread([this, &thread_is_started]() {
         thread_is_started.set_value();
+        if (TraceRecorder::is_enabled()) {
+            TraceRecorder::instance().set_thread_name("DataTransfer");
+        }
         for (auto cb : status_change_cbs_) {
             cb.second(Status::Started);
         }
@@ -177,6 +181,8 @@ bool DataTransfer::stopped() const {
 }
 
 void DataTransfer::fire_callbacks(const BufferPtr &buffer) const {
+    MV_TRACE_SCOPE("DataTransfer::fire_callbacks");
+    MV_TRACE_COUNTER("DataTransfer buffer size", buffer.size());
     for (auto &cb : new_buffer_cbs_) {
         cb.second(buffer);
     }
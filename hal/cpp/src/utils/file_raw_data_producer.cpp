@@ -9,9 +9,12 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <algorithm>
+
 #include "metavision/hal/utils/data_transfer.h"
 #include "metavision/hal/utils/hal_exception.h"
 #include "metavision/hal/utils/file_raw_data_producer.h"
+#include "metavision/hal/utils/raw_index_trailer.h"
 
 namespace Metavision {
 
@@ -31,8 +34,14 @@ FileRawDataProducer::FileRawDataProducer(std::unique_ptr<std::istream> stream, u
     read_bytes_size_ = config.n_events_to_read_ * raw_event_size_bytes;
     data_start_pos_  = stream_to_read_->tellg();
 
-    stream_to_read_->seekg(0, std::ios::end);
-    data_end_pos_ = stream_to_read_->tellg();
+    // the index trailer appended to recorded RAW files is not part of the data
+    RawIndexTrailer trailer;
+    if (read_raw_index_trailer(*stream_to_read_, trailer, false)) {
+        data_end_pos_ = trailer.data_end_pos_;
+    } else {
+        stream_to_read_->seekg(0, std::ios::end);
+        data_end_pos_ = stream_to_read_->tellg();
+    }
 
     stream_to_read_->clear();
     stream_to_read_->seekg(data_start_pos_);
@@ -72,10 +81,19 @@ void FileRawDataProducer::run_impl(const DataTransfer &data_transfer) {
         {
             std::lock_guard<std::mutex> lock(stream_mutex_);
 
+            // do not read past the end of the data
+            const std::streamoff remaining_bytes = data_end_pos_ - stream_to_read_->tellg();
+            if (remaining_bytes == 0) {
+                break;
+            }
+            const auto bytes_to_read =
+                remaining_bytes < 0 ? read_bytes_size_
+                                    : static_cast<uint32_t>(std::min<std::streamoff>(read_bytes_size_, remaining_bytes));
+
             auto data_read = buffer_pool_.acquire();
-            data_read->resize(read_bytes_size_); // Does not reallocate if enough memory already allocated.
+            data_read->resize(bytes_to_read); // Does not reallocate if enough memory already allocated.
 
-            stream_to_read_->read(reinterpret_cast<char *>(data_read->data()), read_bytes_size_);
+            stream_to_read_->read(reinterpret_cast<char *>(data_read->data()), bytes_to_read);
 
             // get size of what have been read (in bytes)
             auto count = stream_to_read_->gcount();
@@ -0,0 +1,226 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+#ifndef _WIN32
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/hal_log.h"
+#include "metavision/hal/utils/network_raw_data_producer.h"
+#include "metavision/hal/utils/detail/network_raw_stream_protocol.h"
+
+namespace Metavision {
+
+namespace Protocol = detail::RawStreamProtocol;
+
+namespace {
+constexpr const char *kUriScheme = "tcp://";
+} // namespace
+
+bool NetworkRawDataProducer::parse_uri(const std::string &uri, std::string &host, uint16_t &port) {
+    const std::string scheme(kUriScheme);
+    if (uri.compare(0, scheme.size(), scheme) != 0) {
+        return false;
+    }
+    const std::string address = uri.substr(scheme.size());
+    const auto separator      = address.rfind(':');
+    if (separator == std::string::npos || separator == 0 || separator + 1 == address.size()) {
+        return false;
+    }
+    const std::string port_str = address.substr(separator + 1);
+    if (!std::all_of(port_str.begin(), port_str.end(), [](char c) { return c >= '0' && c <= '9'; }) ||
+        port_str.size() > 5 || std::stoul(port_str) > 65535) {
+        return false;
+    }
+    host = address.substr(0, separator);
+    // IPv6 addresses are enclosed in brackets
+    if (host.size() > 2 && host.front() == '[' && host.back() == ']') {
+        host = host.substr(1, host.size() - 2);
+    }
+    port = static_cast<uint16_t>(std::stoul(port_str));
+    return true;
+}
+
+const RawFileHeader &NetworkRawDataProducer::get_header() const {
+    return header_;
+}
+
+NetworkRawDataProducer::Statistics NetworkRawDataProducer::get_statistics() const {
+    std::lock_guard<std::mutex> lock(statistics_mutex_);
+    return statistics_;
+}
+
+bool NetworkRawDataProducer::transferred_buffer_follows_dropped_data() const {
+    return buffer_follows_dropped_data_;
+}
+
+#ifndef _WIN32
+
+namespace {
+// Time given to the server to send the RAW header upon connection
+constexpr std::chrono::seconds kHandshakeTimeout(5);
+// Time between two checks of the transfer's state, when waiting for data
+constexpr int kPollPeriodMs = 100;
+
+int64_t get_system_time_us() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+int connect_to(const std::string &host, uint16_t port) {
+    addrinfo hints{};
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo *addresses = nullptr;
+    const int error     = ::getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses);
+    if (error != 0) {
+        throw HalException(HalErrorCode::CameraNotFound,
+                           "Failed to resolve \"" + host + "\": " + std::string(::gai_strerror(error)));
+    }
+
+    int socket = -1;
+    for (addrinfo *address = addresses; address && socket < 0; address = address->ai_next) {
+        socket = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (socket >= 0 && ::connect(socket, address->ai_addr, address->ai_addrlen) != 0) {
+            ::close(socket);
+            socket = -1;
+        }
+    }
+    ::freeaddrinfo(addresses);
+    if (socket < 0) {
+        throw HalException(HalErrorCode::CameraNotFound,
+                           "Failed to connect to " + host + ":" + std::to_string(port) + ".");
+    }
+#ifdef SO_NOSIGPIPE
+    const int enable = 1;
+    ::setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#endif
+    return socket;
+}
+} // namespace
+
+NetworkRawDataProducer::NetworkRawDataProducer(const std::string &host, uint16_t port) :
+    socket_(connect_to(host, port)),
+    connected_(true),
+    buffer_pool_(DataTransfer::DefaultBufferPool::make_unbounded()) {
+    const auto deadline   = std::chrono::steady_clock::now() + kHandshakeTimeout;
+    const auto timed_out  = [deadline] { return std::chrono::steady_clock::now() > deadline; };
+    uint8_t handshake[Protocol::kHandshakeSize];
+    uint32_t header_size = 0;
+    std::string header;
+    bool valid = Protocol::recv_all(socket_, handshake, sizeof(handshake), timed_out) &&
+                 Protocol::decode_handshake(handshake, header_size);
+    if (valid) {
+        header.resize(header_size);
+        valid = Protocol::recv_all(socket_, &header[0], header_size, timed_out);
+    }
+    if (!valid) {
+        ::close(socket_);
+        throw HalException(HalErrorCode::InternalInitializationError,
+                           "No valid RAW stream received from " + host + ":" + std::to_string(port) + ".");
+    }
+    std::istringstream header_stream(header);
+    header_ = RawFileHeader(header_stream);
+}
+
+NetworkRawDataProducer::~NetworkRawDataProducer() {
+    ::close(socket_);
+}
+
+void NetworkRawDataProducer::run_impl(const DataTransfer &data_transfer) {
+    uint8_t header_buffer[Protocol::FrameHeader::kEncodedSize];
+    while (connected_ && !data_transfer.should_stop()) {
+        // the transfer may only be interrupted between two frames, so that the stream stays consistent if it is
+        // resumed
+        pollfd fd{socket_, POLLIN, 0};
+        const int ready = ::poll(&fd, 1, kPollPeriodMs);
+        if (ready == 0 || (ready < 0 && errno == EINTR)) {
+            continue;
+        }
+
+        Protocol::FrameHeader header;
+        connected_ = ready > 0 && Protocol::recv_all(socket_, header_buffer, sizeof(header_buffer), nullptr);
+        if (connected_ && !header.decode(header_buffer)) {
+            MV_HAL_LOG_ERROR() << "Invalid frame received from the network RAW stream";
+            connected_ = false;
+        }
+        if (!connected_) {
+            break;
+        }
+
+        auto buffer = buffer_pool_.acquire();
+        buffer->resize(header.raw_size);
+        if (header.flags & Protocol::Compressed) {
+            payload_.resize(header.payload_size);
+            connected_ = Protocol::recv_all(socket_, payload_.data(), payload_.size(), nullptr);
+            if (connected_ &&
+                !Protocol::lz_decompress(payload_.data(), payload_.size(), buffer->data(), buffer->size())) {
+                MV_HAL_LOG_ERROR() << "Corrupted frame received from the network RAW stream";
+                connected_ = false;
+            }
+        } else {
+            connected_ = Protocol::recv_all(socket_, buffer->data(), buffer->size(), nullptr);
+        }
+        if (!connected_) {
+            break;
+        }
+
+        const int64_t now_us     = get_system_time_us();
+        const int64_t latency_us = now_us - header.send_time_us;
+        {
+            std::lock_guard<std::mutex> lock(statistics_mutex_);
+            auto &stats = statistics_;
+            if (stats.received_frames == 0) {
+                first_frame_time_us_ = now_us;
+            }
+            ++stats.received_frames;
+            if (header.flags & Protocol::FollowsDroppedData) {
+                ++stats.frames_following_dropped_data;
+            }
+            stats.received_raw_bytes += header.raw_size;
+            stats.received_bytes += Protocol::FrameHeader::kEncodedSize + header.payload_size;
+            stats.last_latency_us = latency_us;
+            stats.max_latency_us  = std::max(stats.max_latency_us, latency_us);
+            stats.mean_latency_us += (latency_us - stats.mean_latency_us) / stats.received_frames;
+            if (now_us > first_frame_time_us_) {
+                stats.throughput = stats.received_raw_bytes * 1e6 / (now_us - first_frame_time_us_);
+            }
+        }
+
+        buffer_follows_dropped_data_ = (header.flags & Protocol::FollowsDroppedData) != 0;
+        data_transfer.fire_callbacks(DataTransfer::make_buffer_ptr(buffer));
+    }
+}
+
+#else
+
+NetworkRawDataProducer::NetworkRawDataProducer(const std::string &, uint16_t) : connected_(false) {
+    throw HalException(HalErrorCode::OperationNotImplemented, "Network RAW streams are not supported on Windows.");
+}
+
+NetworkRawDataProducer::~NetworkRawDataProducer() {}
+
+void NetworkRawDataProducer::run_impl(const DataTransfer &) {}
+
+#endif
+
+} // namespace Metavision
@@ -0,0 +1,272 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#ifndef MSG_NOSIGNAL
+// SIGPIPE is disabled with the SO_NOSIGPIPE socket option instead
+#define MSG_NOSIGNAL 0
+#endif
+#endif
+
+#include "metavision/hal/utils/detail/network_raw_stream_protocol.h"
+
+namespace Metavision {
+namespace detail {
+namespace RawStreamProtocol {
+
+namespace {
+
+constexpr std::size_t kMinMatch  = 4;
+constexpr std::size_t kMaxOffset = 65535;
+constexpr int kHashLog           = 14;
+constexpr uint8_t kMaxNibble     = 15;
+constexpr int kPollPeriodMs      = 100;
+
+template<typename T>
+void write_le(uint8_t *buffer, T value) {
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        buffer[i] = static_cast<uint8_t>(static_cast<uint64_t>(value) >> (8 * i));
+    }
+}
+
+template<typename T>
+T read_le(const uint8_t *buffer) {
+    uint64_t value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<uint64_t>(buffer[i]) << (8 * i);
+    }
+    return static_cast<T>(value);
+}
+
+uint32_t read32(const uint8_t *p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+uint8_t *write_length(uint8_t *out, std::size_t length) {
+    while (length >= 255) {
+        *out++ = 255;
+        length -= 255;
+    }
+    *out++ = static_cast<uint8_t>(length);
+    return out;
+}
+
+bool read_length(const uint8_t *&in, const uint8_t *end, std::size_t &length) {
+    uint8_t byte;
+    do {
+        if (in == end) {
+            return false;
+        }
+        byte = *in++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+// Writes a token, the literals and, if match_length is not 0, the match
+uint8_t *write_sequence(uint8_t *out, const uint8_t *literals, std::size_t num_literals, std::size_t offset,
+                        std::size_t match_length) {
+    const std::size_t match_code = match_length ? match_length - kMinMatch : 0;
+    uint8_t *token               = out++;
+    *token = static_cast<uint8_t>((std::min<std::size_t>(num_literals, kMaxNibble) << 4) |
+                                  std::min<std::size_t>(match_code, kMaxNibble));
+    if (num_literals >= kMaxNibble) {
+        out = write_length(out, num_literals - kMaxNibble);
+    }
+    std::memcpy(out, literals, num_literals);
+    out += num_literals;
+    if (match_length) {
+        write_le<uint16_t>(out, static_cast<uint16_t>(offset));
+        out += 2;
+        if (match_code >= kMaxNibble) {
+            out = write_length(out, match_code - kMaxNibble);
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+void FrameHeader::encode(uint8_t *buffer) const {
+    write_le(buffer, flags);
+    write_le(buffer + 4, payload_size);
+    write_le(buffer + 8, raw_size);
+    write_le(buffer + 12, uint32_t(0));
+    write_le(buffer + 16, sequence);
+    write_le(buffer + 24, send_time_us);
+}
+
+bool FrameHeader::decode(const uint8_t *buffer) {
+    flags        = read_le<uint32_t>(buffer);
+    payload_size = read_le<uint32_t>(buffer + 4);
+    raw_size     = read_le<uint32_t>(buffer + 8);
+    sequence     = read_le<uint64_t>(buffer + 16);
+    send_time_us = read_le<int64_t>(buffer + 24);
+    return payload_size <= kMaxPayloadSize && raw_size <= kMaxPayloadSize &&
+           ((flags & Compressed) || payload_size == raw_size);
+}
+
+void encode_handshake(uint32_t header_size, uint8_t *buffer) {
+    write_le(buffer, kMagic);
+    write_le(buffer + 4, kVersion);
+    write_le(buffer + 8, header_size);
+}
+
+bool decode_handshake(const uint8_t *buffer, uint32_t &header_size) {
+    header_size = read_le<uint32_t>(buffer + 8);
+    return read_le<uint32_t>(buffer) == kMagic && read_le<uint32_t>(buffer + 4) == kVersion &&
+           header_size <= kMaxHeaderSize;
+}
+
+std::size_t lz_compress_bound(std::size_t size) {
+    return size + size / 255 + 16;
+}
+
+std::size_t lz_compress(const uint8_t *src, std::size_t size, uint8_t *dst) {
+    // positions (plus one) of the last occurrences of the 4 bytes sequences, indexed by their hash
+    thread_local std::vector<uint32_t> table;
+    table.assign(std::size_t(1) << kHashLog, 0);
+
+    uint8_t *out       = dst;
+    std::size_t anchor = 0;
+    std::size_t i      = 0;
+    while (i + kMinMatch <= size) {
+        const uint32_t sequence = read32(src + i);
+        const uint32_t hash     = (sequence * 2654435761u) >> (32 - kHashLog);
+        const std::size_t candidate = table[hash];
+        table[hash]                 = static_cast<uint32_t>(i + 1);
+
+        if (candidate == 0 || i - (candidate - 1) > kMaxOffset || read32(src + candidate - 1) != sequence) {
+            ++i;
+            continue;
+        }
+
+        const std::size_t match = candidate - 1;
+        std::size_t length      = kMinMatch;
+        while (i + length < size && src[match + length] == src[i + length]) {
+            ++length;
+        }
+        out    = write_sequence(out, src + anchor, i - anchor, i - match, length);
+        i     += length;
+        anchor = i;
+    }
+    out = write_sequence(out, src + anchor, size - anchor, 0, 0);
+    return out - dst;
+}
+
+bool lz_decompress(const uint8_t *src, std::size_t size, uint8_t *dst, std::size_t dst_size) {
+    const uint8_t *in      = src;
+    const uint8_t *in_end  = src + size;
+    uint8_t *out           = dst;
+    uint8_t *const out_end = dst + dst_size;
+    while (in < in_end) {
+        const uint8_t token      = *in++;
+        std::size_t num_literals = token >> 4;
+        if (num_literals == kMaxNibble && !read_length(in, in_end, num_literals)) {
+            return false;
+        }
+        if (num_literals > static_cast<std::size_t>(in_end - in) ||
+            num_literals > static_cast<std::size_t>(out_end - out)) {
+            return false;
+        }
+        std::memcpy(out, in, num_literals);
+        in += num_literals;
+        out += num_literals;
+        if (in == in_end) {
+            break;
+        }
+
+        if (in_end - in < 2) {
+            return false;
+        }
+        const std::size_t offset = read_le<uint16_t>(in);
+        in += 2;
+        std::size_t length = token & kMaxNibble;
+        if (length == kMaxNibble && !read_length(in, in_end, length)) {
+            return false;
+        }
+        length += kMinMatch;
+        if (offset == 0 || offset > static_cast<std::size_t>(out - dst) ||
+            length > static_cast<std::size_t>(out_end - out)) {
+            return false;
+        }
+        // the match may overlap the output, it is copied byte per byte
+        const uint8_t *match = out - offset;
+        for (std::size_t j = 0; j < length; ++j) {
+            out[j] = match[j];
+        }
+        out += length;
+    }
+    return out == out_end;
+}
+
+#ifndef _WIN32
+
+bool send_all(int socket, const void *data, std::size_t size) {
+    const char *ptr = static_cast<const char *>(data);
+    while (size > 0) {
+        const ssize_t sent = ::send(socket, ptr, size, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent <= 0) {
+            return false;
+        }
+        ptr += sent;
+        size -= sent;
+    }
+    return true;
+}
+
+bool recv_all(int socket, void *data, std::size_t size, const std::function<bool()> &should_stop) {
+    char *ptr = static_cast<char *>(data);
+    while (size > 0) {
+        pollfd fd{socket, POLLIN, 0};
+        const int ready = ::poll(&fd, 1, kPollPeriodMs);
+        if (should_stop && should_stop()) {
+            return false;
+        }
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ready < 0) {
+            return false;
+        }
+        if (ready == 0) {
+            continue;
+        }
+        const ssize_t received = ::recv(socket, ptr, size, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return false;
+        }
+        ptr += received;
+        size -= received;
+    }
+    return true;
+}
+
+#endif
+
+} // namespace RawStreamProtocol
+} // namespace detail
+} // namespace Metavision
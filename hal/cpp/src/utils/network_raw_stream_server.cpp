@@ -0,0 +1,486 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#ifndef MSG_NOSIGNAL
+// SIGPIPE is disabled with the SO_NOSIGPIPE socket option instead
+#define MSG_NOSIGNAL 0
+#endif
+#endif
+
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/hal_log.h"
+#include "metavision/hal/utils/network_raw_stream_server.h"
+#include "metavision/hal/utils/detail/network_raw_stream_protocol.h"
+
+namespace Metavision {
+
+namespace Protocol = detail::RawStreamProtocol;
+
+#ifndef _WIN32
+
+namespace {
+// Time between two checks for new clients, and for disconnections of idle clients
+constexpr int kPollPeriodMs = 100;
+// A client that does not read anything for this long is disconnected
+constexpr int kSendTimeoutS = 5;
+// Maximum number of buffers sent at once without compression
+constexpr std::size_t kMaxBuffersPerFrame = 64;
+
+int64_t get_system_time_us() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+// Sends all the data pointed by the vectors, which are consumed
+bool send_all(int socket, std::vector<iovec> &vectors) {
+    std::size_t first = 0;
+    while (first < vectors.size()) {
+        msghdr message{};
+        message.msg_iov    = vectors.data() + first;
+        message.msg_iovlen = vectors.size() - first;
+        ssize_t sent       = ::sendmsg(socket, &message, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent <= 0) {
+            return false;
+        }
+        while (first < vectors.size() && static_cast<std::size_t>(sent) >= vectors[first].iov_len) {
+            sent -= vectors[first].iov_len;
+            ++first;
+        }
+        if (sent > 0) {
+            vectors[first].iov_base = static_cast<char *>(vectors[first].iov_base) + sent;
+            vectors[first].iov_len -= sent;
+        }
+    }
+    return true;
+}
+} // namespace
+
+class NetworkRawStreamServer::Private {
+public:
+    struct Counters {
+        std::atomic<uint64_t> published_bytes{0};
+        std::atomic<uint64_t> sent_raw_bytes{0};
+        std::atomic<uint64_t> sent_bytes{0};
+        std::atomic<uint64_t> sent_frames{0};
+        std::atomic<uint64_t> dropped_bytes{0};
+        std::atomic<uint64_t> dropped_buffers{0};
+    };
+
+    // Buffer queued for a client, the buffers published in several slices are queued or dropped as a whole
+    struct QueuedSlice {
+        DataTransfer::BufferPtr slice;
+        bool follows_dropped_data;
+    };
+
+    class Client {
+    public:
+        Client(int socket, const Private &server) : socket_(socket), server_(server) {
+            thread_ = std::thread([this] { run(); });
+        }
+
+        ~Client() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                closing_ = true;
+            }
+            cond_.notify_one();
+            thread_.join();
+            ::close(socket_);
+        }
+
+        bool is_connected() const {
+            return connected_;
+        }
+
+        // Queues the slices of a published buffer, or drops them all if they do not fit in the queue, so that the
+        // sent data stays aligned on the buffers boundaries
+        void push(const std::vector<DataTransfer::BufferPtr> &slices, std::size_t size) {
+            bool notify;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!connected_ || queued_bytes_ + size > server_.config_.max_queued_bytes_) {
+                    server_.counters_.dropped_bytes += size;
+                    ++server_.counters_.dropped_buffers;
+                    dropped_data_ = true;
+                    return;
+                }
+                if (queue_.empty()) {
+                    first_queued_time_ = std::chrono::steady_clock::now();
+                }
+                notify = queue_.empty() || (queued_bytes_ < server_.config_.batch_size_ &&
+                                            queued_bytes_ + size >= server_.config_.batch_size_);
+                for (const auto &slice : slices) {
+                    queue_.push_back({slice, dropped_data_});
+                    dropped_data_ = false;
+                }
+                queued_bytes_ += size;
+            }
+            if (notify) {
+                cond_.notify_one();
+            }
+        }
+
+    private:
+        void run() {
+            std::vector<uint8_t> handshake(Protocol::kHandshakeSize);
+            Protocol::encode_handshake(static_cast<uint32_t>(server_.header_.size()), handshake.data());
+            handshake.insert(handshake.end(), server_.header_.begin(), server_.header_.end());
+            bool ok = Protocol::send_all(socket_, handshake.data(), handshake.size());
+
+            std::vector<DataTransfer::BufferPtr> batch;
+            bool follows_dropped_data = false;
+            while (ok && wait_for_batch(batch, follows_dropped_data)) {
+                ok = send_frame(batch, follows_dropped_data);
+                batch.clear();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            connected_ = false;
+            for (const auto &queued : queue_) {
+                server_.counters_.dropped_bytes += queued.slice.size();
+            }
+            queue_.clear();
+        }
+
+        // Waits for a batch to be full, or to have been waiting long enough, and takes it from the queue. A batch only
+        // starts with data following dropped data, so that the receiver knows where the discontinuity is
+        // Returns false when the client should be disconnected
+        bool wait_for_batch(std::vector<DataTransfer::BufferPtr> &batch, bool &follows_dropped_data) {
+            const auto &config = server_.config_;
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (true) {
+                if (queue_.empty()) {
+                    if (closing_) {
+                        return false;
+                    }
+                    if (!cond_.wait_for(lock, std::chrono::milliseconds(kPollPeriodMs),
+                                        [this] { return closing_ || !queue_.empty(); }) &&
+                        is_peer_closed()) {
+                        return false;
+                    }
+                    continue;
+                }
+                if (closing_ || queued_bytes_ >= config.batch_size_) {
+                    break;
+                }
+                const auto deadline = first_queued_time_ + config.max_batch_delay_;
+                if (!cond_.wait_until(lock, deadline,
+                                      [this, &config] { return closing_ || queued_bytes_ >= config.batch_size_; })) {
+                    break;
+                }
+            }
+
+            std::size_t batch_bytes = 0;
+            follows_dropped_data    = queue_.front().follows_dropped_data;
+            while (!queue_.empty() &&
+                   (batch.empty() || (batch_bytes + queue_.front().slice.size() <= config.batch_size_ &&
+                                      batch.size() < kMaxBuffersPerFrame && !queue_.front().follows_dropped_data))) {
+                batch_bytes += queue_.front().slice.size();
+                batch.push_back(std::move(queue_.front().slice));
+                queue_.pop_front();
+            }
+            queued_bytes_ -= batch_bytes;
+            first_queued_time_ = std::chrono::steady_clock::now();
+            return true;
+        }
+
+        // The clients never send anything, the socket is readable only once closed by the peer
+        bool is_peer_closed() const {
+            pollfd fd{socket_, POLLIN, 0};
+            return ::poll(&fd, 1, 0) > 0;
+        }
+
+        bool send_frame(const std::vector<DataTransfer::BufferPtr> &batch, bool follows_dropped_data) {
+            Protocol::FrameHeader header;
+            if (follows_dropped_data) {
+                header.flags |= Protocol::FollowsDroppedData;
+            }
+            for (const auto &buffer : batch) {
+                header.raw_size += static_cast<uint32_t>(buffer.size());
+            }
+            header.payload_size = header.raw_size;
+            header.sequence     = sequence_++;
+
+            std::vector<iovec> vectors;
+            vectors.push_back({header_buffer_, Protocol::FrameHeader::kEncodedSize});
+            if (server_.config_.compression_) {
+                raw_.clear();
+                for (const auto &buffer : batch) {
+                    raw_.insert(raw_.end(), buffer.cbegin(), buffer.cend());
+                }
+                compressed_.resize(Protocol::lz_compress_bound(raw_.size()));
+                const std::size_t compressed_size = Protocol::lz_compress(raw_.data(), raw_.size(), compressed_.data());
+                if (compressed_size < raw_.size()) {
+                    header.flags |= Protocol::Compressed;
+                    header.payload_size = static_cast<uint32_t>(compressed_size);
+                    vectors.push_back({compressed_.data(), compressed_size});
+                } else {
+                    vectors.push_back({raw_.data(), raw_.size()});
+                }
+            } else {
+                for (const auto &buffer : batch) {
+                    vectors.push_back({const_cast<DataTransfer::Data *>(buffer.data()), buffer.size()});
+                }
+            }
+
+            header.send_time_us = get_system_time_us();
+            header.encode(header_buffer_);
+            if (!send_all(socket_, vectors)) {
+                server_.counters_.dropped_bytes += header.raw_size;
+                return false;
+            }
+            server_.counters_.sent_raw_bytes += header.raw_size;
+            server_.counters_.sent_bytes += Protocol::FrameHeader::kEncodedSize + header.payload_size;
+            ++server_.counters_.sent_frames;
+            return true;
+        }
+
+        const int socket_;
+        const Private &server_;
+        std::thread thread_;
+
+        std::mutex mutex_;
+        std::condition_variable cond_;
+        std::deque<QueuedSlice> queue_;
+        std::size_t queued_bytes_ = 0;
+        bool dropped_data_        = false; // true if data was dropped since the last queued buffer
+        std::chrono::steady_clock::time_point first_queued_time_;
+        bool closing_ = false;
+        std::atomic<bool> connected_{true};
+
+        // only used by the client's thread
+        uint64_t sequence_ = 0;
+        uint8_t header_buffer_[Protocol::FrameHeader::kEncodedSize];
+        std::vector<uint8_t> raw_, compressed_;
+    };
+
+    Private(const RawFileHeader &header, const NetworkRawStreamServerConfig &config) :
+        header_(header.to_string()), config_(config) {
+        if (header_.size() > Protocol::kMaxHeaderSize) {
+            throw HalException(HalErrorCode::InvalidArgument, "RAW header too large to be streamed.");
+        }
+        if (config_.batch_size_ == 0 || config_.batch_size_ > Protocol::kMaxPayloadSize) {
+            throw HalException(HalErrorCode::ValueOutOfRange, "Invalid network stream batch size.");
+        }
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port   = htons(config_.port_);
+        if (::inet_pton(AF_INET, config_.address_.c_str(), &address.sin_addr) != 1) {
+            throw HalException(HalErrorCode::InvalidArgument,
+                               "Invalid network stream address: \"" + config_.address_ + "\".");
+        }
+
+        listen_socket_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (listen_socket_ < 0) {
+            throw HalException(HalErrorCode::InternalInitializationError,
+                               std::string("Failed to create socket: ") + std::strerror(errno));
+        }
+        const int enable = 1;
+        ::setsockopt(listen_socket_, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+        if (::bind(listen_socket_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+            ::listen(listen_socket_, SOMAXCONN) != 0) {
+            const std::string error = std::strerror(errno);
+            ::close(listen_socket_);
+            throw HalException(HalErrorCode::OperationNotPermitted, "Failed to listen on " + config_.address_ + ":" +
+                                                                        std::to_string(config_.port_) + ": " + error);
+        }
+        socklen_t address_size = sizeof(address);
+        ::getsockname(listen_socket_, reinterpret_cast<sockaddr *>(&address), &address_size);
+        port_ = ntohs(address.sin_port);
+
+        acceptor_ = std::thread([this] { accept_clients(); });
+    }
+
+    ~Private() {
+        stop_ = true;
+        acceptor_.join();
+        ::close(listen_socket_);
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        clients_.clear();
+    }
+
+    void publish(const DataTransfer::BufferPtr &buffer) {
+        counters_.published_bytes += buffer.size();
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        if (clients_.empty()) {
+            return;
+        }
+        // buffers too large to fit in a frame are split, their slices share the original buffer
+        std::vector<DataTransfer::BufferPtr> slices;
+        const std::size_t max_size = config_.batch_size_;
+        for (std::size_t offset = 0; offset < buffer.size(); offset += max_size) {
+            const std::size_t size = std::min(max_size, buffer.size() - offset);
+            slices.push_back((offset == 0 && size == buffer.size()) ?
+                                 buffer :
+                                 DataTransfer::BufferPtr(buffer, buffer.data() + offset, size));
+        }
+        for (const auto &client : clients_) {
+            client->push(slices, buffer.size());
+        }
+    }
+
+    bool has_clients() const {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        return !clients_.empty();
+    }
+
+    std::size_t get_num_clients() const {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        return std::count_if(clients_.begin(), clients_.end(),
+                             [](const std::unique_ptr<Client> &client) { return client->is_connected(); });
+    }
+
+    void accept_clients() {
+        while (!stop_) {
+            pollfd fd{listen_socket_, POLLIN, 0};
+            const int ready = ::poll(&fd, 1, kPollPeriodMs);
+
+            // the disconnected clients are cleaned up here, out of the publishing path
+            std::vector<std::unique_ptr<Client>> disconnected;
+            {
+                std::lock_guard<std::mutex> lock(clients_mutex_);
+                auto it = std::partition(clients_.begin(), clients_.end(),
+                                         [](const std::unique_ptr<Client> &client) { return client->is_connected(); });
+                std::move(it, clients_.end(), std::back_inserter(disconnected));
+                clients_.erase(it, clients_.end());
+            }
+            disconnected.clear();
+
+            if (ready <= 0) {
+                continue;
+            }
+            const int socket = ::accept(listen_socket_, nullptr, nullptr);
+            if (socket < 0) {
+                continue;
+            }
+            configure_client_socket(socket);
+            auto client = std::make_unique<Client>(socket, *this);
+            std::lock_guard<std::mutex> lock(clients_mutex_);
+            clients_.push_back(std::move(client));
+        }
+    }
+
+    static void configure_client_socket(int socket) {
+        const int enable = 1;
+        ::setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+#ifdef SO_NOSIGPIPE
+        ::setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#endif
+        timeval timeout{kSendTimeoutS, 0};
+        ::setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    }
+
+    const std::string header_;
+    const NetworkRawStreamServerConfig config_;
+    int listen_socket_ = -1;
+    uint16_t port_     = 0;
+    std::atomic<bool> stop_{false};
+    std::thread acceptor_;
+
+    mutable std::mutex clients_mutex_;
+    std::vector<std::unique_ptr<Client>> clients_;
+    mutable Counters counters_;
+};
+
+NetworkRawStreamServer::NetworkRawStreamServer(const RawFileHeader &header,
+                                               const NetworkRawStreamServerConfig &config) :
+    pimpl_(new Private(header, config)) {}
+
+NetworkRawStreamServer::~NetworkRawStreamServer() {}
+
+uint16_t NetworkRawStreamServer::get_port() const {
+    return pimpl_->port_;
+}
+
+void NetworkRawStreamServer::publish(const DataTransfer::BufferPtr &buffer) {
+    pimpl_->publish(buffer);
+}
+
+void NetworkRawStreamServer::publish(const DataTransfer::Data *begin, const DataTransfer::Data *end) {
+    // the data is only copied if someone is listening
+    if (!pimpl_->has_clients()) {
+        pimpl_->counters_.published_bytes += end - begin;
+        return;
+    }
+    auto copy = std::make_shared<DataTransfer::BufferPtr::CloneType>(begin, end);
+    pimpl_->publish(DataTransfer::make_buffer_ptr(copy));
+}
+
+std::size_t NetworkRawStreamServer::get_num_clients() const {
+    return pimpl_->get_num_clients();
+}
+
+NetworkRawStreamServer::Statistics NetworkRawStreamServer::get_statistics() const {
+    const auto &counters = pimpl_->counters_;
+    Statistics statistics;
+    statistics.published_bytes = counters.published_bytes;
+    statistics.sent_raw_bytes  = counters.sent_raw_bytes;
+    statistics.sent_bytes      = counters.sent_bytes;
+    statistics.sent_frames     = counters.sent_frames;
+    statistics.dropped_bytes   = counters.dropped_bytes;
+    statistics.dropped_buffers = counters.dropped_buffers;
+    return statistics;
+}
+
+#else
+
+class NetworkRawStreamServer::Private {};
+
+NetworkRawStreamServer::NetworkRawStreamServer(const RawFileHeader &, const NetworkRawStreamServerConfig &) {
+    throw HalException(HalErrorCode::OperationNotImplemented, "Network RAW streams are not supported on Windows.");
+}
+
+NetworkRawStreamServer::~NetworkRawStreamServer() {}
+
+uint16_t NetworkRawStreamServer::get_port() const {
+    return 0;
+}
+
+void NetworkRawStreamServer::publish(const DataTransfer::BufferPtr &) {}
+
+void NetworkRawStreamServer::publish(const DataTransfer::Data *, const DataTransfer::Data *) {}
+
+std::size_t NetworkRawStreamServer::get_num_clients() const {
+    return 0;
+}
+
+NetworkRawStreamServer::Statistics NetworkRawStreamServer::get_statistics() const {
+    return Statistics();
+}
+
+#endif
+
+} // namespace Metavision
@@ -0,0 +1,91 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include "metavision/hal/facilities/i_events_stream_decoder.h"
+#include "metavision/hal/utils/detail/raw_bookmarks_builder.h"
+
+namespace Metavision {
+namespace detail {
+
+RawBookmarksBuilder::RawBookmarksBuilder(I_EventsStreamDecoder &decoder, uint32_t bookmark_period_us,
+                                         uint64_t data_start_pos, const BookmarkCallback &bookmark_cb) :
+    decoder_(decoder),
+    raw_event_size_bytes_(decoder.get_raw_event_size_bytes()),
+    bookmark_period_us_(bookmark_period_us),
+    bookmark_cb_(bookmark_cb),
+    byte_offset_(data_start_pos),
+    // the decoder default timestamp, so that we know when a valid timestamp has been decoded
+    prev_ts_(decoder.get_last_timestamp()) {
+    last_bookmark_.timestamp_   = -1;
+    last_bookmark_.byte_offset_ = data_start_pos;
+}
+
+void RawBookmarksBuilder::add_cd_events(std::size_t count) {
+    cd_event_count_ += count;
+}
+
+bool RawBookmarksBuilder::add_event(const uint8_t *raw_event) {
+    // Decode single event
+    decoder_.decode(raw_event, raw_event + raw_event_size_bytes_);
+    const uint64_t byte_offset = byte_offset_;
+    byte_offset_ += raw_event_size_bytes_;
+
+    // Wait for timestamp shift to be computed before logging any bookmark
+    if (!ts_shift_computed_) {
+        if (!decoder_.get_timestamp_shift(ts_shift_us_)) {
+            return true;
+        }
+        ts_shift_computed_ = true;
+    }
+
+    const auto new_ts = decoder_.get_last_timestamp();
+    // Same ts: nothing to do
+    if (prev_ts_ == new_ts) {
+        return true;
+    }
+    prev_ts_ = new_ts;
+
+    const std::size_t bookmark_index = new_ts / bookmark_period_us_ + 1;
+    if (bookmark_index > last_bookmark_index_) {
+        // the periods without any event are bookmarked at the last timestamp, with no events
+        I_EventsStream::Bookmark bookmark = last_bookmark_;
+        for (; last_bookmark_index_ < bookmark_index; ++last_bookmark_index_) {
+            if (!bookmark_cb_(bookmark)) {
+                return false;
+            }
+            bookmark.cd_event_count_ = 0;
+        }
+        last_bookmark_.byte_offset_    = byte_offset;
+        last_bookmark_.timestamp_      = new_ts;
+        last_bookmark_.cd_event_count_ = cd_event_count_;
+        cd_event_count_                = 0;
+    }
+    return true;
+}
+
+I_EventsStream::Bookmark RawBookmarksBuilder::get_last_bookmark() const {
+    return last_bookmark_;
+}
+
+bool RawBookmarksBuilder::is_ts_shift_computed() const {
+    return ts_shift_computed_;
+}
+
+timestamp RawBookmarksBuilder::get_ts_shift() const {
+    return ts_shift_us_;
+}
+
+uint64_t RawBookmarksBuilder::get_byte_offset() const {
+    return byte_offset_;
+}
+
+} // namespace detail
+} // namespace Metavision
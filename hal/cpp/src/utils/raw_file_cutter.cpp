@@ -0,0 +1,413 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+#include "metavision/hal/decoders/evt2/evt2_event_types.h"
+#include "metavision/hal/decoders/evt21/evt21_event_types.h"
+#include "metavision/hal/decoders/evt3/evt3_event_types.h"
+#include "metavision/hal/device/device.h"
+#include "metavision/hal/facilities/i_event_decoder.h"
+#include "metavision/hal/facilities/i_events_stream.h"
+#include "metavision/hal/facilities/i_events_stream_decoder.h"
+#include "metavision/hal/facilities/i_hw_identification.h"
+#include "metavision/hal/utils/hal_log.h"
+#include "metavision/hal/utils/raw_file_cutter.h"
+#include "metavision/hal/utils/raw_file_header.h"
+#include "metavision/hal/utils/raw_index_trailer.h"
+
+namespace Metavision {
+
+namespace {
+
+enum class RawFormat { Unsupported, EVT2, EVT21, EVT21Legacy, EVT3 };
+
+// Number of RAW events read at once when looking for a cut point
+constexpr size_t cut_point_read_events = 4096;
+
+// Number of bytes copied at once when copy_file_range is not available
+constexpr size_t copy_buffer_size = 1 << 20;
+
+RawFormat get_raw_format(const RawFileHeader &header) {
+    // Format string is of the form NAME;option1=value1;option2=value2...
+    std::istringstream format(header.get_field("format"));
+    std::string name, option;
+    std::getline(format, name, ';');
+    bool legacy = false;
+    while (std::getline(format, option, ';')) {
+        legacy = legacy || option == "endianness=legacy";
+    }
+
+    if (name == "EVT2") {
+        return RawFormat::EVT2;
+    } else if (name == "EVT21") {
+        return legacy ? RawFormat::EVT21Legacy : RawFormat::EVT21;
+    } else if (name == "EVT3") {
+        return RawFormat::EVT3;
+    }
+    return RawFormat::Unsupported;
+}
+
+template<typename RawEvent>
+void append_raw_event(std::vector<char> &data, const RawEvent &ev) {
+    const char *begin = reinterpret_cast<const char *>(&ev);
+    data.insert(data.end(), begin, begin + sizeof(ev));
+}
+
+// Position in the RAW file from which the data of the events at or after a timestamp can be copied
+struct CutPoint {
+    uint64_t byte_offset;
+    timestamp ts;           // time base at byte_offset, in the time reference of the decoder
+    uint16_t evt3_addr_y;   // for EVT3, last EVT_ADDR_Y event before byte_offset
+    bool evt3_addr_y_valid; // false if there is no EVT_ADDR_Y event before byte_offset
+};
+
+class CutPointFinder {
+public:
+    CutPointFinder(Device &device, const std::filesystem::path &raw_file_path, RawFormat format,
+                   uint64_t data_begin) :
+        raw_file_(raw_file_path, std::ios::binary),
+        events_stream_(*device.get_facility<I_EventsStream>()),
+        decoder_(*device.get_facility<I_EventsStreamDecoder>()),
+        cd_decoder_(device.get_facility<I_EventDecoder<EventCD>>()),
+        ext_trigger_decoder_(device.get_facility<I_EventDecoder<EventExtTrigger>>()),
+        format_(format),
+        data_begin_(data_begin) {
+        if (cd_decoder_) {
+            cd_callback_id_ = cd_decoder_->add_event_buffer_callback(
+                [this](const EventCD *begin, const EventCD *end) { on_events(begin, end); });
+        }
+        if (ext_trigger_decoder_) {
+            ext_trigger_callback_id_ = ext_trigger_decoder_->add_event_buffer_callback(
+                [this](const EventExtTrigger *begin, const EventExtTrigger *end) { on_events(begin, end); });
+        }
+    }
+
+    ~CutPointFinder() {
+        if (cd_decoder_) {
+            cd_decoder_->remove_callback(cd_callback_id_);
+        }
+        if (ext_trigger_decoder_) {
+            ext_trigger_decoder_->remove_callback(ext_trigger_callback_id_);
+        }
+    }
+
+    bool is_open() const {
+        return raw_file_.is_open();
+    }
+
+    /// Finds the cut point of the first event at or after target_ts
+    /// Returns false if there is no such event in the file
+    bool find(timestamp target_ts, CutPoint &cut_point) {
+        I_EventsStream::Bookmark bookmark;
+        if (events_stream_.get_bookmark(target_ts, bookmark) != I_EventsStream::SeekStatus::Success) {
+            return false;
+        }
+
+        // in EVT3, the row address is not reset with the time base, the events after the bookmark can only be decoded
+        // once the last EVT_ADDR_Y event before it is known
+        uint16_t addr_y   = 0;
+        bool addr_y_valid = format_ == RawFormat::EVT3 && find_last_evt3_addr_y(bookmark.byte_offset_, addr_y);
+
+        raw_file_.clear();
+        raw_file_.seekg(bookmark.byte_offset_);
+        decoder_.reset_last_timestamp(bookmark.timestamp_);
+        if (addr_y_valid) {
+            const auto *raw_addr_y = reinterpret_cast<const I_EventsStreamDecoder::RawData *>(&addr_y);
+            decoder_.decode(raw_addr_y, raw_addr_y + sizeof(addr_y));
+        }
+
+        // the bookmark is located on a RAW event changing the time base
+        cut_point              = {bookmark.byte_offset_, bookmark.timestamp_, addr_y, addr_y_valid};
+        uint64_t byte_offset   = bookmark.byte_offset_;
+        target_ts_             = target_ts;
+        target_reached_        = false;
+        const size_t raw_size  = decoder_.get_raw_event_size_bytes();
+        std::vector<char> buffer(cut_point_read_events * raw_size);
+
+        while (raw_file_.read(buffer.data(), buffer.size()) || raw_file_.gcount() > 0) {
+            const auto *begin = reinterpret_cast<const I_EventsStreamDecoder::RawData *>(buffer.data());
+            const auto *end   = begin + (raw_file_.gcount() / raw_size) * raw_size;
+            // RAW events are decoded one by one to know which one changes the time base
+            for (const auto *raw_ev = begin; raw_ev != end; raw_ev += raw_size, byte_offset += raw_size) {
+                const timestamp prev_ts = decoder_.get_last_timestamp();
+                decoder_.decode(raw_ev, raw_ev + raw_size);
+                const timestamp ts = decoder_.get_last_timestamp();
+                if (ts != prev_ts) {
+                    cut_point = {byte_offset, ts, addr_y, addr_y_valid};
+                }
+                if (target_reached_) {
+                    // all the events decoded since the last time base change have the same timestamp
+                    cut_point.ts = ts;
+                    return true;
+                }
+                if (format_ == RawFormat::EVT3 && is_evt3_addr_y(raw_ev)) {
+                    addr_y       = *reinterpret_cast<const uint16_t *>(raw_ev);
+                    addr_y_valid = true;
+                }
+            }
+        }
+        return false;
+    }
+
+private:
+    static bool is_evt3_addr_y(const I_EventsStreamDecoder::RawData *raw_ev) {
+        const auto *ev = reinterpret_cast<const Evt3Raw::RawEvent *>(raw_ev);
+        return ev->type == static_cast<EventTypesUnderlying_t>(Evt3EventTypes_4bits::EVT_ADDR_Y);
+    }
+
+    // Finds the last EVT_ADDR_Y event before byte_offset, reading the data backwards
+    // Each EVT3 word holds its type, so the data does not need to be decoded
+    bool find_last_evt3_addr_y(uint64_t byte_offset, uint16_t &addr_y) {
+        std::vector<uint16_t> buffer(cut_point_read_events);
+        while (byte_offset > data_begin_) {
+            const size_t num_words =
+                static_cast<size_t>(std::min<uint64_t>(buffer.size(), (byte_offset - data_begin_) / sizeof(uint16_t)));
+            if (num_words == 0) {
+                break;
+            }
+            byte_offset -= num_words * sizeof(uint16_t);
+            raw_file_.clear();
+            raw_file_.seekg(byte_offset);
+            if (!raw_file_.read(reinterpret_cast<char *>(buffer.data()), num_words * sizeof(uint16_t))) {
+                break;
+            }
+            for (size_t i = num_words; i-- > 0;) {
+                if (is_evt3_addr_y(reinterpret_cast<const I_EventsStreamDecoder::RawData *>(&buffer[i]))) {
+                    addr_y = buffer[i];
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    template<typename Event>
+    void on_events(const Event *begin, const Event *end) {
+        target_reached_ =
+            target_reached_ || std::any_of(begin, end, [this](const Event &ev) { return ev.t >= target_ts_; });
+    }
+
+    std::ifstream raw_file_;
+    I_EventsStream &events_stream_;
+    I_EventsStreamDecoder &decoder_;
+    I_EventDecoder<EventCD> *cd_decoder_;
+    I_EventDecoder<EventExtTrigger> *ext_trigger_decoder_;
+    size_t cd_callback_id_          = 0;
+    size_t ext_trigger_callback_id_ = 0;
+    const RawFormat format_;
+    const uint64_t data_begin_;
+    timestamp target_ts_ = 0;
+    bool target_reached_ = false;
+};
+
+// Encodes the RAW events setting the time base of a decoder to the one of the cut point
+std::vector<char> make_prologue(RawFormat format, const CutPoint &cut_point, timestamp ts_shift) {
+    const uint64_t ts = static_cast<uint64_t>(cut_point.ts + ts_shift);
+    std::vector<char> prologue;
+    switch (format) {
+    case RawFormat::EVT2: {
+        EVT2TimeHigh ev;
+        ev.ts   = ts >> EVT2EventsTimeStampBits;
+        ev.type = static_cast<EventTypesUnderlying_t>(EVT2EventTypes::EVT_TIME_HIGH);
+        append_raw_event(prologue, ev);
+        break;
+    }
+    case RawFormat::EVT21: {
+        Evt21Raw::Event_TIME_HIGH ev{};
+        ev.ts   = ts >> 6;
+        ev.type = static_cast<EventTypesUnderlying_t>(Evt21EventTypes_4bits::EVT_TIME_HIGH);
+        append_raw_event(prologue, ev);
+        break;
+    }
+    case RawFormat::EVT21Legacy: {
+        Evt21LegacyRaw::Event_TIME_HIGH ev{};
+        ev.ts   = ts >> 6;
+        ev.type = static_cast<EventTypesUnderlying_t>(Evt21EventTypes_4bits::EVT_TIME_HIGH);
+        append_raw_event(prologue, ev);
+        break;
+    }
+    case RawFormat::EVT3: {
+        // the time low is needed too, as a time high event does not reset it
+        Evt3Raw::Event_Time ev;
+        ev.time = (ts >> 12) & 0xFFF;
+        ev.type = static_cast<EventTypesUnderlying_t>(Evt3EventTypes_4bits::EVT_TIME_HIGH);
+        append_raw_event(prologue, ev);
+        ev.time = ts & 0xFFF;
+        ev.type = static_cast<EventTypesUnderlying_t>(Evt3EventTypes_4bits::EVT_TIME_LOW);
+        append_raw_event(prologue, ev);
+        if (cut_point.evt3_addr_y_valid) {
+            append_raw_event(prologue, cut_point.evt3_addr_y);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    return prologue;
+}
+
+bool copy_with_streams(const std::filesystem::path &input_path, const std::filesystem::path &output_path,
+                       uint64_t begin, uint64_t end) {
+    std::ifstream input(input_path, std::ios::binary);
+    std::ofstream output(output_path, std::ios::binary | std::ios::app);
+    if (!input || !output || !input.seekg(begin)) {
+        return false;
+    }
+    std::vector<char> buffer(copy_buffer_size);
+    while (begin < end) {
+        const size_t size = static_cast<size_t>(std::min<uint64_t>(buffer.size(), end - begin));
+        if (!input.read(buffer.data(), size) || !output.write(buffer.data(), size)) {
+            return false;
+        }
+        begin += size;
+    }
+    return true;
+}
+
+// Appends the bytes [begin, end) of the input file to the output file
+bool copy_file_range_to_end(const std::filesystem::path &input_path, const std::filesystem::path &output_path,
+                            uint64_t begin, uint64_t end) {
+#ifdef __linux__
+    // copy_file_range lets the kernel (or the file system, e.g. with reflinks) copy the data without it going through
+    // user space. If it is not supported for these files, the remaining data is copied with streams
+    const int in_fd = ::open(input_path.c_str(), O_RDONLY);
+    if (in_fd >= 0) {
+        const int out_fd = ::open(output_path.c_str(), O_WRONLY);
+        if (out_fd >= 0) {
+            loff_t in_offset  = begin;
+            loff_t out_offset = ::lseek(out_fd, 0, SEEK_END);
+            while (begin < end && out_offset >= 0) {
+                const ssize_t copied = ::copy_file_range(in_fd, &in_offset, out_fd, &out_offset, end - begin, 0);
+                if (copied <= 0) {
+                    if (copied < 0 && errno == EINTR) {
+                        continue;
+                    }
+                    break;
+                }
+                begin += copied;
+            }
+            ::close(out_fd);
+        }
+        ::close(in_fd);
+    }
+    if (begin == end) {
+        return true;
+    }
+#endif
+    return copy_with_streams(input_path, output_path, begin, end);
+}
+
+} // namespace
+
+RawFileCutStatus cut_raw_file(Device &device, const std::filesystem::path &output_path, timestamp start_ts,
+                              timestamp end_ts) {
+    auto *events_stream     = device.get_facility<I_EventsStream>();
+    auto *decoder           = device.get_facility<I_EventsStreamDecoder>();
+    auto *hw_identification = device.get_facility<I_HW_Identification>();
+    if (!events_stream || !decoder || !hw_identification || events_stream->get_underlying_file().empty()) {
+        return RawFileCutStatus::Failed;
+    }
+    const std::filesystem::path input_path = events_stream->get_underlying_file();
+
+    auto header       = hw_identification->get_header();
+    const auto format = get_raw_format(header);
+    if (format == RawFormat::Unsupported) {
+        MV_HAL_LOG_TRACE() << "Can not cut RAW file" << input_path << "without decoding it: unsupported format"
+                           << header.get_field("format");
+        return RawFileCutStatus::Failed;
+    }
+
+    timestamp first_ts, last_ts;
+    auto index_status = events_stream->get_seek_range(first_ts, last_ts);
+    while (index_status == I_EventsStream::IndexStatus::Building) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        index_status = events_stream->get_seek_range(first_ts, last_ts);
+    }
+    if (index_status != I_EventsStream::IndexStatus::Good) {
+        MV_HAL_LOG_TRACE() << "Can not cut RAW file" << input_path << "without decoding it: index is not available";
+        return RawFileCutStatus::Failed;
+    }
+
+    timestamp ts_shift = 0;
+    if (decoder->is_time_shifting_enabled() && !decoder->get_timestamp_shift(ts_shift)) {
+        return RawFileCutStatus::Failed;
+    }
+
+    uint64_t data_begin, data_end;
+    {
+        std::ifstream raw_file(input_path, std::ios::binary);
+        RawFileHeader raw_file_header(raw_file);
+        data_begin = raw_file.tellg();
+        // the index trailer of the input file, if any, does not apply to the output file
+        RawIndexTrailer trailer;
+        if (read_raw_index_trailer(raw_file, trailer, false)) {
+            data_end = trailer.data_end_pos_;
+        } else {
+            raw_file.seekg(0, std::ios::end);
+            data_end = raw_file.tellg();
+        }
+    }
+
+    CutPointFinder finder(device, input_path, format, data_begin);
+    if (!finder.is_open()) {
+        MV_HAL_LOG_ERROR() << "Failed to open RAW file" << input_path;
+        return RawFileCutStatus::Failed;
+    }
+
+    std::vector<char> prologue;
+    uint64_t copy_begin = data_begin;
+    CutPoint cut_point;
+    if (start_ts > first_ts) {
+        if (!finder.find(start_ts, cut_point)) {
+            return RawFileCutStatus::NothingToCut;
+        }
+        copy_begin = cut_point.byte_offset;
+        prologue   = make_prologue(format, cut_point, ts_shift);
+    }
+    const uint64_t copy_end = finder.find(end_ts, cut_point) ? cut_point.byte_offset : data_end;
+
+    {
+        std::ofstream output(output_path, std::ios::binary);
+        if (!output) {
+            MV_HAL_LOG_ERROR() << "Failed to open output RAW file" << output_path;
+            return RawFileCutStatus::Failed;
+        }
+        header.add_date();
+        output << header;
+        output.write(prologue.data(), prologue.size());
+        if (!output) {
+            MV_HAL_LOG_ERROR() << "Failed to write output RAW file" << output_path;
+            return RawFileCutStatus::Failed;
+        }
+    }
+
+    if (copy_begin < copy_end && !copy_file_range_to_end(input_path, output_path, copy_begin, copy_end)) {
+        MV_HAL_LOG_ERROR() << "Failed to write output RAW file" << output_path;
+        return RawFileCutStatus::Failed;
+    }
+    return RawFileCutStatus::Success;
+}
+
+} // namespace Metavision
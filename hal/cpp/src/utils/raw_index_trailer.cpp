@@ -0,0 +1,312 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/generic_header.h"
+#include "metavision/hal/decoders/evt2/evt2_decoder.h"
+#include "metavision/hal/decoders/evt21/evt21_decoder.h"
+#include "metavision/hal/decoders/evt3/evt3_decoder.h"
+#include "metavision/hal/facilities/i_event_decoder.h"
+#include "metavision/hal/facilities/i_events_stream_decoder.h"
+#include "metavision/hal/utils/detail/raw_bookmarks_builder.h"
+#include "metavision/hal/utils/raw_index_trailer.h"
+
+namespace Metavision {
+
+namespace {
+
+// Layout of the trailer, before encoding:
+//   - padding_size zero bytes, so that the trailer starts with whole events even if the RAW data ends with an event
+//     expecting CONTINUED events
+//   - the body: a header holding the trailer_version_key, bookmark_period_key and ts_shift_key fields, followed by
+//     the bookmarks
+//   - zero bytes, so that the size of the encoded trailer is a multiple of 8 bytes
+//   - the footer: the magic number, the position of the end of the RAW data and the size of the body
+// The integers are stored in little endian.
+//
+// Each byte of the trailer is encoded as two bytes, the second one being continued_byte, so that every 16, 32 or
+// 64 bits word of the encoded trailer is a CONTINUED event in the EVT3, EVT2 and EVT2.1 formats (including EVT2.1 with
+// legacy endianness), which the decoders ignore.
+constexpr uint8_t continued_byte      = 0xF0;
+constexpr size_t padding_size         = 4;
+constexpr char magic_number[]         = "MVRAWIDX";
+constexpr size_t magic_number_size    = sizeof(magic_number) - 1;
+constexpr size_t footer_size          = magic_number_size + 2 * sizeof(uint64_t);
+constexpr size_t encoded_footer_size  = 2 * footer_size;
+constexpr size_t bookmark_packed_size = sizeof(int64_t) + sizeof(uint64_t) + sizeof(uint32_t);
+
+static const std::string trailer_version_key = "index_trailer_version";
+static const std::string trailer_version     = "1.0";
+static const std::string bookmark_period_key = "bookmark_period_us";
+static const std::string ts_shift_key        = "ts_shift_us";
+
+size_t get_encoded_trailer_size(uint64_t body_size) {
+    const uint64_t size = padding_size + body_size + footer_size;
+    return 2 * (size + (4 - size % 4) % 4);
+}
+
+template<typename T>
+void append_le(std::string &data, T value) {
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        data.push_back(static_cast<char>(static_cast<uint64_t>(value) >> (8 * i)));
+    }
+}
+
+template<typename T>
+T read_le(const std::string &data, size_t pos) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(data[pos + i])) << (8 * i);
+    }
+    return static_cast<T>(value);
+}
+
+std::string encode(const std::string &data) {
+    std::string encoded;
+    encoded.reserve(2 * data.size());
+    for (char c : data) {
+        encoded.push_back(c);
+        encoded.push_back(static_cast<char>(continued_byte));
+    }
+    return encoded;
+}
+
+bool decode(const std::string &encoded, std::string &data) {
+    data.clear();
+    data.reserve(encoded.size() / 2);
+    for (size_t i = 0; i + 1 < encoded.size(); i += 2) {
+        if (static_cast<uint8_t>(encoded[i + 1]) != continued_byte) {
+            return false;
+        }
+        data.push_back(encoded[i]);
+    }
+    return true;
+}
+
+// Builds a decoder of the format of the RAW data, with the configuration used to index RAW files
+std::unique_ptr<I_EventsStreamDecoder>
+    make_indexing_decoder(const RawFileHeader &header, const std::shared_ptr<I_EventDecoder<EventCD>> &cd_decoder) {
+    // Format string is of the form NAME;option1=value1;option2=value2...
+    std::istringstream format(header.get_field("format"));
+    std::string name, option;
+    std::getline(format, name, ';');
+    bool legacy = false;
+    int width = 0, height = 0;
+    while (std::getline(format, option, ';')) {
+        if (option == "endianness=legacy") {
+            legacy = true;
+        } else if (option.rfind("width=", 0) == 0) {
+            width = std::atoi(option.c_str() + 6);
+        } else if (option.rfind("height=", 0) == 0) {
+            height = std::atoi(option.c_str() + 7);
+        }
+    }
+
+    if (name == "EVT2") {
+        return std::make_unique<EVT2Decoder>(true, cd_decoder);
+    } else if (name == "EVT21") {
+        if (legacy) {
+            return std::make_unique<EVT21LegacyDecoder>(true, cd_decoder);
+        }
+        return std::make_unique<EVT21Decoder>(true, cd_decoder);
+    } else if (name == "EVT3" && width > 0 && height > 0) {
+        return make_evt3_decoder(true, height, width, cd_decoder);
+    }
+    return nullptr;
+}
+
+} // namespace
+
+class RawIndexTrailerWriter::Private {
+public:
+    Private(const RawFileHeader &header, uint64_t data_start_pos, uint32_t bookmark_period_us) :
+        cd_decoder_(std::make_shared<I_EventDecoder<EventCD>>()),
+        decoder_(make_indexing_decoder(header, cd_decoder_)),
+        bookmark_period_us_(bookmark_period_us),
+        data_start_pos_(data_start_pos) {
+        if (decoder_) {
+            // same bookmarks as when indexing a RAW file once recorded, see I_EventsStream::index
+            builder_ = std::make_unique<detail::RawBookmarksBuilder>(
+                *decoder_, bookmark_period_us, data_start_pos, [this](const I_EventsStream::Bookmark &bookmark) {
+                    bookmarks_.push_back(bookmark);
+                    return true;
+                });
+            cd_decoder_->add_event_buffer_callback(
+                [this](auto begin, auto end) { builder_->add_cd_events(std::distance(begin, end)); });
+            raw_event_size_bytes_ = decoder_->get_raw_event_size_bytes();
+        }
+    }
+
+    void add_data(const uint8_t *begin, const uint8_t *end) {
+        if (!decoder_) {
+            return;
+        }
+        if (!partial_event_.empty()) {
+            const size_t size = std::min<size_t>(raw_event_size_bytes_ - partial_event_.size(), end - begin);
+            partial_event_.insert(partial_event_.end(), begin, begin + size);
+            begin += size;
+            if (partial_event_.size() < raw_event_size_bytes_) {
+                return;
+            }
+            builder_->add_event(partial_event_.data());
+            partial_event_.clear();
+        }
+        for (; static_cast<size_t>(end - begin) >= raw_event_size_bytes_; begin += raw_event_size_bytes_) {
+            builder_->add_event(begin);
+        }
+        partial_event_.assign(begin, end);
+    }
+
+    uint64_t get_data_size() const {
+        return (builder_ ? builder_->get_byte_offset() : data_start_pos_) + partial_event_.size() - data_start_pos_;
+    }
+
+    bool write(std::ostream &stream) {
+        // a trailer following a truncated event would not be made of whole CONTINUED events
+        if (!decoder_ || !builder_->is_ts_shift_computed() || !partial_event_.empty()) {
+            return false;
+        }
+
+        GenericHeader header;
+        header.set_field(trailer_version_key, trailer_version);
+        header.set_field(bookmark_period_key, std::to_string(bookmark_period_us_));
+        header.set_field(ts_shift_key, std::to_string(builder_->get_ts_shift()));
+        std::string body = header.to_string();
+        body.reserve(body.size() + (bookmarks_.size() + 1) * bookmark_packed_size);
+        const auto append_bookmark = [&body](const I_EventsStream::Bookmark &bookmark) {
+            append_le(body, bookmark.timestamp_);
+            append_le(body, bookmark.byte_offset_);
+            append_le(body, bookmark.cd_event_count_);
+        };
+        for (const auto &bookmark : bookmarks_) {
+            append_bookmark(bookmark);
+        }
+        // the bookmark of the last timestamp, as added at the end of the indexing
+        append_bookmark(builder_->get_last_bookmark());
+
+        std::string footer(magic_number, magic_number_size);
+        append_le(footer, builder_->get_byte_offset());
+        append_le(footer, static_cast<uint64_t>(body.size()));
+
+        const size_t encoded_size = get_encoded_trailer_size(body.size());
+        std::string trailer       = encode(std::string(padding_size, '\0'));
+        trailer.reserve(encoded_size);
+        trailer += encode(body);
+        trailer += encode(std::string((encoded_size - trailer.size() - encoded_footer_size) / 2, '\0'));
+        trailer += encode(footer);
+
+        return static_cast<bool>(stream.write(trailer.data(), trailer.size()));
+    }
+
+    std::shared_ptr<I_EventDecoder<EventCD>> cd_decoder_;
+    std::unique_ptr<I_EventsStreamDecoder> decoder_;
+    std::unique_ptr<detail::RawBookmarksBuilder> builder_;
+    size_t raw_event_size_bytes_ = 0;
+    std::vector<uint8_t> partial_event_;
+
+    const uint32_t bookmark_period_us_;
+    const uint64_t data_start_pos_;
+    I_EventsStream::Bookmarks bookmarks_;
+};
+
+RawIndexTrailerWriter::RawIndexTrailerWriter(const RawFileHeader &header, uint64_t data_start_pos,
+                                             uint32_t bookmark_period_us) :
+    pimpl_(new Private(header, data_start_pos, bookmark_period_us)) {}
+
+RawIndexTrailerWriter::~RawIndexTrailerWriter() {}
+
+bool RawIndexTrailerWriter::is_supported() const {
+    return pimpl_->decoder_ != nullptr;
+}
+
+void RawIndexTrailerWriter::add_data(const uint8_t *begin, const uint8_t *end) {
+    pimpl_->add_data(begin, end);
+}
+
+uint64_t RawIndexTrailerWriter::get_data_size() const {
+    return pimpl_->get_data_size();
+}
+
+bool RawIndexTrailerWriter::write(std::ostream &stream) {
+    return pimpl_->write(stream);
+}
+
+bool read_raw_index_trailer(std::istream &stream, RawIndexTrailer &trailer, bool read_bookmarks) {
+    const auto initial_pos = stream.tellg();
+    const auto restore     = [&stream, initial_pos](bool ret) {
+        stream.clear();
+        stream.seekg(initial_pos);
+        return ret;
+    };
+
+    if (!stream.seekg(0, std::ios::end)) {
+        return restore(false);
+    }
+    const uint64_t file_size = stream.tellg();
+    if (file_size < encoded_footer_size) {
+        return restore(false);
+    }
+
+    std::string encoded(encoded_footer_size, '\0'), footer;
+    if (!stream.seekg(file_size - encoded_footer_size) || !stream.read(&encoded[0], encoded.size()) ||
+        !decode(encoded, footer) || footer.compare(0, magic_number_size, magic_number) != 0) {
+        return restore(false);
+    }
+    const uint64_t data_end_pos = read_le<uint64_t>(footer, magic_number_size);
+    const uint64_t body_size    = read_le<uint64_t>(footer, magic_number_size + sizeof(uint64_t));
+    // the trailer must span exactly from the end of the data to the end of the file, which is not the case for
+    // instance if the file was truncated and then written again
+    if (body_size > file_size || data_end_pos > file_size ||
+        data_end_pos + get_encoded_trailer_size(body_size) != file_size) {
+        return restore(false);
+    }
+    trailer.data_end_pos_ = data_end_pos;
+    if (!read_bookmarks) {
+        return restore(true);
+    }
+
+    std::string body;
+    encoded.resize(2 * body_size);
+    if (!stream.seekg(data_end_pos + 2 * padding_size) || !stream.read(&encoded[0], encoded.size()) ||
+        !decode(encoded, body)) {
+        return restore(false);
+    }
+
+    std::istringstream body_stream(body);
+    GenericHeader header(body_stream);
+    const uint32_t bookmark_period_us = std::atol(header.get_field(bookmark_period_key).c_str());
+    if (header.get_field(trailer_version_key) != trailer_version || bookmark_period_us == 0 ||
+        header.get_field(ts_shift_key).empty() || !body_stream) {
+        return restore(false);
+    }
+    trailer.bookmark_period_us_ = bookmark_period_us;
+    trailer.ts_shift_us_        = std::atoll(header.get_field(ts_shift_key).c_str());
+
+    trailer.bookmarks_.clear();
+    trailer.bookmarks_.reserve((body.size() - body_stream.tellg()) / bookmark_packed_size);
+    for (size_t pos = body_stream.tellg(); pos + bookmark_packed_size <= body.size(); pos += bookmark_packed_size) {
+        I_EventsStream::Bookmark bookmark;
+        bookmark.timestamp_      = read_le<int64_t>(body, pos);
+        bookmark.byte_offset_    = read_le<uint64_t>(body, pos + sizeof(int64_t));
+        bookmark.cd_event_count_ = read_le<uint32_t>(body, pos + sizeof(int64_t) + sizeof(uint64_t));
+        trailer.bookmarks_.push_back(bookmark);
+    }
+    return restore(!trailer.bookmarks_.empty());
+}
+
+} // namespace Metavision
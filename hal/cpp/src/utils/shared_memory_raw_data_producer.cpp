@@ -0,0 +1,209 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/hal_log.h"
+#include "metavision/hal/utils/shared_memory_raw_data_producer.h"
+#include "metavision/hal/utils/detail/shared_memory_raw_ring.h"
+
+namespace Metavision {
+
+namespace {
+// Time between two checks of the publisher's position, when all the published data has been read
+constexpr std::chrono::microseconds kPollPeriod(100);
+} // namespace
+
+using Ring = detail::SharedMemoryRawRing;
+
+// State shared with the transferred buffers, which may outlive the producer
+struct SharedMemoryRawDataProducer::State {
+    explicit State(std::unique_ptr<Ring> ring) : ring(std::move(ring)) {}
+
+    // Takes a free consumer slot, and starts reading from the current write position
+    bool join() {
+        if (try_join()) {
+            return true;
+        }
+        // the slots may be held by consumers which exited without leaving
+        bool released_slot = false;
+        for (auto &consumer : ring->control().consumers) {
+            released_slot = Ring::release_dead_consumer(consumer) || released_slot;
+        }
+        return released_slot && try_join();
+    }
+
+    bool try_join() {
+        auto &control = ring->control();
+        for (auto &consumer : control.consumers) {
+            uint32_t state = Ring::Free;
+            if (consumer.state.compare_exchange_strong(state, Ring::Joining)) {
+                consumer.pid.store(Ring::get_current_pid(), std::memory_order_release);
+                consumer.read_pos.store(control.write_pos.load());
+                consumer.state.store(Ring::Active);
+                // the publisher may not have seen the slot as active before writing further, the data published
+                // before this point is skipped
+                next_pos = control.write_pos.load();
+                consumer.read_pos.store(next_pos);
+                slot = &consumer;
+                records.clear();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void leave() {
+        slot->pid.store(0, std::memory_order_relaxed);
+        slot->state.store(Ring::Free, std::memory_order_release);
+        slot = nullptr;
+    }
+
+    void update_read_pos() {
+        slot->read_pos.store(records.empty() ? next_pos : records.front().first, std::memory_order_release);
+    }
+
+    void release(uint64_t record_pos) {
+        std::lock_guard<std::mutex> lock(mutex);
+        // the buffers are usually released in order, the search starts from the oldest one
+        for (auto &record : records) {
+            if (record.first == record_pos) {
+                record.second = true;
+                break;
+            }
+        }
+        bool released_front = false;
+        while (!records.empty() && records.front().second) {
+            records.pop_front();
+            released_front = true;
+        }
+        if (released_front) {
+            update_read_pos();
+        }
+        if (!reading && records.empty() && slot) {
+            leave();
+        }
+    }
+
+    std::unique_ptr<Ring> ring;
+    std::mutex mutex;
+    Ring::Consumer *slot = nullptr;
+    uint64_t next_pos    = 0;
+    bool reading         = false;
+    bool failed          = false;
+    // Position of the records being transferred, and whether they have been released
+    std::deque<std::pair<uint64_t, bool>> records;
+};
+
+SharedMemoryRawDataProducer::SharedMemoryRawDataProducer(const std::string &name) :
+    state_(std::make_shared<State>(Ring::open(name))) {
+    // the header size is read once, as the control block may be modified by another process after its validation
+    const auto &control           = state_->ring->control();
+    const std::size_t header_size = control.header_size;
+    if (header_size > Ring::kMaxHeaderSize) {
+        throw HalException(HalErrorCode::InternalInitializationError,
+                           "Invalid header size in the shared memory stream \"" + name + "\".");
+    }
+    std::istringstream header_stream(std::string(control.header, header_size));
+    header_ = RawFileHeader(header_stream);
+}
+
+SharedMemoryRawDataProducer::~SharedMemoryRawDataProducer() {}
+
+const RawFileHeader &SharedMemoryRawDataProducer::get_header() const {
+    return header_;
+}
+
+std::vector<std::string> SharedMemoryRawDataProducer::list() {
+    return Ring::list();
+}
+
+void SharedMemoryRawDataProducer::run_impl(const DataTransfer &data_transfer) {
+    auto state          = state_;
+    const Ring &ring    = *state->ring;
+    const auto &control = ring.control();
+    const uint64_t capacity = ring.capacity();
+    const uint64_t mask     = capacity - 1;
+
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->failed) {
+            return;
+        }
+        if (!state->slot && !state->join()) {
+            MV_HAL_LOG_ERROR() << "Too many consumers of the shared memory stream, at most" << Ring::kMaxConsumers
+                               << "are supported";
+            return;
+        }
+        state->reading = true;
+    }
+
+    // next_pos is only modified by this thread, it can be read without locking
+    while (!data_transfer.should_stop()) {
+        const uint64_t record_pos = state->next_pos;
+        const uint64_t write_pos  = control.write_pos.load(std::memory_order_acquire);
+        if (record_pos == write_pos) {
+            if (control.closed.load(std::memory_order_acquire) || !Ring::is_process_alive(control.publisher_pid)) {
+                break;
+            }
+            std::this_thread::sleep_for(kPollPeriod);
+            continue;
+        }
+
+        const uint64_t offset = record_pos & mask;
+        const char *record    = ring.data() + offset;
+        Ring::RecordHeader header;
+        std::memcpy(&header, record, sizeof(header));
+
+        // the record must fit in the ring and in the published data, otherwise the stream is corrupted and reading it
+        // further would access memory out of the ring
+        const uint64_t size = header.padding ? capacity - offset : Ring::record_size(header.size);
+        if (write_pos - record_pos < sizeof(header) || size > capacity - offset || size > write_pos - record_pos) {
+            MV_HAL_LOG_ERROR() << "Invalid record in the shared memory stream, stopping";
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->failed = true;
+            break;
+        }
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (header.padding) {
+                state->next_pos += size;
+                if (state->records.empty()) {
+                    state->update_read_pos();
+                }
+                continue;
+            }
+            state->next_pos += size;
+            state->records.emplace_back(record_pos, false);
+        }
+
+        // the buffer points to the record, which is released when the last copy of the buffer is destroyed
+        const auto *data = reinterpret_cast<const DataTransfer::Data *>(record + sizeof(header));
+        std::shared_ptr<const DataTransfer::Data> record_ref(
+            data, [state, record_pos](const DataTransfer::Data *) { state->release(record_pos); });
+        data_transfer.fire_callbacks(DataTransfer::BufferPtr(record_ref, data, header.size));
+    }
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->reading = false;
+    if (state->records.empty() && state->slot) {
+        state->leave();
+    }
+}
+
+} // namespace Metavision
@@ -0,0 +1,120 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "metavision/hal/utils/shared_memory_raw_publisher.h"
+#include "metavision/hal/utils/detail/shared_memory_raw_ring.h"
+
+namespace Metavision {
+
+namespace {
+// Time between two checks of the consumers' positions, when waiting for a slow consumer
+constexpr std::chrono::microseconds kBlockPollPeriod(100);
+} // namespace
+
+using Ring = detail::SharedMemoryRawRing;
+
+SharedMemoryRawPublisher::SharedMemoryRawPublisher(const std::string &name, const RawFileHeader &header,
+                                                   std::size_t capacity, SlowConsumerPolicy policy,
+                                                   uint32_t permissions) :
+    ring_(Ring::create(name, capacity, header.to_string(), static_cast<uint32_t>(policy), permissions)),
+    policy_(policy) {}
+
+SharedMemoryRawPublisher::~SharedMemoryRawPublisher() {}
+
+void SharedMemoryRawPublisher::publish(const DataTransfer::BufferPtr &buffer) {
+    publish(buffer.cbegin(), buffer.cend());
+}
+
+void SharedMemoryRawPublisher::publish(const DataTransfer::Data *begin, const DataTransfer::Data *end) {
+    // large buffers are split, a RAW event may be split in between as when transferred by a DataTransfer
+    const std::size_t max_record_data_size = ring_->capacity() / 4 - sizeof(Ring::RecordHeader);
+    while (begin < end) {
+        const std::size_t size = std::min<std::size_t>(end - begin, max_record_data_size);
+        const uint64_t offset  = write_pos_ & (ring_->capacity() - 1);
+        const uint64_t record  = Ring::record_size(size);
+        const uint64_t padding = (offset + record > ring_->capacity()) ? ring_->capacity() - offset : 0;
+        if (!wait_for_room(write_pos_ + padding + record)) {
+            ring_->control().dropped_bytes.fetch_add(end - begin, std::memory_order_relaxed);
+            return;
+        }
+        if (padding) {
+            const Ring::RecordHeader padding_header{0, 1};
+            std::memcpy(ring_->data() + offset, &padding_header, sizeof(padding_header));
+            write_pos_ += padding;
+        }
+        write_record(begin, size);
+        begin += size;
+    }
+}
+
+void SharedMemoryRawPublisher::write_record(const DataTransfer::Data *data, std::size_t size) {
+    char *record = ring_->data() + (write_pos_ & (ring_->capacity() - 1));
+    const Ring::RecordHeader header{static_cast<uint32_t>(size), 0};
+    std::memcpy(record, &header, sizeof(header));
+    std::memcpy(record + sizeof(header), data, size);
+    write_pos_ += Ring::record_size(size);
+    ring_->control().write_pos.store(write_pos_, std::memory_order_release);
+}
+
+bool SharedMemoryRawPublisher::wait_for_room(uint64_t end_pos) {
+    auto &control = ring_->control();
+    while (true) {
+        uint64_t min_read_pos = write_pos_;
+        for (auto &consumer : control.consumers) {
+            if (consumer.state.load(std::memory_order_acquire) == Ring::Active) {
+                min_read_pos = std::min(min_read_pos, consumer.read_pos.load(std::memory_order_acquire));
+            }
+        }
+        if (end_pos - min_read_pos <= ring_->capacity()) {
+            return true;
+        }
+
+        // the consumers holding the ring may have exited without releasing their slot, and the ones which exited
+        // while joining would hold their slot forever
+        bool released_slot = false;
+        for (auto &consumer : control.consumers) {
+            const uint32_t state = consumer.state.load(std::memory_order_acquire);
+            if ((state == Ring::Joining ||
+                 (state == Ring::Active &&
+                  consumer.read_pos.load(std::memory_order_acquire) + ring_->capacity() < end_pos)) &&
+                Ring::release_dead_consumer(consumer)) {
+                released_slot = released_slot || state == Ring::Active;
+            }
+        }
+        if (released_slot) {
+            continue;
+        }
+
+        if (policy_ == SlowConsumerPolicy::Drop) {
+            return false;
+        }
+        std::this_thread::sleep_for(kBlockPollPeriod);
+    }
+}
+
+std::size_t SharedMemoryRawPublisher::get_num_consumers() const {
+    std::size_t num_consumers = 0;
+    for (const auto &consumer : ring_->control().consumers) {
+        num_consumers += (consumer.state.load(std::memory_order_acquire) == Ring::Active) ? 1 : 0;
+    }
+    return num_consumers;
+}
+
+uint64_t SharedMemoryRawPublisher::get_num_dropped_bytes() const {
+    return ring_->control().dropped_bytes.load(std::memory_order_relaxed);
+}
+
+} // namespace Metavision
@@ -0,0 +1,250 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <new>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "metavision/hal/utils/detail/shared_memory_raw_ring.h"
+#include "metavision/hal/utils/hal_exception.h"
+
+namespace Metavision {
+namespace detail {
+
+namespace {
+
+constexpr uint64_t kMagic          = 0x474e495257415256; // "VRAWRING"
+constexpr uint32_t kVersion        = 1;
+constexpr const char *kNamePrefix  = "mv_raw_";
+constexpr std::size_t kMaxCapacity = std::size_t(1) << 32;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free &&
+                  std::atomic<int64_t>::is_always_lock_free,
+              "Atomics shared between processes must be lock free");
+
+std::string get_object_name(const std::string &name) {
+    return "/" + std::string(kNamePrefix) + name;
+}
+
+} // namespace
+
+std::size_t SharedMemoryRawRing::get_control_size() {
+    // the data area starts on a cache line
+    return (sizeof(Control) + 63) & ~std::size_t(63);
+}
+
+#ifndef _WIN32
+
+SharedMemoryRawRing::SharedMemoryRawRing(const std::string &object_name, void *mapping, std::size_t mapping_size,
+                                         bool owner, uint64_t capacity) :
+    object_name_(object_name),
+    mapping_(mapping),
+    mapping_size_(mapping_size),
+    owner_(owner),
+    control_(static_cast<Control *>(mapping)),
+    data_(static_cast<char *>(mapping) + get_control_size()),
+    capacity_(capacity) {}
+
+SharedMemoryRawRing::~SharedMemoryRawRing() {
+    if (owner_) {
+        control_->closed.store(1, std::memory_order_release);
+        ::shm_unlink(object_name_.c_str());
+    }
+    ::munmap(mapping_, mapping_size_);
+}
+
+std::unique_ptr<SharedMemoryRawRing> SharedMemoryRawRing::create(const std::string &name, std::size_t capacity,
+                                                                 const std::string &header,
+                                                                 uint32_t slow_consumer_policy,
+                                                                 uint32_t permissions) {
+    if (name.empty() || name.find('/') != std::string::npos) {
+        throw HalException(HalErrorCode::InvalidArgument, "Invalid shared memory stream name: \"" + name + "\".");
+    }
+    if (header.size() > kMaxHeaderSize) {
+        throw HalException(HalErrorCode::InvalidArgument, "RAW header too large to be shared.");
+    }
+    if (capacity == 0 || capacity > kMaxCapacity) {
+        throw HalException(HalErrorCode::ValueOutOfRange, "Invalid shared memory ring capacity.");
+    }
+    std::size_t rounded_capacity = kMinCapacity;
+    while (rounded_capacity < capacity) {
+        rounded_capacity <<= 1;
+    }
+
+    const std::string object_name = get_object_name(name);
+    const mode_t mode             = static_cast<mode_t>(permissions & 0777);
+    int fd                        = ::shm_open(object_name.c_str(), O_CREAT | O_EXCL | O_RDWR, mode);
+    if (fd < 0 && errno == EEXIST) {
+        // replaces the ring of a publisher that did not exit cleanly
+        bool publisher_alive = false;
+        try {
+            publisher_alive = is_process_alive(open(name)->control().publisher_pid);
+        } catch (const HalException &) {}
+        if (publisher_alive) {
+            throw HalException(HalErrorCode::OperationNotPermitted,
+                               "A stream is already published with the name \"" + name + "\".");
+        }
+        ::shm_unlink(object_name.c_str());
+        fd = ::shm_open(object_name.c_str(), O_CREAT | O_EXCL | O_RDWR, mode);
+    }
+    if (fd < 0) {
+        throw HalException(HalErrorCode::InternalInitializationError,
+                           "Could not create shared memory object \"" + object_name + "\": " + std::strerror(errno));
+    }
+
+    const std::size_t mapping_size = get_control_size() + rounded_capacity;
+    void *mapping                  = MAP_FAILED;
+    // the permissions are set explicitly, as the mode given to shm_open is restricted by the umask
+    if (::fchmod(fd, mode) == 0 && ::ftruncate(fd, static_cast<off_t>(mapping_size)) == 0) {
+        mapping = ::mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        ::shm_unlink(object_name.c_str());
+        throw HalException(HalErrorCode::InternalInitializationError,
+                           "Could not map shared memory object \"" + object_name + "\".");
+    }
+
+    // the object is zero filled by ftruncate, the magic number is written last so that it is only valid once set up
+    Control *control = new (mapping) Control();
+    control->version              = kVersion;
+    control->slow_consumer_policy = slow_consumer_policy;
+    control->capacity             = rounded_capacity;
+    control->publisher_pid        = get_current_pid();
+    control->header_size          = header.size();
+    std::memcpy(control->header, header.data(), header.size());
+    std::atomic_thread_fence(std::memory_order_release);
+    control->magic = kMagic;
+
+    return std::unique_ptr<SharedMemoryRawRing>(
+        new SharedMemoryRawRing(object_name, mapping, mapping_size, true, rounded_capacity));
+}
+
+std::unique_ptr<SharedMemoryRawRing> SharedMemoryRawRing::open(const std::string &name) {
+    const std::string object_name = get_object_name(name);
+    const int fd                  = ::shm_open(object_name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        throw HalException(HalErrorCode::CameraNotFound, "No stream published with the name \"" + name + "\".");
+    }
+
+    struct stat st;
+    void *mapping = MAP_FAILED;
+    if (::fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) > get_control_size()) {
+        mapping = ::mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw HalException(HalErrorCode::InternalInitializationError,
+                           "Could not map shared memory object \"" + object_name + "\".");
+    }
+
+    const Control &control = *static_cast<const Control *>(mapping);
+    const bool valid_magic = control.magic == kMagic;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // the capacity is validated and kept, the control block is writable by the other processes
+    const uint64_t capacity = control.capacity;
+    std::unique_ptr<SharedMemoryRawRing> ring(
+        new SharedMemoryRawRing(object_name, mapping, st.st_size, false, capacity));
+    if (!valid_magic || control.version != kVersion || capacity < kMinCapacity ||
+        (capacity & (capacity - 1)) != 0 || get_control_size() + capacity != static_cast<std::size_t>(st.st_size) ||
+        control.header_size > kMaxHeaderSize) {
+        throw HalException(HalErrorCode::InternalInitializationError,
+                           "Shared memory object \"" + object_name + "\" is not a valid RAW data ring.");
+    }
+    return ring;
+}
+
+std::vector<std::string> SharedMemoryRawRing::list() {
+    std::vector<std::string> names;
+    // POSIX does not provide a way to list the shared memory objects, they are visible in /dev/shm on Linux
+    std::error_code ec;
+    for (const auto &entry : std::filesystem::directory_iterator("/dev/shm", ec)) {
+        const std::string filename = entry.path().filename().string();
+        if (filename.rfind(kNamePrefix, 0) == 0) {
+            names.emplace_back(filename.substr(std::strlen(kNamePrefix)));
+        }
+    }
+    return names;
+}
+
+bool SharedMemoryRawRing::is_process_alive(int64_t pid) {
+    return ::kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH;
+}
+
+int64_t SharedMemoryRawRing::get_current_pid() {
+    return static_cast<int64_t>(::getpid());
+}
+
+bool SharedMemoryRawRing::release_dead_consumer(Consumer &consumer) {
+    // a joining slot whose process has not set its identifier yet can not be checked
+    const int64_t pid = consumer.pid.load(std::memory_order_acquire);
+    if (pid == 0 || is_process_alive(pid)) {
+        return false;
+    }
+    for (uint32_t state : {static_cast<uint32_t>(Joining), static_cast<uint32_t>(Active)}) {
+        if (consumer.state.compare_exchange_strong(state, Free)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#else
+
+SharedMemoryRawRing::SharedMemoryRawRing(const std::string &object_name, void *mapping, std::size_t mapping_size,
+                                         bool owner, uint64_t capacity) :
+    object_name_(object_name),
+    mapping_(mapping),
+    mapping_size_(mapping_size),
+    owner_(owner),
+    control_(static_cast<Control *>(mapping)),
+    data_(static_cast<char *>(mapping) + get_control_size()),
+    capacity_(capacity) {}
+
+SharedMemoryRawRing::~SharedMemoryRawRing() {}
+
+std::unique_ptr<SharedMemoryRawRing> SharedMemoryRawRing::create(const std::string &, std::size_t,
+                                                                 const std::string &, uint32_t, uint32_t) {
+    throw HalException(HalErrorCode::OperationNotImplemented, "Shared memory streams are not supported on Windows.");
+}
+
+std::unique_ptr<SharedMemoryRawRing> SharedMemoryRawRing::open(const std::string &) {
+    throw HalException(HalErrorCode::OperationNotImplemented, "Shared memory streams are not supported on Windows.");
+}
+
+std::vector<std::string> SharedMemoryRawRing::list() {
+    return {};
+}
+
+bool SharedMemoryRawRing::is_process_alive(int64_t) {
+    return true;
+}
+
+int64_t SharedMemoryRawRing::get_current_pid() {
+    return 0;
+}
+
+bool SharedMemoryRawRing::release_dead_consumer(Consumer &) {
+    return false;
+}
+
+#endif
+
+} // namespace detail
+} // namespace Metavision
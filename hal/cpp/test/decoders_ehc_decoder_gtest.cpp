@@ -0,0 +1,89 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include "metavision/hal/decoders/ehc/ehc_decoder.h"
+
+#include <gtest/gtest.h>
+
+using namespace Metavision;
+
+namespace {
+std::vector<I_Decoder::RawData> make_raw_frames(size_t num_frames, size_t frame_size) {
+    std::vector<I_Decoder::RawData> data(num_frames * frame_size);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<I_Decoder::RawData>((i * 7 + i / frame_size) & 0x7F);
+    }
+    return data;
+}
+} // namespace
+
+TEST(EHCDecoder_GTest, histo3d_full_and_straddling_frames) {
+    // GIVEN a padded histogram decoder and raw data for 5 frames
+    const int width = 13, height = 7;
+    const size_t frame_size = 2 * width * height;
+    Histo3dDecoder decoder(height, width, 4, 4, true);
+    const auto raw_data = make_raw_frames(5, frame_size);
+
+    std::vector<std::vector<uint8_t>> frames;
+    decoder.add_event_frame_callback([&](const RawEventFrameHisto &h) {
+        EXPECT_FALSE(h.get_config().packed);
+        frames.push_back(h.get_data());
+    });
+
+    // WHEN decoding buffers containing several full frames, then frames straddling several buffers
+    const auto *cur = raw_data.data();
+    decoder.decode(cur, cur + 2 * frame_size);
+    cur += 2 * frame_size;
+    for (size_t step : {size_t(1), frame_size / 3, frame_size, frame_size + 5}) {
+        const auto *end = std::min(cur + step, raw_data.data() + raw_data.size());
+        decoder.decode(cur, end);
+        cur = end;
+    }
+    decoder.decode(cur, raw_data.data() + raw_data.size());
+
+    // THEN each frame holds exactly its raw data
+    ASSERT_EQ(5u, frames.size());
+    for (size_t f = 0; f < frames.size(); ++f) {
+        ASSERT_EQ(frame_size, frames[f].size());
+        for (size_t i = 0; i < frame_size; ++i) {
+            ASSERT_EQ(raw_data[f * frame_size + i], frames[f][i]);
+        }
+    }
+}
+
+TEST(EHCDecoder_GTest, diff3d_last_frame_is_not_overwritten_while_referenced) {
+    // GIVEN a diff decoder and raw data for 10 frames
+    const int width = 8, height = 4;
+    const size_t frame_size = width * height;
+    Diff3dDecoder decoder(height, width, 8);
+    const auto raw_data = make_raw_frames(10, frame_size);
+
+    // WHEN decoding frames one by one while keeping references on the last decoded frames
+    std::vector<std::shared_ptr<const RawEventFrameDiff>> kept_frames;
+    for (size_t f = 0; f < 10; ++f) {
+        decoder.decode(raw_data.data() + f * frame_size, raw_data.data() + (f + 1) * frame_size);
+        auto frame = decoder.get_last_frame();
+        ASSERT_NE(nullptr, frame);
+        if (f % 2 == 0) {
+            kept_frames.push_back(frame);
+        }
+    }
+
+    // THEN the frames still referenced hold the data they were decoded from, even though the decoder reuses frames
+    ASSERT_EQ(5u, kept_frames.size());
+    for (size_t k = 0; k < kept_frames.size(); ++k) {
+        const auto &data = kept_frames[k]->get_data();
+        ASSERT_EQ(frame_size, data.size());
+        for (size_t i = 0; i < frame_size; ++i) {
+            ASSERT_EQ(static_cast<int8_t>(raw_data[2 * k * frame_size + i]), data[i]);
+        }
+    }
+}
@@ -247,7 +247,7 @@ TEST_F(Evt21VectorDecoderTest, should_decode_basic_evt21_stream) {
         event_2d(3, 1, 0, true),
     });
 
-    const std::vector<EventCDVector> expected_events = {// base_x, y, polarity, vector_mask, event_timestamp
+    const std::vector<EventCDVector> expected_events = {// base_x, y, p, vector_mask, t
                                                         {2, 1, false, 1U, 0},
                                                         {3, 1, true, 1U, 0}};
 
@@ -261,7 +261,7 @@ TEST_F(Evt21VectorDecoderTest, should_drop_events_before_1st_timehigh) {
         event_2d(5, 4, 0, false),
     });
 
-    const std::vector<EventCDVector> expected_events = {// base_x, y, polarity, vector_mask, event_timestamp
+    const std::vector<EventCDVector> expected_events = {// base_x, y, p, vector_mask, t
                                                         {5, 4, false, 1U, 3 << 6}};
     EXPECT_THAT(events, ContainerEq(expected_events));
 }
@@ -273,7 +273,7 @@ TEST_F(Evt21VectorDecoderTest, should_decode_event_vect) {
         event_2d(10, 6, 0, true, (1 << 14 | 1 << 10 | 1 << 4)),
     });
 
-    const std::vector<EventCDVector> expected_events = {// base_x, y, polarity, vector_mask, event_timestamp
+    const std::vector<EventCDVector> expected_events = {// base_x, y, p, vector_mask, t
                                                         {5, 4, false, (1 << 7 | 1 << 3 | 1), 0},
                                                         {10, 6, true, (1 << 14 | 1 << 10 | 1 << 4), 0}};
 
@@ -290,7 +290,7 @@ TEST_F(Evt21VectorDecoderTest, should_decode_event_timestamps) {
         event_2d(10, 6, 20, true),
     });
 
-    const std::vector<EventCDVector> expected_events = {// base_x, y, polarity, vector_mask, event_timestamp
+    const std::vector<EventCDVector> expected_events = {// base_x, y, p, vector_mask, t
                                                         {5, 4, false, 1U, 5},
                                                         {10, 6, true, 1U, 20},
                                                         {5, 4, false, 1U, (15 << 6) + 5},
@@ -311,7 +311,7 @@ TEST_F(Evt21VectorDecoderTest, should_decode_event_timestamp_loop) {
         event_2d(5, 4, 5, false),
     });
 
-    const std::vector<EventCDVector> expected_events = {// base_x, y, polarity, vector_mask, event_timestamp
+    const std::vector<EventCDVector> expected_events = {// base_x, y, p, vector_mask, t
                                                         {5, 4, false, 1U, 5},
                                                         {5, 4, false, 1U, (1ULL << 34) + 5},
                                                         {5, 4, false, 1U, (2ULL << 34) + 5}
@@ -328,7 +328,7 @@ TEST_F(Evt21VectorDecoderTest, should_decode_negative_32bit_as_unsigned_timehigh
         event_2d(5, 4, 5, false),
     });
 
-    const std::vector<EventCDVector> expected_events = {// base_x, y, polarity, vector_mask, event_timestamp
+    const std::vector<EventCDVector> expected_events = {// base_x, y, p, vector_mask, t
                                                         {5, 4, false, 1U, ((1ULL << 25) << 6) + 5}};
 
     EXPECT_THAT(events, ContainerEq(expected_events));
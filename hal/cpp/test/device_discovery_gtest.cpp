@@ -12,11 +12,15 @@
 #include <iostream>
 #include <fstream>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include "metavision/utils/gtest/gtest_with_tmp_dir.h"
 #include "metavision/utils/gtest/gtest_custom.h"
 #include "metavision/hal/device/device_discovery.h"
 #include "metavision/hal/device/device.h"
+#include "metavision/hal/plugin/plugin.h"
+#include "metavision/hal/plugin/detail/plugin_loader.h"
 #include "metavision/hal/utils/hal_exception.h"
 #include "metavision/hal/utils/raw_file_header.h"
 #include "metavision/hal/facilities/i_hw_identification.h"
@@ -180,6 +184,115 @@ TEST_F(DeviceDiscovery_GTest, open_rawfile_success_with_dummy_test_plugin_and_pl
 #endif
 }
 
+TEST_F(DeviceDiscovery_GTest, open_rawfile_success_with_dummy_test_plugin_and_plugins_manifest) {
+    const std::string dummy_plugin_test_path(HAL_DUMMY_TEST_PLUGIN);
+    const std::string manifest_path = tmpdir_handler_->get_full_path("plugins_manifest.txt");
+    const char *env                 = getenv("MV_HAL_PLUGIN_PATH");
+
+#ifdef _WIN32
+    std::string s("MV_HAL_PLUGIN_PATH=");
+    s += std::string(env ? env : "") + ";" + dummy_plugin_test_path;
+    _putenv(s.c_str());
+    _putenv(("MV_HAL_PLUGIN_MANIFEST=" + manifest_path).c_str());
+#else
+    std::string s(env ? env : "");
+    s += ":" + dummy_plugin_test_path;
+    setenv("MV_HAL_PLUGIN_PATH", s.c_str(), 1);
+    setenv("MV_HAL_PLUGIN_MANIFEST", manifest_path.c_str(), 1);
+#endif
+
+    RawFileHeader header;
+    const std::string plugin_integrator_name("__DummyTestPlugin__");
+    const std::string plugin_name("hal_dummy_test_plugin");
+    const std::string camera_integrator_name("__DummyTestCamera__");
+    header.set_plugin_integrator_name(plugin_integrator_name);
+    header.set_plugin_name(plugin_name);
+    header.set_camera_integrator_name(camera_integrator_name);
+    write_header(header);
+
+    // The first run loads the plugin and fills the manifest, the second one loads the plugin lazily from the manifest
+    for (int run = 0; run < 2; ++run) {
+        DeviceDiscovery::unload_plugins();
+
+        std::unique_ptr<Device> device;
+        ASSERT_NO_THROW(device = DeviceDiscovery::open_raw_file(rawfile_to_log_path_));
+        I_HW_Identification *hw_id = device->get_facility<I_HW_Identification>();
+        ASSERT_EQ(camera_integrator_name, hw_id->get_integrator());
+
+        I_PluginSoftwareInfo *plugin_soft_info = device->get_facility<I_PluginSoftwareInfo>();
+        ASSERT_EQ(plugin_integrator_name, plugin_soft_info->get_plugin_integrator_name());
+        ASSERT_EQ(plugin_name, plugin_soft_info->get_plugin_name());
+
+        std::ifstream manifest(manifest_path);
+        ASSERT_TRUE(manifest.is_open());
+        const std::string content((std::istreambuf_iterator<char>(manifest)), std::istreambuf_iterator<char>());
+        ASSERT_NE(std::string::npos, content.find("\t" + plugin_name + "\t" + plugin_integrator_name + "\t"));
+    }
+
+    DeviceDiscovery::unload_plugins();
+#ifdef _WIN32
+    s = "MV_HAL_PLUGIN_PATH=" + std::string(env ? env : "");
+    _putenv(s.c_str());
+    _putenv("MV_HAL_PLUGIN_MANIFEST=");
+#else
+    setenv("MV_HAL_PLUGIN_PATH", env ? env : "", 1);
+    unsetenv("MV_HAL_PLUGIN_MANIFEST");
+#endif
+}
+
+TEST_F(DeviceDiscovery_GTest, plugin_described_in_manifest_is_loaded_once_when_first_used) {
+    const std::string plugin_name("hal_dummy_test_plugin");
+    const std::string manifest_path = tmpdir_handler_->get_full_path("plugins_manifest_lazy.txt");
+
+    // GIVEN a manifest filled by a first loader, which loads all the plugins to describe them
+    {
+        PluginLoader loader;
+        loader.set_manifest_path(manifest_path);
+        loader.insert_folder(HAL_DUMMY_TEST_PLUGIN);
+        loader.load_plugins();
+        ASSERT_TRUE(loader.is_plugin_loaded(plugin_name));
+    }
+
+    // WHEN a second loader reads the plugins from the manifest
+    PluginLoader loader;
+    loader.set_manifest_path(manifest_path);
+    loader.insert_folder(HAL_DUMMY_TEST_PLUGIN);
+    loader.load_plugins();
+
+    // THEN the plugin is described, but not loaded until one of its discoveries is used
+    bool described = false;
+    for (const auto &description : loader.get_plugin_descriptions()) {
+        described = described || description.name == plugin_name;
+    }
+    ASSERT_TRUE(described);
+    ASSERT_FALSE(loader.is_plugin_loaded(plugin_name));
+
+    auto plugins = loader.get_plugin_list(
+        [&plugin_name](const PluginLoader::PluginDescription &description) { return description.name == plugin_name; });
+    ASSERT_EQ(1u, plugins.size());
+    ASSERT_FALSE(loader.is_plugin_loaded(plugin_name));
+
+    // AND it is loaded once, even when its discoveries are used from several threads at once
+    std::vector<const Plugin *> used_plugins(4, nullptr);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < used_plugins.size(); ++i) {
+        threads.emplace_back([&plugins, &used_plugins, i]() {
+            for (auto &plugin : plugins) {
+                plugin.get_file_discovery_list();
+                used_plugins[i] = &plugin;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    ASSERT_TRUE(loader.is_plugin_loaded(plugin_name));
+    for (auto plugin : used_plugins) {
+        ASSERT_NE(nullptr, plugin);
+        ASSERT_EQ(used_plugins[0], plugin);
+    }
+}
+
 TEST_WITHOUT_CAMERA(DeviceDiscoveryNoF_GTest, open_camera_fails_if_no_camera_plugged) {
     std::unique_ptr<Device> device;
     ASSERT_NO_THROW(device = DeviceDiscovery::open(""));
@@ -0,0 +1,203 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/hal/decoders/evt3/evt3_decoder.h"
+#include "metavision/hal/decoders/evt3/evt3_encoder.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+
+using namespace Metavision;
+
+class Evt3Encoder_GTest : public GTestWithTmpDir {
+protected:
+    static constexpr int kWidth  = 640;
+    static constexpr int kHeight = 480;
+
+    void SetUp() override {
+        path_ = tmpdir_handler_->get_full_path("evt3_encoder.raw");
+    }
+
+    // Encodes the events, merging CD and trigger events in time order, and returns the written raw data
+    std::vector<std::uint16_t> encode(const std::vector<EventCD> &events_cd,
+                                      const std::vector<EventExtTrigger> &events_trigger) {
+        {
+            std::ofstream ofs(path_, std::ios::binary);
+            Evt3Encoder encoder(kWidth);
+            auto it_trigger = events_trigger.cbegin();
+            for (const auto &ev : events_cd) {
+                for (; it_trigger != events_trigger.cend() && it_trigger->t < ev.t; ++it_trigger) {
+                    encoder.encode_event_trigger(ofs, *it_trigger);
+                }
+                encoder.encode_event_cd(ofs, ev);
+            }
+            for (; it_trigger != events_trigger.cend(); ++it_trigger) {
+                encoder.encode_event_trigger(ofs, *it_trigger);
+            }
+            encoder.flush(ofs);
+        }
+        std::ifstream ifs(path_, std::ios::binary);
+        std::vector<char> bytes{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+        std::vector<std::uint16_t> data(bytes.size() / sizeof(std::uint16_t));
+        std::copy(bytes.cbegin(), bytes.cend(), reinterpret_cast<char *>(data.data()));
+        return data;
+    }
+
+    // Decodes the raw data with the robust decoder, checking that it reports no protocol violation other than the
+    // time high words skipped by the encoder across time gaps
+    void decode(const std::vector<std::uint16_t> &data, std::vector<EventCD> &events_cd,
+                std::vector<EventExtTrigger> &events_trigger) {
+        auto cd_decoder      = std::make_shared<I_EventDecoder<EventCD>>();
+        auto trigger_decoder = std::make_shared<I_EventDecoder<EventExtTrigger>>();
+        RobustEVT3Decoder decoder(false, kHeight, kWidth, cd_decoder, trigger_decoder);
+        decoder.add_protocol_violation_callback([](DecoderProtocolViolation violation) {
+            if (violation != DecoderProtocolViolation::NonContinuousTimeHigh) {
+                ADD_FAILURE() << "Protocol violation: " << violation;
+            }
+        });
+        cd_decoder->add_event_buffer_callback(
+            [&](const EventCD *begin, const EventCD *end) { events_cd.insert(events_cd.end(), begin, end); });
+        trigger_decoder->add_event_buffer_callback([&](const EventExtTrigger *begin, const EventExtTrigger *end) {
+            events_trigger.insert(events_trigger.end(), begin, end);
+        });
+        const auto *begin = reinterpret_cast<const I_Decoder::RawData *>(data.data());
+        decoder.decode(begin, begin + data.size() * sizeof(std::uint16_t));
+    }
+
+    static void sort_by_time_and_position(std::vector<EventCD> &events) {
+        std::sort(events.begin(), events.end(), [](const EventCD &ev1, const EventCD &ev2) {
+            return std::tie(ev1.t, ev1.y, ev1.p, ev1.x) < std::tie(ev2.t, ev2.y, ev2.p, ev2.x);
+        });
+    }
+
+    std::string path_;
+};
+
+TEST_F(Evt3Encoder_GTest, encode_decode_sparse_and_bursty_events) {
+    // GIVEN sparse events, runs of events on rows (including at the right edge of the sensor and with duplicates),
+    // trigger events, and time gaps of several time high periods
+    std::vector<EventCD> events_cd;
+    std::vector<EventExtTrigger> events_trigger;
+    std::mt19937 rng(42);
+    timestamp t = 100;
+    for (int i = 0; i < 2000; ++i) {
+        t += rng() % 50;
+        if (i % 100 == 0) {
+            t += 20000;
+            events_trigger.emplace_back(i % 2, t, 0);
+        }
+        if (i % 10 == 0) {
+            const unsigned short y  = rng() % kHeight;
+            const short p           = rng() % 2;
+            const unsigned short x0 = (i % 30 == 0) ? kWidth - 40 : rng() % (kWidth - 64);
+            for (unsigned short x = x0; x < std::min<int>(x0 + 64, kWidth); x += 1 + rng() % 3) {
+                events_cd.emplace_back(x, y, p, t);
+            }
+            events_cd.emplace_back(x0, y, p, t);
+        } else {
+            events_cd.emplace_back(rng() % kWidth, rng() % kHeight, rng() % 2, t);
+        }
+    }
+
+    // WHEN we encode and decode them
+    const auto data = encode(events_cd, events_trigger);
+    std::vector<EventCD> decoded_cd;
+    std::vector<EventExtTrigger> decoded_trigger;
+    decode(data, decoded_cd, decoded_trigger);
+
+    // THEN the same events are decoded, the CD events of a timestamp being ordered by position
+    sort_by_time_and_position(events_cd);
+    sort_by_time_and_position(decoded_cd);
+    ASSERT_EQ(events_cd.size(), decoded_cd.size());
+    for (size_t i = 0; i < events_cd.size(); ++i) {
+        ASSERT_EQ(events_cd[i].x, decoded_cd[i].x);
+        ASSERT_EQ(events_cd[i].y, decoded_cd[i].y);
+        ASSERT_EQ(events_cd[i].p, decoded_cd[i].p);
+        ASSERT_EQ(events_cd[i].t, decoded_cd[i].t);
+    }
+    ASSERT_EQ(events_trigger.size(), decoded_trigger.size());
+    for (size_t i = 0; i < events_trigger.size(); ++i) {
+        ASSERT_EQ(events_trigger[i].id, decoded_trigger[i].id);
+        ASSERT_EQ(events_trigger[i].p, decoded_trigger[i].p);
+        ASSERT_EQ(events_trigger[i].t, decoded_trigger[i].t);
+    }
+}
+
+TEST_F(Evt3Encoder_GTest, runs_of_events_are_encoded_as_vectors) {
+    // GIVEN a full row of events at the same timestamp
+    std::vector<EventCD> events_cd;
+    for (unsigned short x = 0; x < kWidth; ++x) {
+        events_cd.emplace_back(x, 10, 1, 1000);
+    }
+
+    // WHEN we encode them
+    const auto data = encode(events_cd, {});
+
+    // THEN they are encoded as vectors of 32 events: time high, time low, y address, vector base and 3 words per
+    // vector
+    ASSERT_EQ(4u + 3u * (kWidth / 32), data.size());
+    std::vector<EventCD> decoded_cd;
+    std::vector<EventExtTrigger> decoded_trigger;
+    decode(data, decoded_cd, decoded_trigger);
+    ASSERT_EQ(events_cd.size(), decoded_cd.size());
+}
+
+TEST_F(Evt3Encoder_GTest, long_time_gaps_are_encoded_with_two_time_high_words_per_time_loop) {
+    // GIVEN events separated by time gaps spanning several EVT3 time loops of 2^24 us, the first one starting near
+    // the end of a loop and the second one near its beginning
+    const timestamp loop_duration = timestamp(1) << 24;
+    std::vector<EventCD> events_cd{EventCD(1, 2, 0, loop_duration - 5000), EventCD(3, 4, 1, 6 * loop_duration + 100),
+                                   EventCD(5, 6, 0, 9 * loop_duration + 12345)};
+    std::vector<EventExtTrigger> events_trigger{EventExtTrigger(1, 7 * loop_duration + 4096 * 3 + 1, 0)};
+
+    // WHEN we encode them
+    const auto data = encode(events_cd, events_trigger);
+
+    // THEN the time high words in between are skipped: at most the last time high word of a loop and the first one of
+    // the next loop are written for each of the 9 time loops, plus the first one and those of the timestamps
+    const auto num_timehigh = std::count_if(data.cbegin(), data.cend(), [](std::uint16_t word) {
+        return (word >> 12) == static_cast<std::uint16_t>(Evt3EventTypes_4bits::EVT_TIME_HIGH);
+    });
+    ASSERT_LE(num_timehigh, 2 * 9 + 4);
+
+    // AND the events are decoded with their timestamps
+    std::vector<EventCD> decoded_cd;
+    std::vector<EventExtTrigger> decoded_trigger;
+    decode(data, decoded_cd, decoded_trigger);
+    ASSERT_EQ(events_cd.size(), decoded_cd.size());
+    for (size_t i = 0; i < events_cd.size(); ++i) {
+        ASSERT_EQ(events_cd[i].x, decoded_cd[i].x);
+        ASSERT_EQ(events_cd[i].t, decoded_cd[i].t);
+    }
+    ASSERT_EQ(1u, decoded_trigger.size());
+    ASSERT_EQ(events_trigger[0].t, decoded_trigger[0].t);
+}
+
+TEST_F(Evt3Encoder_GTest, throws_on_non_monotonic_time) {
+    // GIVEN an encoder that encoded an event
+    std::ofstream ofs(path_, std::ios::binary);
+    Evt3Encoder encoder(kWidth);
+    encoder.encode_event_cd(ofs, EventCD(0, 0, 0, 1000));
+
+    // WHEN we encode an older event
+    // THEN it throws
+    ASSERT_THROW(encoder.encode_event_cd(ofs, EventCD(0, 0, 0, 999)), std::runtime_error);
+    ASSERT_THROW(encoder.encode_event_trigger(ofs, EventExtTrigger(0, 999, 0)), std::runtime_error);
+}
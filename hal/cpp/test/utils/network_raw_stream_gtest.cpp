@@ -0,0 +1,330 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "metavision/hal/utils/data_transfer.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/network_raw_data_producer.h"
+#include "metavision/hal/utils/network_raw_stream_server.h"
+#include "metavision/hal/utils/raw_file_header.h"
+#include "metavision/hal/utils/detail/network_raw_stream_protocol.h"
+
+using namespace Metavision;
+
+namespace {
+
+// Client of a network stream, storing the transferred data
+class Client {
+public:
+    Client(uint16_t port, bool start = true) :
+        producer_(std::make_shared<NetworkRawDataProducer>("127.0.0.1", port)), transfer_(producer_) {
+        transfer_.add_new_buffer_callback([this](const DataTransfer::BufferPtr &buffer) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (producer_->transferred_buffer_follows_dropped_data()) {
+                dropped_data_offsets_.push_back(data_.size());
+            }
+            data_.insert(data_.end(), buffer.cbegin(), buffer.cend());
+        });
+        if (start) {
+            transfer_.start();
+        }
+    }
+
+    void start() {
+        transfer_.start();
+    }
+
+    bool stopped() const {
+        return transfer_.stopped();
+    }
+
+    std::vector<uint8_t> data() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return data_;
+    }
+
+    // Offsets in the data of the buffers received after data was dropped
+    std::vector<std::size_t> dropped_data_offsets() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return dropped_data_offsets_;
+    }
+
+    const NetworkRawDataProducer &producer() const {
+        return *producer_;
+    }
+
+private:
+    std::shared_ptr<NetworkRawDataProducer> producer_;
+    DataTransfer transfer_;
+    std::mutex mutex_;
+    std::vector<uint8_t> data_;
+    std::vector<std::size_t> dropped_data_offsets_;
+};
+
+template<typename Predicate>
+bool wait_for(Predicate predicate) {
+    for (int i = 0; i < 5000 && !predicate(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return predicate();
+}
+
+// Data looking like an events stream: mostly small increments, with some noise
+std::vector<uint8_t> make_data(std::size_t size, unsigned seed = 0) {
+    std::mt19937 generator(seed);
+    std::vector<uint8_t> data(size);
+    uint16_t value = 0;
+    for (std::size_t i = 0; i + 1 < size; i += 2) {
+        value += generator() % 4;
+        data[i]     = static_cast<uint8_t>(value);
+        data[i + 1] = static_cast<uint8_t>(value >> 8);
+    }
+    return data;
+}
+
+} // namespace
+
+class NetworkRawStream_GTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        header_.set_field("format", "EVT3;height=720;width=1280");
+        header_.set_field("serial_number", "00001234");
+        config_.address_ = "127.0.0.1";
+    }
+
+    void publish(NetworkRawStreamServer &server, std::size_t num_buffers, std::vector<uint8_t> &published) {
+        for (std::size_t i = 0; i < num_buffers; ++i) {
+            const auto data = make_data((i * 1237) % 40000 + 1, static_cast<unsigned>(i));
+            server.publish(data.data(), data.data() + data.size());
+            published.insert(published.end(), data.begin(), data.end());
+        }
+    }
+
+    RawFileHeader header_;
+    NetworkRawStreamServerConfig config_;
+};
+
+TEST(NetworkRawStreamProtocol_GTest, compresses_and_decompresses_data) {
+    namespace Protocol = detail::RawStreamProtocol;
+    std::vector<uint8_t> random(10000);
+    std::mt19937 generator(42);
+    for (auto &byte : random) {
+        byte = static_cast<uint8_t>(generator());
+    }
+    const std::vector<std::vector<uint8_t>> inputs = {
+        {}, {1, 2, 3}, std::vector<uint8_t>(100000, 7), make_data(100000), random};
+
+    for (const auto &input : inputs) {
+        std::vector<uint8_t> compressed(Protocol::lz_compress_bound(input.size()));
+        compressed.resize(Protocol::lz_compress(input.data(), input.size(), compressed.data()));
+        std::vector<uint8_t> output(input.size());
+        ASSERT_TRUE(Protocol::lz_decompress(compressed.data(), compressed.size(), output.data(), output.size()));
+        EXPECT_EQ(input, output);
+    }
+
+    // the repetitive data is much smaller once compressed
+    const auto input = std::vector<uint8_t>(100000, 7);
+    std::vector<uint8_t> compressed(Protocol::lz_compress_bound(input.size()));
+    compressed.resize(Protocol::lz_compress(input.data(), input.size(), compressed.data()));
+    EXPECT_LT(compressed.size(), input.size() / 100);
+
+    // corrupted or truncated data is detected
+    std::vector<uint8_t> output(input.size());
+    EXPECT_FALSE(Protocol::lz_decompress(compressed.data(), compressed.size() / 2, output.data(), output.size()));
+    EXPECT_FALSE(Protocol::lz_decompress(compressed.data(), compressed.size(), output.data(), output.size() - 1));
+    compressed[3] = 0xFF; // offset of the first match, beyond the start of the data
+    EXPECT_FALSE(Protocol::lz_decompress(compressed.data(), compressed.size(), output.data(), output.size()));
+}
+
+TEST(NetworkRawDataProducer_GTest, parses_uris) {
+    std::string host;
+    uint16_t port = 0;
+    EXPECT_TRUE(NetworkRawDataProducer::parse_uri("tcp://localhost:1234", host, port));
+    EXPECT_EQ("localhost", host);
+    EXPECT_EQ(1234, port);
+    EXPECT_TRUE(NetworkRawDataProducer::parse_uri("tcp://[::1]:80", host, port));
+    EXPECT_EQ("::1", host);
+    EXPECT_EQ(80, port);
+
+    EXPECT_FALSE(NetworkRawDataProducer::parse_uri("localhost:1234", host, port));
+    EXPECT_FALSE(NetworkRawDataProducer::parse_uri("tcp://localhost", host, port));
+    EXPECT_FALSE(NetworkRawDataProducer::parse_uri("tcp://localhost:", host, port));
+    EXPECT_FALSE(NetworkRawDataProducer::parse_uri("tcp://:1234", host, port));
+    EXPECT_FALSE(NetworkRawDataProducer::parse_uri("tcp://localhost:70000", host, port));
+    EXPECT_FALSE(NetworkRawDataProducer::parse_uri("tcp://localhost:12a", host, port));
+}
+
+TEST_F(NetworkRawStream_GTest, streams_published_data) {
+    NetworkRawStreamServer server(header_, config_);
+    Client client(server.get_port());
+    EXPECT_EQ(header_.get_field("format"), client.producer().get_header().get_field("format"));
+    EXPECT_EQ(header_.get_field("serial_number"), client.producer().get_header().get_field("serial_number"));
+    ASSERT_TRUE(wait_for([&] { return server.get_num_clients() == 1; }));
+
+    std::vector<uint8_t> published;
+    publish(server, 100, published);
+    ASSERT_TRUE(wait_for([&] { return client.data().size() == published.size(); }));
+    EXPECT_EQ(published, client.data());
+
+    // the statistics are updated once the data has been sent
+    ASSERT_TRUE(wait_for([&] { return server.get_statistics().sent_raw_bytes == published.size(); }));
+    const auto server_stats = server.get_statistics();
+    EXPECT_EQ(published.size(), server_stats.published_bytes);
+    EXPECT_EQ(published.size(), server_stats.sent_raw_bytes);
+    EXPECT_EQ(0, server_stats.dropped_bytes);
+    // the buffers are batched in frames
+    EXPECT_LT(server_stats.sent_frames, 100);
+
+    const auto client_stats = client.producer().get_statistics();
+    EXPECT_EQ(published.size(), client_stats.received_raw_bytes);
+    EXPECT_EQ(server_stats.sent_bytes, client_stats.received_bytes);
+    EXPECT_EQ(server_stats.sent_frames, client_stats.received_frames);
+    EXPECT_LE(client_stats.last_latency_us, client_stats.max_latency_us);
+    EXPECT_LE(client_stats.mean_latency_us, client_stats.max_latency_us);
+}
+
+TEST_F(NetworkRawStream_GTest, streams_compressed_data) {
+    config_.compression_ = true;
+    NetworkRawStreamServer server(header_, config_);
+    Client client(server.get_port());
+    ASSERT_TRUE(wait_for([&] { return server.get_num_clients() == 1; }));
+
+    std::vector<uint8_t> published;
+    publish(server, 100, published);
+    ASSERT_TRUE(wait_for([&] { return client.data().size() == published.size(); }));
+    EXPECT_EQ(published, client.data());
+
+    // the statistics are updated once the data has been sent
+    ASSERT_TRUE(wait_for([&] { return server.get_statistics().sent_raw_bytes == published.size(); }));
+    const auto server_stats = server.get_statistics();
+    EXPECT_LT(server_stats.sent_bytes, server_stats.sent_raw_bytes);
+    const auto client_stats = client.producer().get_statistics();
+    EXPECT_EQ(published.size(), client_stats.received_raw_bytes);
+    EXPECT_EQ(server_stats.sent_bytes, client_stats.received_bytes);
+}
+
+TEST_F(NetworkRawStream_GTest, streams_to_several_clients) {
+    NetworkRawStreamServer server(header_, config_);
+    std::vector<std::unique_ptr<Client>> clients;
+    for (int i = 0; i < 3; ++i) {
+        clients.push_back(std::make_unique<Client>(server.get_port()));
+    }
+    ASSERT_TRUE(wait_for([&] { return server.get_num_clients() == 3; }));
+
+    // large buffers are split into several frames without being copied
+    auto buffer                    = std::make_shared<std::vector<uint8_t>>(make_data(3 * config_.batch_size_ + 17));
+    std::vector<uint8_t> published = *buffer;
+    server.publish(DataTransfer::make_buffer_ptr(buffer));
+    publish(server, 10, published);
+    for (auto &client : clients) {
+        ASSERT_TRUE(wait_for([&] { return client->data().size() == published.size(); }));
+        EXPECT_EQ(published, client->data());
+    }
+    EXPECT_TRUE(wait_for([&] { return server.get_statistics().sent_raw_bytes == 3 * published.size(); }));
+
+    clients.pop_back();
+    EXPECT_TRUE(wait_for([&] { return server.get_num_clients() == 2; }));
+}
+
+TEST_F(NetworkRawStream_GTest, stops_clients_when_the_server_closes) {
+    auto server = std::make_unique<NetworkRawStreamServer>(header_, config_);
+    Client client(server->get_port());
+    ASSERT_TRUE(wait_for([&] { return server->get_num_clients() == 1; }));
+
+    // the queued data is sent before closing
+    std::vector<uint8_t> published;
+    publish(*server, 10, published);
+    server.reset();
+
+    EXPECT_TRUE(wait_for([&] { return client.stopped(); }));
+    EXPECT_EQ(published, client.data());
+}
+
+TEST_F(NetworkRawStream_GTest, drops_whole_buffers_for_a_stalled_client) {
+    // GIVEN a server with a small queue and a client that does not read the stream yet
+    config_.batch_size_       = 16 * 1024;
+    config_.max_queued_bytes_ = 256 * 1024;
+    NetworkRawStreamServer server(header_, config_);
+    Client client(server.get_port(), false);
+    ASSERT_TRUE(wait_for([&] { return server.get_num_clients() == 1; }));
+
+    // WHEN much more data than the queue and the socket buffers can hold is published, in buffers that are split in
+    // several frames and tagged with their index
+    constexpr uint32_t num_buffers = 1000;
+    std::vector<std::size_t> sizes;
+    for (uint32_t i = 0; i < num_buffers; ++i) {
+        std::vector<uint8_t> buffer(20000 + (i * 7919) % 20000);
+        for (std::size_t j = 0; j < buffer.size(); ++j) {
+            buffer[j] = static_cast<uint8_t>(i + j);
+        }
+        std::memcpy(buffer.data(), &i, sizeof(i));
+        server.publish(buffer.data(), buffer.data() + buffer.size());
+        sizes.push_back(buffer.size());
+    }
+    client.start();
+
+    // THEN data is dropped for this client
+    ASSERT_TRUE(wait_for([&] {
+        const auto stats = server.get_statistics();
+        return stats.sent_raw_bytes + stats.dropped_bytes == stats.published_bytes;
+    }));
+    const auto server_stats = server.get_statistics();
+    ASSERT_LT(0, server_stats.dropped_buffers);
+    ASSERT_TRUE(wait_for([&] { return client.data().size() == server_stats.sent_raw_bytes; }));
+
+    // THEN the client receives whole buffers, and is notified of each discontinuity
+    const auto data                 = client.data();
+    const auto dropped_data_offsets = client.dropped_data_offsets();
+    std::size_t offset = 0, num_received_buffers = 0, num_gaps = 0;
+    int64_t last_index = -1;
+    while (offset < data.size()) {
+        uint32_t index;
+        ASSERT_LE(offset + sizeof(index), data.size());
+        std::memcpy(&index, data.data() + offset, sizeof(index));
+        ASSERT_LT(index, num_buffers);
+        ASSERT_LT(last_index, static_cast<int64_t>(index));
+        ASSERT_LE(offset + sizes[index], data.size());
+        for (std::size_t j = sizeof(index); j < sizes[index]; ++j) {
+            ASSERT_EQ(static_cast<uint8_t>(index + j), data[offset + j]);
+        }
+        const bool flagged = std::find(dropped_data_offsets.begin(), dropped_data_offsets.end(), offset) !=
+                             dropped_data_offsets.end();
+        ASSERT_EQ(index != last_index + 1, flagged) << "buffer " << index;
+        num_gaps += flagged;
+        last_index = index;
+        offset += sizes[index];
+        ++num_received_buffers;
+    }
+    EXPECT_EQ(num_buffers, num_received_buffers + server_stats.dropped_buffers);
+    EXPECT_EQ(dropped_data_offsets.size(), num_gaps);
+    EXPECT_EQ(num_gaps, client.producer().get_statistics().frames_following_dropped_data);
+}
+
+TEST_F(NetworkRawStream_GTest, fails_to_connect_without_server) {
+    uint16_t port;
+    {
+        NetworkRawStreamServer server(header_, config_);
+        port = server.get_port();
+    }
+    EXPECT_THROW(NetworkRawDataProducer("127.0.0.1", port), HalException);
+}
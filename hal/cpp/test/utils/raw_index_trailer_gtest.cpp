@@ -0,0 +1,223 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "metavision/hal/decoders/evt2/evt2_decoder.h"
+#include "metavision/hal/decoders/evt2/evt2_encoder.h"
+#include "metavision/hal/decoders/evt3/evt3_decoder.h"
+#include "metavision/hal/decoders/evt3/evt3_encoder.h"
+#include "metavision/hal/facilities/i_event_decoder.h"
+#include "metavision/hal/utils/file_raw_data_producer.h"
+#include "metavision/hal/utils/raw_file_header.h"
+#include "metavision/hal/utils/raw_index_trailer.h"
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+
+using namespace Metavision;
+
+namespace {
+
+constexpr int kWidth  = 640;
+constexpr int kHeight = 480;
+
+std::vector<EventCD> make_events(std::size_t num_events, timestamp first_ts, timestamp duration) {
+    std::mt19937 generator(42);
+    std::vector<EventCD> events;
+    for (std::size_t i = 0; i < num_events; ++i) {
+        events.emplace_back(generator() % kWidth, generator() % kHeight, generator() % 2,
+                            first_ts + static_cast<timestamp>(i * duration / num_events));
+    }
+    return events;
+}
+
+std::unique_ptr<I_EventsStreamDecoder> make_decoder(const std::string &format,
+                                                    const std::shared_ptr<I_EventDecoder<EventCD>> &cd_decoder) {
+    if (format == "EVT2") {
+        return std::make_unique<EVT2Decoder>(false, cd_decoder);
+    }
+    return make_evt3_decoder(false, kHeight, kWidth, cd_decoder);
+}
+
+std::vector<EventCD> decode(const std::string &format, const char *begin, const char *end,
+                            timestamp first_ts = -1) {
+    auto cd_decoder = std::make_shared<I_EventDecoder<EventCD>>();
+    std::vector<EventCD> events;
+    cd_decoder->add_event_buffer_callback(
+        [&events](const EventCD *begin, const EventCD *end) { events.insert(events.end(), begin, end); });
+    auto decoder = make_decoder(format, cd_decoder);
+    if (first_ts >= 0) {
+        decoder->reset_last_timestamp(first_ts);
+    }
+    decoder->decode(reinterpret_cast<const uint8_t *>(begin), reinterpret_cast<const uint8_t *>(end));
+    return events;
+}
+
+std::string read_file(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+} // namespace
+
+class RawIndexTrailer_GTest : public GTestWithTmpDir {
+protected:
+    // Writes a RAW file of the given format holding events_, and returns the size of its header
+    std::size_t write_raw_file(const std::string &format) {
+        RawFileHeader header;
+        header.set_field("format", format + ";height=" + std::to_string(kHeight) + ";width=" + std::to_string(kWidth));
+        std::ofstream file(path_, std::ios::binary);
+        file << header;
+        const std::size_t header_size = file.tellp();
+        if (format == "EVT2") {
+            Evt2Encoder encoder;
+            for (const auto &ev : events_) {
+                encoder.encode_event_cd(file, ev);
+            }
+        } else {
+            Evt3Encoder encoder(kWidth);
+            for (const auto &ev : events_) {
+                encoder.encode_event_cd(file, ev);
+            }
+            encoder.flush(file);
+        }
+        file.close();
+        header_ = header;
+        return header_size;
+    }
+
+    // Indexes the data of the RAW file, added by chunks not aligned on the RAW events, and appends the trailer
+    bool append_trailer(std::size_t header_size) {
+        const auto data = read_file(path_).substr(header_size);
+        RawIndexTrailerWriter writer(header_, header_size);
+        EXPECT_TRUE(writer.is_supported());
+        const auto *ptr = reinterpret_cast<const uint8_t *>(data.data());
+        for (std::size_t pos = 0; pos < data.size(); pos += 1001) {
+            writer.add_data(ptr + pos, ptr + std::min(pos + 1001, data.size()));
+        }
+        EXPECT_EQ(data.size(), writer.get_data_size());
+        std::ofstream file(path_, std::ios::binary | std::ios::app);
+        return writer.write(file);
+    }
+
+    const std::string path_            = tmpdir_handler_->get_full_path("recording.raw");
+    const std::vector<EventCD> events_ = make_events(100000, 123456, 50000);
+    RawFileHeader header_;
+};
+
+TEST_F(RawIndexTrailer_GTest, trailer_indexes_the_data_and_is_ignored_by_the_decoders) {
+    for (const std::string format : {"EVT2", "EVT3"}) {
+        SCOPED_TRACE(format);
+        const auto header_size = write_raw_file(format);
+        const auto data        = read_file(path_).substr(header_size);
+        RawIndexTrailer trailer;
+        {
+            std::ifstream file(path_, std::ios::binary);
+            EXPECT_FALSE(read_raw_index_trailer(file, trailer));
+        }
+
+        ASSERT_TRUE(append_trailer(header_size));
+        const auto file_content = read_file(path_);
+        ASSERT_GT(file_content.size(), header_size + data.size());
+        ASSERT_EQ(0, (file_content.size() - header_size - data.size()) % 8);
+
+        // readers not knowing about the trailer decode the same events
+        const auto events = decode(format, data.data(), data.data() + data.size());
+        ASSERT_EQ(events_.size(), events.size());
+        const auto events_with_trailer =
+            decode(format, file_content.data() + header_size, file_content.data() + file_content.size());
+        ASSERT_EQ(events.size(), events_with_trailer.size());
+        EXPECT_TRUE(std::equal(events.begin(), events.end(), events_with_trailer.begin(),
+                               [](const EventCD &ev1, const EventCD &ev2) {
+                                   return ev1.x == ev2.x && ev1.y == ev2.y && ev1.p == ev2.p && ev1.t == ev2.t;
+                               }));
+
+        std::ifstream file(path_, std::ios::binary);
+        RawFileHeader header(file);
+        const auto pos = file.tellg();
+        ASSERT_TRUE(read_raw_index_trailer(file, trailer));
+        EXPECT_EQ(pos, file.tellg());
+        EXPECT_EQ(header_size + data.size(), trailer.data_end_pos_);
+        EXPECT_EQ(2000, trailer.bookmark_period_us_);
+        ASSERT_GE(trailer.bookmarks_.size(), 25);
+
+        // decoding from a bookmark gives the events from its position
+        timestamp last_ts = -1;
+        for (const auto &bookmark : trailer.bookmarks_) {
+            ASSERT_LE(last_ts, bookmark.timestamp_);
+            last_ts = bookmark.timestamp_;
+            if (bookmark.timestamp_ < 0) {
+                continue;
+            }
+            ASSERT_GE(bookmark.byte_offset_, header_size);
+            ASSERT_LT(bookmark.byte_offset_, trailer.data_end_pos_);
+            const auto events_from_bookmark =
+                decode(format, file_content.data() + bookmark.byte_offset_,
+                       file_content.data() + trailer.data_end_pos_, bookmark.timestamp_ + trailer.ts_shift_us_);
+            ASSERT_FALSE(events_from_bookmark.empty());
+            ASSERT_LE(events_from_bookmark.size(), events.size());
+            const auto offset = events.size() - events_from_bookmark.size();
+            EXPECT_GE(events[offset].t, bookmark.timestamp_ + trailer.ts_shift_us_);
+            EXPECT_EQ(events[offset].t, events_from_bookmark.front().t);
+            EXPECT_EQ(events.back().t, events_from_bookmark.back().t);
+        }
+    }
+}
+
+TEST_F(RawIndexTrailer_GTest, file_reader_stops_before_the_trailer) {
+    const auto header_size = write_raw_file("EVT3");
+    const auto data_end    = std::filesystem::file_size(path_);
+    ASSERT_TRUE(append_trailer(header_size));
+
+    auto stream = std::make_unique<std::ifstream>(path_, std::ios::binary);
+    RawFileHeader header(*stream);
+    FileRawDataProducer producer(std::move(stream), 2, RawFileConfig());
+    std::streampos data_start_pos, data_end_pos;
+    producer.get_seek_range(data_start_pos, data_end_pos);
+    EXPECT_EQ(header_size, data_start_pos);
+    EXPECT_EQ(data_end, data_end_pos);
+}
+
+TEST_F(RawIndexTrailer_GTest, invalid_trailers_are_ignored) {
+    const auto header_size = write_raw_file("EVT2");
+    ASSERT_TRUE(append_trailer(header_size));
+    auto content = read_file(path_);
+
+    RawIndexTrailer trailer;
+    std::istringstream valid(content);
+    EXPECT_TRUE(read_raw_index_trailer(valid, trailer));
+
+    // data written after the trailer
+    std::istringstream appended(content + std::string(8, '\0'));
+    EXPECT_FALSE(read_raw_index_trailer(appended, trailer));
+
+    // corrupted trailer
+    content[content.size() - 40] = 0;
+    std::istringstream corrupted(content);
+    EXPECT_FALSE(read_raw_index_trailer(corrupted, trailer));
+
+    // unsupported format or no data
+    RawFileHeader header;
+    header.set_field("format", "EVT4;height=480;width=640");
+    EXPECT_FALSE(RawIndexTrailerWriter(header, 0).is_supported());
+    header.set_field("format", "EVT2");
+    RawIndexTrailerWriter writer(header, 0);
+    std::ostringstream output;
+    EXPECT_FALSE(writer.write(output));
+    EXPECT_TRUE(output.str().empty());
+}
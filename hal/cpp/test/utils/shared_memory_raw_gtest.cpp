@@ -0,0 +1,293 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <numeric>
+#include <memory>
+#include <string>
+#include <thread>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include "metavision/hal/utils/data_transfer.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/hal/utils/raw_file_header.h"
+#include "metavision/hal/utils/shared_memory_raw_data_producer.h"
+#include "metavision/hal/utils/shared_memory_raw_publisher.h"
+#include "metavision/hal/utils/detail/shared_memory_raw_ring.h"
+
+using namespace Metavision;
+
+namespace {
+
+// Consumer of a shared memory stream, storing or holding the transferred buffers
+class Consumer {
+public:
+    Consumer(const std::string &name, bool hold_buffers = false) :
+        producer_(std::make_shared<SharedMemoryRawDataProducer>(name)), transfer_(producer_) {
+        transfer_.add_new_buffer_callback([this, hold_buffers](const DataTransfer::BufferPtr &buffer) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            data_.insert(data_.end(), buffer.cbegin(), buffer.cend());
+            if (hold_buffers) {
+                held_buffers_.push_back(buffer);
+            }
+        });
+    }
+
+    void start() {
+        transfer_.start();
+    }
+
+    void stop() {
+        transfer_.stop();
+    }
+
+    bool stopped() const {
+        return transfer_.stopped();
+    }
+
+    void release_buffers() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        held_buffers_.clear();
+    }
+
+    std::vector<uint8_t> data() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return data_;
+    }
+
+    const RawFileHeader &header() const {
+        return producer_->get_header();
+    }
+
+private:
+    std::shared_ptr<SharedMemoryRawDataProducer> producer_;
+    DataTransfer transfer_;
+    std::mutex mutex_;
+    std::vector<uint8_t> data_;
+    std::vector<DataTransfer::BufferPtr> held_buffers_;
+};
+
+template<typename Predicate>
+bool wait_for(Predicate predicate) {
+    for (int i = 0; i < 2000 && !predicate(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return predicate();
+}
+
+std::vector<uint8_t> make_data(std::size_t size, uint8_t first = 0) {
+    std::vector<uint8_t> data(size);
+    std::iota(data.begin(), data.end(), first);
+    return data;
+}
+
+// Gets the identifier of a process which exited
+int64_t get_dead_pid() {
+    const pid_t pid = ::fork();
+    if (pid == 0) {
+        ::_exit(0);
+    }
+    ::waitpid(pid, nullptr, 0);
+    return pid;
+}
+
+mode_t get_permissions(const std::string &name) {
+    struct stat st;
+    return ::stat(("/dev/shm/mv_raw_" + name).c_str(), &st) == 0 ? (st.st_mode & 0777) : 0;
+}
+
+} // namespace
+
+class SharedMemoryRaw_GTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        name_ = "gtest_" + std::to_string(::getpid()) + "_" +
+                ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        header_.set_field("format", "EVT3;height=720;width=1280");
+        header_.set_field("serial_number", "00001234");
+    }
+
+    std::string name_;
+    RawFileHeader header_;
+};
+
+TEST_F(SharedMemoryRaw_GTest, fans_out_published_data_to_all_consumers) {
+    SharedMemoryRawPublisher publisher(name_, header_, 4096, SharedMemoryRawPublisher::SlowConsumerPolicy::Block);
+    Consumer consumer1(name_), consumer2(name_);
+    EXPECT_EQ(header_.get_field("format"), consumer1.header().get_field("format"));
+    EXPECT_EQ(header_.get_field("serial_number"), consumer2.header().get_field("serial_number"));
+
+    consumer1.start();
+    consumer2.start();
+    ASSERT_TRUE(wait_for([&] { return publisher.get_num_consumers() == 2; }));
+
+    // the buffers are of various sizes, larger than the ring for some of them, so that the records wrap around
+    std::vector<uint8_t> published;
+    for (std::size_t i = 0; i < 64; ++i) {
+        const auto data = make_data((i * 397) % 5000 + 1, static_cast<uint8_t>(i));
+        publisher.publish(data.data(), data.data() + data.size());
+        published.insert(published.end(), data.begin(), data.end());
+    }
+    ASSERT_TRUE(wait_for([&] { return consumer1.data().size() == published.size(); }));
+    ASSERT_TRUE(wait_for([&] { return consumer2.data().size() == published.size(); }));
+    EXPECT_EQ(published, consumer1.data());
+    EXPECT_EQ(published, consumer2.data());
+    EXPECT_EQ(0, publisher.get_num_dropped_bytes());
+
+    consumer1.stop();
+    ASSERT_TRUE(wait_for([&] { return publisher.get_num_consumers() == 1; }));
+}
+
+TEST_F(SharedMemoryRaw_GTest, drops_data_when_a_consumer_holds_the_ring) {
+    SharedMemoryRawPublisher publisher(name_, header_, 4096, SharedMemoryRawPublisher::SlowConsumerPolicy::Drop);
+    Consumer consumer(name_, true);
+    consumer.start();
+    ASSERT_TRUE(wait_for([&] { return publisher.get_num_consumers() == 1; }));
+
+    const auto data = make_data(512);
+    std::size_t num_published = 0;
+    while (publisher.get_num_dropped_bytes() == 0) {
+        publisher.publish(data.data(), data.data() + data.size());
+        ++num_published;
+        ASSERT_LT(num_published, 16);
+    }
+    EXPECT_EQ(data.size(), publisher.get_num_dropped_bytes());
+
+    // once the buffers are released, the data is published again
+    ASSERT_TRUE(wait_for([&] { return consumer.data().size() == (num_published - 1) * data.size(); }));
+    consumer.release_buffers();
+    publisher.publish(data.data(), data.data() + data.size());
+    EXPECT_EQ(data.size(), publisher.get_num_dropped_bytes());
+    EXPECT_TRUE(wait_for([&] { return consumer.data().size() == num_published * data.size(); }));
+}
+
+TEST_F(SharedMemoryRaw_GTest, blocks_until_a_slow_consumer_releases_the_ring) {
+    SharedMemoryRawPublisher publisher(name_, header_, 4096, SharedMemoryRawPublisher::SlowConsumerPolicy::Block);
+    Consumer consumer(name_, true);
+    consumer.start();
+    ASSERT_TRUE(wait_for([&] { return publisher.get_num_consumers() == 1; }));
+
+    const auto data = make_data(512);
+    std::atomic<int> num_published{0};
+    std::thread publishing_thread([&] {
+        for (int i = 0; i < 16; ++i) {
+            publisher.publish(data.data(), data.data() + data.size());
+            ++num_published;
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_LT(num_published, 16);
+    while (num_published < 16) {
+        consumer.release_buffers();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    publishing_thread.join();
+
+    EXPECT_EQ(0, publisher.get_num_dropped_bytes());
+    EXPECT_TRUE(wait_for([&] { return consumer.data().size() == 16 * data.size(); }));
+}
+
+TEST_F(SharedMemoryRaw_GTest, stops_consumers_when_the_publisher_closes) {
+    auto publisher = std::make_unique<SharedMemoryRawPublisher>(name_, header_, 4096);
+    Consumer consumer(name_);
+    consumer.start();
+    ASSERT_TRUE(wait_for([&] { return publisher->get_num_consumers() == 1; }));
+
+    const auto data = make_data(100);
+    publisher->publish(data.data(), data.data() + data.size());
+    publisher.reset();
+
+    EXPECT_TRUE(wait_for([&] { return consumer.stopped(); }));
+    EXPECT_EQ(data, consumer.data());
+}
+
+TEST_F(SharedMemoryRaw_GTest, lists_published_streams) {
+    auto publisher = std::make_unique<SharedMemoryRawPublisher>(name_, header_, 4096);
+    auto names     = SharedMemoryRawDataProducer::list();
+    EXPECT_NE(names.end(), std::find(names.begin(), names.end(), name_));
+
+    EXPECT_THROW(SharedMemoryRawPublisher(name_, header_, 4096), HalException);
+
+    publisher.reset();
+    names = SharedMemoryRawDataProducer::list();
+    EXPECT_EQ(names.end(), std::find(names.begin(), names.end(), name_));
+    EXPECT_THROW(SharedMemoryRawDataProducer producer(name_), HalException);
+}
+
+TEST_F(SharedMemoryRaw_GTest, restricts_the_access_to_the_stream) {
+    // by default, only the user can access the stream, whatever the umask
+    {
+        SharedMemoryRawPublisher publisher(name_, header_, 4096);
+        EXPECT_EQ(0600, get_permissions(name_));
+    }
+
+    const mode_t umask = ::umask(0077);
+    {
+        SharedMemoryRawPublisher publisher(name_, header_, 4096, SharedMemoryRawPublisher::SlowConsumerPolicy::Drop,
+                                           0640);
+        EXPECT_EQ(0640, get_permissions(name_));
+    }
+    ::umask(umask);
+}
+
+TEST_F(SharedMemoryRaw_GTest, reclaims_the_slots_of_consumers_which_exited_while_joining) {
+    SharedMemoryRawPublisher publisher(name_, header_, 4096);
+
+    // all the slots are held by a process which exited while joining the stream
+    auto ring           = detail::SharedMemoryRawRing::open(name_);
+    const auto dead_pid = get_dead_pid();
+    for (auto &slot : ring->control().consumers) {
+        slot.pid.store(dead_pid);
+        slot.state.store(detail::SharedMemoryRawRing::Joining);
+    }
+
+    Consumer consumer(name_);
+    consumer.start();
+    ASSERT_TRUE(wait_for([&] { return publisher.get_num_consumers() == 1; }));
+
+    const auto data = make_data(100);
+    publisher.publish(data.data(), data.data() + data.size());
+    EXPECT_TRUE(wait_for([&] { return consumer.data() == data; }));
+}
+
+TEST_F(SharedMemoryRaw_GTest, rejects_corrupted_streams) {
+    SharedMemoryRawPublisher publisher(name_, header_, 4096);
+    auto ring       = detail::SharedMemoryRawRing::open(name_);
+    auto &control   = ring->control();
+    const auto size = control.header_size;
+
+    // the header size is checked
+    control.header_size = detail::SharedMemoryRawRing::kMaxHeaderSize + 1;
+    EXPECT_THROW(SharedMemoryRawDataProducer producer(name_), HalException);
+    control.header_size = size;
+
+    // a record which does not fit in the ring stops the consumer
+    Consumer consumer(name_);
+    consumer.start();
+    ASSERT_TRUE(wait_for([&] { return publisher.get_num_consumers() == 1; }));
+    const detail::SharedMemoryRawRing::RecordHeader header{static_cast<uint32_t>(ring->capacity()), 0};
+    const uint64_t write_pos = control.write_pos.load();
+    std::memcpy(ring->data() + (write_pos & (ring->capacity() - 1)), &header, sizeof(header));
+    control.write_pos.store(write_pos + detail::SharedMemoryRawRing::kRecordAlignment);
+
+    EXPECT_TRUE(wait_for([&] { return consumer.stopped(); }));
+    EXPECT_TRUE(consumer.data().empty());
+    EXPECT_EQ(0, publisher.get_num_consumers());
+}
@@ -0,0 +1,33 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_PSEE_NETWORK_CAMERA_DISCOVERY_H
+#define METAVISION_HAL_PSEE_NETWORK_CAMERA_DISCOVERY_H
+
+#include "metavision/hal/utils/camera_discovery.h"
+
+namespace Metavision {
+
+/// @brief Opens the RAW data streams sent over TCP by a NetworkRawStreamServer
+///
+/// The streams can not be listed, they are opened with the serial "tcp://<host>:<port>" as a camera whose events
+/// stream reads the network stream.
+class PseeNetworkCameraDiscovery : public CameraDiscovery {
+public:
+    SerialList list() override;
+    SystemList list_available_sources() override;
+    bool discover(DeviceBuilder &device_builder, const std::string &serial, const DeviceConfig &config) override;
+    bool is_for_local_camera() const override;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_PSEE_NETWORK_CAMERA_DISCOVERY_H
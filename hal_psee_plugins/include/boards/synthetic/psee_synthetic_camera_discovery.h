@@ -0,0 +1,33 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_PSEE_SYNTHETIC_CAMERA_DISCOVERY_H
+#define METAVISION_HAL_PSEE_SYNTHETIC_CAMERA_DISCOVERY_H
+
+#include "metavision/hal/utils/camera_discovery.h"
+
+namespace Metavision {
+
+/// @brief Opens cameras producing synthetic events, for load testing
+///
+/// The cameras are not listed, they are opened with the serial "synthetic:<options>", where the options are parsed
+/// by @ref SyntheticEventsConfig::parse, for instance "synthetic:format=evt2,rate=100M,paced=false".
+class PseeSyntheticCameraDiscovery : public CameraDiscovery {
+public:
+    SerialList list() override;
+    SystemList list_available_sources() override;
+    bool discover(DeviceBuilder &device_builder, const std::string &serial, const DeviceConfig &config) override;
+    bool is_for_local_camera() const override;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_PSEE_SYNTHETIC_CAMERA_DISCOVERY_H
@@ -0,0 +1,116 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_HAL_SYNTHETIC_RAW_DATA_PRODUCER_H
+#define METAVISION_HAL_SYNTHETIC_RAW_DATA_PRODUCER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "metavision/hal/utils/data_transfer.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Configuration of the synthetic events generated by a @ref SyntheticRawDataProducer
+class SyntheticEventsConfig {
+public:
+    /// @brief Spatial and temporal distribution of the events
+    enum class Pattern {
+        /// Events uniformly distributed over the sensor, at a constant rate
+        Uniform,
+        /// Events uniformly distributed over the sensor, emitted in bursts of 1 ms every 10 ms
+        Bursts,
+        /// Events uniformly distributed over the sensor, at a rate modulated at 100 Hz, ON events while the rate
+        /// increases and OFF events while it decreases
+        Flicker,
+        /// Events along a vertical edge sweeping the sensor from left to right every 100 ms, ON events in front of
+        /// the edge and OFF events behind it
+        MovingEdge
+    };
+
+    /// Encoding format of the RAW data, "EVT2", "EVT21" or "EVT3"
+    std::string format_ = "EVT3";
+
+    /// Width of the sensor
+    int width_ = 1280;
+
+    /// Height of the sensor
+    int height_ = 720;
+
+    /// Mean event rate in events per second
+    double event_rate_ = 10e6;
+
+    /// Distribution of the events
+    Pattern pattern_ = Pattern::Uniform;
+
+    /// If true, the data is produced in real time, otherwise as fast as possible
+    bool paced_ = true;
+
+    /// Time covered by each transferred buffer, in us
+    timestamp buffer_duration_us_ = 1000;
+
+    /// Time after which the stream ends, in us, or 0 for an endless stream
+    timestamp duration_us_ = 0;
+
+    /// Seed of the random generator
+    uint32_t seed_ = 0;
+
+    /// @brief Parses a configuration from a string of comma separated "key=value" pairs
+    ///
+    /// The keys are "format" (evt2, evt21 or evt3), "width", "height", "rate" (in events per second, with an optional
+    /// k, M or G suffix), "pattern" (uniform, bursts, flicker or edge), "paced" (true or false), "buffer_duration"
+    /// and "duration" (in us) and "seed". The missing keys keep their default value.
+    /// @param options String to parse, for instance "format=evt2,rate=100M,pattern=edge,paced=false"
+    /// @return The parsed configuration
+    /// @throw HalException if a key or a value is invalid
+    static SyntheticEventsConfig parse(const std::string &options);
+
+    /// @brief Gets the format of the generated RAW data, with its geometry, as written in a RAW header
+    std::string get_format_string() const;
+};
+
+/// @brief Generates a synthetic RAW data stream, for load testing
+///
+/// The events are generated according to a @ref SyntheticEventsConfig, and directly encoded in the configured RAW
+/// format, so that the whole decoding pipeline is exercised as with a real sensor. When not paced, the generation is
+/// only limited by the speed of the consumers of the transferred buffers.
+class SyntheticRawDataProducer : public DataTransfer::RawDataProducer {
+public:
+    /// @brief Constructor
+    /// @param config Configuration of the generated events
+    /// @throw HalException if the configuration is not valid
+    explicit SyntheticRawDataProducer(const SyntheticEventsConfig &config);
+
+    /// @brief Destructor
+    ~SyntheticRawDataProducer() override;
+
+    /// @brief Gets the configuration of the generated events
+    const SyntheticEventsConfig &get_config() const;
+
+    /// @brief Gets the number of events generated since the construction
+    uint64_t get_num_generated_events() const;
+
+private:
+    void run_impl(const DataTransfer &data_transfer) override final;
+
+    class Generator;
+    const SyntheticEventsConfig config_;
+    std::unique_ptr<Generator> generator_;
+    DataTransfer::DefaultBufferPool buffer_pool_;
+    std::atomic<uint64_t> num_generated_events_{0};
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_HAL_SYNTHETIC_RAW_DATA_PRODUCER_H
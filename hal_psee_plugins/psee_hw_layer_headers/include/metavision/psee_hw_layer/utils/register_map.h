@@ -19,6 +19,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 #include <iostream>
 
 #include "metavision/hal/utils/hal_log.h"
@@ -139,6 +140,37 @@ public:
         RegisterMap *register_map_ = nullptr;
         std::map<std::string, Field> name_to_field_;
     };
+    /// @brief Batch of register writes, sent to the device when the transaction is committed
+    ///
+    /// While a transaction is open, the writes to the register map are queued instead of being sent one by one:
+    ///  - successive writes of different fields of a register are coalesced into a single register write, while
+    ///    plain register writes and successive writes of the same field (e.g. pulses) are all sent
+    ///  - when committed, the queued writes are sent in order, and writes to consecutive addresses are sent as a
+    ///    single burst through the callback set with @ref set_write_burst_cb
+    ///
+    /// Reads of a register written in the transaction return the queued value, other reads are sent to the device
+    /// immediately, before the queued writes. A read that depends on the side effects of queued writes (e.g. polling a
+    /// status bit) must thus be done after the transaction is committed.
+    ///
+    /// Transactions can be nested, the writes are sent when the outermost transaction is committed. A transaction
+    /// that is not explicitly committed is committed on destruction.
+    class Transaction {
+    public:
+        Transaction(Transaction &&other);
+        Transaction &operator=(Transaction &&other);
+        Transaction(const Transaction &)            = delete;
+        Transaction &operator=(const Transaction &) = delete;
+        ~Transaction();
+
+        /// @brief Ends the transaction, and sends the queued writes if it is the outermost one
+        void commit();
+
+    private:
+        friend class RegisterMap;
+        explicit Transaction(RegisterMap *register_map);
+        RegisterMap *register_map_;
+    };
+
     using RegmapData = std::vector<std::tuple<RegmapElement *, uint32_t, std::string, uint32_t>>;
     RegisterMap(RegmapData);
 
@@ -153,11 +185,22 @@ public:
     void write(uint32_t address, uint32_t v);
     uint32_t read(uint32_t address);
 
+    /// @brief Opens a transaction, in which the register writes are queued until it is committed
+    /// @return The opened transaction
+    Transaction begin_transaction();
+
     typedef std::function<void(uint32_t address, uint32_t v)> write_cb_t;
     typedef std::function<uint32_t(uint32_t address)> read_cb_t;
+    typedef std::function<void(uint32_t address, const std::vector<uint32_t> &values)> write_burst_cb_t;
     void set_write_cb(write_cb_t cb);
     void set_read_cb(read_cb_t cb);
 
+    /// @brief Sets the callback writing values to consecutive registers, starting at the given address
+    ///
+    /// The callback is used when committing transactions. If not set, the registers are written one by one with the
+    /// write callback.
+    void set_write_burst_cb(write_burst_cb_t cb);
+
     void dump();
 
 private:
@@ -171,8 +214,19 @@ private:
         return RegisterAccess(it->second.get());
     }
 
+    void write_field_update(uint32_t address, uint32_t v, uint32_t field_mask);
+    void log_write(uint32_t address, uint32_t v);
+    void end_transaction();
+    void flush_pending_writes();
+
     write_cb_t write_cb_;
     read_cb_t read_cb_;
+    write_burst_cb_t write_burst_cb_;
+    int transaction_depth_ = 0;
+    std::vector<std::pair<uint32_t, uint32_t>> pending_writes_;
+    std::map<uint32_t, uint32_t> pending_values_;
+    // bits of the fields updated by the last pending write, 0 if it is a plain register write
+    uint32_t pending_field_mask_ = 0;
     std::map<uint32_t, std::shared_ptr<Register>> addr_to_register_;
     std::map<std::string, std::shared_ptr<Register>> name_to_register_;
 };
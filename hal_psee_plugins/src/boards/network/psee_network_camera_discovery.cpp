@@ -0,0 +1,67 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <memory>
+#include <string>
+
+#include "boards/network/psee_network_camera_discovery.h"
+#include "metavision/psee_hw_layer/boards/rawfile/psee_raw_file_header.h"
+#include "metavision/psee_hw_layer/boards/rawfile/file_hw_identification.h"
+#include "metavision/hal/facilities/i_events_stream.h"
+#include "metavision/hal/utils/device_builder.h"
+#include "metavision/hal/utils/hal_log.h"
+#include "metavision/hal/utils/network_raw_data_producer.h"
+#include "metavision/psee_hw_layer/utils/psee_format.h"
+#include "utils/make_decoder.h"
+
+namespace Metavision {
+
+CameraDiscovery::SerialList PseeNetworkCameraDiscovery::list() {
+    return SerialList();
+}
+
+CameraDiscovery::SystemList PseeNetworkCameraDiscovery::list_available_sources() {
+    return SystemList();
+}
+
+bool PseeNetworkCameraDiscovery::is_for_local_camera() const {
+    return false;
+}
+
+bool PseeNetworkCameraDiscovery::discover(DeviceBuilder &device_builder, const std::string &serial,
+                                          const DeviceConfig &config) {
+    std::string host;
+    uint16_t port;
+    if (!NetworkRawDataProducer::parse_uri(serial, host, port)) {
+        return false;
+    }
+
+    try {
+        auto producer = std::make_unique<NetworkRawDataProducer>(host, port);
+        PseeRawFileHeader psee_header(producer->get_header());
+        StreamFormat format = psee_header.get_format();
+
+        // as for a live camera, the timestamps are not shifted
+        size_t raw_size_bytes = 0;
+        auto decoder          = make_decoder(device_builder, format, raw_size_bytes, false, config);
+
+        auto hw_id = device_builder.add_facility(
+            std::make_unique<FileHWIdentification>(device_builder.get_plugin_software_info(), psee_header));
+
+        device_builder.add_facility(std::make_unique<I_EventsStream>(std::move(producer), hw_id, decoder));
+        return true;
+    } catch (std::exception &e) {
+        MV_HAL_LOG_TRACE() << "Could not open network stream" << serial << ":" << e.what();
+        return false;
+    }
+}
+
+} // namespace Metavision
@@ -35,7 +35,9 @@ bool PseeFileDiscovery::discover(DeviceBuilder &device_builder, std::unique_ptr<
         PseeRawFileHeader psee_header(header);
         StreamFormat format = psee_header.get_format();
 
-        auto decoder = make_decoder(device_builder, format, raw_size_bytes, file_config.do_time_shifting_);
+        DeviceConfig config;
+        config.set("evt21_keep_vectors", file_config.evt21_keep_vectors_);
+        auto decoder = make_decoder(device_builder, format, raw_size_bytes, file_config.do_time_shifting_, config);
 
         auto file_hw_id = device_builder.add_facility(
             std::make_unique<FileHWIdentification>(device_builder.get_plugin_software_info(), psee_header));
@@ -0,0 +1,440 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "boards/synthetic/synthetic_raw_data_producer.h"
+#include "metavision/hal/decoders/evt2/evt2_event_types.h"
+#include "metavision/hal/decoders/evt21/evt21_event_types.h"
+#include "metavision/hal/decoders/evt3/evt3_event_types.h"
+#include "metavision/hal/utils/hal_exception.h"
+
+namespace Metavision {
+
+namespace {
+
+constexpr timestamp kBurstPeriodUs   = 10000;
+constexpr timestamp kBurstDurationUs = 1000;
+constexpr timestamp kFlickerPeriodUs = 10000;
+constexpr timestamp kSweepPeriodUs   = 100000;
+constexpr int kEdgeHalfWidth         = 4;
+constexpr int kMaxSensorSize         = 2048;
+constexpr double kPi                 = 3.14159265358979323846;
+
+struct PixelEvent {
+    uint16_t x;
+    uint16_t y;
+    uint8_t p;
+};
+
+template<typename Word>
+uint8_t *write_word(uint8_t *out, const Word &word) {
+    std::memcpy(out, &word, sizeof(word));
+    return out + sizeof(word);
+}
+
+// Encodes the events of each timestamp directly in memory
+class Encoder {
+public:
+    virtual ~Encoder() = default;
+
+    // Gets the maximum size of the encoded data for n events of the same timestamp
+    virtual std::size_t get_max_encoded_size(std::size_t n) const = 0;
+
+    // Encodes events sharing the timestamp t, returns the end of the encoded data
+    virtual uint8_t *encode(timestamp t, const PixelEvent *begin, const PixelEvent *end, uint8_t *out) = 0;
+};
+
+class Evt2Encoder final : public Encoder {
+public:
+    std::size_t get_max_encoded_size(std::size_t n) const override {
+        return sizeof(EVT2TimeHigh) + n * sizeof(EVT2Event2D);
+    }
+
+    uint8_t *encode(timestamp t, const PixelEvent *begin, const PixelEvent *end, uint8_t *out) override {
+        const timestamp time_high = t >> EVT2EventsTimeStampBits;
+        if (time_high != last_time_high_) {
+            EVT2TimeHigh word;
+            word.ts         = static_cast<uint32_t>(time_high);
+            word.type       = static_cast<uint32_t>(EVT2EventTypes::EVT_TIME_HIGH);
+            out             = write_word(out, word);
+            last_time_high_ = time_high;
+        }
+        EVT2Event2D word;
+        word.timestamp = static_cast<uint32_t>(t) & ((1u << EVT2EventsTimeStampBits) - 1);
+        for (auto ev = begin; ev != end; ++ev) {
+            word.x    = ev->x;
+            word.y    = ev->y;
+            word.type = static_cast<uint32_t>(ev->p ? EVT2EventTypes::CD_ON : EVT2EventTypes::CD_OFF);
+            out       = write_word(out, word);
+        }
+        return out;
+    }
+
+private:
+    timestamp last_time_high_ = -1;
+};
+
+class Evt21Encoder final : public Encoder {
+public:
+    std::size_t get_max_encoded_size(std::size_t n) const override {
+        return sizeof(Evt21Raw::Event_TIME_HIGH) + n * sizeof(Evt21Raw::Event_2D);
+    }
+
+    uint8_t *encode(timestamp t, const PixelEvent *begin, const PixelEvent *end, uint8_t *out) override {
+        const timestamp time_high = t >> 6;
+        if (time_high != last_time_high_) {
+            Evt21Raw::Event_TIME_HIGH word{};
+            word.ts         = static_cast<uint64_t>(time_high);
+            word.type       = static_cast<uint64_t>(Evt21EventTypes_4bits::EVT_TIME_HIGH);
+            out             = write_word(out, word);
+            last_time_high_ = time_high;
+        }
+        // consecutive events of the same row, polarity and group of 32 pixels are merged in a single vector
+        uint8_t *last = nullptr;
+        Evt21Raw::Event_2D word{};
+        word.ts = static_cast<uint64_t>(t) & 63;
+        for (auto ev = begin; ev != end; ++ev) {
+            const uint64_t base_x = ev->x & ~31u;
+            const uint64_t type   = ev->p ? static_cast<uint64_t>(Evt21EventTypes_4bits::EVT_POS) :
+                                            static_cast<uint64_t>(Evt21EventTypes_4bits::EVT_NEG);
+            const uint32_t bit    = 1u << (ev->x & 31);
+            // a pixel firing twice in the same us needs another vector
+            if (last && word.y == ev->y && word.x == base_x && word.type == type && !(word.valid & bit)) {
+                word.valid |= bit;
+                std::memcpy(last, &word, sizeof(word));
+                continue;
+            }
+            word.valid = bit;
+            word.x     = base_x;
+            word.y     = ev->y;
+            word.type  = type;
+            last       = out;
+            out        = write_word(out, word);
+        }
+        return out;
+    }
+
+private:
+    timestamp last_time_high_ = -1;
+};
+
+class Evt3Encoder final : public Encoder {
+public:
+    std::size_t get_max_encoded_size(std::size_t n) const override {
+        return 2 * sizeof(Evt3Raw::RawEvent) * (n + 1);
+    }
+
+    uint8_t *encode(timestamp t, const PixelEvent *begin, const PixelEvent *end, uint8_t *out) override {
+        const int time_high = static_cast<int>((t >> 12) & 0xFFF);
+        const int time_low  = static_cast<int>(t & 0xFFF);
+        if (time_high != last_time_high_) {
+            out             = write_raw(out, Evt3EventTypes_4bits::EVT_TIME_HIGH, time_high);
+            last_time_high_ = time_high;
+            last_time_low_  = -1;
+        }
+        if (time_low != last_time_low_) {
+            out            = write_raw(out, Evt3EventTypes_4bits::EVT_TIME_LOW, time_low);
+            last_time_low_ = time_low;
+        }
+        for (auto ev = begin; ev != end; ++ev) {
+            if (ev->y != last_y_) {
+                Evt3Raw::Event_Y word;
+                word.y    = ev->y;
+                word.orig = 0;
+                word.type = static_cast<uint16_t>(Evt3EventTypes_4bits::EVT_ADDR_Y);
+                out       = write_word(out, word);
+                last_y_   = ev->y;
+            }
+            Evt3Raw::Event_PosX word;
+            word.x    = ev->x;
+            word.pol  = ev->p;
+            word.type = static_cast<uint16_t>(Evt3EventTypes_4bits::EVT_ADDR_X);
+            out       = write_word(out, word);
+        }
+        return out;
+    }
+
+private:
+    static uint8_t *write_raw(uint8_t *out, Evt3EventTypes_4bits type, int content) {
+        Evt3Raw::RawEvent word;
+        word.content = static_cast<uint16_t>(content);
+        word.type    = static_cast<uint16_t>(type);
+        return write_word(out, word);
+    }
+
+    int last_time_high_ = -1;
+    int last_time_low_  = -1;
+    int last_y_         = -1;
+};
+
+std::string to_lower(std::string str) {
+    std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return std::tolower(c); });
+    return str;
+}
+
+[[noreturn]] void throw_invalid_option(const std::string &option) {
+    throw HalException(HalErrorCode::InvalidArgument, "Invalid synthetic events option: \"" + option + "\".");
+}
+
+double parse_number(const std::string &option, const std::string &value) {
+    double multiplier = 1.;
+    std::string digits = value;
+    if (!digits.empty()) {
+        switch (digits.back()) {
+        case 'k':
+        case 'K':
+            multiplier = 1e3;
+            break;
+        case 'M':
+            multiplier = 1e6;
+            break;
+        case 'G':
+            multiplier = 1e9;
+            break;
+        default:
+            break;
+        }
+        if (multiplier != 1.) {
+            digits.pop_back();
+        }
+    }
+    try {
+        std::size_t parsed = 0;
+        const double number = std::stod(digits, &parsed);
+        if (parsed != digits.size()) {
+            throw_invalid_option(option);
+        }
+        return number * multiplier;
+    } catch (const std::logic_error &) {
+        throw_invalid_option(option);
+    }
+}
+
+} // namespace
+
+SyntheticEventsConfig SyntheticEventsConfig::parse(const std::string &options) {
+    SyntheticEventsConfig config;
+    std::istringstream stream(options);
+    std::string option;
+    while (std::getline(stream, option, ',')) {
+        if (option.empty()) {
+            continue;
+        }
+        const auto separator = option.find('=');
+        if (separator == std::string::npos) {
+            throw_invalid_option(option);
+        }
+        const std::string key   = to_lower(option.substr(0, separator));
+        const std::string value = option.substr(separator + 1);
+        if (key == "format") {
+            config.format_ = value;
+            std::transform(config.format_.begin(), config.format_.end(), config.format_.begin(),
+                           [](unsigned char c) { return std::toupper(c); });
+        } else if (key == "width") {
+            config.width_ = static_cast<int>(parse_number(option, value));
+        } else if (key == "height") {
+            config.height_ = static_cast<int>(parse_number(option, value));
+        } else if (key == "rate") {
+            config.event_rate_ = parse_number(option, value);
+        } else if (key == "pattern") {
+            const std::string pattern = to_lower(value);
+            if (pattern == "uniform") {
+                config.pattern_ = Pattern::Uniform;
+            } else if (pattern == "bursts") {
+                config.pattern_ = Pattern::Bursts;
+            } else if (pattern == "flicker") {
+                config.pattern_ = Pattern::Flicker;
+            } else if (pattern == "edge") {
+                config.pattern_ = Pattern::MovingEdge;
+            } else {
+                throw_invalid_option(option);
+            }
+        } else if (key == "paced") {
+            const std::string paced = to_lower(value);
+            if (paced != "true" && paced != "false" && paced != "1" && paced != "0") {
+                throw_invalid_option(option);
+            }
+            config.paced_ = paced == "true" || paced == "1";
+        } else if (key == "buffer_duration") {
+            config.buffer_duration_us_ = static_cast<timestamp>(parse_number(option, value));
+        } else if (key == "duration") {
+            config.duration_us_ = static_cast<timestamp>(parse_number(option, value));
+        } else if (key == "seed") {
+            config.seed_ = static_cast<uint32_t>(parse_number(option, value));
+        } else {
+            throw_invalid_option(option);
+        }
+    }
+    return config;
+}
+
+std::string SyntheticEventsConfig::get_format_string() const {
+    return format_ + ";height=" + std::to_string(height_) + ";width=" + std::to_string(width_);
+}
+
+class SyntheticRawDataProducer::Generator {
+public:
+    Generator(const SyntheticEventsConfig &config) :
+        config_(config), rate_per_us_(config.event_rate_ * 1e-6), state_(0x9E3779B97F4A7C15ull ^ config.seed_) {
+        if (config.format_ == "EVT2") {
+            encoder_ = std::make_unique<Evt2Encoder>();
+        } else if (config.format_ == "EVT21") {
+            encoder_ = std::make_unique<Evt21Encoder>();
+        } else {
+            encoder_ = std::make_unique<Evt3Encoder>();
+        }
+    }
+
+    timestamp get_time() const {
+        return time_;
+    }
+
+    // Generates the events until the given time, and appends their encoded data to the buffer
+    // Returns the number of generated events
+    uint64_t generate(timestamp end, std::vector<uint8_t> &buffer) {
+        uint64_t num_events = 0;
+        // avoids reallocations of the buffer as it grows, for the mean rate
+        buffer.reserve(buffer.size() + encoder_->get_max_encoded_size(static_cast<std::size_t>(
+                                           std::max<timestamp>(end - time_, 0) * rate_per_us_ * 1.25)));
+        for (; time_ < end; ++time_) {
+            expected_events_ += get_rate(time_);
+            const std::size_t n = static_cast<std::size_t>(expected_events_);
+            if (n == 0) {
+                continue;
+            }
+            expected_events_ -= n;
+            num_events += n;
+
+            events_.resize(n);
+            for (auto &ev : events_) {
+                ev = make_event(time_);
+            }
+            const std::size_t size = buffer.size();
+            buffer.resize(size + encoder_->get_max_encoded_size(n));
+            const uint8_t *encoded_end =
+                encoder_->encode(time_, events_.data(), events_.data() + n, buffer.data() + size);
+            buffer.resize(encoded_end - buffer.data());
+        }
+        return num_events;
+    }
+
+private:
+    // Expected number of events in the given us
+    double get_rate(timestamp t) const {
+        switch (config_.pattern_) {
+        case SyntheticEventsConfig::Pattern::Bursts:
+            return (t % kBurstPeriodUs) < kBurstDurationUs ? rate_per_us_ * kBurstPeriodUs / kBurstDurationUs : 0.;
+        case SyntheticEventsConfig::Pattern::Flicker:
+            return rate_per_us_ * (1. - std::cos(2 * kPi * (t % kFlickerPeriodUs) / kFlickerPeriodUs));
+        default:
+            return rate_per_us_;
+        }
+    }
+
+    PixelEvent make_event(timestamp t) {
+        PixelEvent ev;
+        ev.y = static_cast<uint16_t>(random(config_.height_));
+        switch (config_.pattern_) {
+        case SyntheticEventsConfig::Pattern::MovingEdge: {
+            const int edge_x = static_cast<int>((t % kSweepPeriodUs) * config_.width_ / kSweepPeriodUs);
+            const int offset = static_cast<int>(random(2 * kEdgeHalfWidth)) - kEdgeHalfWidth;
+            ev.x             = static_cast<uint16_t>(std::clamp(edge_x + offset, 0, config_.width_ - 1));
+            ev.p             = offset >= 0;
+            break;
+        }
+        case SyntheticEventsConfig::Pattern::Flicker:
+            ev.x = static_cast<uint16_t>(random(config_.width_));
+            ev.p = (t % kFlickerPeriodUs) < kFlickerPeriodUs / 2;
+            break;
+        default:
+            ev.x = static_cast<uint16_t>(random(config_.width_));
+            ev.p = static_cast<uint8_t>(random(2));
+            break;
+        }
+        return ev;
+    }
+
+    // Draws a random number in [0, n), with a xorshift generator
+    uint32_t random(uint32_t n) {
+        state_ ^= state_ >> 12;
+        state_ ^= state_ << 25;
+        state_ ^= state_ >> 27;
+        const uint32_t value = static_cast<uint32_t>((state_ * 0x2545F4914F6CDD1Dull) >> 32);
+        return static_cast<uint32_t>((static_cast<uint64_t>(value) * n) >> 32);
+    }
+
+    const SyntheticEventsConfig config_;
+    const double rate_per_us_;
+    uint64_t state_;
+    std::unique_ptr<Encoder> encoder_;
+    std::vector<PixelEvent> events_;
+    timestamp time_         = 0;
+    double expected_events_ = 0.;
+};
+
+SyntheticRawDataProducer::SyntheticRawDataProducer(const SyntheticEventsConfig &config) :
+    config_(config), buffer_pool_(DataTransfer::DefaultBufferPool::make_unbounded()) {
+    if (config_.format_ != "EVT2" && config_.format_ != "EVT21" && config_.format_ != "EVT3") {
+        throw HalException(HalErrorCode::UnsupportedValue,
+                           "Unsupported format for synthetic events: \"" + config_.format_ + "\".");
+    }
+    if (config_.width_ <= 0 || config_.width_ > kMaxSensorSize || config_.height_ <= 0 ||
+        config_.height_ > kMaxSensorSize) {
+        throw HalException(HalErrorCode::ValueOutOfRange, "Invalid geometry for synthetic events.");
+    }
+    if (!(config_.event_rate_ >= 0.) || config_.buffer_duration_us_ <= 0 || config_.duration_us_ < 0) {
+        throw HalException(HalErrorCode::ValueOutOfRange, "Invalid rate or duration for synthetic events.");
+    }
+    generator_ = std::make_unique<Generator>(config_);
+}
+
+SyntheticRawDataProducer::~SyntheticRawDataProducer() {}
+
+const SyntheticEventsConfig &SyntheticRawDataProducer::get_config() const {
+    return config_;
+}
+
+uint64_t SyntheticRawDataProducer::get_num_generated_events() const {
+    return num_generated_events_;
+}
+
+void SyntheticRawDataProducer::run_impl(const DataTransfer &data_transfer) {
+    // when paced, the stream time is mapped to the time at which the transfer is (re)started
+    const auto start = std::chrono::steady_clock::now() - std::chrono::microseconds(generator_->get_time());
+    while (!data_transfer.should_stop()) {
+        timestamp end = generator_->get_time() + config_.buffer_duration_us_;
+        if (config_.duration_us_ > 0) {
+            if (generator_->get_time() >= config_.duration_us_) {
+                break;
+            }
+            end = std::min(end, config_.duration_us_);
+        }
+        if (config_.paced_) {
+            // the data of a time slice is only available once it is over
+            std::this_thread::sleep_until(start + std::chrono::microseconds(end));
+        }
+
+        auto buffer = buffer_pool_.acquire();
+        buffer->clear();
+        num_generated_events_ += generator_->generate(end, *buffer);
+        data_transfer.fire_callbacks(DataTransfer::make_buffer_ptr(buffer));
+    }
+}
+
+} // namespace Metavision
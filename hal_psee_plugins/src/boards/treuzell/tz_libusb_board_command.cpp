@@ -9,6 +9,7 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <algorithm>
 #include <assert.h>
 #include <iomanip>
 #ifndef _MSC_VER
@@ -37,6 +38,8 @@
 #define PSEE_EVK_PROTOCOL 0
 
 #define TZ_MAX_ANSWER_SIZE 1024
+// Maximum number of registers accessed in a frame: header, device and address words followed by the values
+#define TZ_MAX_REG32_BURST ((TZ_MAX_ANSWER_SIZE / sizeof(uint32_t)) - 4)
 
 namespace Metavision {
 
@@ -280,6 +283,18 @@ unsigned int TzLibUSBBoardCommand::get_device_count() {
 }
 
 std::vector<uint32_t> TzLibUSBBoardCommand::read_device_register(uint32_t device, uint32_t address, int nval) {
+    if (nval > static_cast<int>(TZ_MAX_REG32_BURST)) {
+        // long bursts are split so that each answer fits in a frame
+        std::vector<uint32_t> res;
+        res.reserve(nval);
+        for (int i = 0; i < nval; i += TZ_MAX_REG32_BURST) {
+            const int n = std::min(nval - i, static_cast<int>(TZ_MAX_REG32_BURST));
+            auto values = read_device_register(device, address + i * sizeof(uint32_t), n);
+            res.insert(res.end(), values.begin(), values.end());
+        }
+        return res;
+    }
+
     TzGenericCtrlFrame req(TZ_PROP_DEVICE_REG32);
 
     req.push_back32(device);
@@ -315,6 +330,16 @@ std::vector<uint32_t> TzLibUSBBoardCommand::read_device_register(uint32_t device
 }
 
 void TzLibUSBBoardCommand::write_device_register(uint32_t device, uint32_t address, const std::vector<uint32_t> &val) {
+    if (val.size() > TZ_MAX_REG32_BURST) {
+        // long bursts are split so that each request fits in a frame
+        for (std::size_t i = 0; i < val.size(); i += TZ_MAX_REG32_BURST) {
+            const std::size_t n = std::min(val.size() - i, TZ_MAX_REG32_BURST);
+            write_device_register(device, address + i * sizeof(uint32_t),
+                                  std::vector<uint32_t>(val.begin() + i, val.begin() + i + n));
+        }
+        return;
+    }
+
     TzGenericCtrlFrame req(TZ_PROP_DEVICE_REG32 | TZ_WRITE_FLAG);
 
     req.push_back32(device);
@@ -31,6 +31,9 @@ void Gen41ROICommand::reset_to_full_roi() {
     uint32_t td_roi_x00_addr, td_roi_x39_addr;
     uint32_t td_roi_y00_addr, td_roi_y22_addr;
 
+    // the x and y registers are consecutive, they are written in two bursts
+    auto transaction = register_map_->begin_transaction();
+
     // setting x registers
     td_roi_x00_addr = (*register_map_)[sensor_prefix_ + "roi/td_roi_x00"].get_address();
     td_roi_x39_addr = (*register_map_)[sensor_prefix_ + "roi/td_roi_x39"].get_address();
@@ -44,6 +47,8 @@ void Gen41ROICommand::reset_to_full_roi() {
     for (row_td_ind = td_roi_y00_addr; row_td_ind <= td_roi_y22_addr; row_td_ind += roi_step) {
         (*register_map_)[row_td_ind]["effective"] = "enable";
     }
+
+    transaction.commit();
 }
 
 void Gen41ROICommand::write_ROI(const std::vector<unsigned int> &vroiparams) {
@@ -65,6 +70,9 @@ void Gen41ROICommand::write_ROI(const std::vector<unsigned int> &vroiparams) {
         MV_HAL_LOG_WARNING() << "Error setting ROI.";
     }
 
+    // the x and y registers are consecutive, they are written in two bursts
+    auto transaction = register_map_->begin_transaction();
+
     // setting x registers
     for (col_td_ind = td_roi_x00_addr; col_td_ind <= td_roi_x39_addr; col_td_ind += roi_step, ++param_ind) {
         (*register_map_)[col_td_ind] = ~vroiparams[param_ind];
@@ -78,6 +86,8 @@ void Gen41ROICommand::write_ROI(const std::vector<unsigned int> &vroiparams) {
         }
         (*register_map_)[row_td_ind] = v;
     }
+
+    transaction.commit();
 }
 
 bool Gen41ROICommand::set_mode(const I_ROI::Mode &mode) {
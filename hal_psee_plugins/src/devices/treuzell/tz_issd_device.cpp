@@ -70,9 +70,19 @@ void TzIssdDevice::ApplyRegisterOperation(const RegisterOperation operation) {
 }
 
 void TzIssdDevice::ApplyRegisterOperationSequence(const std::vector<RegisterOperation> sequence) {
+    // Writes are batched in transactions, so that runs of consecutive registers are sent in a single frame. The
+    // pending writes are sent before any read or delay, so that the device sees the exact same sequence.
+    auto transaction = register_map->begin_transaction();
     for (auto operation : sequence) {
-        ApplyRegisterOperation(operation);
+        if (operation.action != RegisterAction::WRITE) {
+            transaction.commit();
+            ApplyRegisterOperation(operation);
+            transaction = register_map->begin_transaction();
+        } else {
+            ApplyRegisterOperation(operation);
+        }
     }
+    transaction.commit();
 }
 
 } // namespace Metavision
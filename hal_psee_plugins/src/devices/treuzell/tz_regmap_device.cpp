@@ -23,6 +23,12 @@ TzDeviceWithRegmap::TzDeviceWithRegmap(RegmapData regmap_data, std::string root)
         return read_register(address);
     });
     register_map->set_write_cb([this](uint32_t address, uint32_t v) { write_register(address, v); });
+    register_map->set_write_burst_cb([this](uint32_t address, const std::vector<uint32_t> &values) {
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            init_register(address + i * sizeof(uint32_t), values[i]);
+        }
+        cmd->write_device_register(tzID, address, values);
+    });
 }
 
 TzDeviceWithRegmap::TzDeviceWithRegmap(RegmapElement *regarray, uint32_t size, std::string root) :
@@ -55,6 +55,25 @@ PluginDiscovery register_v4l2([](Plugin &plugin) {
 });
 #endif // HAS_V4L2
 
+#if defined(HAS_SHARED_MEMORY_STREAMS)
+#include "boards/shared_memory/psee_shared_memory_camera_discovery.h"
+PluginDiscovery register_shared_memory([](Plugin &plugin) {
+    auto &shm_disc = plugin.add_camera_discovery(std::make_unique<PseeSharedMemoryCameraDiscovery>());
+});
+#endif // HAS_SHARED_MEMORY_STREAMS
+
+#if defined(HAS_NETWORK_STREAMS)
+#include "boards/network/psee_network_camera_discovery.h"
+PluginDiscovery register_network([](Plugin &plugin) {
+    auto &network_disc = plugin.add_camera_discovery(std::make_unique<PseeNetworkCameraDiscovery>());
+});
+#endif // HAS_NETWORK_STREAMS
+
+#include "boards/synthetic/psee_synthetic_camera_discovery.h"
+PluginDiscovery register_synthetic([](Plugin &plugin) {
+    auto &synthetic_disc = plugin.add_camera_discovery(std::make_unique<PseeSyntheticCameraDiscovery>());
+});
+
 #include "boards/rawfile/psee_file_discovery.h"
 PluginDiscovery register_psee_file([](Plugin &plugin) {
     auto &file_disc = plugin.add_file_discovery(std::make_unique<PseeFileDiscovery>());
@@ -115,7 +115,7 @@ std::shared_ptr<I_EventsStreamDecoder> make_decoder(DeviceBuilder &device_builde
         auto evt21_keep_vectors = config.get<bool>("evt21_keep_vectors");
 
         if (evt21_keep_vectors){
-            if (endianness != "little"){
+            if (endianness == "legacy"){
                 throw std::invalid_argument("Value for option 'endianness` not supported when option `evt21_keep_vectors=true` is set"); 
             }
 
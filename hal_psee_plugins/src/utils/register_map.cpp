@@ -9,6 +9,7 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <exception>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -127,9 +128,7 @@ void RegisterMap::FieldAccess::write_value(uint32_t v) {
     if (field_ && register_) {
         MV_HAL_LOG_REGISTERS() << "Write Register" << register_->get_name() << "Field" << field_->get_name() << std::hex
                                << v << std::dec;
-        uint32_t cur_value = register_->read_value();
-        field_->set_bitfield_in_value(v, cur_value);
-        register_->write_value(cur_value);
+        register_->write_value(field_->get_name(), v);
     } else {
         if (register_) {
             MV_HAL_LOG_ERROR() << "Write: Invalid field for register" << register_->get_name();
@@ -310,16 +309,21 @@ RegisterMap::Register &RegisterMap::Register::operator=(uint32_t v) {
 }
 
 RegisterMap::Register &RegisterMap::Register::operator=(const std::map<std::string, uint32_t> &bitfields) {
-    auto val = this->read_value();
+    auto val            = this->read_value();
+    uint32_t field_mask = 0;
     for (auto v : bitfields) {
         auto it = name_to_field_.find(v.first);
         if (it != name_to_field_.end()) {
             it->second.set_bitfield_in_value(v.second, val);
+            field_mask |= static_cast<uint32_t>(((uint64_t(1) << it->second.get_len()) - 1) << it->second.get_start());
         } else {
             MV_HAL_LOG_ERROR() << "Unknown field" << v.first << "for register" << this->get_name();
         }
     }
-    *this = val;
+    if (register_map_) {
+        MV_HAL_LOG_REGISTERS() << "Write" << name_ << std::hex << val << std::dec;
+        register_map_->write_field_update(address_, val, field_mask);
+    }
     return *this;
 }
 
@@ -436,17 +440,125 @@ void RegisterMap::add_register(const Register &r) {
     ptr->set_register_map(this);
 }
 
-void RegisterMap::write(uint32_t address, uint32_t v) {
+RegisterMap::Transaction::Transaction(RegisterMap *register_map) : register_map_(register_map) {}
+
+RegisterMap::Transaction::Transaction(Transaction &&other) : register_map_(other.register_map_) {
+    other.register_map_ = nullptr;
+}
+
+RegisterMap::Transaction &RegisterMap::Transaction::operator=(Transaction &&other) {
+    if (this != &other) {
+        commit();
+        register_map_       = other.register_map_;
+        other.register_map_ = nullptr;
+    }
+    return *this;
+}
+
+RegisterMap::Transaction::~Transaction() {
+    try {
+        commit();
+    } catch (const std::exception &e) { MV_HAL_LOG_ERROR() << "Failed to commit register transaction:" << e.what(); }
+}
+
+void RegisterMap::Transaction::commit() {
+    if (register_map_) {
+        RegisterMap *register_map = register_map_;
+        register_map_             = nullptr;
+        register_map->end_transaction();
+    }
+}
+
+RegisterMap::Transaction RegisterMap::begin_transaction() {
+    ++transaction_depth_;
+    return Transaction(this);
+}
+
+void RegisterMap::end_transaction() {
+    if (--transaction_depth_ == 0) {
+        flush_pending_writes();
+    }
+}
+
+void RegisterMap::flush_pending_writes() {
+    std::vector<std::pair<uint32_t, uint32_t>> writes;
+    writes.swap(pending_writes_);
+    pending_values_.clear();
+    pending_field_mask_ = 0;
+
+    // writes to consecutive addresses are grouped in bursts, keeping the order of the writes
+    std::vector<uint32_t> burst;
+    uint32_t burst_address = 0;
+
+    auto send_burst = [&]() {
+        if (burst.empty()) {
+            return;
+        }
+        if (write_burst_cb_) {
+            write_burst_cb_(burst_address, burst);
+        } else {
+            for (std::size_t i = 0; i < burst.size(); ++i) {
+                write_cb_(burst_address + i * sizeof(uint32_t), burst[i]);
+            }
+        }
+        burst.clear();
+    };
+    for (const auto &write : writes) {
+        if (burst.empty() || write.first != burst_address + burst.size() * sizeof(uint32_t)) {
+            send_burst();
+            burst_address = write.first;
+        }
+        burst.push_back(write.second);
+    }
+    send_burst();
+}
+
+void RegisterMap::log_write(uint32_t address, uint32_t v) {
     if (getenv("LOG_REGISTERS")) {
         std::ostringstream s(std::ostringstream::ate);
         s << "write, 0x" << std::setw(8) << std::setfill('0') << std::hex << address;
         s << ", 0x" << std::setw(8) << std::setfill('0') << std::hex << v;
         MV_HAL_LOG_INFO() << s.str();
     }
+}
+
+void RegisterMap::write(uint32_t address, uint32_t v) {
+    log_write(address, v);
+    if (transaction_depth_ > 0) {
+        pending_writes_.emplace_back(address, v);
+        pending_values_[address] = v;
+        pending_field_mask_      = 0;
+        return;
+    }
     write_cb_(address, v);
 }
+
+void RegisterMap::write_field_update(uint32_t address, uint32_t v, uint32_t field_mask) {
+    // a field update is merged into the previous write only if it also is a field update of the same register
+    // touching other fields: plain register writes and successive writes of a field (e.g. pulses) are kept, as they
+    // may be meaningful to the device
+    if (transaction_depth_ > 0 && pending_field_mask_ != 0 && pending_writes_.back().first == address &&
+        (pending_field_mask_ & field_mask) == 0) {
+        log_write(address, v);
+        pending_writes_.back().second = v;
+        pending_values_[address]      = v;
+        pending_field_mask_ |= field_mask;
+        return;
+    }
+    write(address, v);
+    if (transaction_depth_ > 0) {
+        pending_field_mask_ = field_mask;
+    }
+}
+
 uint32_t RegisterMap::read(uint32_t address) {
-    uint32_t v = read_cb_(address);
+    uint32_t v;
+    auto it = pending_values_.find(address);
+    if (it != pending_values_.end()) {
+        v = it->second;
+    } else {
+        v = read_cb_(address);
+    }
     if (getenv("LOG_REGISTERS")) {
         std::ostringstream s(std::ostringstream::ate);
         s << "read, 0x" << std::setw(8) << std::setfill('0') << std::hex << address;
@@ -461,6 +573,9 @@ void RegisterMap::set_write_cb(write_cb_t cb) {
 void RegisterMap::set_read_cb(read_cb_t cb) {
     read_cb_ = cb;
 }
+void RegisterMap::set_write_burst_cb(write_burst_cb_t cb) {
+    write_burst_cb_ = cb;
+}
 
 void RegisterMap::dump() {
     for (auto &a : name_to_register_)
@@ -25,6 +25,7 @@
 #include "metavision/hal/device/device.h"
 #include "metavision/hal/device/device_discovery.h"
 #include "metavision/hal/utils/device_builder.h"
+#include "metavision/hal/utils/raw_index_trailer.h"
 #include "metavision/utils/gtest/gtest_custom.h"
 #include "metavision/hal/decoders/evt2/evt2_decoder.h"
 #include "metavision/psee_hw_layer/boards/rawfile/psee_raw_file_header.h"
@@ -105,6 +106,12 @@ class MockRawDataProducer : public DataTransfer::RawDataProducer {
 public:
     MockRawDataProducer() {}
 
+    bool transferred_buffer_follows_dropped_data() const final {
+        return follows_dropped_data_;
+    }
+
+    bool follows_dropped_data_ = false;
+
 private:
     void start_impl() final {}
     void run_impl(const DataTransfer &data_transfer) final {
@@ -133,7 +140,9 @@ public:
         DeviceBuilder device_builder = make_device_builder();
         auto decoder                 = device_builder.add_facility(std::make_unique<EVT2Decoder>(false));
         device_                      = device_builder();
-        events_stream_ = std::make_shared<I_EventsStream>(std::make_unique<MockRawDataProducer>(), hw_identification_,
+        auto producer                = std::make_unique<MockRawDataProducer>();
+        producer_                    = producer.get();
+        events_stream_ = std::make_shared<I_EventsStream>(std::move(producer), hw_identification_,
                                                           std::shared_ptr<I_EventsStreamDecoder>(decoder));
         events_stream_->start();
     }
@@ -145,6 +154,8 @@ public:
         events_stream_->get_data_transfer().transfer_data(data);
     }
 
+    MockRawDataProducer *producer_ = nullptr;
+
 protected:
     virtual void SetUp() override {
         datasets_.push_back(
@@ -258,6 +269,52 @@ TEST_F(I_EventsStream_GTest, stop_triggers_wait_next_buffer) {
     thread.join();
 }
 
+TEST_F(I_EventsStream_GTest, bounded_queue_drops_oldest_buffers) {
+    events_stream_->set_max_queued_buffers(2);
+    EXPECT_EQ(2, events_stream_->get_max_queued_buffers());
+    for (DataTransfer::Data i = 0; i < 5; ++i) {
+        transfer_data(std::make_shared<DataTransfer::DefaultBufferType>(2, i));
+    }
+    EXPECT_EQ(2, events_stream_->get_num_queued_buffers());
+    EXPECT_EQ(3, events_stream_->get_dropped_data().buffers_);
+    EXPECT_EQ(6, events_stream_->get_dropped_data().bytes_);
+
+    // the most recent buffers are kept, the first one following the dropped data
+    auto buffer = events_stream_->get_latest_raw_data();
+    ASSERT_EQ(2, buffer.size());
+    EXPECT_EQ(3, *buffer.cbegin());
+    EXPECT_TRUE(events_stream_->latest_raw_data_follows_dropped_data());
+    buffer = events_stream_->get_latest_raw_data();
+    ASSERT_EQ(2, buffer.size());
+    EXPECT_EQ(4, *buffer.cbegin());
+    EXPECT_FALSE(events_stream_->latest_raw_data_follows_dropped_data());
+
+    // an unbounded queue never drops buffers
+    events_stream_->set_max_queued_buffers(0);
+    for (int i = 0; i < 5; ++i) {
+        transfer_data(std::make_shared<DataTransfer::DefaultBufferType>(list));
+    }
+    EXPECT_EQ(5, events_stream_->get_num_queued_buffers());
+    EXPECT_EQ(3, events_stream_->get_dropped_data().buffers_);
+}
+
+TEST_F(I_EventsStream_GTest, flags_buffers_following_data_dropped_by_the_producer) {
+    transfer_data(std::make_shared<DataTransfer::DefaultBufferType>(2, 0));
+    producer_->follows_dropped_data_ = true;
+    transfer_data(std::make_shared<DataTransfer::DefaultBufferType>(2, 1));
+    producer_->follows_dropped_data_ = false;
+    transfer_data(std::make_shared<DataTransfer::DefaultBufferType>(2, 2));
+
+    // the data dropped by the producer is not counted by the events stream, which did not drop anything
+    EXPECT_EQ(0, events_stream_->get_dropped_data().buffers_);
+    for (DataTransfer::Data i = 0; i < 3; ++i) {
+        auto buffer = events_stream_->get_latest_raw_data();
+        ASSERT_EQ(2, buffer.size());
+        EXPECT_EQ(i, *buffer.cbegin());
+        EXPECT_EQ(i == 1, events_stream_->latest_raw_data_follows_dropped_data());
+    }
+}
+
 TEST_F_WITH_DATASET(I_EventsStream_GTest, valid_index_file) {
     ////////////////////////////////////////////////////////////////////////////////
     // PURPOSE
@@ -460,6 +517,93 @@ TEST_F_WITH_DATASET(I_EventsStream_GTest, invalid_index_file) {
     }
 }
 
+TEST_F_WITH_DATASET(I_EventsStream_GTest, logged_index_trailer_matches_index_built_from_the_file) {
+    ////////////////////////////////////////////////////////////////////////////////
+    // PURPOSE
+    // Check that the index appended as a trailer when logging RAW data is the one built when indexing the logged file
+
+    const auto wait_for_index = [](I_EventsStream &fes, timestamp &start_ts, timestamp &end_ts) {
+        constexpr uint32_t max_trials = 1000;
+        auto s                        = fes.get_seek_range(start_ts, end_ts);
+        for (uint32_t trials = 1; s != I_EventsStream::IndexStatus::Good && trials < max_trials; ++trials) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            s = fes.get_seek_range(start_ts, end_ts);
+        }
+        return s == I_EventsStream::IndexStatus::Good;
+    };
+
+    for (size_t i = 0; i < datasets_.size(); ++i) {
+        const auto &dataset = datasets_[i];
+        SCOPED_TRACE(dataset);
+        const auto logged_path     = tmpdir_handler_->get_full_path("logged_" + std::to_string(i) + ".raw");
+        const auto no_trailer_path = tmpdir_handler_->get_full_path("no_trailer_" + std::to_string(i) + ".raw");
+
+        // Log the whole dataset, with its index trailer
+        ASSERT_TRUE(open_dataset(dataset));
+        auto fes = device_->get_facility<I_EventsStream>();
+        ASSERT_NE(nullptr, fes);
+        ASSERT_TRUE(fes->log_raw_data(logged_path));
+        fes->start();
+        while (fes->wait_next_buffer() > 0) {
+            fes->get_latest_raw_data();
+        }
+        fes->stop_log_raw_data();
+        device_.reset();
+
+        RawIndexTrailer trailer;
+        {
+            std::ifstream logged_file(logged_path, std::ios::binary);
+            ASSERT_TRUE(read_raw_index_trailer(logged_file, trailer));
+        }
+
+        // Copy the logged data without the trailer, so that it is indexed from its events
+        {
+            std::ifstream logged_file(logged_path, std::ios::binary);
+            std::ofstream no_trailer_file(no_trailer_path, std::ios::binary);
+            std::vector<char> data(trailer.data_end_pos_);
+            ASSERT_TRUE(logged_file.read(data.data(), data.size()));
+            ASSERT_TRUE(no_trailer_file.write(data.data(), data.size()));
+        }
+
+        timestamp no_trailer_start_ts, no_trailer_end_ts;
+        ASSERT_TRUE(open_dataset(no_trailer_path));
+        ASSERT_TRUE(wait_for_index(*device_->get_facility<I_EventsStream>(), no_trailer_start_ts, no_trailer_end_ts));
+        device_.reset();
+
+        // The index built from the events holds the same timestamp shift and bookmarks as the trailer
+        std::ifstream index_file(no_trailer_path + ".tmp_index", std::ios::binary);
+        ASSERT_TRUE(index_file);
+        GenericHeader index_header(index_file);
+        EXPECT_EQ(std::to_string(trailer.bookmark_period_us_), index_header.get_field("bookmark_period_us"));
+        EXPECT_EQ(std::to_string(trailer.ts_shift_us_), index_header.get_field("ts_shift_us"));
+        I_EventsStream::Bookmarks bookmarks;
+        I_EventsStream::Bookmark bookmark;
+        while (index_file.read(reinterpret_cast<char *>(&bookmark.timestamp_), sizeof(bookmark.timestamp_)) &&
+               index_file.read(reinterpret_cast<char *>(&bookmark.byte_offset_), sizeof(bookmark.byte_offset_)) &&
+               index_file.read(reinterpret_cast<char *>(&bookmark.cd_event_count_), sizeof(bookmark.cd_event_count_))) {
+            bookmarks.push_back(bookmark);
+        }
+        // the last one is the magic number
+        ASSERT_FALSE(bookmarks.empty());
+        bookmarks.pop_back();
+        ASSERT_EQ(bookmarks.size(), trailer.bookmarks_.size());
+        for (size_t j = 0; j < bookmarks.size(); ++j) {
+            EXPECT_EQ(bookmarks[j].timestamp_, trailer.bookmarks_[j].timestamp_);
+            EXPECT_EQ(bookmarks[j].byte_offset_, trailer.bookmarks_[j].byte_offset_);
+            EXPECT_EQ(bookmarks[j].cd_event_count_, trailer.bookmarks_[j].cd_event_count_);
+        }
+
+        // The logged file is seekable right away, over the same range, without being indexed
+        timestamp start_ts, end_ts;
+        ASSERT_TRUE(open_dataset(logged_path));
+        ASSERT_TRUE(wait_for_index(*device_->get_facility<I_EventsStream>(), start_ts, end_ts));
+        EXPECT_FALSE(std::filesystem::exists(logged_path + ".tmp_index"));
+        EXPECT_EQ(no_trailer_start_ts, start_ts);
+        EXPECT_EQ(no_trailer_end_ts, end_ts);
+        device_.reset();
+    }
+}
+
 TEST_F_WITH_DATASET(I_EventsStream_GTest, seek_range) {
     ////////////////////////////////////////////////////////////////////////////////
     // PURPOSE
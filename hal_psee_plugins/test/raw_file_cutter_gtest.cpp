@@ -0,0 +1,183 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+#include "metavision/utils/gtest/gtest_custom.h"
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/hal/decoders/evt3/evt3_encoder.h"
+#include "metavision/hal/device/device_discovery.h"
+#include "metavision/hal/device/device.h"
+#include "metavision/hal/facilities/i_event_decoder.h"
+#include "metavision/hal/facilities/i_events_stream.h"
+#include "metavision/hal/facilities/i_events_stream_decoder.h"
+#include "metavision/hal/utils/raw_file_cutter.h"
+#include "metavision/hal/utils/raw_file_header.h"
+
+using namespace Metavision;
+
+class RawFileCutter_Gtest : public GTestWithTmpDir {
+protected:
+    // Decodes the CD events of a RAW file that are in [start_ts, end_ts)
+    std::vector<EventCD> decode_events(const std::filesystem::path &raw_file_path, timestamp start_ts = 0,
+                                       timestamp end_ts = std::numeric_limits<timestamp>::max()) {
+        RawFileConfig config;
+        config.build_index_ = false;
+        std::unique_ptr<Device> device(DeviceDiscovery::open_raw_file(raw_file_path.string(), config));
+        EXPECT_NE(nullptr, device);
+
+        std::vector<EventCD> events;
+        auto decoder    = device->get_facility<I_EventsStreamDecoder>();
+        auto cd_decoder = device->get_facility<I_EventDecoder<EventCD>>();
+        auto es         = device->get_facility<I_EventsStream>();
+        cd_decoder->add_event_buffer_callback([&](const EventCD *begin, const EventCD *end) {
+            std::copy_if(begin, end, std::back_inserter(events),
+                         [&](const EventCD &ev) { return ev.t >= start_ts && ev.t < end_ts; });
+        });
+
+        es->start();
+        while (es->wait_next_buffer() >= 0) {
+            decoder->decode(es->get_latest_raw_data());
+        }
+        return events;
+    }
+
+    // Cuts a dataset between start_ts and end_ts, and checks that the output file holds the same events as the
+    // dataset in this range
+    void cut_and_check(const std::filesystem::path &dataset_path, timestamp start_ts, timestamp end_ts) {
+        const std::filesystem::path output_path =
+            tmpdir_handler_->get_full_path("cut_" + std::to_string(start_ts) + "_" + std::to_string(end_ts) + ".raw");
+        {
+            std::unique_ptr<Device> device(DeviceDiscovery::open_raw_file(dataset_path.string()));
+            ASSERT_NE(nullptr, device);
+            ASSERT_EQ(RawFileCutStatus::Success, cut_raw_file(*device, output_path, start_ts, end_ts));
+        }
+
+        const auto expected_events = decode_events(dataset_path, start_ts, end_ts);
+        const auto events          = decode_events(output_path);
+        ASSERT_FALSE(expected_events.empty());
+        ASSERT_EQ(expected_events.size(), events.size());
+
+        // The output file has its own time origin
+        const timestamp ts_offset = expected_events.front().t - events.front().t;
+        for (size_t i = 0; i < events.size(); ++i) {
+            ASSERT_EQ(expected_events[i].x, events[i].x);
+            ASSERT_EQ(expected_events[i].y, events[i].y);
+            ASSERT_EQ(expected_events[i].p, events[i].p);
+            ASSERT_EQ(expected_events[i].t, events[i].t + ts_offset);
+        }
+    }
+
+    // Gets the range of the events of a RAW file, and the bookmark reached when seeking in the middle of the file
+    void get_seek_range(const std::filesystem::path &raw_file_path, timestamp &first_ts, timestamp &last_ts,
+                        I_EventsStream::Bookmark &middle_bookmark) {
+        std::unique_ptr<Device> device(DeviceDiscovery::open_raw_file(raw_file_path.string()));
+        ASSERT_NE(nullptr, device);
+        auto es           = device->get_facility<I_EventsStream>();
+        auto index_status = es->get_seek_range(first_ts, last_ts);
+        while (index_status == I_EventsStream::IndexStatus::Building) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            index_status = es->get_seek_range(first_ts, last_ts);
+        }
+        ASSERT_EQ(I_EventsStream::IndexStatus::Good, index_status);
+        ASSERT_EQ(I_EventsStream::SeekStatus::Success, es->get_bookmark((first_ts + last_ts) / 2, middle_bookmark));
+    }
+
+    // Writes an EVT3 RAW file whose events are all on the same row, so that the row address is only encoded once
+    std::filesystem::path write_single_row_evt3_file() {
+        const std::filesystem::path raw_file_path = tmpdir_handler_->get_full_path("single_row_evt3.raw");
+        std::ofstream ofs(raw_file_path, std::ios::binary);
+        RawFileHeader header;
+        header.set_field("format", "EVT3;height=480;width=640");
+        header.set_field("serial_number", "00001234");
+        header.set_camera_integrator_name("Prophesee");
+        header.set_plugin_integrator_name("Prophesee");
+        ofs << header;
+        Evt3Encoder encoder(640);
+        for (timestamp t = 100; t < 1000000; t += 20) {
+            encoder.encode_event_cd(ofs, EventCD(static_cast<unsigned short>(t % 640), 123, t % 3 == 0, t));
+        }
+        encoder.flush(ofs);
+        return raw_file_path;
+    }
+
+    void cut_and_check(const std::string &dataset) {
+        const auto dataset_path = std::filesystem::path(GtestsParameters::instance().dataset_dir) / "openeb" / dataset;
+
+        timestamp first_ts, last_ts;
+        I_EventsStream::Bookmark middle_bookmark;
+        ASSERT_NO_FATAL_FAILURE(get_seek_range(dataset_path, first_ts, last_ts, middle_bookmark));
+
+        // Beginning of the file, where the data is copied from the start of the file
+        cut_and_check(dataset_path, 0, first_ts + 50000);
+        // Middle of the file, with cut points between bookmarks
+        const timestamp middle_ts = (first_ts + last_ts) / 2 + 1234;
+        cut_and_check(dataset_path, middle_ts, middle_ts + 100017);
+        // Just after a bookmark, where the data before the bookmark is needed to know the state of the decoder
+        cut_and_check(dataset_path, middle_bookmark.timestamp_ + 1, middle_bookmark.timestamp_ + 100000);
+        // End of the file, where the data is copied up to the end of the file
+        cut_and_check(dataset_path, last_ts - 50000, last_ts + 1000000);
+    }
+};
+
+TEST_F_WITH_DATASET(RawFileCutter_Gtest, cut_evt2) {
+    cut_and_check("gen4_evt2_hand.raw");
+}
+
+TEST_F_WITH_DATASET(RawFileCutter_Gtest, cut_evt21) {
+    cut_and_check("claque_doigt_evt21.raw");
+}
+
+TEST_F_WITH_DATASET(RawFileCutter_Gtest, cut_evt21_legacy) {
+    cut_and_check("standup_evt21-legacy.raw");
+}
+
+TEST_F_WITH_DATASET(RawFileCutter_Gtest, cut_evt3) {
+    cut_and_check("gen4_evt3_hand.raw");
+}
+
+TEST_F(RawFileCutter_Gtest, cut_evt3_keeps_the_row_address_encoded_before_the_cut) {
+    // GIVEN an EVT3 file whose row address is only encoded at the beginning
+    const auto raw_file_path = write_single_row_evt3_file();
+    timestamp first_ts, last_ts;
+    I_EventsStream::Bookmark middle_bookmark;
+    ASSERT_NO_FATAL_FAILURE(get_seek_range(raw_file_path, first_ts, last_ts, middle_bookmark));
+
+    // WHEN it is cut just after a bookmark, or between bookmarks
+    // THEN the output files hold the same events as the input file in these ranges
+    cut_and_check(raw_file_path, middle_bookmark.timestamp_ + 1, middle_bookmark.timestamp_ + 10000);
+    cut_and_check(raw_file_path, (first_ts + last_ts) / 3 + 1234, (first_ts + last_ts) / 3 + 100017);
+}
+
+TEST_F(RawFileCutter_Gtest, nothing_to_cut_after_the_end_of_the_file) {
+    // GIVEN a RAW file
+    const auto raw_file_path = write_single_row_evt3_file();
+    timestamp first_ts, last_ts;
+    I_EventsStream::Bookmark middle_bookmark;
+    ASSERT_NO_FATAL_FAILURE(get_seek_range(raw_file_path, first_ts, last_ts, middle_bookmark));
+
+    // WHEN it is cut after its last event
+    const std::filesystem::path output_path = tmpdir_handler_->get_full_path("cut_after_end.raw");
+    std::unique_ptr<Device> device(DeviceDiscovery::open_raw_file(raw_file_path.string()));
+    ASSERT_NE(nullptr, device);
+    const auto status = cut_raw_file(*device, output_path, last_ts + 1000000, last_ts + 2000000);
+
+    // THEN there is nothing to cut, and no output file is written
+    EXPECT_EQ(RawFileCutStatus::NothingToCut, status);
+    EXPECT_FALSE(std::filesystem::exists(output_path));
+}
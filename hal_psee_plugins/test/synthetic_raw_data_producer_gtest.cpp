@@ -0,0 +1,137 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "boards/synthetic/synthetic_raw_data_producer.h"
+#include "metavision/hal/decoders/evt2/evt2_decoder.h"
+#include "metavision/hal/decoders/evt21/evt21_decoder.h"
+#include "metavision/hal/decoders/evt3/evt3_decoder.h"
+#include "metavision/hal/facilities/i_event_decoder.h"
+#include "metavision/hal/utils/data_transfer.h"
+#include "metavision/hal/utils/hal_exception.h"
+#include "metavision/sdk/base/events/event_cd.h"
+
+using namespace Metavision;
+
+namespace {
+
+std::vector<uint8_t> generate(const SyntheticEventsConfig &config, uint64_t &num_generated_events) {
+    auto producer = std::make_shared<SyntheticRawDataProducer>(config);
+    std::vector<uint8_t> data;
+    DataTransfer transfer(producer);
+    transfer.add_new_buffer_callback(
+        [&data](const DataTransfer::BufferPtr &buffer) { data.insert(data.end(), buffer.cbegin(), buffer.cend()); });
+    transfer.start();
+    while (!transfer.stopped()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    num_generated_events = producer->get_num_generated_events();
+    return data;
+}
+
+std::vector<EventCD> decode(const SyntheticEventsConfig &config, const std::vector<uint8_t> &data) {
+    auto cd_decoder = std::make_shared<I_EventDecoder<EventCD>>();
+    std::vector<EventCD> events;
+    cd_decoder->add_event_buffer_callback(
+        [&events](const EventCD *begin, const EventCD *end) { events.insert(events.end(), begin, end); });
+
+    std::unique_ptr<I_EventsStreamDecoder> decoder;
+    if (config.format_ == "EVT2") {
+        decoder = std::make_unique<EVT2Decoder>(false, cd_decoder);
+    } else if (config.format_ == "EVT21") {
+        decoder = std::make_unique<EVT21Decoder>(false, cd_decoder);
+    } else {
+        decoder = make_evt3_decoder(false, config.height_, config.width_, cd_decoder);
+    }
+    decoder->decode(data.data(), data.data() + data.size());
+    return events;
+}
+
+} // namespace
+
+TEST(SyntheticRawDataProducer_GTest, generates_decodable_events) {
+    using Pattern = SyntheticEventsConfig::Pattern;
+    SyntheticEventsConfig config;
+    config.width_       = 640;
+    config.height_      = 480;
+    config.event_rate_  = 2e6;
+    config.paced_       = false;
+    config.duration_us_ = 50000;
+
+    for (const auto &format : {"EVT2", "EVT21", "EVT3"}) {
+        for (const auto pattern : {Pattern::Uniform, Pattern::Bursts, Pattern::Flicker, Pattern::MovingEdge}) {
+            SCOPED_TRACE(std::string(format) + " pattern " + std::to_string(static_cast<int>(pattern)));
+            config.format_  = format;
+            config.pattern_ = pattern;
+
+            uint64_t num_generated_events = 0;
+            const auto data               = generate(config, num_generated_events);
+            const auto events             = decode(config, data);
+
+            // the mean rate is respected over whole periods of the patterns
+            EXPECT_NEAR(config.event_rate_ * config.duration_us_ * 1e-6, num_generated_events, 1);
+            ASSERT_EQ(num_generated_events, events.size());
+            timestamp last_t = 0;
+            for (const auto &ev : events) {
+                ASSERT_LE(last_t, ev.t);
+                ASSERT_LT(ev.t, config.duration_us_);
+                ASSERT_LT(ev.x, config.width_);
+                ASSERT_LT(ev.y, config.height_);
+                if (pattern == Pattern::Bursts) {
+                    ASSERT_LT(ev.t % 10000, 1000);
+                }
+                last_t = ev.t;
+            }
+        }
+    }
+}
+
+TEST(SyntheticRawDataProducer_GTest, paces_the_data_in_real_time) {
+    SyntheticEventsConfig config;
+    config.event_rate_  = 1e6;
+    config.duration_us_ = 50000;
+
+    const auto start              = std::chrono::steady_clock::now();
+    uint64_t num_generated_events = 0;
+    generate(config, num_generated_events);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::microseconds(config.duration_us_));
+    EXPECT_EQ(50000, num_generated_events);
+}
+
+TEST(SyntheticEventsConfig_GTest, parses_options) {
+    const auto config = SyntheticEventsConfig::parse(
+        "format=evt21,width=320,height=240,rate=1.5M,pattern=edge,paced=false,duration=1000");
+    EXPECT_EQ("EVT21", config.format_);
+    EXPECT_EQ(320, config.width_);
+    EXPECT_EQ(240, config.height_);
+    EXPECT_EQ(1.5e6, config.event_rate_);
+    EXPECT_EQ(SyntheticEventsConfig::Pattern::MovingEdge, config.pattern_);
+    EXPECT_FALSE(config.paced_);
+    EXPECT_EQ(1000, config.duration_us_);
+    EXPECT_EQ("EVT21;height=240;width=320", config.get_format_string());
+
+    const auto default_config = SyntheticEventsConfig::parse("");
+    EXPECT_EQ("EVT3", default_config.format_);
+    EXPECT_TRUE(default_config.paced_);
+
+    EXPECT_THROW(SyntheticEventsConfig::parse("unknown=1"), HalException);
+    EXPECT_THROW(SyntheticEventsConfig::parse("rate=fast"), HalException);
+    EXPECT_THROW(SyntheticEventsConfig::parse("pattern=spiral"), HalException);
+    EXPECT_THROW(SyntheticRawDataProducer(SyntheticEventsConfig::parse("format=evt4")), HalException);
+    EXPECT_THROW(SyntheticRawDataProducer(SyntheticEventsConfig::parse("width=4096")), HalException);
+}
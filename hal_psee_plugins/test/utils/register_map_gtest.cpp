@@ -96,3 +96,125 @@ TEST_F(RegisterAccessTest, should_get_const_accesses_from_const_regmap) {
     EXPECT_TRUE(is_const<decltype(const_regmap["path"]["register"])>());
     EXPECT_TRUE(is_const<decltype(const_regmap[0x123]["register"])>());
 }
+
+static RegmapElement testBurstRegmap[] = {
+    // clang-format off
+    {R, {{"reg0", 0x100}}},
+    {F, {{"low", 0, 8}}},
+    {F, {{"high", 8, 8}}},
+    {R, {{"reg1", 0x104}}},
+    {R, {{"reg2", 0x108}}},
+    {R, {{"reg3", 0x200}}},
+    // clang-format on
+};
+static uint32_t testBurstRegmapSize = sizeof(testBurstRegmap) / sizeof(testBurstRegmap[0]);
+
+class RegisterTransactionTest : public ::testing::Test {
+public:
+    RegisterMap regmap;
+    RegisterTransactionTest() : regmap({std::make_tuple(testBurstRegmap, testBurstRegmapSize, "", 0)}) {}
+
+    MockFunction<void(uint32_t addr, uint32_t val)> write_mock;
+    MockFunction<uint32_t(uint32_t addr)> read_mock;
+    MockFunction<void(uint32_t addr, const std::vector<uint32_t> &values)> write_burst_mock;
+
+    void SetUp() {
+        regmap.set_write_cb(write_mock.AsStdFunction());
+        regmap.set_read_cb(read_mock.AsStdFunction());
+        regmap.set_write_burst_cb(write_burst_mock.AsStdFunction());
+    }
+};
+
+TEST_F(RegisterTransactionTest, should_send_consecutive_writes_as_bursts_on_commit) {
+    EXPECT_CALL(write_mock, Call(_, _)).Times(0);
+
+    auto transaction = regmap.begin_transaction();
+    regmap["reg0"]   = 1;
+    regmap["reg1"]   = 2;
+    regmap["reg3"]   = 3;
+    regmap["reg2"]   = 4;
+    Mock::VerifyAndClearExpectations(&write_burst_mock);
+
+    InSequence seq;
+    EXPECT_CALL(write_burst_mock, Call(0x100, std::vector<uint32_t>({1, 2})));
+    EXPECT_CALL(write_burst_mock, Call(0x200, std::vector<uint32_t>({3})));
+    EXPECT_CALL(write_burst_mock, Call(0x108, std::vector<uint32_t>({4})));
+    transaction.commit();
+}
+
+TEST_F(RegisterTransactionTest, should_coalesce_field_writes_of_a_register) {
+    // the register is read once from the device, the next field write uses the pending value
+    EXPECT_CALL(read_mock, Call(0x100)).WillOnce(Return(0xFF0000));
+    EXPECT_CALL(write_burst_mock, Call(0x100, std::vector<uint32_t>({0xFF3412})));
+
+    auto transaction               = regmap.begin_transaction();
+    regmap["reg0"]["low"]          = 0x12;
+    regmap["reg0"]["high"]         = 0x34;
+    EXPECT_EQ(regmap["reg0"].read_value(), 0xFF3412);
+    transaction.commit();
+}
+
+TEST_F(RegisterTransactionTest, should_not_coalesce_register_writes) {
+    InSequence seq;
+    EXPECT_CALL(write_burst_mock, Call(0x100, std::vector<uint32_t>({1})));
+    EXPECT_CALL(write_burst_mock, Call(0x100, std::vector<uint32_t>({0})));
+
+    auto transaction = regmap.begin_transaction();
+    regmap["reg0"]   = 1;
+    regmap["reg0"]   = 0;
+}
+
+TEST_F(RegisterTransactionTest, should_not_coalesce_field_write_into_register_write) {
+    InSequence seq;
+    EXPECT_CALL(write_burst_mock, Call(0x100, std::vector<uint32_t>({0x101})));
+    EXPECT_CALL(write_burst_mock, Call(0x100, std::vector<uint32_t>({0x100})));
+
+    auto transaction      = regmap.begin_transaction();
+    regmap["reg0"]        = 0x101;
+    regmap["reg0"]["low"] = 0;
+    EXPECT_EQ(regmap["reg0"].read_value(), 0x100);
+}
+
+TEST_F(RegisterTransactionTest, should_not_coalesce_successive_writes_of_a_field) {
+    // the register is read once from the device, and the pulse of the field is sent as two writes
+    EXPECT_CALL(read_mock, Call(0x100)).WillOnce(Return(0xFF0000));
+    InSequence seq;
+    EXPECT_CALL(write_burst_mock, Call(0x100, std::vector<uint32_t>({0xFF0001})));
+    EXPECT_CALL(write_burst_mock, Call(0x100, std::vector<uint32_t>({0xFF0000})));
+
+    auto transaction      = regmap.begin_transaction();
+    regmap["reg0"]["low"] = 1;
+    regmap["reg0"]["low"] = 0;
+}
+
+TEST_F(RegisterTransactionTest, should_commit_when_outermost_transaction_is_committed) {
+    auto transaction = regmap.begin_transaction();
+    {
+        auto nested    = regmap.begin_transaction();
+        regmap["reg0"] = 1;
+    }
+    regmap["reg1"] = 2;
+    Mock::VerifyAndClearExpectations(&write_burst_mock);
+
+    EXPECT_CALL(write_burst_mock, Call(0x100, std::vector<uint32_t>({1, 2})));
+    transaction.commit();
+    Mock::VerifyAndClearExpectations(&write_burst_mock);
+
+    // writes out of a transaction are sent immediately
+    EXPECT_CALL(write_mock, Call(0x104, 3));
+    regmap["reg1"] = 3;
+}
+
+TEST_F(RegisterTransactionTest, should_write_registers_one_by_one_without_burst_callback) {
+    regmap.set_write_burst_cb(nullptr);
+
+    InSequence seq;
+    EXPECT_CALL(write_mock, Call(0x100, 1));
+    EXPECT_CALL(write_mock, Call(0x104, 2));
+    EXPECT_CALL(write_mock, Call(0x108, 3));
+
+    auto transaction = regmap.begin_transaction();
+    regmap["reg0"]   = 1;
+    regmap["reg1"]   = 2;
+    regmap["reg2"]   = 3;
+}
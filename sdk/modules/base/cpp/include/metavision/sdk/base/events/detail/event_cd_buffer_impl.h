@@ -0,0 +1,234 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_BASE_EVENT_CD_BUFFER_IMPL_H
+#define METAVISION_SDK_BASE_EVENT_CD_BUFFER_IMPL_H
+
+#include <limits>
+#include <utility>
+
+namespace Metavision {
+
+inline EventCDBuffer::EventCDBuffer(bool relative_timestamps) :
+    relative_timestamps_requested_(relative_timestamps), relative_timestamps_(relative_timestamps) {}
+
+inline bool EventCDBuffer::has_relative_timestamps() const {
+    return relative_timestamps_;
+}
+
+inline timestamp EventCDBuffer::time_base() const {
+    return time_base_;
+}
+
+inline std::size_t EventCDBuffer::size() const {
+    return x_.size();
+}
+
+inline bool EventCDBuffer::empty() const {
+    return x_.empty();
+}
+
+inline void EventCDBuffer::clear() {
+    x_.clear();
+    y_.clear();
+    p_.clear();
+    t_.clear();
+    relative_t_.clear();
+    time_base_           = 0;
+    relative_timestamps_ = relative_timestamps_requested_;
+}
+
+inline void EventCDBuffer::reserve(std::size_t n) {
+    x_.reserve(n);
+    y_.reserve(n);
+    p_.reserve(n);
+    if (relative_timestamps_) {
+        relative_t_.reserve(n);
+    } else {
+        t_.reserve(n);
+    }
+}
+
+inline void EventCDBuffer::push_back(const EventCD &ev) {
+    emplace_back(ev.x, ev.y, ev.p, ev.t);
+}
+
+inline void EventCDBuffer::emplace_back(std::uint16_t x, std::uint16_t y, std::int16_t p, timestamp t) {
+    const std::size_t i = size();
+    if (i == 0) {
+        time_base_ = t;
+    }
+    resize(i + 1);
+    x_[i] = x;
+    y_[i] = y;
+    p_[i] = p;
+    set_t(i, t);
+}
+
+template<typename InputIt>
+inline void EventCDBuffer::append(InputIt begin, InputIt end) {
+    if (begin == end) {
+        return;
+    }
+    std::size_t i = size();
+    if (i == 0) {
+        time_base_ = begin->t;
+    }
+    resize(i + std::distance(begin, end));
+    for (auto it = begin; it != end; ++it, ++i) {
+        x_[i] = it->x;
+        y_[i] = it->y;
+        p_[i] = it->p;
+        set_t(i, it->t);
+    }
+}
+
+template<typename Predicate>
+inline void EventCDBuffer::append_if(const EventCDBuffer &other, Predicate &&pred) {
+    const std::size_t n = other.size();
+    if (n == 0) {
+        return;
+    }
+    const std::size_t offset = size();
+    if (offset == 0) {
+        time_base_ = other.relative_timestamps_ ? other.time_base_ : other.t(0);
+    }
+    resize(offset + n);
+
+    const bool same_timestamps_layout =
+        relative_timestamps_ == other.relative_timestamps_ && (!relative_timestamps_ || time_base_ == other.time_base_);
+    std::size_t k = offset;
+    if (same_timestamps_layout) {
+        // every event is written, and the position of the next one is only advanced if the event is kept
+        if (relative_timestamps_) {
+            for (std::size_t j = 0; j < n; ++j) {
+                x_[k]          = other.x_[j];
+                y_[k]          = other.y_[j];
+                p_[k]          = other.p_[j];
+                relative_t_[k] = other.relative_t_[j];
+                k += pred(j) ? 1 : 0;
+            }
+        } else {
+            for (std::size_t j = 0; j < n; ++j) {
+                x_[k] = other.x_[j];
+                y_[k] = other.y_[j];
+                p_[k] = other.p_[j];
+                t_[k] = other.t_[j];
+                k += pred(j) ? 1 : 0;
+            }
+        }
+    } else {
+        for (std::size_t j = 0; j < n; ++j) {
+            if (pred(j)) {
+                x_[k] = other.x_[j];
+                y_[k] = other.y_[j];
+                p_[k] = other.p_[j];
+                set_t(k, other.t(j));
+                ++k;
+            }
+        }
+    }
+    resize(k);
+}
+
+inline EventCD EventCDBuffer::operator[](std::size_t i) const {
+    return EventCD(x_[i], y_[i], p_[i], t(i));
+}
+
+inline timestamp EventCDBuffer::t(std::size_t i) const {
+    return relative_timestamps_ ? time_base_ + relative_t_[i] : t_[i];
+}
+
+inline const std::uint16_t *EventCDBuffer::x_data() const {
+    return x_.data();
+}
+
+inline std::uint16_t *EventCDBuffer::x_data() {
+    return x_.data();
+}
+
+inline const std::uint16_t *EventCDBuffer::y_data() const {
+    return y_.data();
+}
+
+inline std::uint16_t *EventCDBuffer::y_data() {
+    return y_.data();
+}
+
+inline const std::int16_t *EventCDBuffer::p_data() const {
+    return p_.data();
+}
+
+inline std::int16_t *EventCDBuffer::p_data() {
+    return p_.data();
+}
+
+inline const timestamp *EventCDBuffer::t_data() const {
+    return relative_timestamps_ ? nullptr : t_.data();
+}
+
+inline const std::uint32_t *EventCDBuffer::relative_t_data() const {
+    return relative_timestamps_ ? relative_t_.data() : nullptr;
+}
+
+inline EventCDBuffer::const_iterator EventCDBuffer::begin() const {
+    return const_iterator(this, 0);
+}
+
+inline EventCDBuffer::const_iterator EventCDBuffer::end() const {
+    return const_iterator(this, size());
+}
+
+inline void EventCDBuffer::swap(EventCDBuffer &other) {
+    std::swap(x_, other.x_);
+    std::swap(y_, other.y_);
+    std::swap(p_, other.p_);
+    std::swap(t_, other.t_);
+    std::swap(relative_t_, other.relative_t_);
+    std::swap(time_base_, other.time_base_);
+    std::swap(relative_timestamps_requested_, other.relative_timestamps_requested_);
+    std::swap(relative_timestamps_, other.relative_timestamps_);
+}
+
+inline void EventCDBuffer::resize(std::size_t n) {
+    x_.resize(n);
+    y_.resize(n);
+    p_.resize(n);
+    if (relative_timestamps_) {
+        relative_t_.resize(n);
+    } else {
+        t_.resize(n);
+    }
+}
+
+inline void EventCDBuffer::set_t(std::size_t i, timestamp t) {
+    if (relative_timestamps_) {
+        if (t >= time_base_ && t - time_base_ <= std::numeric_limits<std::uint32_t>::max()) {
+            relative_t_[i] = static_cast<std::uint32_t>(t - time_base_);
+            return;
+        }
+        make_absolute();
+    }
+    t_[i] = t;
+}
+
+inline void EventCDBuffer::make_absolute() {
+    t_.resize(relative_t_.size());
+    for (std::size_t i = 0; i < relative_t_.size(); ++i) {
+        t_[i] = time_base_ + relative_t_[i];
+    }
+    relative_t_.clear();
+    relative_timestamps_ = false;
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_BASE_EVENT_CD_BUFFER_IMPL_H
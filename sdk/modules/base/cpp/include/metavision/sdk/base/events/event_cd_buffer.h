@@ -0,0 +1,298 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_BASE_EVENT_CD_BUFFER_H
+#define METAVISION_SDK_BASE_EVENT_CD_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Buffer of CD events stored as a structure of arrays
+///
+/// The x, y, polarity and timestamp of the events are stored in separate contiguous arrays, so that the processing
+/// only reading some of the fields (e.g. the coordinates to filter or to accumulate the events, or the timestamps to
+/// slice them) only loads those fields, and can be vectorized by the compiler.
+///
+/// The timestamps can optionally be stored as 32-bit offsets from the timestamp of the first event of the buffer,
+/// halving the memory used by the timestamps. If an event can not be represented this way (i.e. it is older than the
+/// first event or more than ~71 minutes after it), the buffer switches back to absolute timestamps.
+///
+/// The buffer can also be iterated over as a sequence of @ref EventCD, which are built on the fly, so that it can be
+/// passed to the algorithms processing iterators over @ref EventCD.
+class EventCDBuffer {
+public:
+    class const_iterator;
+
+    /// @brief Constructor
+    /// @param relative_timestamps If true, the timestamps are stored as 32-bit offsets from the first event's one
+    inline explicit EventCDBuffer(bool relative_timestamps = false);
+
+    /// @brief Checks if the timestamps are stored as 32-bit offsets
+    /// @return true if the timestamps are stored as offsets from @ref time_base, false otherwise
+    inline bool has_relative_timestamps() const;
+
+    /// @brief Gets the timestamp from which the relative timestamps are counted
+    /// @return Timestamp of the first event, if the timestamps are relative and the buffer is not empty
+    inline timestamp time_base() const;
+
+    /// @brief Gets the number of events in the buffer
+    /// @return Number of events
+    inline std::size_t size() const;
+
+    /// @brief Checks if the buffer is empty
+    /// @return true if the buffer has no events, false otherwise
+    inline bool empty() const;
+
+    /// @brief Removes all the events
+    ///
+    /// If the buffer was created with relative timestamps, they are used again for the next events.
+    inline void clear();
+
+    /// @brief Reserves memory for a number of events
+    /// @param n Number of events
+    inline void reserve(std::size_t n);
+
+    /// @brief Adds an event at the end of the buffer
+    /// @param ev Event to add
+    inline void push_back(const EventCD &ev);
+
+    /// @brief Adds an event at the end of the buffer
+    /// @param x Column position of the event
+    /// @param y Row position of the event
+    /// @param p Polarity of the event
+    /// @param t Timestamp of the event
+    inline void emplace_back(std::uint16_t x, std::uint16_t y, std::int16_t p, timestamp t);
+
+    /// @brief Adds a sequence of events at the end of the buffer
+    ///
+    /// This is meant to transpose the buffers of events produced by the decoders.
+    /// @tparam InputIt Iterator over @ref EventCD or equivalent
+    /// @param begin Iterator to the first event to add
+    /// @param end Iterator to the past-the-end event to add
+    template<typename InputIt>
+    inline void append(InputIt begin, InputIt end);
+
+    /// @brief Adds the events of another buffer for which a predicate is true
+    ///
+    /// The events are copied without branching on the predicate, which makes this method efficient even when the
+    /// predicate is unpredictable.
+    /// @tparam Predicate Function taking the index of an event in @p other and returning true if it must be added
+    /// @param other Buffer of the events to add, must be different from this buffer
+    /// @param pred Predicate
+    template<typename Predicate>
+    inline void append_if(const EventCDBuffer &other, Predicate &&pred);
+
+    /// @brief Gets an event
+    /// @param i Index of the event
+    /// @return Event at the given index
+    inline EventCD operator[](std::size_t i) const;
+
+    /// @brief Gets the timestamp of an event
+    /// @param i Index of the event
+    /// @return Timestamp of the event at the given index
+    inline timestamp t(std::size_t i) const;
+
+    /// @brief Gets the array of the x coordinates
+    /// @return Pointer to the x coordinate of the first event
+    inline const std::uint16_t *x_data() const;
+
+    /// @brief Gets the array of the x coordinates
+    /// @return Pointer to the x coordinate of the first event
+    inline std::uint16_t *x_data();
+
+    /// @brief Gets the array of the y coordinates
+    /// @return Pointer to the y coordinate of the first event
+    inline const std::uint16_t *y_data() const;
+
+    /// @brief Gets the array of the y coordinates
+    /// @return Pointer to the y coordinate of the first event
+    inline std::uint16_t *y_data();
+
+    /// @brief Gets the array of the polarities
+    /// @return Pointer to the polarity of the first event
+    inline const std::int16_t *p_data() const;
+
+    /// @brief Gets the array of the polarities
+    /// @return Pointer to the polarity of the first event
+    inline std::int16_t *p_data();
+
+    /// @brief Gets the array of the absolute timestamps
+    /// @return Pointer to the timestamp of the first event, or nullptr if the timestamps are relative
+    inline const timestamp *t_data() const;
+
+    /// @brief Gets the array of the relative timestamps
+    /// @return Pointer to the offset of the first event from @ref time_base, or nullptr if the timestamps are absolute
+    inline const std::uint32_t *relative_t_data() const;
+
+    /// @brief Gets an iterator to the first event
+    /// @return Iterator to the first event
+    inline const_iterator begin() const;
+
+    /// @brief Gets an iterator to the past-the-end event
+    /// @return Iterator to the past-the-end event
+    inline const_iterator end() const;
+
+    /// @brief Swaps the events of two buffers
+    /// @param other Buffer to swap with
+    inline void swap(EventCDBuffer &other);
+
+private:
+    inline void resize(std::size_t n);
+    inline void set_t(std::size_t i, timestamp t);
+    inline void make_absolute();
+
+    std::vector<std::uint16_t> x_;
+    std::vector<std::uint16_t> y_;
+    std::vector<std::int16_t> p_;
+    std::vector<timestamp> t_;
+    std::vector<std::uint32_t> relative_t_;
+    timestamp time_base_{0};
+    bool relative_timestamps_requested_;
+    bool relative_timestamps_;
+};
+
+/// @brief Random access iterator over the events of an @ref EventCDBuffer
+///
+/// The iterator is read-only: the events are built on the fly when dereferenced, and returned by value.
+class EventCDBuffer::const_iterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = EventCD;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = EventCD;
+
+    /// @brief Proxy returned by operator->, holding the event it points to
+    struct pointer {
+        const EventCD *operator->() const {
+            return &ev;
+        }
+        EventCD ev;
+    };
+
+    const_iterator() = default;
+
+    reference operator*() const {
+        return (*buffer_)[index_];
+    }
+
+    pointer operator->() const {
+        return pointer{(*buffer_)[index_]};
+    }
+
+    reference operator[](difference_type n) const {
+        return (*buffer_)[index_ + n];
+    }
+
+    const_iterator &operator++() {
+        ++index_;
+        return *this;
+    }
+
+    const_iterator operator++(int) {
+        const_iterator it = *this;
+        ++index_;
+        return it;
+    }
+
+    const_iterator &operator--() {
+        --index_;
+        return *this;
+    }
+
+    const_iterator operator--(int) {
+        const_iterator it = *this;
+        --index_;
+        return it;
+    }
+
+    const_iterator &operator+=(difference_type n) {
+        index_ += n;
+        return *this;
+    }
+
+    const_iterator &operator-=(difference_type n) {
+        index_ -= n;
+        return *this;
+    }
+
+    friend const_iterator operator+(const_iterator it, difference_type n) {
+        return it += n;
+    }
+
+    friend const_iterator operator+(difference_type n, const_iterator it) {
+        return it += n;
+    }
+
+    friend const_iterator operator-(const_iterator it, difference_type n) {
+        return it -= n;
+    }
+
+    friend difference_type operator-(const const_iterator &lhs, const const_iterator &rhs) {
+        return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+    }
+
+    friend bool operator==(const const_iterator &lhs, const const_iterator &rhs) {
+        return lhs.index_ == rhs.index_;
+    }
+
+    friend bool operator!=(const const_iterator &lhs, const const_iterator &rhs) {
+        return lhs.index_ != rhs.index_;
+    }
+
+    friend bool operator<(const const_iterator &lhs, const const_iterator &rhs) {
+        return lhs.index_ < rhs.index_;
+    }
+
+    friend bool operator>(const const_iterator &lhs, const const_iterator &rhs) {
+        return lhs.index_ > rhs.index_;
+    }
+
+    friend bool operator<=(const const_iterator &lhs, const const_iterator &rhs) {
+        return lhs.index_ <= rhs.index_;
+    }
+
+    friend bool operator>=(const const_iterator &lhs, const const_iterator &rhs) {
+        return lhs.index_ >= rhs.index_;
+    }
+
+    /// @brief Gets the buffer the iterator points into
+    /// @return Buffer of the events
+    const EventCDBuffer &buffer() const {
+        return *buffer_;
+    }
+
+    /// @brief Gets the index of the event the iterator points to
+    /// @return Index of the event in the buffer
+    std::size_t index() const {
+        return index_;
+    }
+
+private:
+    friend class EventCDBuffer;
+
+    const_iterator(const EventCDBuffer *buffer, std::size_t index) : buffer_(buffer), index_(index) {}
+
+    const EventCDBuffer *buffer_ = nullptr;
+    std::size_t index_           = 0;
+};
+
+} // namespace Metavision
+
+#include "metavision/sdk/base/events/detail/event_cd_buffer_impl.h"
+
+#endif // METAVISION_SDK_BASE_EVENT_CD_BUFFER_H
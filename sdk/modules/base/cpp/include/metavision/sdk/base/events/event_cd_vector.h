@@ -12,9 +12,12 @@
 #ifndef METAVISION_SDK_BASE_EVENT_CD_VECTOR_H
 #define METAVISION_SDK_BASE_EVENT_CD_VECTOR_H
 
+#include <bitset>
 #include <cstdint>
 #include <iostream>
 
+#include "metavision/sdk/base/utils/detail/bitinstructions.h"
+#include "metavision/sdk/base/utils/detail/deprecated_feature.h"
 #include "metavision/sdk/base/utils/timestamp.h"
 
 namespace Metavision {
@@ -22,6 +25,10 @@ namespace Metavision {
 /// @brief Class representing Vectorized 2D CD (Contrast Detection) events:
 /// @details vector_mask represents 32 potentially triggered events in a single lane as a 32bit value.
 /// Each set bit represents a triggered event at pos(base_x + vector_mask[i], y)
+///
+/// The polarity and timestamp fields are named as in @ref EventCD, so that the algorithms only relying on them (e.g.
+/// time slicing) can process both types of events. Their former names, polarity and event_timestamp, are deprecated
+/// aliases of the same fields.
 class EventCDVector {
 public:
 
@@ -36,17 +43,17 @@ public:
         timestamp event_timestamp
     ) :
         base_x(base_x), y(y),
-        polarity(polarity),
+        p(polarity),
         vector_mask(vector_mask),
-        event_timestamp(event_timestamp)
+        t(event_timestamp)
     {}
 
     inline bool operator==(const EventCDVector &rhs) const {
         return (
-            (polarity == rhs.polarity) && 
+            (p == rhs.p) &&
             (base_x == rhs.base_x) && (y == rhs.y) &&
-            (vector_mask == rhs.vector_mask) && 
-            (event_timestamp == rhs.event_timestamp)
+            (vector_mask == rhs.vector_mask) &&
+            (t == rhs.t)
         );
     }
 
@@ -57,18 +64,42 @@ public:
         output 
                 << rhs.base_x << ", "
                 << rhs.y << ", "
-                << (int)rhs.polarity << ", " 
-                << rhs.vector_mask << ", " 
-                << rhs.event_timestamp;
+                << (int)rhs.p << ", "
+                << rhs.vector_mask << ", "
+                << rhs.t;
 
         output << ")";
         return output;
     }
-   
+
+    /// @brief Gets the number of events in the vector
+    /// @return Number of bits set in the vector mask
+    inline int size() const {
+        return static_cast<int>(std::bitset<32>(vector_mask).count());
+    }
+
+    /// @brief Calls a function with the x coordinate of each event of the vector, in increasing order
+    /// @tparam Function Type of a function callable with a uint16_t
+    /// @param f Function to call
+    template<typename Function>
+    inline void for_each_x(Function &&f) const {
+        for (uint32_t mask = vector_mask; mask != 0; mask &= mask - 1) {
+            f(static_cast<uint16_t>(base_x + ctz_not_zero(mask)));
+        }
+    }
+
     uint16_t base_x, y;
-    bool polarity;
+    union {
+        bool p;
+        /// @deprecated Use @ref p instead
+        METAVISION_DEPRECATED_FEATURE(5.2.0) bool polarity;
+    };
     uint32_t vector_mask;
-    timestamp event_timestamp;
+    union {
+        timestamp t;
+        /// @deprecated Use @ref t instead
+        METAVISION_DEPRECATED_FEATURE(5.2.0) timestamp event_timestamp;
+    };
 
 };
 
@@ -74,6 +74,32 @@ public:
 #endif
 
 namespace detail {
+// Checks the level before building the strings of the operation, so that a filtered operation costs no allocation
+template<LogLevel Level, typename PrefixFmt>
+LoggingOperation<Level> makeLoggingOperation(const PrefixFmt &prefixFmt, const char *file, int line,
+                                             const char *function) {
+    const LogOptions opts = getLogOptions();
+    if (Level < opts.getLevel()) {
+        return LoggingOperation<Level>(opts);
+    }
+    return LoggingOperation<Level>(opts, prefixFmt, file, line, function);
+}
+
+template<LogLevel Level>
+LoggingOperation<Level> log(const char *file, int line, const char *function) {
+    return makeLoggingOperation<Level>("", file, line, function);
+}
+
+template<LogLevel Level>
+LoggingOperation<Level> log(const char *file, int line, const char *function, const std::string &prefixFmt) {
+    return makeLoggingOperation<Level>(prefixFmt, file, line, function);
+}
+
+template<LogLevel Level>
+LoggingOperation<Level> log(const char *file, int line, const char *function, const char *const prefixFmt) {
+    return makeLoggingOperation<Level>(prefixFmt, file, line, function);
+}
+
 template<LogLevel Level>
 LoggingOperation<Level> log(const std::filesystem::path &file, int line, const std::string &function) {
     return LoggingOperation<Level>(getLogOptions(), "", file, line, function);
@@ -199,10 +225,27 @@ protected:
     int sync() override;
 
 private:
+    friend struct log_stream;
+
     std::vector<char> bytes_;
     std::streambuf *buf_;
     bool has_output_;
+    bool async_;
 };
+
+// Stream in which a logging operation formats its message, recycled from one operation to the other by the thread
+// that created it so that logging does not allocate once the buffers are large enough
+struct log_stream {
+    log_stream() : streambuf(nullptr), stream(&streambuf) {}
+
+    // Sets the stream back to its initial state, before it is used by a new operation
+    void reset(std::streambuf *buf, bool async);
+
+    concurrent_ostreambuf streambuf;
+    std::ostream stream;
+};
+
+log_stream *acquireLogStream(std::streambuf *buf, bool async);
 } // namespace detail
 
 template<LogLevel Level>
@@ -211,17 +254,19 @@ constexpr LogLevel LoggingOperation<Level>::Level;
 template<LogLevel Level>
 LoggingOperation<Level>::LoggingOperation(const LogOptions &opts, const std::string &prefixFmt,
                                           const std::filesystem::path &file, int line, const std::string &function) :
-    streambuf_(new detail::concurrent_ostreambuf(opts.getStream().rdbuf())),
-    stream_(new std::ostream(streambuf_.get())),
+    stream_(Level >= opts.getLevel() ? detail::acquireLogStream(opts.getStream().rdbuf(), opts.isAsynchronous()) :
+                                       nullptr),
     addSpaceBetweenTokens_(true),
     addEndLine_(true),
-    should_output_(Level >= opts.getLevel()),
-    prefix_(detail::getLogPrefixFormatString<Level>(opts.isLevelPrefixPadding(), prefixFmt, file, line, function)),
-    file_(file),
-    function_(function),
+    should_output_(stream_ != nullptr),
+    prefix_(should_output_ ? detail::getLogPrefixFormatString<Level>(opts.isLevelPrefixPadding(), prefixFmt, file,
+                                                                      line, function) :
+                             std::string()),
+    function_(should_output_ ? function : std::string()),
+    file_(should_output_ ? file : std::filesystem::path()),
     line_(line) {
     if (should_output_)
-        (*stream_) << prefix_;
+        stream_->stream << prefix_;
 }
 
 template<LogLevel Level>
@@ -234,8 +279,8 @@ template<LogLevel Level>
 LoggingOperation<Level>::~LoggingOperation() {
     if (stream_ && should_output_) {
         if (addEndLine_)
-            (*stream_) << "\n";
-        stream_->flush();
+            stream_->stream << "\n";
+        stream_->stream.flush();
     }
 }
 
@@ -283,9 +328,9 @@ template<LogLevel Level>
 template<typename T>
 void LoggingOperation<Level>::log(const T &t) {
     if (stream_ && should_output_) {
-        streambuf_->reset_output_sentinel();
-        (*stream_) << t;
-        if (streambuf_->get_output_sentinel()) {
+        stream_->streambuf.reset_output_sentinel();
+        stream_->stream << t;
+        if (stream_->streambuf.get_output_sentinel()) {
             handleSpace();
         }
     }
@@ -294,7 +339,7 @@ void LoggingOperation<Level>::log(const T &t) {
 template<LogLevel Level>
 void LoggingOperation<Level>::log(bool b) {
     if (stream_ && should_output_) {
-        (*stream_) << (b ? "true" : "false");
+        stream_->stream << (b ? "true" : "false");
 
         handleSpace();
     }
@@ -304,13 +349,13 @@ template<LogLevel Level>
 template<typename T>
 void LoggingOperation<Level>::log(const std::vector<T> &v) {
     if (stream_ && should_output_) {
-        (*stream_) << "[ ";
+        stream_->stream << "[ ";
         using SizeType = typename std::vector<T>::size_type;
         for (SizeType i = 0; i < v.size() - 1; ++i) {
-            (*stream_) << v[i] << ", ";
+            stream_->stream << v[i] << ", ";
         }
-        (*stream_) << v.back();
-        (*stream_) << " ]";
+        stream_->stream << v.back();
+        stream_->stream << " ]";
 
         handleSpace();
     }
@@ -319,14 +364,14 @@ void LoggingOperation<Level>::log(const std::vector<T> &v) {
 template<LogLevel Level>
 void LoggingOperation<Level>::apply(std::ostream &(*manip)(std::ostream &)) {
     if (stream_ && should_output_) {
-        (*stream_) << manip;
+        stream_->stream << manip;
     }
 }
 
 template<LogLevel Level>
 void LoggingOperation<Level>::handleSpace() {
     if (addSpaceBetweenTokens_)
-        (*stream_) << " ";
+        stream_->stream << " ";
 }
 
 template<LogLevel Level, typename T>
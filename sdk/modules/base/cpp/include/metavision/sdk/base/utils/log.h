@@ -113,6 +113,12 @@ void setLogStream(std::ostream &stream);
 /// @brief Resets the current logging stream read from the environment variable MV_LOG_FILE
 void resetLogStreamFromEnv();
 
+/// @brief Waits until all the messages logged asynchronously so far are written in their stream
+///
+/// A stream in which messages were logged asynchronously must not be destroyed before this function is called.
+/// @sa @ref LogOptions::setAsynchronous
+void flushLogs();
+
 /// @brief Struct that defines the settings used for the logging behaviors
 class LogOptions {
 private:
@@ -126,6 +132,9 @@ private:
     /// so that all level label will be displayed with a fixed length.
     bool level_prefix_padding_ = false;
 
+    /// @brief When set to true, the messages are written in the stream by a background thread
+    bool asynchronous_ = false;
+
 public:
     /// @brief Construct a LogOptions object.
     /// @param level The current level of logging
@@ -190,6 +199,32 @@ public:
     /// @brief Is the "[level]" prefix padded with white spaces
     /// @return a boolean that defines if the option is enabled
     bool isLevelPrefixPadding() const;
+
+    /// @brief Defines if the messages are written in the stream asynchronously
+    ///
+    /// When enabled, a logging operation formats its message in a stream recycled from one operation to the other,
+    /// and pushes it in a lock-free buffer owned by the calling thread when it is done. A background thread then
+    /// writes the messages of all the threads in their stream, so that logging never waits for the stream or for
+    /// the other threads. If the buffer of a thread is full, its messages are dropped, and the number of dropped
+    /// messages is written in the stream instead.
+    ///
+    /// The messages of a thread are written in order, but the messages of different threads may be interleaved in a
+    /// different order than they were logged.
+    ///
+    /// @param is_asynchronous If true, the messages are written asynchronously
+    /// @return The current LogOptions object
+    /// @note By default, the messages are written synchronously
+    /// @note It is also possible to enable the asynchronous logging by setting the environment variable MV_LOG_ASYNC
+    /// to 1 (or to disable it by setting it to 0). If the environment variable is set, it will have precedence over
+    /// the value set by this function. The size in bytes of the buffer of each thread can be set with the environment
+    /// variable MV_LOG_ASYNC_BUFFER_SIZE (65536 by default).
+    /// @warning A stream in which messages were logged asynchronously must not be destroyed before @ref flushLogs is
+    /// called
+    LogOptions &setAsynchronous(bool is_asynchronous);
+
+    /// @brief Are the messages written in the stream asynchronously
+    /// @return a boolean that defines if the option is enabled
+    bool isAsynchronous() const;
 };
 
 /// @brief define global options to tweak logging behavior
@@ -208,7 +243,11 @@ void resetLogOptions();
 // Forward declaration
 namespace detail {
 class concurrent_ostreambuf;
-}
+struct log_stream;
+struct log_stream_deleter {
+    void operator()(log_stream *stream) const;
+};
+} // namespace detail
 
 /// @brief Base class for any logging operation
 ///
@@ -322,8 +361,7 @@ public:
 private:
     void handleSpace();
 
-    std::unique_ptr<detail::concurrent_ostreambuf> streambuf_;
-    std::unique_ptr<std::ostream> stream_;
+    std::unique_ptr<detail::log_stream, detail::log_stream_deleter> stream_;
     bool addSpaceBetweenTokens_;
     bool addEndLine_;
     bool should_output_;
@@ -0,0 +1,124 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_BASE_TRACE_RECORDER_H
+#define METAVISION_SDK_BASE_TRACE_RECORDER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+/// @brief Records the duration of the enclosing scope in the trace, if tracing is enabled
+/// @param name Name of the slice, must be a string literal
+#define MV_TRACE_SCOPE(name) Metavision::TraceScope MV_TRACE_CONCAT(mv_trace_scope_, __LINE__)(name)
+
+/// @brief Records the value of a counter in the trace, if tracing is enabled
+/// @param name Name of the counter, must be a string literal
+/// @param value Value of the counter
+#define MV_TRACE_COUNTER(name, value)                                                         \
+    do {                                                                                      \
+        if (Metavision::TraceRecorder::is_enabled()) {                                        \
+            Metavision::TraceRecorder::instance().add_counter_event(name, std::int64_t(value)); \
+        }                                                                                     \
+    } while (0)
+
+#define MV_TRACE_CONCAT_IMPL(a, b) a##b
+#define MV_TRACE_CONCAT(a, b) MV_TRACE_CONCAT_IMPL(a, b)
+
+namespace Metavision {
+
+/// @brief Records duration and counter events in per-thread ring buffers and saves them in the Chrome Tracing format
+///
+/// Tracing is enabled by setting the environment variable MV_TRACE_FILE to the path of the file in which the trace
+/// is saved when the process exits. Each thread records its events in its own ring buffer, so that recording an event
+/// never blocks on other threads, and only the most recent events are kept: MV_TRACE_BUFFER_SIZE can be set to the
+/// number of events kept per thread (65536 by default).
+///
+/// When tracing is disabled, the cost of the instrumentation is a check of a flag per traced scope or counter.
+///
+/// The saved file can be opened in chrome://tracing or https://ui.perfetto.dev
+class TraceRecorder {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Checks if tracing was enabled through the environment
+    /// @return true if MV_TRACE_FILE is set, false otherwise
+    static bool is_enabled();
+
+    /// @brief Gets the trace recorder of the process
+    /// @return Trace recorder instance
+    static TraceRecorder &instance();
+
+    /// @brief Records a complete duration slice on the calling thread
+    /// @param name Name of the slice, must outlive the recorder (e.g. a string literal)
+    /// @param start Time at which the slice started
+    /// @param end Time at which the slice ended
+    void add_complete_event(const char *name, const Clock::time_point &start, const Clock::time_point &end);
+
+    /// @brief Records the value of a counter
+    /// @param name Name of the counter, must outlive the recorder (e.g. a string literal)
+    /// @param value Value of the counter
+    void add_counter_event(const char *name, std::int64_t value);
+
+    /// @brief Names the calling thread in the trace
+    /// @param name Name of the thread
+    void set_thread_name(const std::string &name);
+
+    /// @brief Saves the events recorded so far
+    ///
+    /// The events are kept, so that the trace can be saved several times.
+    /// @param path Path of the output file
+    /// @return true if the trace could be saved, false otherwise
+    bool save(const std::filesystem::path &path) const;
+
+    /// @brief Saves the events recorded so far in the file specified by MV_TRACE_FILE
+    /// @return true if the trace could be saved, false otherwise
+    bool save() const;
+
+private:
+    TraceRecorder();
+
+    struct Private;
+    std::unique_ptr<Private> pimpl_;
+};
+
+/// @brief Records the duration of its lifetime as a complete duration slice, if tracing is enabled
+class TraceScope {
+public:
+    /// @brief Constructor
+    /// @param name Name of the slice, must outlive the recorder (e.g. a string literal)
+    explicit TraceScope(const char *name) : name_(TraceRecorder::is_enabled() ? name : nullptr) {
+        if (name_) {
+            start_ = TraceRecorder::Clock::now();
+        }
+    }
+
+    /// @brief Destructor, records the slice
+    ~TraceScope() {
+        if (name_) {
+            TraceRecorder::instance().add_complete_event(name_, start_, TraceRecorder::Clock::now());
+        }
+    }
+
+    TraceScope(const TraceScope &)            = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+    const char *name_;
+    TraceRecorder::Clock::time_point start_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_BASE_TRACE_RECORDER_H
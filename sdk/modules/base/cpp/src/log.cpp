@@ -9,10 +9,16 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 #include <memory>
 #include <mutex>
+#include <thread>
 #ifdef __ANDROID__
 #include <android/log.h>
 #include <dlfcn.h>
@@ -65,10 +71,295 @@ std::ostream android_stream(reinterpret_cast<std::streambuf *>(&streambuf));
 #endif
 
 std::mutex concurrent_ostreambuf_mutex;
+
+// Returns 1 or 0 if MV_LOG_ASYNC enables or disables the asynchronous logging, -1 if it is not set
+int get_log_async_env() {
+    static const int async = []() {
+        const char *env = std::getenv("MV_LOG_ASYNC");
+        if (env && *env) {
+            return (std::string(env) == "0" || std::string(env) == "false") ? 0 : 1;
+        }
+        return -1;
+    }();
+    return async;
+}
+
+std::size_t get_log_async_buffer_size_env() {
+    std::size_t size        = 65536;
+    const char *buffer_size = std::getenv("MV_LOG_ASYNC_BUFFER_SIZE");
+    if (buffer_size) {
+        const long long env_size = std::atoll(buffer_size);
+        if (env_size > 0) {
+            size = static_cast<std::size_t>(env_size);
+        }
+    }
+    // the capacity is a power of two, large enough to hold a few records
+    std::size_t capacity = 256;
+    while (capacity < size) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+// Single producer single consumer ring of the messages logged asynchronously by a thread
+//
+// Each message is stored contiguously after a header, padded to the size of the header. When a message does not fit
+// before the end of the buffer, a padding record with no stream fills the end of the buffer.
+class AsyncLogRing {
+public:
+    struct Header {
+        std::streambuf *dest;
+        std::size_t size;
+    };
+
+    explicit AsyncLogRing(std::size_t capacity) : data_(capacity), mask_(capacity - 1) {}
+
+    static std::size_t record_size(std::size_t size) {
+        return sizeof(Header) + ((size + sizeof(Header) - 1) / sizeof(Header)) * sizeof(Header);
+    }
+
+    std::size_t capacity() const {
+        return data_.size();
+    }
+
+    // Called by the owning thread only, returns false if the message was dropped because the ring is full
+    bool push(std::streambuf *dest, const char *bytes, std::size_t size) {
+        const std::size_t rec_size = record_size(size);
+        std::size_t tail           = tail_.load(std::memory_order_relaxed);
+        const std::size_t head     = head_.load(std::memory_order_acquire);
+        const std::size_t to_end   = data_.size() - (tail & mask_);
+        const std::size_t padding  = rec_size > to_end ? to_end : 0;
+        if (tail + padding + rec_size - head > data_.size()) {
+            dropped_dest_.store(dest, std::memory_order_relaxed);
+            dropped_.fetch_add(1, std::memory_order_release);
+            return false;
+        }
+        if (padding) {
+            write_header(tail, {nullptr, padding});
+            tail += padding;
+        }
+        write_header(tail, {dest, size});
+        std::memcpy(&data_[(tail & mask_) + sizeof(Header)], bytes, size);
+        tail_.store(tail + rec_size, std::memory_order_release);
+        return true;
+    }
+
+    // Called by the consumer only, calls write(dest, bytes, size) on each message, oldest first
+    template<typename Writer>
+    void drain(Writer &&write) {
+        std::size_t head       = head_.load(std::memory_order_relaxed);
+        const std::size_t tail = tail_.load(std::memory_order_acquire);
+        while (head != tail) {
+            Header header;
+            std::memcpy(&header, &data_[head & mask_], sizeof(Header));
+            if (header.dest) {
+                write(header.dest, &data_[(head & mask_) + sizeof(Header)], header.size);
+                head += record_size(header.size);
+            } else {
+                head += header.size;
+            }
+        }
+        head_.store(head, std::memory_order_release);
+    }
+
+    bool is_half_full() const {
+        return 2 * (tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_relaxed)) > data_.size();
+    }
+
+    bool empty() const {
+        return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+    }
+
+    // Returns the number of messages dropped since the last call, and the stream of the last one
+    std::size_t take_dropped(std::streambuf *&dest) {
+        const std::size_t dropped = dropped_.exchange(0, std::memory_order_acquire);
+        dest                      = dropped_dest_.load(std::memory_order_relaxed);
+        return dropped;
+    }
+
+    std::atomic<bool> owner_exited{false};
+
+private:
+    void write_header(std::size_t index, const Header &header) {
+        std::memcpy(&data_[index & mask_], &header, sizeof(Header));
+    }
+
+    std::vector<char> data_;
+    const std::size_t mask_;
+    std::atomic<std::size_t> head_{0};
+    std::atomic<std::size_t> tail_{0};
+    std::atomic<std::size_t> dropped_{0};
+    std::atomic<std::streambuf *> dropped_dest_{nullptr};
+};
+
+// Writes the messages pushed in the rings of all the threads in their stream, from a background thread
+class AsyncLogBackend {
+public:
+    // The backend is never destroyed, so that it can be used by threads running during the static destruction. The
+    // messages still in the rings are written when the process exits, after which the messages are written
+    // synchronously.
+    static AsyncLogBackend &instance() {
+        static AsyncLogBackend *backend = []() {
+            auto *backend = new AsyncLogBackend();
+            std::atexit([]() { AsyncLogBackend::instance().stop(); });
+            created_.store(backend, std::memory_order_release);
+            return backend;
+        }();
+        return *backend;
+    }
+
+    // Returns the backend if it was already created, nullptr otherwise
+    static AsyncLogBackend *instance_if_created() {
+        return created_.load(std::memory_order_acquire);
+    }
+
+    // Returns false if the message must be written synchronously
+    bool push(std::streambuf *dest, const char *bytes, std::size_t size) {
+        if (stopped_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        AsyncLogRing *ring = get_thread_ring();
+        if (!ring) {
+            return false;
+        }
+        if (AsyncLogRing::record_size(size) > ring->capacity() / 4) {
+            // large messages are written synchronously, after the previous ones to keep the order of the thread
+            drain_all();
+            return false;
+        }
+        ring->push(dest, bytes, size);
+        if (ring->is_half_full()) {
+            wake_cond_.notify_one();
+        }
+        return true;
+    }
+
+    void flush() {
+        drain_all();
+    }
+
+private:
+    AsyncLogBackend() {
+        std::thread([this]() { run(); }).detach();
+    }
+
+    struct ThreadRing {
+        ~ThreadRing();
+        std::shared_ptr<AsyncLogRing> ring;
+    };
+
+    AsyncLogRing *get_thread_ring();
+
+    void run() {
+        while (!stopped_.load(std::memory_order_acquire)) {
+            {
+                std::unique_lock<std::mutex> lock(wake_mutex_);
+                wake_cond_.wait_for(lock, std::chrono::milliseconds(10));
+            }
+            drain_all();
+        }
+    }
+
+    void stop() {
+        stopped_.store(true, std::memory_order_release);
+        drain_all();
+        wake_cond_.notify_all();
+    }
+
+    void drain_all() {
+        std::lock_guard<std::mutex> drain_lock(drain_mutex_);
+        {
+            std::lock_guard<std::mutex> lock(rings_mutex_);
+            draining_rings_ = rings_;
+        }
+        for (auto &ring : draining_rings_) {
+            std::lock_guard<std::mutex> lock(concurrent_ostreambuf_mutex);
+            std::streambuf *dropped_dest = nullptr;
+            ring->drain([](std::streambuf *dest, const char *bytes, std::size_t size) {
+                dest->sputn(bytes, static_cast<std::streamsize>(size));
+            });
+            if (const std::size_t dropped = ring->take_dropped(dropped_dest)) {
+                const std::string message = "[LOG] " + std::to_string(dropped) +
+                                            " messages dropped, the asynchronous log buffer is full\n";
+                dropped_dest->sputn(message.data(), static_cast<std::streamsize>(message.size()));
+            }
+        }
+
+        // the rings of the threads that exited are released once empty
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings_.erase(std::remove_if(rings_.begin(), rings_.end(),
+                                    [](const auto &ring) { return ring->owner_exited && ring->empty(); }),
+                     rings_.end());
+        draining_rings_.clear();
+    }
+
+    static std::atomic<AsyncLogBackend *> created_;
+
+    std::atomic<bool> stopped_{false};
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cond_;
+    std::mutex drain_mutex_;
+    std::mutex rings_mutex_;
+    std::vector<std::shared_ptr<AsyncLogRing>> rings_;
+    std::vector<std::shared_ptr<AsyncLogRing>> draining_rings_;
+};
+
+std::atomic<AsyncLogBackend *> AsyncLogBackend::created_{nullptr};
+
+// The ring of a thread is accessed through a trivially destructible pointer, so that messages logged by the
+// destructors of other thread local objects after the ring is released are written synchronously
+thread_local AsyncLogRing *thread_ring = nullptr;
+thread_local bool thread_ring_released = false;
+
+AsyncLogBackend::ThreadRing::~ThreadRing() {
+    thread_ring          = nullptr;
+    thread_ring_released = true;
+    if (ring) {
+        ring->owner_exited = true;
+    }
+}
+
+AsyncLogRing *AsyncLogBackend::get_thread_ring() {
+    if (!thread_ring && !thread_ring_released) {
+        thread_local ThreadRing owner;
+        owner.ring = std::make_shared<AsyncLogRing>(get_log_async_buffer_size_env());
+        {
+            std::lock_guard<std::mutex> lock(rings_mutex_);
+            rings_.push_back(owner.ring);
+        }
+        thread_ring = owner.ring.get();
+    }
+    return thread_ring;
+}
+
+// Streams released by the logging operations of a thread, reused by its next operations
+struct LogStreamPool {
+    ~LogStreamPool() {
+        alive = false;
+        for (auto *stream : streams) {
+            delete stream;
+        }
+    }
+
+    std::vector<detail::log_stream *> streams;
+    static thread_local bool alive;
+};
+thread_local bool LogStreamPool::alive = true;
+
+LogStreamPool &get_log_stream_pool() {
+    thread_local LogStreamPool pool;
+    return pool;
+}
 } // namespace
 
+void flushLogs() {
+    if (auto *backend = AsyncLogBackend::instance_if_created()) {
+        backend->flush();
+    }
+}
+
 namespace detail {
-concurrent_ostreambuf::concurrent_ostreambuf(std::streambuf *buf) : buf_(buf), has_output_(false) {}
+concurrent_ostreambuf::concurrent_ostreambuf(std::streambuf *buf) : buf_(buf), has_output_(false), async_(false) {}
 
 std::streamsize concurrent_ostreambuf::xsputn(const char_type *s, std::streamsize n) {
     bytes_.insert(bytes_.end(), s, s + n);
@@ -85,7 +376,10 @@ int concurrent_ostreambuf::overflow(int ch) {
 }
 
 int concurrent_ostreambuf::sync() {
-    {
+    if (bytes_.empty()) {
+        return 1;
+    }
+    if (!async_ || !AsyncLogBackend::instance().push(buf_, bytes_.data(), bytes_.size())) {
         std::lock_guard<std::mutex> lock(concurrent_ostreambuf_mutex);
         buf_->sputn(bytes_.data(), bytes_.size());
     }
@@ -101,6 +395,43 @@ bool concurrent_ostreambuf::get_output_sentinel() const {
     return has_output_;
 }
 
+void log_stream::reset(std::streambuf *buf, bool async) {
+    streambuf.buf_        = buf;
+    streambuf.async_      = async;
+    streambuf.has_output_ = false;
+    streambuf.bytes_.clear();
+    // the format flags may have been modified by stream manipulators during the previous operation
+    stream.clear();
+    stream.flags(std::ios_base::skipws | std::ios_base::dec);
+    stream.precision(6);
+    stream.width(0);
+    stream.fill(' ');
+}
+
+log_stream *acquireLogStream(std::streambuf *buf, bool async) {
+    log_stream *stream = nullptr;
+    if (LogStreamPool::alive) {
+        auto &streams = get_log_stream_pool().streams;
+        if (!streams.empty()) {
+            stream = streams.back();
+            streams.pop_back();
+        }
+    }
+    if (!stream) {
+        stream = new log_stream();
+    }
+    stream->reset(buf, async);
+    return stream;
+}
+
+void log_stream_deleter::operator()(log_stream *stream) const {
+    if (LogStreamPool::alive) {
+        get_log_stream_pool().streams.push_back(stream);
+    } else {
+        delete stream;
+    }
+}
+
 LogLevelNameMap::const_iterator getLongestLogLevelName(const LogLevelNameMap &levelnames) {
     return std::max_element(levelnames.cbegin(), levelnames.cend(),
                             [](const auto &lhs, const auto &rhs) { return lhs.second.size() < rhs.second.size(); });
@@ -157,6 +488,7 @@ void setLogLevel(const LogLevel &level) {
 }
 
 void setLogOptions(LogOptions opts) {
+    flushLogs();
     gLogOptions = opts;
 }
 
@@ -178,10 +510,12 @@ std::ostream &getLogStream() {
 }
 
 void setLogStream(std::ostream &stream) {
+    flushLogs();
     gLogOptions.setStream(stream);
 }
 
 void resetLogStreamFromEnv() {
+    flushLogs();
     gLogStreamEnvRead = false;
     gFileStream.reset(nullptr);
 }
@@ -202,6 +536,14 @@ LogOptions &LogOptions::setLevelPrefixPadding(bool is_padded) {
 bool LogOptions::isLevelPrefixPadding() const {
     return level_prefix_padding_;
 }
+LogOptions &LogOptions::setAsynchronous(bool is_asynchronous) {
+    asynchronous_ = is_asynchronous;
+    return *this;
+}
+bool LogOptions::isAsynchronous() const {
+    const int async_env = get_log_async_env();
+    return async_env < 0 ? asynchronous_ : async_env == 1;
+}
 LogOptions &LogOptions::setStream(std::ostream &stream) {
     stream_ = &stream;
     return *this;
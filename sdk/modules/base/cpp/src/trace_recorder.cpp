@@ -0,0 +1,234 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <vector>
+
+#include "metavision/sdk/base/utils/trace_recorder.h"
+
+namespace Metavision {
+
+namespace {
+
+// origin of the timestamps of the trace, taken when the library is loaded so that it precedes all recorded events
+const TraceRecorder::Clock::time_point trace_origin = TraceRecorder::Clock::now();
+
+const char *get_trace_file_env() {
+    static const char *trace_file = std::getenv("MV_TRACE_FILE");
+    return (trace_file && *trace_file) ? trace_file : nullptr;
+}
+
+std::size_t get_trace_buffer_size_env() {
+    const char *buffer_size = std::getenv("MV_TRACE_BUFFER_SIZE");
+    if (buffer_size) {
+        const long long size = std::atoll(buffer_size);
+        if (size > 0) {
+            return static_cast<std::size_t>(size);
+        }
+    }
+    return 65536;
+}
+
+void write_json_string(std::ostream &os, const std::string &str) {
+    os << '"';
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            os << '\\' << c;
+        } else if (static_cast<unsigned char>(c) >= 0x20) {
+            os << c;
+        }
+    }
+    os << '"';
+}
+
+} // namespace
+
+struct TraceRecorder::Private {
+    struct Record {
+        const char *name;
+        char type;
+        std::int64_t ts_ns;
+        std::int64_t value; // duration in ns for complete events, counter value for counter events
+    };
+
+    // Ring buffer of the events of one thread, written by this thread only and read while the trace is being saved.
+    // Recording an event takes no lock: each slot holds the index of the record it contains, which is reset while the
+    // slot is overwritten, so that the reader can skip the records that are overwritten while it copies them.
+    struct ThreadBuffer {
+        struct Slot {
+            std::atomic<std::uint64_t> index{0}; // index of the record + 1, 0 while the slot is being written
+            std::atomic<const char *> name{nullptr};
+            std::atomic<char> type{0};
+            std::atomic<std::int64_t> ts_ns{0};
+            std::atomic<std::int64_t> value{0};
+        };
+
+        ThreadBuffer(std::uint32_t tid, std::size_t capacity) :
+            tid(tid), capacity(capacity), slots(new Slot[capacity]) {}
+
+        void push(const Record &record) {
+            const std::uint64_t index = count.load(std::memory_order_relaxed);
+            Slot &slot                = slots[index % capacity];
+            slot.index.store(0, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.name.store(record.name, std::memory_order_relaxed);
+            slot.type.store(record.type, std::memory_order_relaxed);
+            slot.ts_ns.store(record.ts_ns, std::memory_order_relaxed);
+            slot.value.store(record.value, std::memory_order_relaxed);
+            slot.index.store(index + 1, std::memory_order_release);
+            count.store(index + 1, std::memory_order_release);
+        }
+
+        // Copies the records kept in the buffer, oldest first
+        std::vector<Record> get_records() const {
+            std::vector<Record> records;
+            const std::uint64_t end   = count.load(std::memory_order_acquire);
+            const std::uint64_t begin = end > capacity ? end - capacity : 0;
+            records.reserve(end - begin);
+            for (std::uint64_t index = begin; index < end; ++index) {
+                const Slot &slot = slots[index % capacity];
+                if (slot.index.load(std::memory_order_acquire) != index + 1) {
+                    continue;
+                }
+                Record record{slot.name.load(std::memory_order_relaxed), slot.type.load(std::memory_order_relaxed),
+                              slot.ts_ns.load(std::memory_order_relaxed), slot.value.load(std::memory_order_relaxed)};
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.index.load(std::memory_order_relaxed) == index + 1) {
+                    records.push_back(record);
+                }
+            }
+            return records;
+        }
+
+        const std::uint32_t tid;
+        const std::size_t capacity;
+        std::unique_ptr<Slot[]> slots;
+        std::atomic<std::uint64_t> count{0}; // number of records pushed so far
+
+        mutable std::mutex name_mutex;
+        std::string name;
+    };
+
+    ThreadBuffer &get_thread_buffer() {
+        // Buffers are owned by the recorder so that the events of a thread are kept after it exits
+        thread_local ThreadBuffer *thread_buffer = nullptr;
+        if (!thread_buffer) {
+            std::lock_guard<std::mutex> lock(buffers_mutex);
+            buffers.emplace_back(
+                std::make_unique<ThreadBuffer>(static_cast<std::uint32_t>(buffers.size() + 1), buffer_size));
+            thread_buffer = buffers.back().get();
+        }
+        return *thread_buffer;
+    }
+
+    std::int64_t to_ns(const Clock::time_point &t) const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t - trace_origin).count();
+    }
+
+    const std::size_t buffer_size = get_trace_buffer_size_env();
+    mutable std::mutex buffers_mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+bool TraceRecorder::is_enabled() {
+    static const bool enabled = get_trace_file_env() != nullptr;
+    return enabled;
+}
+
+TraceRecorder &TraceRecorder::instance() {
+    // The instance is never destroyed, so that it can still be used by threads running during the static
+    // destruction. The trace is saved when the process exits.
+    static TraceRecorder *recorder = []() {
+        auto *recorder = new TraceRecorder();
+        if (is_enabled()) {
+            std::atexit([]() { TraceRecorder::instance().save(); });
+        }
+        return recorder;
+    }();
+    return *recorder;
+}
+
+TraceRecorder::TraceRecorder() : pimpl_(new Private()) {}
+
+void TraceRecorder::add_complete_event(const char *name, const Clock::time_point &start, const Clock::time_point &end) {
+    const std::int64_t start_ns = pimpl_->to_ns(start);
+    pimpl_->get_thread_buffer().push({name, 'X', start_ns, pimpl_->to_ns(end) - start_ns});
+}
+
+void TraceRecorder::add_counter_event(const char *name, std::int64_t value) {
+    pimpl_->get_thread_buffer().push({name, 'C', pimpl_->to_ns(Clock::now()), value});
+}
+
+void TraceRecorder::set_thread_name(const std::string &name) {
+    auto &thread_buffer = pimpl_->get_thread_buffer();
+    std::lock_guard<std::mutex> lock(thread_buffer.name_mutex);
+    thread_buffer.name = name;
+}
+
+bool TraceRecorder::save(const std::filesystem::path &path) const {
+    std::ofstream ofs(path);
+    if (!ofs.is_open()) {
+        return false;
+    }
+
+    // timestamps and durations are written in microseconds
+    ofs << std::fixed << std::setprecision(3);
+    ofs << "{\"traceEvents\":[";
+    bool first = true;
+    auto write_separator = [&]() {
+        if (!first) {
+            ofs << ",\n";
+        }
+        first = false;
+    };
+
+    std::lock_guard<std::mutex> buffers_lock(pimpl_->buffers_mutex);
+    for (const auto &thread_buffer : pimpl_->buffers) {
+        {
+            std::lock_guard<std::mutex> lock(thread_buffer->name_mutex);
+            if (!thread_buffer->name.empty()) {
+                write_separator();
+                ofs << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << thread_buffer->tid
+                    << ",\"args\":{\"name\":";
+                write_json_string(ofs, thread_buffer->name);
+                ofs << "}}";
+            }
+        }
+
+        for (const auto &record : thread_buffer->get_records()) {
+            write_separator();
+            ofs << "{\"name\":";
+            write_json_string(ofs, record.name);
+            ofs << ",\"ph\":\"" << record.type << "\",\"ts\":" << record.ts_ns / 1000.
+                << ",\"pid\":0,\"tid\":" << thread_buffer->tid;
+            if (record.type == 'X') {
+                ofs << ",\"dur\":" << record.value / 1000.;
+            } else {
+                ofs << ",\"args\":{\"value\":" << record.value << "}";
+            }
+            ofs << "}";
+        }
+    }
+    ofs << "]}\n";
+
+    return ofs.good();
+}
+
+bool TraceRecorder::save() const {
+    const char *trace_file = get_trace_file_env();
+    return trace_file ? save(trace_file) : false;
+}
+
+} // namespace Metavision
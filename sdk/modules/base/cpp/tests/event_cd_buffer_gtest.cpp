@@ -0,0 +1,123 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd_buffer.h"
+
+using namespace Metavision;
+
+namespace {
+std::vector<EventCD> make_events(std::size_t n, timestamp t0) {
+    std::vector<EventCD> events;
+    for (std::size_t i = 0; i < n; ++i) {
+        events.emplace_back(i % 640, (i * 7) % 480, i % 2, t0 + 3 * i);
+    }
+    return events;
+}
+
+void assert_same_events(const std::vector<EventCD> &expected, const EventCDBuffer &buffer) {
+    ASSERT_EQ(expected.size(), buffer.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i], buffer[i]);
+        ASSERT_EQ(expected[i].x, buffer.x_data()[i]);
+        ASSERT_EQ(expected[i].y, buffer.y_data()[i]);
+        ASSERT_EQ(expected[i].p, buffer.p_data()[i]);
+        ASSERT_EQ(expected[i].t, buffer.t(i));
+    }
+}
+} // namespace
+
+TEST(EventCDBuffer_GTest, append_and_push_back) {
+    for (bool relative : {false, true}) {
+        const auto events = make_events(1000, 1'000'000'000);
+        EventCDBuffer buffer(relative);
+        buffer.append(events.data(), events.data() + 500);
+        for (std::size_t i = 500; i < events.size(); ++i) {
+            buffer.push_back(events[i]);
+        }
+        assert_same_events(events, buffer);
+        ASSERT_EQ(relative, buffer.has_relative_timestamps());
+        ASSERT_EQ(relative, buffer.t_data() == nullptr);
+        ASSERT_EQ(relative, buffer.relative_t_data() != nullptr);
+        if (relative) {
+            ASSERT_EQ(events.front().t, buffer.time_base());
+            ASSERT_EQ(0u, buffer.relative_t_data()[0]);
+        }
+    }
+}
+
+TEST(EventCDBuffer_GTest, relative_timestamps_fall_back_to_absolute) {
+    // GIVEN a buffer with relative timestamps and events too far apart to be stored as 32 bits offsets
+    auto events = make_events(10, 100);
+    events.emplace_back(1, 2, 1, 100 + (timestamp(1) << 33));
+    events.emplace_back(3, 4, 0, 50);
+
+    EventCDBuffer buffer(true);
+    buffer.append(events.cbegin(), events.cend());
+
+    // THEN the timestamps are stored as absolute ones
+    ASSERT_FALSE(buffer.has_relative_timestamps());
+    assert_same_events(events, buffer);
+
+    // WHEN the buffer is cleared, THEN the relative timestamps are used again
+    buffer.clear();
+    ASSERT_TRUE(buffer.empty());
+    buffer.push_back(events.front());
+    ASSERT_TRUE(buffer.has_relative_timestamps());
+}
+
+TEST(EventCDBuffer_GTest, iterate) {
+    const auto events = make_events(100, 42);
+    EventCDBuffer buffer(true);
+    buffer.append(events.cbegin(), events.cend());
+
+    std::vector<EventCD> copy(buffer.begin(), buffer.end());
+    ASSERT_EQ(events, copy);
+    ASSERT_EQ(100, std::distance(buffer.begin(), buffer.end()));
+    ASSERT_EQ(events[10].t, (buffer.begin() + 10)->t);
+    ASSERT_EQ(events.back(), *std::prev(buffer.end()));
+
+    auto it = std::lower_bound(buffer.begin(), buffer.end(), events[50].t,
+                               [](const EventCD &ev, timestamp t) { return ev.t < t; });
+    ASSERT_EQ(50u, it.index());
+}
+
+TEST(EventCDBuffer_GTest, append_if) {
+    const auto events = make_events(1000, 0);
+    for (bool relative_in : {false, true}) {
+        for (bool relative_out : {false, true}) {
+            EventCDBuffer in(relative_in), out(relative_out);
+            in.append(events.cbegin(), events.cend());
+            out.append(events.cbegin(), events.cbegin() + 3);
+            out.append_if(in, [&](std::size_t i) { return in.x_data()[i] % 3 == 0; });
+
+            std::vector<EventCD> expected(events.cbegin(), events.cbegin() + 3);
+            std::copy_if(events.cbegin(), events.cend(), std::back_inserter(expected),
+                         [](const EventCD &ev) { return ev.x % 3 == 0; });
+            assert_same_events(expected, out);
+        }
+    }
+}
+
+TEST(EventCDBuffer_GTest, swap) {
+    const auto events = make_events(10, 0);
+    EventCDBuffer a(true), b;
+    a.append(events.cbegin(), events.cend());
+    a.swap(b);
+    ASSERT_TRUE(a.empty());
+    ASSERT_FALSE(a.has_relative_timestamps());
+    ASSERT_TRUE(b.has_relative_timestamps());
+    assert_same_events(events, b);
+}
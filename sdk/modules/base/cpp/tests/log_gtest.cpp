@@ -10,10 +10,13 @@
  **********************************************************************************************************************/
 
 #include <cstdlib>
+#include <cstdio>
 #include <ctime>
 #include <cstdlib>
 #include <fstream>
 #include <iterator>
+#include <sstream>
+#include <thread>
 #include <gtest/gtest.h>
 #include <type_traits>
 #ifdef __ANDROID__
@@ -902,3 +905,105 @@ TEST_F(Sdk_log_GTest, should_have_no_padding_when_disabled) {
 
     EXPECT_EQ(oss.str(), expected_output);
 }
+
+class AsyncLog_GTest : public ::testing::Test {
+public:
+    std::ostringstream oss;
+    void SetUp() override {
+        resetLogLevelFromEnv();
+        resetLogStreamFromEnv();
+        resetLogOptions();
+        setLogOptions(LogOptions(LogLevel::Trace, oss).setAsynchronous(true));
+    }
+
+    void TearDown() override {
+        flushLogs();
+        resetLogOptions();
+    }
+};
+
+TEST_F(AsyncLog_GTest, messages_are_written_after_flush) {
+    MV_SDK_LOG_INFO() << "message" << 1;
+    MV_LOG_WARNING("prefix ") << Metavision::Log::no_space << "message" << 2;
+    flushLogs();
+
+    EXPECT_EQ("[SDK][INFO] message 1 \nprefix message2\n", oss.str());
+}
+
+TEST_F(AsyncLog_GTest, filtered_messages_are_not_written) {
+    setLogOptions(getLogOptions().setLevel(LogLevel::Warning));
+    MV_SDK_LOG_INFO() << "message";
+    MV_SDK_LOG_TRACE() << "message";
+    flushLogs();
+
+    EXPECT_EQ(std::string(), oss.str());
+}
+
+TEST_F(AsyncLog_GTest, format_flags_are_reset_between_messages) {
+    MV_LOG_INFO() << std::hex << 255;
+    MV_LOG_INFO() << 255;
+    flushLogs();
+
+    EXPECT_EQ("ff \n255 \n", oss.str());
+}
+
+TEST_F(AsyncLog_GTest, messages_of_a_thread_keep_their_order) {
+    std::thread thread([]() {
+        for (int i = 0; i < 100; ++i) {
+            MV_LOG_INFO() << i;
+        }
+        // a large message is written synchronously, after the previous ones
+        MV_LOG_INFO() << std::string(1 << 20, 'x');
+    });
+    thread.join();
+    flushLogs();
+
+    std::istringstream iss(oss.str());
+    std::string line;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(std::getline(iss, line));
+        EXPECT_EQ(std::to_string(i) + " ", line);
+    }
+    ASSERT_TRUE(std::getline(iss, line));
+    EXPECT_EQ(std::string(1 << 20, 'x') + " ", line);
+}
+
+TEST_F(AsyncLog_GTest, messages_are_dropped_when_the_buffer_is_full) {
+#ifdef _WIN32
+    _putenv("MV_LOG_ASYNC_BUFFER_SIZE=256");
+#else
+    setenv("MV_LOG_ASYNC_BUFFER_SIZE", "256", 1);
+#endif
+
+    // the buffer size is read when a thread logs its first message
+    const int num_messages = 10000;
+    std::thread thread([]() {
+        for (int i = 0; i < num_messages; ++i) {
+            MV_LOG_INFO() << "message";
+        }
+    });
+    thread.join();
+    flushLogs();
+
+#ifdef _WIN32
+    _putenv("MV_LOG_ASYNC_BUFFER_SIZE=");
+#else
+    unsetenv("MV_LOG_ASYNC_BUFFER_SIZE");
+#endif
+
+    // each message is either written or counted as dropped
+    int num_written = 0, num_dropped = 0;
+    std::istringstream iss(oss.str());
+    std::string line;
+    while (std::getline(iss, line)) {
+        if (line == "message ") {
+            ++num_written;
+        } else {
+            int dropped = 0;
+            ASSERT_EQ(1, std::sscanf(line.c_str(), "[LOG] %d messages dropped", &dropped));
+            num_dropped += dropped;
+        }
+    }
+    EXPECT_EQ(num_messages, num_written + num_dropped);
+    EXPECT_LT(0, num_dropped);
+}
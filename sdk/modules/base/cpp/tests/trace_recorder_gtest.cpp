@@ -0,0 +1,95 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/utils/trace_recorder.h"
+#include "metavision/utils/gtest/gtest_with_tmp_dir.h"
+
+using namespace Metavision;
+
+class TraceRecorder_GTest : public GTestWithTmpDir {
+protected:
+    std::string save_and_read() {
+        const std::string path = tmpdir_handler_->get_full_path("trace.json");
+        EXPECT_TRUE(TraceRecorder::instance().save(path));
+        std::ifstream ifs(path);
+        std::stringstream ss;
+        ss << ifs.rdbuf();
+        return ss.str();
+    }
+};
+
+TEST_F(TraceRecorder_GTest, saves_events_in_chrome_tracing_format) {
+    // GIVEN a complete event and a counter event recorded from a named thread
+    std::thread t([]() {
+        auto &recorder = TraceRecorder::instance();
+        recorder.set_thread_name("TraceRecorder_GTest thread");
+        const auto start = TraceRecorder::Clock::now();
+        recorder.add_complete_event("TraceRecorder_GTest slice", start, start + std::chrono::microseconds(5));
+        recorder.add_counter_event("TraceRecorder_GTest counter", 42);
+    });
+    t.join();
+
+    // WHEN saving the trace
+    const std::string trace = save_and_read();
+
+    // THEN the events are saved as chrome tracing events, even though the thread has exited
+    EXPECT_EQ(0u, trace.find("{\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, trace.find("\"args\":{\"name\":\"TraceRecorder_GTest thread\"}"));
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"TraceRecorder_GTest slice\",\"ph\":\"X\""));
+    EXPECT_NE(std::string::npos, trace.find("\"dur\":5.000"));
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"TraceRecorder_GTest counter\",\"ph\":\"C\""));
+    EXPECT_NE(std::string::npos, trace.find("\"args\":{\"value\":42}"));
+}
+
+TEST_F(TraceRecorder_GTest, scope_is_not_recorded_when_tracing_is_disabled) {
+    if (TraceRecorder::is_enabled()) {
+        GTEST_SKIP() << "MV_TRACE_FILE is set";
+    }
+
+    // GIVEN a traced scope while tracing is disabled
+    { MV_TRACE_SCOPE("TraceRecorder_GTest disabled scope"); }
+
+    // WHEN saving the trace
+    const std::string trace = save_and_read();
+
+    // THEN the scope is not in the trace
+    EXPECT_EQ(std::string::npos, trace.find("TraceRecorder_GTest disabled scope"));
+}
+
+TEST_F(TraceRecorder_GTest, saves_while_events_are_recorded) {
+    // GIVEN a thread recording more counter events than its ring buffer can keep
+    const std::int64_t num_events = 200000;
+    std::atomic<bool> done{false};
+    std::thread t([&]() {
+        auto &recorder = TraceRecorder::instance();
+        for (std::int64_t i = 0; i < num_events; ++i) {
+            recorder.add_counter_event("TraceRecorder_GTest concurrent counter", i);
+        }
+        done = true;
+    });
+
+    // WHEN saving the trace while the events are recorded
+    while (!done) {
+        const std::string trace = save_and_read();
+        EXPECT_NE(std::string::npos, trace.rfind("]}\n"));
+    }
+    t.join();
+
+    // THEN the trace holds the most recent events once recording is done
+    const std::string trace = save_and_read();
+    EXPECT_NE(std::string::npos, trace.find("\"args\":{\"value\":" + std::to_string(num_events - 1) + "}"));
+}
@@ -13,7 +13,13 @@
 #define METAVISION_SDK_CORE_ADAPTIVE_RATE_EVENTS_SPLITTER_ALGORITHM_H
 
 #include "metavision/sdk/base/events/event_cd.h"
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <vector>
 #include <assert.h>
 
 namespace Metavision {
@@ -25,8 +31,50 @@ namespace Metavision {
 /// events. An additional criterion is the maximum proportion of active pixels containing both positive and negative
 /// events.
 ///
+/// The statistics can be restricted to the events of a region of interest and/or of a polarity (see
+/// @ref set_statistics_filter), the slices still containing all the events of the stream. Several splitters with
+/// different filters can be run in parallel on the same stream with an @ref AdaptiveRateEventsSplitterGroup.
 class AdaptiveRateEventsSplitterAlgorithm {
 public:
+    /// @brief Events taken into account to compute the statistics of the slices
+    struct StatisticsFilter {
+        /// Polarity of the events to use, or -1 to use both polarities
+        int polarity = -1;
+        /// Region of interest of the events to use, bounds included
+        int x0 = 0, y0 = 0, x1 = std::numeric_limits<int>::max(), y1 = std::numeric_limits<int>::max();
+
+        /// @brief Checks if an event is used to compute the statistics
+        /// @param ev Event to check
+        /// @return true if the event passes the filter, false otherwise
+        bool operator()(const EventCD &ev) const {
+            return (polarity < 0 || ev.p == polarity) && ev.x >= x0 && ev.x <= x1 && ev.y >= y0 && ev.y <= y1;
+        }
+    };
+
+    /// @brief View over the events of a slice, valid only during the call of the slice callback
+    ///
+    /// The events of a slice are the events kept from the previous input buffers, followed by events of the current
+    /// input buffer, that are not copied.
+    struct SliceView {
+        /// Events of the slice kept from the previous input buffers
+        const EventCD *kept_begin, *kept_end;
+        /// Events of the slice in the current input buffer
+        const EventCD *begin, *end;
+
+        /// @brief Gets the number of events of the slice
+        /// @return Number of events
+        std::size_t size() const {
+            return (kept_end - kept_begin) + (end - begin);
+        }
+
+        /// @brief Copies the events of the slice
+        /// @param out_vec Output vector, the events of the slice are appended to it
+        void copy_to(std::vector<EventCD> &out_vec) const {
+            out_vec.insert(out_vec.end(), kept_begin, kept_end);
+            out_vec.insert(out_vec.end(), begin, end);
+        }
+    };
+
     /// @brief Constructs a new AdaptiveRateEventsSplitterAlgorithm
     ///
     /// @param height height of the input frame of events
@@ -40,6 +88,12 @@ public:
     /// @brief Destructor
     ~AdaptiveRateEventsSplitterAlgorithm(){};
 
+    /// @brief Restricts the events used to compute the statistics of the slices
+    /// @param filter Filter of the events used to decide when to split
+    void set_statistics_filter(const StatisticsFilter &filter) {
+        filter_ = filter;
+    }
+
     /// @brief Process a slice of events, and determines if slicing should be performed or not at the end
     ///
     /// @param begin Iterator pointing to the beginning of the events buffer
@@ -48,6 +102,20 @@ public:
     template<typename InputIt>
     bool process_events(InputIt begin, InputIt end);
 
+    /// @brief Process a buffer of events, calling a callback for each slice found
+    ///
+    /// Unlike the other overload, the events of the buffer are only copied if they belong to a slice that is not
+    /// complete at the end of the buffer. The slices are passed as views over the kept events and the input buffer.
+    ///
+    /// @param begin Pointer to the beginning of the events buffer
+    /// @param end Pointer to the end of the events buffer
+    /// @param on_slice Function called with a const @ref SliceView & for each slice
+    /// @param check_interval Number of events after which the split criterion is checked, 0 to check it only at the
+    /// end of the buffer as the other overload does. Smaller intervals lead to more reactive splits but to more checks.
+    template<typename OnSliceCb>
+    void process_events(const EventCD *begin, const EventCD *end, OnSliceCb &&on_slice,
+                        std::size_t check_interval = 0);
+
     /// @brief Retrieves the slice of events and resets internal state
     ///
     /// @param out_vec output vector of events
@@ -58,10 +126,14 @@ public:
     }
 
 private:
+    template<typename InputIt>
+    void accumulate(InputIt begin, InputIt end);
+    bool is_slice_ready();
     void reset_local_variables();
 
     int height_, width_, shift_;
     float thr_var_per_event_;
+    StatisticsFilter filter_;
 
     int nb_pos_;
     float mean_pos_;
@@ -81,6 +153,9 @@ private:
 
     int nb_both_pos_and_neg_pix_;
 
+    // Pixels of img_pos_ and img_neg_ updated since the last reset, so that only them are reset
+    std::vector<int> touched_pixels_;
+
     float one_over_height_times_width_;
     float one_over_height_times_width_squared_;
 
@@ -92,14 +167,46 @@ private:
 template<typename InputIt>
 bool AdaptiveRateEventsSplitterAlgorithm::process_events(InputIt begin, InputIt end) {
     std::copy(begin, end, std::back_inserter(events_));
+    accumulate(begin, end);
+    if (is_slice_ready()) {
+        assert(events_.size());
+        return true;
+    }
+    return false;
+}
+
+template<typename OnSliceCb>
+void AdaptiveRateEventsSplitterAlgorithm::process_events(const EventCD *begin, const EventCD *end,
+                                                         OnSliceCb &&on_slice, std::size_t check_interval) {
+    const std::size_t interval = check_interval == 0 ? static_cast<std::size_t>(end - begin) : check_interval;
+    const EventCD *slice_begin = begin;
+    for (const EventCD *chunk_begin = begin; chunk_begin != end;) {
+        const EventCD *chunk_end = chunk_begin + std::min<std::size_t>(interval, end - chunk_begin);
+        accumulate(chunk_begin, chunk_end);
+        chunk_begin = chunk_end;
+        if (is_slice_ready()) {
+            on_slice(SliceView{events_.data(), events_.data() + events_.size(), slice_begin, chunk_end});
+            reset_local_variables();
+            slice_begin = chunk_end;
+        }
+    }
+    // only the remainder of the buffer after the last split is copied
+    events_.insert(events_.end(), slice_begin, end);
+}
+
+template<typename InputIt>
+void AdaptiveRateEventsSplitterAlgorithm::accumulate(InputIt begin, InputIt end) {
     const int two_pow_shift = 1 << shift_;
     for (auto it = begin; it != end; ++it) {
-        if ((it->x % two_pow_shift) || (it->y % two_pow_shift)) {
+        if ((it->x % two_pow_shift) || (it->y % two_pow_shift) || !filter_(*it)) {
             continue;
         }
         const int x       = it->x >> shift_;
         const int y       = it->y >> shift_;
         const int idx_pix = y * width_ + x;
+        if (img_pos_[idx_pix] == 0 && img_neg_[idx_pix] == 0) {
+            touched_pixels_.push_back(idx_pix);
+        }
         if (it->p == 1) {
             if (img_pos_[idx_pix] == 0) {
                 nb_pos_pix_++;
@@ -126,31 +233,6 @@ bool AdaptiveRateEventsSplitterAlgorithm::process_events(InputIt begin, InputIt
             nb_neg_++;
         }
     }
-    float var_per_event_pos = 0.f;
-    if (nb_pos_ == 0) {
-        assert(var_pos_ == 0.f);
-    } else {
-        var_per_event_pos = var_pos_ / nb_pos_;
-    }
-    float var_per_event_neg = 0.f;
-    if (nb_neg_ == 0) {
-        assert(var_neg_ == 0.f);
-    } else {
-        var_per_event_neg = var_neg_ / nb_neg_;
-    }
-    const float ratio_pix_both = nb_both_pos_and_neg_pix_ / (nb_pos_pix_ + nb_neg_pix_ + 1e-5f);
-
-    if ((ratio_pix_both >= kMaxRatioBothPix) ||
-        ((var_per_event_neg < prev_var_per_event_neg_) && (var_per_event_neg > thr_var_per_event_)) ||
-        ((var_per_event_pos < prev_var_per_event_pos_) && (var_per_event_pos > thr_var_per_event_))) {
-        assert(events_.size());
-        auto first_ts = events_[0].t;
-        auto last_ts  = events_[events_.size() - 1].t;
-        return true;
-    }
-    prev_var_per_event_neg_ = var_per_event_neg;
-    prev_var_per_event_pos_ = var_per_event_pos;
-    return false;
 }
 
 } // namespace Metavision
@@ -0,0 +1,88 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_ADAPTIVE_RATE_EVENTS_SPLITTER_GROUP_H
+#define METAVISION_SDK_CORE_ADAPTIVE_RATE_EVENTS_SPLITTER_GROUP_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/adaptive_rate_events_splitter_algorithm.h"
+#include "metavision/sdk/core/utils/executor.h"
+
+namespace Metavision {
+
+/// @brief Runs several @ref AdaptiveRateEventsSplitterAlgorithm in parallel on the same stream of events
+///
+/// Each splitter computes its statistics on the events selected by its own filter (e.g. a polarity or a region of
+/// interest), and splits the stream independently of the others. The input buffers are shared by all the splitters and
+/// are not copied, except for the events of the slices that are not complete at the end of a buffer.
+class AdaptiveRateEventsSplitterGroup {
+public:
+    /// @brief Type of the callback called for each slice
+    ///
+    /// The callback is called from the worker threads of the executor, concurrently for different splitters but
+    /// sequentially for a given splitter. The view is only valid during the call.
+    using SliceCallback =
+        std::function<void(std::size_t splitter_index, const AdaptiveRateEventsSplitterAlgorithm::SliceView &slice)>;
+
+    /// @brief Constructor
+    /// @param executor Executor running the splitters, must outlive the group
+    explicit AdaptiveRateEventsSplitterGroup(Executor &executor = Executor::get_default());
+
+    /// @brief Adds a splitter to the group
+    /// @param height height of the input frame of events
+    /// @param width width of the input frame of events
+    /// @param filter Filter of the events used by the splitter to compute its statistics
+    /// @param thr_var_per_event minimum variance per pixel value to reach before considering splitting the slice
+    /// @param downsampling_factor downsampling of the input before computing the statistics
+    /// @return Index of the splitter, passed to the slice callback
+    std::size_t add_splitter(int height, int width,
+                             const AdaptiveRateEventsSplitterAlgorithm::StatisticsFilter &filter,
+                             float thr_var_per_event = 5e-4f, int downsampling_factor = 2);
+
+    /// @brief Gets the number of splitters
+    /// @return Number of splitters in the group
+    std::size_t size() const;
+
+    /// @brief Sets the callback called for each slice
+    /// @param cb Callback to call
+    void set_slice_callback(const SliceCallback &cb);
+
+    /// @brief Processes a buffer of events with all the splitters
+    ///
+    /// The call returns once all the splitters processed the buffer, so that the buffer can be reused afterwards. The
+    /// calling thread processes the splitters that the executor has not started yet, so that the call does not
+    /// depend on the availability of the workers, and can be made from a task of the executor.
+    /// @param begin Pointer to the beginning of the events buffer
+    /// @param end Pointer to the end of the events buffer
+    /// @param check_interval Number of events after which the split criterion is checked, 0 to check it only at the
+    /// end of the buffer
+    /// @throw The first exception thrown by the slice callback, once all the splitters are done with the buffer
+    void process_events(const EventCD *begin, const EventCD *end, std::size_t check_interval = 0);
+
+private:
+    struct Batch;
+
+    void run_batch(Batch &batch, const EventCD *begin, const EventCD *end, std::size_t check_interval);
+    void process_events(std::size_t index, const EventCD *begin, const EventCD *end, std::size_t check_interval);
+
+    Executor &executor_;
+    std::vector<std::unique_ptr<AdaptiveRateEventsSplitterAlgorithm>> splitters_;
+    SliceCallback slice_cb_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_ADAPTIVE_RATE_EVENTS_SPLITTER_GROUP_H
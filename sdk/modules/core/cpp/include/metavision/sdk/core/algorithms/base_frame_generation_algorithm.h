@@ -69,7 +69,8 @@ public:
     /// the input @p accumulation_time_us. If @p accumulation_time_us is kept to 0, all input events are used.
     ///
     /// @warning The input @p frame must be allocated beforehand
-    /// @tparam EventIt Input event iterator type. Works for iterators over containers of @ref EventCD or equivalent
+    /// @tparam EventIt Input event iterator type. Works for iterators over containers of @ref EventCD,
+    /// @ref EventCDVector or equivalent, and over an @ref EventCDBuffer
     /// @param it_begin Iterator to first input event
     /// @param it_end Iterator to the past-the-end event
     /// @param frame Pre-allocated frame that will be filled with CD events. It must have the same geometry as the input
@@ -145,6 +146,18 @@ protected:
     static void generate_frame_from_events(EventIt it_begin, EventIt it_end, cv::Mat &frame, const cv::Vec4b &bg_color,
                                            const std::array<cv::Vec4b, 2> &off_on_colors, int flags);
 
+    /// @brief Draws events over a frame, with the color of their polarity
+    /// @tparam EventIt Input iterator event type. Works for @ref EventCD, @ref EventCDVector or equivalent, and for
+    /// @ref EventCDBuffer::const_iterator
+    /// @tparam PixelT Type of the pixels of the frame
+    /// @param it_begin Iterator to first input event
+    /// @param it_end Iterator to the past-the-end event
+    /// @param frame Frame to draw the events on
+    /// @param off_on_colors Colors of negative and positive events
+    template<typename EventIt, typename PixelT>
+    static void draw_events(EventIt it_begin, EventIt it_end, cv::Mat &frame,
+                            const std::array<PixelT, 2> &off_on_colors);
+
     // Frame properties
     const int width_, height_;               ///< Sensor's geometry
     int flags_;                              ///< Frame's generation parameters
@@ -12,8 +12,11 @@
 #ifndef METAVISION_SDK_CORE_BASE_FRAME_GENERATION_ALGORITHM_IMPL_H
 #define METAVISION_SDK_CORE_BASE_FRAME_GENERATION_ALGORITHM_IMPL_H
 
+#include <type_traits>
 #include <opencv2/core/mat.hpp>
 
+#include "metavision/sdk/base/events/event_cd_buffer.h"
+#include "metavision/sdk/base/events/event_cd_vector.h"
 #include "metavision/sdk/core/utils/colors.h"
 
 namespace Metavision {
@@ -101,17 +104,35 @@ void BaseFrameGenerationAlgorithm::generate_frame_from_events(EventIt it_begin,
 
     if (flags & Parameters::GRAY) {
         frame.setTo(bg_color[0]);
-        for (auto it = it_begin; it != it_end; ++it)
-            frame.at<uint8_t>(it->y, it->x) = off_on_colors[it->p][0];
-
+        draw_events(it_begin, it_end, frame, std::array<uint8_t, 2>{off_on_colors[0][0], off_on_colors[1][0]});
     } else if (flags & Parameters::RGB || flags & Parameters::BGR) {
         frame.setTo(_bg_color3);
-        for (auto it = it_begin; it != it_end; ++it)
-            frame.at<cv::Vec3b>(it->y, it->x) = _off_on_colors3[it->p];
+        draw_events(it_begin, it_end, frame, _off_on_colors3);
     } else {
         frame.setTo(_bg_color4);
+        draw_events(it_begin, it_end, frame, _off_on_colors4);
+    }
+}
+
+template<typename EventIt, typename PixelT>
+void BaseFrameGenerationAlgorithm::draw_events(EventIt it_begin, EventIt it_end, cv::Mat &frame,
+                                               const std::array<PixelT, 2> &off_on_colors) {
+    if constexpr (std::is_same_v<std::decay_t<decltype(*it_begin)>, EventCDVector>) {
+        for (auto it = it_begin; it != it_end; ++it) {
+            PixelT *row         = frame.ptr<PixelT>(it->y);
+            const PixelT &color = off_on_colors[it->p];
+            it->for_each_x([row, &color](uint16_t x) { row[x] = color; });
+        }
+    } else if constexpr (std::is_same_v<EventIt, EventCDBuffer::const_iterator>) {
+        const EventCDBuffer &buffer = it_begin.buffer();
+        const uint16_t *xs          = buffer.x_data();
+        const uint16_t *ys          = buffer.y_data();
+        const int16_t *ps           = buffer.p_data();
+        for (std::size_t i = it_begin.index(), end = it_end.index(); i < end; ++i)
+            frame.at<PixelT>(ys[i], xs[i]) = off_on_colors[ps[i]];
+    } else {
         for (auto it = it_begin; it != it_end; ++it)
-            frame.at<cv::Vec4b>(it->y, it->x) = _off_on_colors4[it->p];
+            frame.at<PixelT>(it->y, it->x) = off_on_colors[it->p];
     }
 }
 
@@ -20,7 +20,7 @@
 #include <sstream>
 
 #include "metavision/sdk/base/utils/sdk_log.h"
-#include "metavision/sdk/core/utils/detail/ring.h"
+#include "metavision/sdk/core/utils/detail/arena_ring.h"
 #include "metavision/sdk/core/utils/timing_profiler.h"
 
 class GenericProducerAlgorithm_GTest;
@@ -59,7 +59,7 @@ public:
     GenericProducerAlgorithm(timestamp timeout = 0, uint32_t max_events_per_second = 0,
                              timestamp max_duration_stored   = std::numeric_limits<timestamp>::max(),
                              bool allow_drop_when_overfilled = false) :
-        ring_event_(256, false),
+        ring_event_(1 << 14, false),
         timeout_(timeout),
         max_events_per_microseconds_(static_cast<float>(max_events_per_second) / 1000000),
         max_duration_stored_(max_duration_stored),
@@ -370,7 +370,9 @@ private:
         ring_event_.fill_buffer_to(inserter, ts);
     }
 
-    Metavision::detail::Ring<EventType> ring_event_;
+    // The stored events are bounded in time by max_duration_stored_, the ring's own limit, which counts events and not
+    // buffers as with Ring, is not set
+    Metavision::detail::ArenaRing<EventType> ring_event_;
     std::condition_variable underfilled_wait_cond_;
     mutable std::mutex underfilled_wait_mut_;
     std::condition_variable overfilled_wait_cond_;
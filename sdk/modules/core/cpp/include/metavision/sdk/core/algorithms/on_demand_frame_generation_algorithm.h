@@ -14,8 +14,10 @@
 
 #include <assert.h>
 #include <deque>
+#include <type_traits>
 
 #include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_cd_vector.h"
 #include "metavision/sdk/core/algorithms/base_frame_generation_algorithm.h"
 
 namespace Metavision {
@@ -46,9 +48,13 @@ public:
                                      const Metavision::ColorPalette &palette = default_palette());
 
     /// @brief Processes a buffer of events
+    ///
+    /// Buffers of @ref EventCDVector are stored without being expanded. A frame is generated from the vectors if some
+    /// were processed since the last frame, and from the other events otherwise: the two types of events are not
+    /// expected to be mixed.
     /// @warning Call @ref reset before starting processing events from a timestamp in the past
-    /// @tparam EventIt Read-Only input event iterator type. Works for iterators over buffers of @ref EventCD
-    /// or equivalent
+    /// @tparam EventIt Read-Only input event iterator type. Works for iterators over buffers of @ref EventCD,
+    /// @ref EventCDVector or equivalent
     /// @param it_begin Iterator to the first input event
     /// @param it_end Iterator to the past-the-end event
     /// @warning This method is expected to be called with timestamps increasing monotonically and events from the past
@@ -86,14 +92,24 @@ public:
     void reset();
 
 private:
+    /// @brief Generates a frame from the events of a queue in [ts_min, ts], and removes the events that are not needed
+    /// anymore
+    template<typename Event>
+    void generate_from_queue(std::deque<Event> &queue, timestamp ts_min, timestamp ts, cv::Mat &frame);
+
     uint32_t accumulation_time_us_; ///< Accumulation time of the events to generate the frame
     timestamp last_frame_ts_us_;    ///< Timestamp of the last generated frame
     std::deque<EventCD> events_queue_;
+    std::deque<EventCDVector> vectors_queue_;
 };
 
 template<typename EventIt>
 inline void OnDemandFrameGenerationAlgorithm::process_events(EventIt it_begin, EventIt it_end) {
-    events_queue_.insert(events_queue_.end(), it_begin, it_end);
+    if constexpr (std::is_same_v<std::decay_t<decltype(*it_begin)>, EventCDVector>) {
+        vectors_queue_.insert(vectors_queue_.end(), it_begin, it_end);
+    } else {
+        events_queue_.insert(events_queue_.end(), it_begin, it_end);
+    }
 }
 
 } // namespace Metavision
@@ -12,10 +12,17 @@
 #ifndef METAVISION_SDK_CORE_PERIODIC_FRAME_GENERATION_ALGORITHM_H
 #define METAVISION_SDK_CORE_PERIODIC_FRAME_GENERATION_ALGORITHM_H
 
+#include <algorithm>
+#include <array>
 #include <functional>
+#include <limits>
+#include <type_traits>
+#include <vector>
 
 #include "metavision/sdk/core/algorithms/base_frame_generation_algorithm.h"
 #include "metavision/sdk/core/algorithms/event_buffer_reslicer_algorithm.h"
+#include "metavision/sdk/base/events/event_cd_vector.h"
+#include "metavision/sdk/base/utils/detail/bitinstructions.h"
 #include "metavision/sdk/base/utils/timestamp.h"
 
 namespace Metavision {
@@ -32,6 +39,10 @@ class PeriodicFrameGenerationAlgorithm;
 /// The elapsed time between two frame generations (frame period = 1 / fps) and the accumulation time can be updated
 /// on the fly.
 ///
+/// Frames are rendered incrementally: the sensor is divided in tiles, and only the tiles that received events since the
+/// last frame, or that still displayed events in it, are updated. The cost of the generation thus depends on the
+/// active area of the scene rather than on the sensor size.
+///
 /// This class should be used when the user prefers to register to an output callback than having to manually ask the
 /// algorithm to generate the frames for increasing multiples of the frame period.
 /// However, this class shouldn't be used in case the user wants to generate a frame inside the callback of an
@@ -59,8 +70,8 @@ public:
     void set_output_callback(const OutputCb &output_cb);
 
     /// @brief Processes a buffer of events to update the internal time surface for the frame generation
-    /// @tparam InputIt Read-Only input event iterator type. Works for iterators over buffers of @ref EventCD
-    /// or equivalent
+    /// @tparam InputIt Read-Only input event iterator type. Works for iterators over buffers of @ref EventCD,
+    /// @ref EventCDVector or equivalent
     /// @param it_begin Iterator to the first input event
     /// @param it_end Iterator to the past-the-end event
     template<typename EventIt>
@@ -122,6 +133,17 @@ private:
     /// @brief Resets the time surface
     void reset_time_surface();
 
+    /// @brief Updates the tiles of the canvas that may have changed since it was last rendered
+    /// @param bg_color Background color
+    /// @param off_on_colors Colors of negative and positive events
+    /// @param min_display_event_ts Time surface timestamp below which events are not displayed
+    /// @param full_render If true, all the tiles are updated
+    template<typename PixelT>
+    void render_tiles(const PixelT &bg_color, const std::array<PixelT, 2> &off_on_colors, int32_t min_display_event_ts,
+                      bool full_render);
+
+    static constexpr int kTileSize = 32; ///< Width and height (in pixels) of the tiles the frame is rendered by
+
     OutputCb output_cb_; ///< The callback to call when a frame is generated
 
     EventBufferReslicerAlgorithm reslicer_; ///< Event buffer reslicer algorithm.
@@ -138,11 +160,21 @@ private:
     bool force_next_frame_; ///< Flag indicating if the next frame must be generated no matter the timestamp of the
                             /// processed time slice
 
-    // Time surface
-    std::vector<std::pair<int32_t, bool>> time_surface_; ///< Pixels' history (time surface). This object stores the
-                                                         ///< last events data that occurred at a given pixel
+    // Time surface, stored as a structure of arrays so that the rendering reads contiguous timestamps
+    std::vector<int32_t> ts_surface_;  ///< Timestamp of the last event that occurred at each pixel
+    std::vector<uint8_t> pol_surface_; ///< Polarity of the last event that occurred at each pixel
     timestamp ts_offset_{0}; ///< State variable to handle time overflow in the time surface. This is to minimize the
                              ///< memory footprint of the time surface access
+
+    // Incremental rendering
+    int n_tiles_x_, n_tiles_y_;         ///< Number of tiles along each axis
+    std::vector<int32_t> tile_last_ts_; ///< Upper bound of the time surface timestamps of each tile
+    cv::Mat canvas_;                    ///< Last rendered frame, copied to @ref frame_ to be output
+    bool canvas_valid_{false};          ///< Flag indicating if the canvas can be updated incrementally
+    int32_t canvas_min_display_ts_;     ///< Display threshold used when the canvas was last rendered
+    int canvas_flags_;                  ///< Frame's generation parameters used when the canvas was last rendered
+    cv::Vec4b canvas_bg_color_;         ///< Background color used when the canvas was last rendered
+    std::array<cv::Vec4b, 2> canvas_off_on_colors_; ///< Events colors used when the canvas was last rendered
 };
 
 template<typename EventIt>
@@ -171,18 +203,47 @@ void PeriodicFrameGenerationAlgorithm::process_event_buffer(EventIt it_begin, Ev
     // Checks time overflow. If one occurs, updates the time offset to apply and the timesurface accordingly.
     while (std::prev(it_end)->t > ts_offset_ + std::numeric_limits<int32_t>::max()) {
         ts_offset_ += std::numeric_limits<int32_t>::max();
-        for (auto &pix_data : time_surface_) {
-            pix_data.first =
-                pix_data.first >= std::numeric_limits<int32_t>::min() + std::numeric_limits<int32_t>::max() ?
-                    pix_data.first - std::numeric_limits<int32_t>::max() :
-                    std::numeric_limits<int32_t>::min();
-        }
+        const auto shift_ts = [](int32_t &ts) {
+            ts = ts >= std::numeric_limits<int32_t>::min() + std::numeric_limits<int32_t>::max() ?
+                     ts - std::numeric_limits<int32_t>::max() :
+                     std::numeric_limits<int32_t>::min();
+        };
+        std::for_each(ts_surface_.begin(), ts_surface_.end(), shift_ts);
+        std::for_each(tile_last_ts_.begin(), tile_last_ts_.end(), shift_ts);
+        canvas_valid_ = false;
     }
 
-    // Refresh the time-surface using the event buffer
-    for (auto it = it_begin; it != it_end; ++it) {
-        const int32_t it_t                    = static_cast<int32_t>(it->t - ts_offset_);
-        time_surface_[it->y * width_ + it->x] = {it_t, it->p};
+    // Refresh the time-surface and the tiles' activity using the event buffer
+    if constexpr (std::is_same_v<std::decay_t<decltype(*it_begin)>, EventCDVector>) {
+        for (auto it = it_begin; it != it_end; ++it) {
+            if (it->vector_mask == 0) {
+                continue;
+            }
+            const int32_t it_t = static_cast<int32_t>(it->t - ts_offset_);
+            int32_t *ts_row    = ts_surface_.data() + it->y * width_;
+            uint8_t *pol_row   = pol_surface_.data() + it->y * width_;
+            const uint8_t p    = static_cast<uint8_t>(it->p);
+            it->for_each_x([ts_row, pol_row, it_t, p](uint16_t x) {
+                ts_row[x]  = it_t;
+                pol_row[x] = p;
+            });
+
+            // A vector spans at most two tiles, the ones of its first and last events
+            int32_t *tiles_row = tile_last_ts_.data() + (it->y / kTileSize) * n_tiles_x_;
+            const int first_x  = it->base_x + ctz_not_zero(it->vector_mask);
+            const int last_x   = it->base_x + 31 - clz_not_zero(it->vector_mask);
+            tiles_row[first_x / kTileSize] = std::max(tiles_row[first_x / kTileSize], it_t);
+            tiles_row[last_x / kTileSize]  = std::max(tiles_row[last_x / kTileSize], it_t);
+        }
+    } else {
+        for (auto it = it_begin; it != it_end; ++it) {
+            const int32_t it_t     = static_cast<int32_t>(it->t - ts_offset_);
+            const size_t pixel_idx = it->y * width_ + it->x;
+            ts_surface_[pixel_idx]  = it_t;
+            pol_surface_[pixel_idx] = it->p;
+            int32_t &tile_last_ts   = tile_last_ts_[(it->y / kTileSize) * n_tiles_x_ + it->x / kTileSize];
+            tile_last_ts            = std::max(tile_last_ts, it_t);
+        }
     }
 }
 
@@ -17,6 +17,7 @@
 #include "metavision/sdk/base/utils/sdk_log.h"
 #include "metavision/sdk/core/algorithms/detail/internal_algorithms.h"
 #include "metavision/sdk/base/events/event2d.h"
+#include "metavision/sdk/base/events/event_cd_buffer.h"
 
 namespace Metavision {
 
@@ -44,6 +45,16 @@ public:
         return Metavision::detail::insert_if(it_begin, it_end, inserter, std::ref(*this));
     }
 
+    /// @brief Applies the Polarity filter to the events of a buffer, adding the result at the end of another buffer
+    ///
+    /// Only the polarities of the events are read to filter them, without branching on the result.
+    /// @param in Buffer of the events to filter
+    /// @param out Buffer to which the events that passed the filter are added, must be different from @p in
+    inline void process_events(const EventCDBuffer &in, EventCDBuffer &out) const {
+        const std::int16_t *ps = in.p_data();
+        out.append_if(in, [&](std::size_t i) { return ps[i] == pol_; });
+    }
+
     /// @brief Basic operator to check if an event is accepted
     /// @param ev Event2D to be tested
     inline bool operator()(const Event2d &ev) const;
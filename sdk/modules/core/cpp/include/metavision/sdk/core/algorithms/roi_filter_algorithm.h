@@ -12,8 +12,12 @@
 #ifndef METAVISION_SDK_CORE_ROI_FILTER_ALGORITHM_H
 #define METAVISION_SDK_CORE_ROI_FILTER_ALGORITHM_H
 
+#include <algorithm>
 #include <memory>
+#include <type_traits>
 
+#include "metavision/sdk/base/events/event_cd_buffer.h"
+#include "metavision/sdk/base/events/event_cd_vector.h"
 #include "metavision/sdk/base/utils/sdk_log.h"
 #include "metavision/sdk/core/algorithms/detail/internal_algorithms.h"
 
@@ -40,10 +44,13 @@ public:
     ~RoiFilterAlgorithm() = default;
 
     /// @brief Applies the ROI Mask filter to the given input buffer storing the result in the output buffer.
-    /// @tparam InputIt Read-Only input event iterator type. Works for iterators over buffers of @ref EventCD
-    /// or equivalent
-    /// @tparam OutputIt Read-Write output event iterator type. Works for iterators over containers of @ref EventCD
-    /// or equivalent
+    ///
+    /// Buffers of @ref EventCDVector are filtered without being expanded: the bits of the vectors outside of the ROI
+    /// are cleared, and the vectors left empty are dropped.
+    /// @tparam InputIt Read-Only input event iterator type. Works for iterators over buffers of @ref EventCD,
+    /// @ref EventCDVector or equivalent
+    /// @tparam OutputIt Read-Write output event iterator type. Works for iterators over containers of the input event
+    /// type
     /// @param it_begin Iterator to first input event
     /// @param it_end Iterator to the past-the-end event
     /// @param inserter Output iterator or back inserter
@@ -51,6 +58,13 @@ public:
     template<class InputIt, class OutputIt>
     inline OutputIt process_events(InputIt it_begin, InputIt it_end, OutputIt inserter);
 
+    /// @brief Applies the ROI Mask filter to the events of a buffer, adding the result at the end of another buffer
+    ///
+    /// The coordinates of the events are tested from the arrays of the buffer, without branching on the result.
+    /// @param in Buffer of the events to filter
+    /// @param out Buffer to which the events that passed the filter are added, must be different from @p in
+    inline void process_events(const EventCDBuffer &in, EventCDBuffer &out) const;
+
     /// @brief Returns true if the algorithm returns events expressed in coordinates relative to the ROI
     /// @return true if the algorithm is resetting the filtered events
     inline bool is_resetting() const;
@@ -98,6 +112,9 @@ public:
     inline void operator()(T &ev) const;
 
 private:
+    template<class InputIt, class OutputIt>
+    inline OutputIt process_vector_events(InputIt it_begin, InputIt it_end, OutputIt inserter) const;
+
     std::int32_t x0_{0};
     std::int32_t y0_{0};
     std::int32_t x1_{0};
@@ -111,7 +128,9 @@ inline RoiFilterAlgorithm::RoiFilterAlgorithm(std::int32_t x0, std::int32_t y0,
 
 template<class InputIt, class OutputIt>
 inline OutputIt RoiFilterAlgorithm::process_events(InputIt it_begin, InputIt it_end, OutputIt inserter) {
-    if (is_resetting()) {
+    if constexpr (std::is_same_v<std::decay_t<decltype(*it_begin)>, EventCDVector>) {
+        return process_vector_events(it_begin, it_end, inserter);
+    } else if (is_resetting()) {
         return Metavision::detail::transform_if(
             it_begin, it_end, inserter, [&](const auto &event) { return this->operator()(event); }, std::cref(*this));
     } else {
@@ -120,6 +139,57 @@ inline OutputIt RoiFilterAlgorithm::process_events(InputIt it_begin, InputIt it_
     }
 }
 
+template<class InputIt, class OutputIt>
+inline OutputIt RoiFilterAlgorithm::process_vector_events(InputIt it_begin, InputIt it_end, OutputIt inserter) const {
+    for (auto it = it_begin; it != it_end; ++it) {
+        const EventCDVector &ev = *it;
+        if (ev.y < y0_ || ev.y > y1_) {
+            continue;
+        }
+
+        // Keeps the bits of the vector whose x coordinates are in [x0, x1]
+        const std::int32_t first_bit = std::max(x0_ - ev.base_x, 0);
+        const std::int32_t last_bit  = std::min(x1_ - ev.base_x, 31);
+        if (first_bit > last_bit) {
+            continue;
+        }
+        const std::uint32_t roi_mask = (0xFFFFFFFFu >> (31 - last_bit)) & (0xFFFFFFFFu << first_bit);
+        const std::uint32_t mask     = ev.vector_mask & roi_mask;
+        if (mask == 0) {
+            continue;
+        }
+
+        EventCDVector filtered_ev = ev;
+        filtered_ev.vector_mask   = mask;
+        if (output_relative_coordinates_) {
+            // A vector starting before x0 is shifted to start at x0, the bits before it being cleared
+            filtered_ev.vector_mask = mask >> first_bit;
+            filtered_ev.base_x      = static_cast<std::uint16_t>(ev.base_x + first_bit - x0_);
+            filtered_ev.y           = static_cast<std::uint16_t>(ev.y - y0_);
+        }
+        *inserter = filtered_ev;
+        ++inserter;
+    }
+    return inserter;
+}
+
+inline void RoiFilterAlgorithm::process_events(const EventCDBuffer &in, EventCDBuffer &out) const {
+    const std::uint16_t *xs  = in.x_data();
+    const std::uint16_t *ys  = in.y_data();
+    const std::size_t offset = out.size();
+    out.append_if(in, [&](std::size_t i) {
+        return (xs[i] >= x0_) & (xs[i] <= x1_) & (ys[i] >= y0_) & (ys[i] <= y1_);
+    });
+    if (output_relative_coordinates_) {
+        std::uint16_t *out_xs = out.x_data();
+        std::uint16_t *out_ys = out.y_data();
+        for (std::size_t i = offset; i < out.size(); ++i) {
+            out_xs[i] -= x0_;
+            out_ys[i] -= y0_;
+        }
+    }
+}
+
 inline bool RoiFilterAlgorithm::is_resetting() const {
     return output_relative_coordinates_;
 }
@@ -12,6 +12,10 @@
 #ifndef METAVISION_SDK_CORE_DETAIL_HISTO_PROCESSOR_IMPL_H
 #define METAVISION_SDK_CORE_DETAIL_HISTO_PROCESSOR_IMPL_H
 
+#include <type_traits>
+
+#include "metavision/sdk/base/events/event_cd_buffer.h"
+#include "metavision/sdk/base/events/event_cd_vector.h"
 #include "metavision/sdk/core/preprocessors/histo_processor.h"
 
 namespace Metavision {
@@ -55,7 +59,41 @@ void HistoProcessor<InputIt>::compute(const timestamp cur_frame_start_ts, InputI
     auto buff            = tensor.data<float>();
     const auto buff_size = tensor.shape().get_nb_values();
     assert(buff_size == this->output_tensor_shape_.get_nb_values());
-    if (is_CHW(tensor)) {
+    if constexpr (std::is_same_v<std::decay_t<decltype(*begin)>, EventCDVector>) {
+        // The offset of the row of a vector is computed once for all its events
+        const bool chw = is_CHW(tensor);
+        for (auto it = begin; it != end; ++it) {
+            const auto &ev = *it;
+            assert((ev.p == 0) || (ev.p == 1));
+            assert(ev.t >= cur_frame_start_ts);
+            assert(ev.y < height_);
+            float *row = chw ? buff + width_ * (height_ * ev.p + ev.y) : buff + channels_ * width_ * ev.y + ev.p;
+            const int x_stride = chw ? 1 : channels_;
+            ev.for_each_x([&](std::uint16_t x) {
+                assert(x < width_);
+                float &value = row[x_stride * x];
+                value        = std::min(clip_value_after_normalization_, value + increment_);
+            });
+        }
+    } else if constexpr (std::is_same_v<InputIt, EventCDBuffer::const_iterator>) {
+        // The fields of the events are loaded from their own contiguous arrays, and only the needed ones are loaded
+        const EventCDBuffer &buffer = begin.buffer();
+        const std::uint16_t *xs     = buffer.x_data();
+        const std::uint16_t *ys     = buffer.y_data();
+        const std::int16_t *ps      = buffer.p_data();
+        const int x_stride          = is_CHW(tensor) ? 1 : channels_;
+        const int y_stride          = is_CHW(tensor) ? width_ : channels_ * width_;
+        const int p_stride          = is_CHW(tensor) ? width_ * height_ : 1;
+        for (std::size_t i = begin.index(), end_index = end.index(); i < end_index; ++i) {
+            assert((ps[i] == 0) || (ps[i] == 1));
+            assert(buffer.t(i) >= cur_frame_start_ts);
+            assert(xs[i] < width_);
+            assert(ys[i] < height_);
+            const int idx = p_stride * ps[i] + y_stride * ys[i] + x_stride * xs[i];
+            assert(idx < static_cast<int>(buff_size));
+            buff[idx] = std::min(clip_value_after_normalization_, buff[idx] + increment_);
+        }
+    } else if (is_CHW(tensor)) {
         for (auto it = begin; it != end; ++it) {
             const auto &ev = *it;
             assert((ev.p == 0) || (ev.p == 1));
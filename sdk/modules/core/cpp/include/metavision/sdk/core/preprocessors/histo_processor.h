@@ -17,6 +17,10 @@
 namespace Metavision {
 
 /// @brief Class used to compute a histogram from a stream of EventCD
+///
+/// Streams of @ref EventCDVector are also supported, in which case the events of each vector are accumulated without
+/// being expanded. With @ref EventCDBuffer::const_iterator, the fields of the events are read from the arrays of the
+/// buffer.
 /// @tparam InputIt The type of the input iterator for the range of events to process
 template<typename InputIt>
 class HistoProcessor : public EventPreprocessor<InputIt> {
@@ -71,13 +71,19 @@ public:
     /// @param cb Function to call every time a new frame is available. It takes in input the time (in us) of the new
     /// frame and the frame. The frame passed as a parameter is guaranteed to be available and left untouched until the
     /// next time the callback is called. This means that you don't need to make a deep copy of it, if you only intend
-    /// to use the frame until the next one is made available by the callback.
+    /// to use the frame until the next one is made available by the callback. The callback is called from the
+    /// generator thread, except for the last frame when frames are dropped, for which it is called from the thread
+    /// calling @ref stop.
     /// @return true if the thread started successfully, false otherwise. Also returns false, if the thread is already
     /// started.
     bool start(std::uint16_t fps, const PeriodicFrameGenerationAlgorithm::OutputCb &cb);
 
     /// @brief Stops the generator thread
     ///
+    /// The frame of the remaining events is generated before leaving. When all frames are processed, the pending
+    /// generations are processed first. Otherwise, they are aborted and the last frame is generated from the calling
+    /// thread, which is then the one calling the frame callback.
+    ///
     /// @return true if the thread has been stopped successfully, false otherwise. Return false if the thread had not
     /// been previously started
     bool stop();
@@ -86,7 +92,7 @@ public:
     void reset();
 
 private:
-    bool generate();
+    void generate(bool flush);
 
     // Image to display
     PeriodicFrameGenerationAlgorithm::OutputCb frame_cb_;
@@ -108,7 +114,6 @@ private:
     // Events to display
     std::mutex processing_mutex_;
     std::atomic<bool> stop_{true};
-    std::condition_variable events_available_cond_;
 
     std::unique_ptr<PeriodicFrameGenerationAlgorithm> frame_generation_algo_;
     // Shadow params
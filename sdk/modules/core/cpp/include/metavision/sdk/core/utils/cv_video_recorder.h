@@ -15,6 +15,7 @@
 #include <filesystem>
 #include <opencv2/videoio.hpp>
 
+#include "metavision/sdk/core/utils/executor.h"
 #include "metavision/sdk/core/utils/threaded_process.h"
 #include "metavision/sdk/core/utils/video_writer.h"
 #include "metavision/sdk/base/utils/object_pool.h"
@@ -53,7 +54,9 @@ private:
 
     using DataPool = SharedObjectPool<cv::Mat>;
     DataPool data_to_write_pool_;
-    ThreadedProcess recorder_thread_;
+    // The encoding blocks on disk I/O, so it is run by a worker of its own rather than by the default executor
+    Executor recorder_executor_{1};
+    ThreadedProcess recorder_thread_{recorder_executor_};
 };
 
 } // namespace Metavision
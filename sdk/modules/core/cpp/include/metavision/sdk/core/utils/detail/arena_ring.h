@@ -0,0 +1,301 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_ARENA_RING_H
+#define METAVISION_SDK_CORE_DETAIL_ARENA_RING_H
+
+#include <mutex>
+#include <vector>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/core/utils/detail/iterator_traits.h"
+#include "metavision/sdk/core/utils/detail/ring.h"
+
+namespace Metavision {
+namespace detail {
+
+/// @brief Ring of time ordered events stored in a single contiguous arena
+///
+/// Replacement of @ref Ring, with the same interface except for the size limit: instead of one heap allocated vector
+/// per added buffer, the events are stored in a single array whose capacity is a power of two, indexed by monotonic
+/// head and tail counters. The stored events are hence always made of at most two contiguous spans, which are searched
+/// and copied without any per-event wrapping logic, and adding events never allocates once the arena is large enough.
+///
+/// The arena grows by doubling when full. If a maximum number of events is set, the oldest events are dropped instead to
+/// make room for the new ones. If auto shrink is enabled, the arena is halved when it is mostly empty.
+template<typename Event>
+class ArenaRing {
+public:
+    typedef Event type_data;
+    typedef std::vector<Event> type_eventsadd;
+
+    /// @brief Constructor
+    /// @param min_ring_capacity Minimum number of events the arena can hold, rounded up to a power of two
+    /// @param auto_shrink If true, the arena is shrunk when less than a quarter of it is used
+    ArenaRing(unsigned int min_ring_capacity = 1024, bool auto_shrink = true) :
+        min_ring_capacity_(round_up_pow2(min_ring_capacity)), auto_shrink_(auto_shrink) {
+        arena_.resize(min_ring_capacity_);
+        mask_ = min_ring_capacity_ - 1;
+    }
+
+    /// @brief Sets the maximum number of events stored, the oldest events are dropped when it is reached
+    ///
+    /// Unlike @ref Ring::set_max_ring_size, which bounds the number of added buffers, the limit is a number of events.
+    /// @param s Maximum number of events, 0 for no limit
+    void set_max_events_stored(unsigned int s) {
+        std::unique_lock<std::mutex> lock(ring_mut_);
+        max_events_stored_ = s;
+    }
+
+    template<typename OutputIt>
+    void fill_buffer_to(OutputIt d_first, timestamp ts) {
+        static_assert(std::is_same<Event, typename iterator_traits<OutputIt>::value_type>::value,
+                      "fill_buffer_to called with invalid type of events.");
+
+        std::unique_lock<std::mutex> lock(ring_mut_);
+        const size_t last = lower_bound(ts);
+        copy_range(head_, last, d_first);
+        head_ = last;
+    }
+
+    // Fill the buffer with max_events events strictly before timestamp ts
+    template<typename OutputIt>
+    void fill_buffer_to_drop_max_events(OutputIt d_first, timestamp ts, int max_events) {
+        static_assert(std::is_same<Event, typename iterator_traits<OutputIt>::value_type>::value,
+                      "fill_buffer_to_drop_max_events called with invalid type of events.");
+
+        std::unique_lock<std::mutex> lock(ring_mut_);
+        const size_t last = lower_bound(ts);
+        const size_t kept = std::min(last - head_, static_cast<size_t>(std::max(max_events, 0)));
+        copy_range(last - kept, last, d_first);
+        head_ = last;
+    }
+
+    template<typename OutputIt>
+    void fill_buffer_remaining(OutputIt d_first) {
+        static_assert(std::is_same<Event, typename iterator_traits<OutputIt>::value_type>::value,
+                      "fill_buffer_remaining called with invalid type of events.");
+
+        std::unique_lock<std::mutex> lock(ring_mut_);
+        copy_range(head_, tail_, d_first);
+        head_ = tail_;
+    }
+
+    void drop() {
+        std::unique_lock<std::mutex> lock(ring_mut_);
+        head_ = tail_;
+    }
+
+    void drop_max_events(int max_events) {
+        std::unique_lock<std::mutex> lock(ring_mut_);
+        const size_t kept = std::min(tail_ - head_, static_cast<size_t>(std::max(max_events, 0)));
+        head_             = tail_ - kept;
+    }
+
+    void drop_to(timestamp ts) {
+        std::unique_lock<std::mutex> lock(ring_mut_);
+        if (head_ == tail_ || get_time(at(tail_ - 1)) < ts) {
+            return;
+        }
+        head_ = lower_bound(ts);
+    }
+
+    void add(std::function<void(std::vector<Event> *)> &adder) {
+        std::unique_lock<std::mutex> lock(ring_mut_);
+        // the staging buffer keeps its capacity from one call to the other
+        staging_.clear();
+        try {
+            adder(&staging_);
+        } catch (std::bad_alloc &) {}
+        append(staging_.cbegin(), staging_.size());
+    }
+
+    template<class IteratorEv>
+    void add(IteratorEv start, IteratorEv end) {
+        std::unique_lock<std::mutex> lock(ring_mut_);
+        append(start, static_cast<size_t>(std::distance(start, end)));
+    }
+
+    void add(type_eventsadd &events) {
+        std::unique_lock<std::mutex> lock(ring_mut_);
+        append(events.cbegin(), events.size());
+    }
+
+    /// @brief Calls a visitor on the contiguous spans of stored events, from the oldest to the newest
+    ///
+    /// The visitor is called with (const Event *begin, const Event *end) once or twice, depending on whether the stored
+    /// events wrap around the end of the arena. It is called with the ring locked, and must not access the ring.
+    /// @param visitor Visitor called on each span
+    template<typename Visitor>
+    void for_each_span(Visitor &&visitor) const {
+        std::unique_lock<std::mutex> lock(ring_mut_);
+        visit_spans(head_, tail_, visitor);
+    }
+
+    bool data_available() const {
+        std::unique_lock<std::mutex> lock(ring_mut_);
+        return head_ != tail_;
+    }
+
+    bool data_available(timestamp ts) const {
+        std::unique_lock<std::mutex> lock(ring_mut_);
+        return head_ != tail_ && get_time(at(tail_ - 1)) >= ts;
+    }
+
+    size_t size() const {
+        std::unique_lock<std::mutex> lock(ring_mut_);
+        return tail_ - head_;
+    }
+
+    /// @brief Gets the number of events the arena can hold without growing
+    size_t capacity() const {
+        std::unique_lock<std::mutex> lock(ring_mut_);
+        return arena_.size();
+    }
+
+    timestamp get_first_time() const {
+        std::unique_lock<std::mutex> lock(ring_mut_);
+        return head_ == tail_ ? -1 : get_time(at(head_));
+    }
+
+    timestamp get_last_time() const {
+        std::unique_lock<std::mutex> lock(ring_mut_);
+        return head_ == tail_ ? -1 : get_time(at(tail_ - 1));
+    }
+
+    void clear() {
+        std::unique_lock<std::mutex> lock(ring_mut_);
+        head_ = 0;
+        tail_ = 0;
+    }
+
+    void stat_ring(std::ostream &os) {
+        std::unique_lock<std::mutex> lock(ring_mut_);
+        os << std::dec << "CAP : " << arena_.size() << " SIZ : " << tail_ - head_ << " ";
+        os << " H " << (head_ & mask_) << " T " << (tail_ & mask_) << " ";
+        if (head_ == tail_) {
+            os << " E1 ";
+        } else {
+            os << get_time(at(head_)) << " " << get_time(at(tail_ - 1)) << " ";
+        }
+        os << std::endl;
+    }
+
+private:
+    static size_t round_up_pow2(size_t n) {
+        size_t p = 1;
+        while (p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    const Event &at(size_t i) const {
+        return arena_[i & mask_];
+    }
+
+    // Calls visitor(begin, end) on the (at most two) contiguous spans holding the events of indices [first, last)
+    template<typename Visitor>
+    void visit_spans(size_t first, size_t last, Visitor &&visitor) const {
+        if (first == last) {
+            return;
+        }
+        const Event *data      = arena_.data();
+        const size_t first_pos = first & mask_;
+        const size_t count     = last - first;
+        const size_t count1    = std::min(count, arena_.size() - first_pos);
+        visitor(data + first_pos, data + first_pos + count1);
+        if (count1 < count) {
+            visitor(data, data + (count - count1));
+        }
+    }
+
+    template<typename OutputIt>
+    void copy_range(size_t first, size_t last, OutputIt &d_first) const {
+        visit_spans(first, last, [&d_first](const Event *begin, const Event *end) {
+            d_first = std::copy(begin, end, d_first);
+        });
+    }
+
+    // Index of the first stored event with a timestamp >= ts, or tail_ if there is none
+    size_t lower_bound(timestamp ts) const {
+        size_t result = tail_;
+        bool found    = false;
+        visit_spans(head_, tail_, [&](const Event *begin, const Event *end) {
+            if (found || get_time(*(end - 1)) < ts) {
+                return;
+            }
+            auto it = std::lower_bound(begin, end, ts, [](const Event &ev, timestamp t) { return get_time(ev) < t; });
+            const size_t offset = static_cast<size_t>(it - arena_.data());
+            // maps the position in the arena back to a monotonic index
+            result = head_ + ((offset - (head_ & mask_)) & mask_);
+            found  = true;
+        });
+        return result;
+    }
+
+    template<class IteratorEv>
+    void append(IteratorEv start, size_t count) {
+        if (max_events_stored_ && count > max_events_stored_) {
+            // only the newest events fit in the ring
+            std::advance(start, count - max_events_stored_);
+            count = max_events_stored_;
+        }
+        if (max_events_stored_ && tail_ - head_ + count > max_events_stored_) {
+            head_ = tail_ + count - max_events_stored_;
+        }
+
+        const size_t required = tail_ - head_ + count;
+        if (required > arena_.size()) {
+            relocate(round_up_pow2(required));
+        } else if (auto_shrink_ && arena_.size() > min_ring_capacity_ && required * 4 < arena_.size()) {
+            relocate(std::max(min_ring_capacity_, round_up_pow2(required * 2)));
+        }
+
+        const size_t pos    = tail_ & mask_;
+        const size_t count1 = std::min(count, arena_.size() - pos);
+        std::copy_n(start, count1, arena_.begin() + pos);
+        std::advance(start, count1);
+        std::copy_n(start, count - count1, arena_.begin());
+        tail_ += count;
+    }
+
+    // Moves the stored events at the beginning of a new arena of the given capacity
+    void relocate(size_t new_capacity) {
+        std::vector<Event> new_arena(new_capacity);
+        auto d_first = new_arena.begin();
+        copy_range(head_, tail_, d_first);
+        tail_ -= head_;
+        head_ = 0;
+        arena_.swap(new_arena);
+        mask_ = new_capacity - 1;
+    }
+
+    std::vector<Event> arena_;
+    std::vector<Event> staging_;
+    size_t mask_          = 0;
+    size_t head_          = 0;
+    size_t tail_          = 0;
+    size_t max_events_stored_ = 0;
+    size_t min_ring_capacity_;
+    bool auto_shrink_;
+    mutable std::mutex ring_mut_;
+};
+
+} // namespace detail
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_ARENA_RING_H
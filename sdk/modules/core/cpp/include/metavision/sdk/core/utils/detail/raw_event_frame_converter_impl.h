@@ -0,0 +1,176 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_DETAIL_RAW_EVENT_FRAME_CONVERTER_IMPL_H
+#define METAVISION_SDK_CORE_DETAIL_RAW_EVENT_FRAME_CONVERTER_IMPL_H
+
+#include <cassert>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace Metavision {
+namespace detail {
+
+// The unpack kernels below are plain loops over contiguous arrays, without any data dependent branch, so that the
+// compiler can vectorize them for the targeted instruction set. The channel masks are loop invariants, which makes a
+// single kernel per layout suitable for all the supported channel bit sizes.
+
+// Packed histogram, one byte per pixel holding both channels, to interleaved channels
+template<typename T>
+void unpack_packed_histo_hwc(const std::uint8_t *input, std::size_t num_pixels, T *output, unsigned neg_bits,
+                             std::uint8_t neg_mask, std::uint8_t pos_mask) {
+    for (std::size_t i = 0; i < num_pixels; ++i) {
+        const std::uint8_t data = input[i];
+        output[2 * i]           = static_cast<T>(data & neg_mask);
+        output[2 * i + 1]       = static_cast<T>((data >> neg_bits) & pos_mask);
+    }
+}
+
+// Packed histogram, one byte per pixel holding both channels, to planar channels
+template<typename T>
+void unpack_packed_histo_chw(const std::uint8_t *input, std::size_t num_pixels, T *neg_output, T *pos_output,
+                             unsigned neg_bits, std::uint8_t neg_mask, std::uint8_t pos_mask) {
+    for (std::size_t i = 0; i < num_pixels; ++i) {
+        const std::uint8_t data = input[i];
+        neg_output[i]           = static_cast<T>(data & neg_mask);
+        pos_output[i]           = static_cast<T>((data >> neg_bits) & pos_mask);
+    }
+}
+
+// Unpacked histogram, one byte per channel, to interleaved channels
+template<typename T>
+void unpack_unpacked_histo_hwc(const std::uint8_t *input, std::size_t num_pixels, T *output, std::uint8_t neg_mask,
+                               std::uint8_t pos_mask) {
+    for (std::size_t i = 0; i < num_pixels; ++i) {
+        output[2 * i]     = static_cast<T>(input[2 * i] & neg_mask);
+        output[2 * i + 1] = static_cast<T>(input[2 * i + 1] & pos_mask);
+    }
+}
+
+// Unpacked histogram, one byte per channel, to planar channels
+template<typename T>
+void unpack_unpacked_histo_chw(const std::uint8_t *input, std::size_t num_pixels, T *neg_output, T *pos_output,
+                               std::uint8_t neg_mask, std::uint8_t pos_mask) {
+    for (std::size_t i = 0; i < num_pixels; ++i) {
+        neg_output[i] = static_cast<T>(input[2 * i] & neg_mask);
+        pos_output[i] = static_cast<T>(input[2 * i + 1] & pos_mask);
+    }
+}
+
+// Single channel, one byte per value
+template<typename T>
+void unpack_single_channel(const std::uint8_t *input, std::size_t size, T *output, std::uint8_t mask) {
+    for (std::size_t i = 0; i < size; ++i) {
+        output[i] = static_cast<T>(input[i] & mask);
+    }
+}
+
+// Signed values, one byte per value
+template<typename T>
+void convert_diff(const std::int8_t *input, std::size_t size, T *output) {
+    for (std::size_t i = 0; i < size; ++i) {
+        output[i] = static_cast<T>(input[i]);
+    }
+}
+
+inline std::uint8_t channel_mask(unsigned bit_size) {
+    return static_cast<std::uint8_t>((1u << bit_size) - 1);
+}
+
+} // namespace detail
+
+template<typename T>
+std::unique_ptr<EventFrameHisto<T>> RawEventFrameConverter::convert(const RawEventFrameHisto &h) const {
+    std::vector<T> output;
+    convert(h, output);
+    return std::make_unique<EventFrameHisto<T>>(height_, width_, num_channels_, format_, std::move(output));
+}
+
+template<typename T>
+std::unique_ptr<EventFrameDiff<T>> RawEventFrameConverter::convert(const RawEventFrameDiff &d) const {
+    std::vector<T> output;
+    convert(d, output);
+    return std::make_unique<EventFrameDiff<T>>(height_, width_, std::move(output));
+}
+
+template<typename T>
+void RawEventFrameConverter::convert(const RawEventFrameHisto &h, std::vector<T> &output) const {
+    output.resize(get_histo_size());
+    convert(h, output.data());
+}
+
+template<typename T>
+void RawEventFrameConverter::convert(const RawEventFrameDiff &d, std::vector<T> &output) const {
+    output.resize(get_diff_size());
+    convert(d, output.data());
+}
+
+template<typename T>
+void RawEventFrameConverter::convert(const RawEventFrameHisto &h, T *output) const {
+    assert(num_channels_ == 2); /// histo has 2 channels (by definition)
+    const auto &histo_cfg = h.get_config();
+    assert(height_ == histo_cfg.height);
+    assert(width_ == histo_cfg.width);
+
+    if (histo_cfg.channel_bit_size.size() != num_channels_) {
+        throw std::invalid_argument("Invalid number of channels in histogram. Expected " +
+                                    std::to_string(num_channels_) + " channels");
+    }
+
+    const std::uint8_t *input    = h.get_data().data();
+    const std::size_t num_pixels = get_diff_size();
+    if (num_channels_ == 2) {
+        const unsigned neg_bits      = histo_cfg.channel_bit_size[HistogramChannel::NEGATIVE];
+        const unsigned pos_bits      = histo_cfg.channel_bit_size[HistogramChannel::POSITIVE];
+        const std::uint8_t neg_mask  = detail::channel_mask(neg_bits);
+        const std::uint8_t pos_mask  = detail::channel_mask(pos_bits);
+        const std::size_t input_size = histo_cfg.packed ? num_pixels : 2 * num_pixels;
+        if (h.get_data().size() < input_size) {
+            throw std::invalid_argument("Invalid histogram size. Expected at least " + std::to_string(input_size) +
+                                        " bytes");
+        }
+
+        if (histo_cfg.packed) {
+            if (format_ == HistogramFormat::HWC) {
+                detail::unpack_packed_histo_hwc(input, num_pixels, output, neg_bits, neg_mask, pos_mask);
+            } else {
+                detail::unpack_packed_histo_chw(input, num_pixels, output, output + channel_stride_, neg_bits,
+                                                neg_mask, pos_mask);
+            }
+        } else {
+            if (format_ == HistogramFormat::HWC) {
+                detail::unpack_unpacked_histo_hwc(input, num_pixels, output, neg_mask, pos_mask);
+            } else {
+                detail::unpack_unpacked_histo_chw(input, num_pixels, output, output + channel_stride_, neg_mask,
+                                                  pos_mask);
+            }
+        }
+    } else {
+        const std::size_t size = std::min(h.get_data().size(), get_histo_size());
+        detail::unpack_single_channel(input, size, output, detail::channel_mask(histo_cfg.channel_bit_size[0]));
+        std::fill(output + size, output + get_histo_size(), T(0));
+    }
+}
+
+template<typename T>
+void RawEventFrameConverter::convert(const RawEventFrameDiff &d, T *output) const {
+    assert(height_ == d.get_config().height);
+    assert(width_ == d.get_config().width);
+    const std::size_t size = std::min(d.get_data().size(), get_diff_size());
+    detail::convert_diff(d.get_data().data(), size, output);
+    std::fill(output + size, output + get_diff_size(), T(0));
+}
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_DETAIL_RAW_EVENT_FRAME_CONVERTER_IMPL_H
@@ -0,0 +1,141 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_CORE_EXECUTOR_H
+#define METAVISION_SDK_CORE_EXECUTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace Metavision {
+
+/// @brief Pool of worker threads running tasks, where idle workers steal tasks from the queues of busy ones
+///
+/// Each worker owns a queue of tasks. Tasks posted from a worker are pushed to its own queue, while tasks posted from
+/// other threads are spread over the queues. A worker whose queue is empty steals tasks from the other queues, and
+/// sleeps when there are no tasks at all, so that the CPU usage follows the actual load.
+///
+/// Tasks posted to an executor are run in no particular order: use a @ref Strand to run a sequence of tasks in order.
+///
+/// Most components use the executor returned by @ref get_default, whose number of workers can be set with the
+/// environment variable MV_EXECUTOR_NUM_WORKERS or with @ref set_default_num_workers.
+class Executor {
+public:
+    using Task = std::function<void()>;
+
+    class Strand;
+
+    /// @brief Constructor
+    /// @param num_workers Number of worker threads, if 0 the number of hardware threads is used (at least 2)
+    explicit Executor(std::size_t num_workers = 0);
+
+    /// @brief Destructor
+    ///
+    /// Waits for all pending tasks completion before joining the workers.
+    ~Executor();
+
+    Executor(const Executor &)            = delete;
+    Executor &operator=(const Executor &) = delete;
+
+    /// @brief Posts a task to be run by one of the workers
+    /// @param task Task to run
+    void post(Task task);
+
+    /// @brief Gets the number of worker threads
+    /// @return Number of worker threads
+    std::size_t get_num_workers() const;
+
+    /// @brief Gets the executor shared by the SDK components
+    ///
+    /// The executor is created on first call, and is never destroyed so that it can be used by objects destroyed
+    /// during the static destruction.
+    /// @return Executor shared by the SDK components
+    static Executor &get_default();
+
+    /// @brief Sets the number of workers of the executor returned by @ref get_default
+    /// @param num_workers Number of worker threads, if 0 the number of hardware threads is used (at least 2)
+    /// @return false if the default executor was already created, in which case the call has no effect
+    static bool set_default_num_workers(std::size_t num_workers);
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void worker_loop(std::size_t index);
+    bool pop_task(std::size_t index, Task &task);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<std::size_t> next_queue_{0};
+    std::atomic<std::size_t> pending_tasks_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cond_;
+    bool stop_ = false;
+};
+
+/// @brief Sequence of tasks run in order, one at a time, by the workers of an @ref Executor
+///
+/// A strand provides the ordering guarantees of a dedicated thread without owning one: when tasks are posted, the
+/// strand schedules itself on the executor and runs them in the order they were posted. To avoid starving the other
+/// strands, it yields the worker back to the executor after a few tasks.
+class Executor::Strand {
+public:
+    /// @brief Constructor
+    /// @param executor Executor running the tasks, must outlive the strand
+    explicit Strand(Executor &executor = Executor::get_default());
+
+    /// @brief Destructor
+    ///
+    /// Waits for all pending tasks completion.
+    ~Strand();
+
+    Strand(const Strand &)            = delete;
+    Strand &operator=(const Strand &) = delete;
+
+    /// @brief Posts a task to be run after all the tasks previously posted to this strand
+    /// @param task Task to run
+    void post(Task task);
+
+    /// @brief Drops the tasks that are not yet running
+    void clear();
+
+    /// @brief Waits until all the posted tasks are run, including the tasks posted by the tasks themselves
+    /// @warning Must not be called from a task of this strand
+    void wait();
+
+    /// @brief Checks if the calling thread is currently running a task of this strand
+    /// @return true if called from a task of this strand, false otherwise
+    bool running_in_this_thread() const;
+
+private:
+    void run();
+
+    Executor &executor_;
+    std::mutex mutex_;
+    std::condition_variable idle_cond_;
+    std::queue<Task> tasks_;
+    bool scheduled_ = false;
+    std::atomic<std::thread::id> running_thread_id_{std::thread::id()};
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_CORE_EXECUTOR_H
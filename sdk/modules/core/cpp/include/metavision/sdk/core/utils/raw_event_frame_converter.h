@@ -12,9 +12,9 @@
 #ifndef METAVISION_SDK_CORE_RAW_EVENT_FRAME_CONVERTER_H
 #define METAVISION_SDK_CORE_RAW_EVENT_FRAME_CONVERTER_H
 
+#include <cstddef>
 #include <memory>
 #include <vector>
-#include <cassert>
 
 #include <metavision/sdk/base/events/raw_event_frame_diff.h>
 #include <metavision/sdk/base/events/raw_event_frame_histo.h>
@@ -105,6 +105,33 @@ public:
     template<typename T>
     std::unique_ptr<EventFrameDiff<T>> convert(const RawEventFrameDiff &d) const;
 
+    /// @brief Converts a histogram into a caller-owned buffer, in the current output format
+    ///
+    /// The channels are unpacked and laid out in a single pass, so that the same buffer can be reused from one frame to
+    /// the next without any allocation.
+    /// @param h Histogram to convert
+    /// @param output Pointer to a buffer of at least @ref get_histo_size elements
+    template<typename T>
+    void convert(const RawEventFrameHisto &h, T *output) const;
+
+    /// @brief Converts a histogram into a caller-owned vector, in the current output format
+    /// @param h Histogram to convert
+    /// @param output Vector receiving the histogram, resized to @ref get_histo_size elements if needed
+    template<typename T>
+    void convert(const RawEventFrameHisto &h, std::vector<T> &output) const;
+
+    /// @brief Converts a diff frame into a caller-owned buffer
+    /// @param d Diff frame to convert
+    /// @param output Pointer to a buffer of at least @ref get_diff_size elements
+    template<typename T>
+    void convert(const RawEventFrameDiff &d, T *output) const;
+
+    /// @brief Converts a diff frame into a caller-owned vector
+    /// @param d Diff frame to convert
+    /// @param output Vector receiving the diff frame, resized to @ref get_diff_size elements if needed
+    template<typename T>
+    void convert(const RawEventFrameDiff &d, std::vector<T> &output) const;
+
     unsigned get_height() const {
         return height_;
     }
@@ -115,6 +142,16 @@ public:
         return format_;
     }
 
+    /// @brief Gets the number of elements of a converted histogram
+    std::size_t get_histo_size() const {
+        return static_cast<std::size_t>(height_) * width_ * num_channels_;
+    }
+
+    /// @brief Gets the number of elements of a converted diff frame
+    std::size_t get_diff_size() const {
+        return static_cast<std::size_t>(height_) * width_;
+    }
+
 private:
     HistogramFormat format_;
 
@@ -125,66 +162,8 @@ private:
     unsigned column_stride_;
 };
 
-template<typename T>
-std::unique_ptr<EventFrameHisto<T>> RawEventFrameConverter::convert(const RawEventFrameHisto &h) const {
-    assert(num_channels_ == 2); /// histo has 2 channels (by definition)
-    auto histo_cfg = h.get_config();
-    assert(height_ == histo_cfg.height);
-    assert(width_ == histo_cfg.width);
-
-    if (histo_cfg.channel_bit_size.size() != num_channels_) {
-        throw std::invalid_argument("Invalid number of channels in histogram. Expected " +
-                                    std::to_string(num_channels_) + " channels");
-    }
-
-    std::vector<T> output(histo_cfg.height * histo_cfg.width * histo_cfg.channel_bit_size.size());
-
-    unsigned idx = 0;
-    if (num_channels_ == 2) {
-        const unsigned neg_bits = histo_cfg.channel_bit_size[HistogramChannel::NEGATIVE];
-        const unsigned pos_bits = histo_cfg.channel_bit_size[HistogramChannel::POSITIVE];
-
-        for (auto data : h.get_data()) {
-            if (histo_cfg.packed) {
-                const T neg_val = data & ((1 << neg_bits) - 1);
-                const T pos_val = (data >> neg_bits) & ((1 << pos_bits) - 1);
-
-                output[idx * column_stride_]                   = neg_val;
-                output[idx * column_stride_ + channel_stride_] = pos_val;
-            } else {
-                if (idx % 2 == 0) {
-                    const T val                        = data & ((1 << neg_bits) - 1);
-                    output[(idx / 2) * column_stride_] = val;
-                } else {
-                    const T val                                          = data & ((1 << pos_bits) - 1);
-                    output[(idx / 2) * column_stride_ + channel_stride_] = val;
-                }
-            }
-            ++idx;
-        }
-    } else {
-        for (auto data : h.get_data()) {
-            output[idx] = data & ((1 << histo_cfg.channel_bit_size[0]) - 1);
-            ++idx;
-        }
-    }
-    return std::make_unique<EventFrameHisto<T>>(height_, width_, num_channels_, format_, std::move(output));
-}
-
-template<typename T>
-std::unique_ptr<EventFrameDiff<T>> RawEventFrameConverter::convert(const RawEventFrameDiff &d) const {
-    assert(height_ == d.get_config().height);
-    assert(width_ == d.get_config().width);
-    std::vector<T> output(height_ * width_);
-
-    unsigned idx = 0;
-    for (auto data : d.get_data()) {
-        output[idx] = data;
-        ++idx;
-    }
-    return std::make_unique<EventFrameDiff<T>>(height_, width_, std::move(output));
-}
-
 } // namespace Metavision
 
+#include "metavision/sdk/core/utils/detail/raw_event_frame_converter_impl.h"
+
 #endif // METAVISION_SDK_CORE_RAW_EVENT_FRAME_CONVERTER_H
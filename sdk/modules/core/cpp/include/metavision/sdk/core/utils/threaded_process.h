@@ -13,22 +13,29 @@
 #define METAVISION_SDK_CORE_THREADED_PROCESS_H
 
 #include <memory>
-#include <condition_variable>
-#include <thread>
-#include <queue>
+#include <mutex>
 #include <atomic>
 #include <functional>
+#include <thread>
 
-#include "metavision/sdk/base/utils/object_pool.h"
+#include "metavision/sdk/core/utils/executor.h"
 
 namespace Metavision {
 
-/// @brief A convenient object whose purpose is to queue and dequeue tasks in a thread
+/// @brief A convenient object whose purpose is to queue and dequeue tasks in order, in another thread
+///
+/// The tasks are run by a @ref Executor::Strand of an @ref Executor (the default one unless specified), so that
+/// processes that are mostly idle do not each hold a thread. Processes running blocking tasks (e.g. writing to disk)
+/// should use an executor of their own, so that they do not hold the workers of the default one.
 class ThreadedProcess {
 public:
     using Task          = std::function<void()>;
     using RepeatingTask = std::function<bool()>;
 
+    /// @brief Constructor
+    /// @param executor Executor running the tasks, must outlive the process
+    explicit ThreadedProcess(Executor &executor = Executor::get_default());
+
     /// @brief Destructor
     ///
     /// Waits for all pending tasks completion before leaving the thread.
@@ -38,6 +45,13 @@ public:
     /// @brief Adds a task to the processing queue.
     void add_task(Task task);
 
+    /// @brief Adds a task to the processing queue and waits for its completion
+    ///
+    /// When called from one of the tasks of the process, the task is run immediately, as it would otherwise wait for
+    /// itself.
+    /// @return false if the task was not run, because the process is not active or has been aborted
+    bool add_task_and_wait(Task task);
+
     /// @brief Adds a task that is repeated once it is done if and only if its result returns true.
     void add_repeating_task(RepeatingTask task);
 
@@ -48,11 +62,13 @@ public:
     /// @brief Requests the processing thread to stop and join
     ///
     /// The processing thread remains active until all pending tasks have been processed
+    /// @warning Must not be called from one of the tasks of the process
     void stop();
 
     /// @brief Requests the processing thread to abort and join
     ///
     /// The threads leaves when it is no longer processing a task. All remaining tasks are dropped.
+    /// @warning Must not be called from one of the tasks of the process
     void abort();
 
     /// @brief Returns if the processing thread is ongoing
@@ -60,14 +76,14 @@ public:
 
 private:
     void stop(bool abort);
-    void processing_thread();
+    bool post(Task task);
 
 private:
-    std::queue<Task> tasks_;
-    std::thread processing_thread_;
+    Executor &executor_;
+    std::unique_ptr<Executor::Strand> strand_;
     std::mutex process_mutex_;
-    std::condition_variable process_cond_;
-    std::atomic<bool> stop_{true}, abort_{true};
+    std::atomic<bool> active_{false}, abort_{true};
+    std::atomic<std::thread::id> task_thread_id_{std::thread::id()};
 };
 
 } // namespace Metavision
@@ -30,11 +30,44 @@ AdaptiveRateEventsSplitterAlgorithm::AdaptiveRateEventsSplitterAlgorithm(int hei
     one_over_height_times_width_squared_ = one_over_height_times_width_ * one_over_height_times_width_;
 }
 
+bool AdaptiveRateEventsSplitterAlgorithm::is_slice_ready() {
+    float var_per_event_pos = 0.f;
+    if (nb_pos_ == 0) {
+        assert(var_pos_ == 0.f);
+    } else {
+        var_per_event_pos = var_pos_ / nb_pos_;
+    }
+    float var_per_event_neg = 0.f;
+    if (nb_neg_ == 0) {
+        assert(var_neg_ == 0.f);
+    } else {
+        var_per_event_neg = var_neg_ / nb_neg_;
+    }
+    const float ratio_pix_both = nb_both_pos_and_neg_pix_ / (nb_pos_pix_ + nb_neg_pix_ + 1e-5f);
+
+    if ((ratio_pix_both >= kMaxRatioBothPix) ||
+        ((var_per_event_neg < prev_var_per_event_neg_) && (var_per_event_neg > thr_var_per_event_)) ||
+        ((var_per_event_pos < prev_var_per_event_pos_) && (var_per_event_pos > thr_var_per_event_))) {
+        return true;
+    }
+    prev_var_per_event_neg_ = var_per_event_neg;
+    prev_var_per_event_pos_ = var_per_event_pos;
+    return false;
+}
+
 void AdaptiveRateEventsSplitterAlgorithm::reset_local_variables() {
-    img_pos_.resize(height_ * width_);
-    img_neg_.resize(height_ * width_);
-    std::fill(img_pos_.begin(), img_pos_.end(), 0);
-    std::fill(img_neg_.begin(), img_neg_.end(), 0);
+    const std::size_t nb_pixels = static_cast<std::size_t>(height_) * width_;
+    if (img_pos_.size() != nb_pixels || touched_pixels_.size() > nb_pixels / 8) {
+        // resetting the whole images is faster when a large part of the pixels was touched
+        img_pos_.assign(nb_pixels, 0);
+        img_neg_.assign(nb_pixels, 0);
+    } else {
+        for (const int idx_pix : touched_pixels_) {
+            img_pos_[idx_pix] = 0;
+            img_neg_[idx_pix] = 0;
+        }
+    }
+    touched_pixels_.clear();
 
     nb_pos_                 = 0;
     mean_pos_               = 0.f;
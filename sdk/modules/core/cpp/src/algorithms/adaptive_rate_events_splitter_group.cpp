@@ -0,0 +1,104 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+
+#include "metavision/sdk/core/algorithms/adaptive_rate_events_splitter_group.h"
+
+namespace Metavision {
+
+AdaptiveRateEventsSplitterGroup::AdaptiveRateEventsSplitterGroup(Executor &executor) : executor_(executor) {}
+
+std::size_t AdaptiveRateEventsSplitterGroup::add_splitter(
+    int height, int width, const AdaptiveRateEventsSplitterAlgorithm::StatisticsFilter &filter,
+    float thr_var_per_event, int downsampling_factor) {
+    splitters_.emplace_back(std::make_unique<AdaptiveRateEventsSplitterAlgorithm>(height, width, thr_var_per_event,
+                                                                                   downsampling_factor));
+    splitters_.back()->set_statistics_filter(filter);
+    return splitters_.size() - 1;
+}
+
+std::size_t AdaptiveRateEventsSplitterGroup::size() const {
+    return splitters_.size();
+}
+
+void AdaptiveRateEventsSplitterGroup::set_slice_callback(const SliceCallback &cb) {
+    slice_cb_ = cb;
+}
+
+// State of the processing of a buffer, shared by the calling thread and the tasks posted to the executor
+struct AdaptiveRateEventsSplitterGroup::Batch {
+    explicit Batch(std::size_t num_splitters) : num_splitters(num_splitters) {}
+
+    const std::size_t num_splitters;
+    std::atomic<std::size_t> next_index{0};
+    std::mutex mutex;
+    std::condition_variable done_cond;
+    std::size_t num_done = 0;
+    std::exception_ptr error;
+};
+
+void AdaptiveRateEventsSplitterGroup::process_events(const EventCD *begin, const EventCD *end,
+                                                     std::size_t check_interval) {
+    if (splitters_.empty()) {
+        return;
+    }
+
+    // the splitters are claimed one by one by the tasks posted to the executor and by the calling thread, which thus
+    // processes them all itself if the executor is busy (e.g. when called from one of its tasks). A task running after
+    // all the splitters have been claimed does nothing, and only accesses the batch that it keeps alive
+    auto batch = std::make_shared<Batch>(splitters_.size());
+    for (std::size_t i = 1; i < splitters_.size(); ++i) {
+        executor_.post([this, batch, begin, end, check_interval]() { run_batch(*batch, begin, end, check_interval); });
+    }
+    run_batch(*batch, begin, end, check_interval);
+
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->done_cond.wait(lock, [&batch]() { return batch->num_done == batch->num_splitters; });
+    if (batch->error) {
+        std::rethrow_exception(batch->error);
+    }
+}
+
+void AdaptiveRateEventsSplitterGroup::run_batch(Batch &batch, const EventCD *begin, const EventCD *end,
+                                                std::size_t check_interval) {
+    for (std::size_t index = batch.next_index++; index < batch.num_splitters; index = batch.next_index++) {
+        std::exception_ptr error;
+        try {
+            process_events(index, begin, end, check_interval);
+        } catch (...) { error = std::current_exception(); }
+
+        std::lock_guard<std::mutex> lock(batch.mutex);
+        if (error && !batch.error) {
+            batch.error = error;
+        }
+        if (++batch.num_done == batch.num_splitters) {
+            batch.done_cond.notify_all();
+        }
+    }
+}
+
+void AdaptiveRateEventsSplitterGroup::process_events(std::size_t index, const EventCD *begin, const EventCD *end,
+                                                     std::size_t check_interval) {
+    splitters_[index]->process_events(
+        begin, end,
+        [this, index](const AdaptiveRateEventsSplitterAlgorithm::SliceView &slice) {
+            if (slice_cb_) {
+                slice_cb_(index, slice);
+            }
+        },
+        check_interval);
+}
+
+} // namespace Metavision
@@ -46,18 +46,27 @@ void OnDemandFrameGenerationAlgorithm::generate(timestamp ts, cv::Mat &frame, bo
     }
 
     const timestamp ts_min = accumulation_time_us_ == 0 ? last_frame_ts_us_ + 1 : ts - accumulation_time_us_ + 1;
-    const auto begin       = std::lower_bound(events_queue_.begin(), events_queue_.end(), ts_min,
+    if (vectors_queue_.empty()) {
+        generate_from_queue(events_queue_, ts_min, ts, frame);
+    } else {
+        generate_from_queue(vectors_queue_, ts_min, ts, frame);
+    }
+
+    last_frame_ts_us_ = ts;
+}
+
+template<typename Event>
+void OnDemandFrameGenerationAlgorithm::generate_from_queue(std::deque<Event> &queue, timestamp ts_min, timestamp ts,
+                                                           cv::Mat &frame) {
+    const auto begin = std::lower_bound(queue.begin(), queue.end(), ts_min,
                                         [](const auto &ev, timestamp t) { return ev.t < t; });
-    const auto end =
-        std::upper_bound(begin, events_queue_.end(), ts, [](timestamp t, const auto &ev) { return t < ev.t; });
+    const auto end   = std::upper_bound(begin, queue.end(), ts, [](timestamp t, const auto &ev) { return t < ev.t; });
 
     // Generate frame using events from the queue
     generate_frame_from_events(begin, end, frame, bg_color_, off_on_colors_, flags_);
     // Remove events older than ts - accumulation_time,
     // Or remove all the processed events if the accumulation time is null
-    events_queue_.erase(events_queue_.begin(), (accumulation_time_us_ == 0 ? end : begin));
-
-    last_frame_ts_us_ = ts;
+    queue.erase(queue.begin(), (accumulation_time_us_ == 0 ? end : begin));
 }
 
 void OnDemandFrameGenerationAlgorithm::set_accumulation_time_us(uint32_t accumulation_time_us) {
@@ -73,6 +82,7 @@ uint32_t OnDemandFrameGenerationAlgorithm::get_accumulation_time_us() const {
 
 void OnDemandFrameGenerationAlgorithm::reset() {
     events_queue_.clear();
+    vectors_queue_.clear();
     last_frame_ts_us_ = 0;
 }
 
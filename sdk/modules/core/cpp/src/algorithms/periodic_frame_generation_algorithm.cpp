@@ -9,6 +9,7 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <algorithm>
 #include <stdexcept>
 #include "metavision/sdk/core/algorithms/periodic_frame_generation_algorithm.h"
 
@@ -23,7 +24,9 @@ PeriodicFrameGenerationAlgorithm::PeriodicFrameGenerationAlgorithm(int sensor_wi
                   std::size_t n_processed_events) {
         this->process_new_slice(slicing_status, processing_ts, n_processed_events);
     }),
-    force_next_frame_(false) {
+    force_next_frame_(false),
+    n_tiles_x_((sensor_width + kTileSize - 1) / kTileSize),
+    n_tiles_y_((sensor_height + kTileSize - 1) / kTileSize) {
     set_accumulation_time_us(accumulation_time_us);
     set_fps(fps);
     reset();
@@ -88,12 +91,13 @@ void PeriodicFrameGenerationAlgorithm::process_new_slice(EventBufferReslicerAlgo
         return;
 
     // Generate Frame using the time surface
+    int frame_type;
     if (flags_ & Parameters::GRAY) {
-        frame_.create(height_, width_, CV_8U);
+        frame_type = CV_8U;
     } else if (flags_ & Parameters::RGB || flags_ & Parameters::BGR) {
-        frame_.create(height_, width_, CV_8UC3);
+        frame_type = CV_8UC3;
     } else {
-        frame_.create(height_, width_, CV_8UC4);
+        frame_type = CV_8UC4;
     }
 
     // Compute the time threshold below which events are not to be displayed
@@ -101,58 +105,40 @@ void PeriodicFrameGenerationAlgorithm::process_new_slice(EventBufferReslicerAlgo
     //      Let's subtract the accumulation time to the current processing timestamp
     const int32_t min_display_event_ts = static_cast<int32_t>((processing_ts - accumulation_time_us_) - ts_offset_);
 
-    cv::Vec3b _bg_color3;
-    cv::Vec4b _bg_color4;
-    std::array<cv::Vec3b, 2> _off_on_colors3;
-    std::array<cv::Vec4b, 2> _off_on_colors4;
-    if (flags_ & Parameters::BGR || flags_ & Parameters::BGRA) {
-        _bg_color3      = detail::bgr(bg_color_);
-        _off_on_colors3 = {detail::bgr(off_on_colors_[0]), detail::bgr(off_on_colors_[1])};
-        _bg_color4      = bg_color_;
-        _off_on_colors4 = off_on_colors_;
-    } else {
-        _bg_color3      = detail::rgb(bg_color_);
-        _off_on_colors3 = {detail::rgb(off_on_colors_[0]), detail::rgb(off_on_colors_[1])};
-        _bg_color4      = detail::rgba(bg_color_);
-        _off_on_colors4 = {detail::rgba(off_on_colors_[0]), detail::rgba(off_on_colors_[1])};
-    }
+    // The tiles that displayed no event in the last rendered frame, and received none since, are left untouched. This
+    // requires the threshold not to decrease, and the rendering parameters to be unchanged.
+    const bool full_render = !canvas_valid_ || canvas_.type() != frame_type || canvas_flags_ != flags_ ||
+                             canvas_bg_color_ != bg_color_ || canvas_off_on_colors_ != off_on_colors_ ||
+                             min_display_event_ts < canvas_min_display_ts_;
+    canvas_.create(height_, width_, frame_type);
 
-    // Fill the frame from the time surface
-    const size_t height = static_cast<size_t>(frame_.rows);
-    const size_t width  = static_cast<size_t>(frame_.cols);
-    // Matrices allocated with the create() method are always continuous in memory
+    const bool bgr_order = flags_ & Parameters::BGR || flags_ & Parameters::BGRA;
     if (flags_ & Parameters::GRAY) {
-        for (size_t y = 0; y < height; ++y) {
-            const auto last_pix_data_ptr = &time_surface_[y * width];
-            auto img_ptr                 = frame_.ptr<uint8_t>(flags_ & Parameters::FLIP_Y ? height - 1 - y : y);
-            for (size_t x = 0; x < width; ++x) {
-                img_ptr[x] = last_pix_data_ptr[x].first < min_display_event_ts ?
-                                 bg_color_[0] :
-                                 off_on_colors_[last_pix_data_ptr[x].second][0];
-            }
-        }
-    } else if (flags_ & Parameters::RGB || flags_ & Parameters::BGR) {
-        for (size_t y = 0; y < height; ++y) {
-            const auto last_pix_data_ptr = &time_surface_[y * width];
-            auto img_ptr                 = frame_.ptr<cv::Vec3b>(flags_ & Parameters::FLIP_Y ? height - 1 - y : y);
-            for (size_t x = 0; x < width; ++x) {
-                img_ptr[x] = last_pix_data_ptr[x].first < min_display_event_ts ?
-                                 _bg_color3 :
-                                 _off_on_colors3[last_pix_data_ptr[x].second];
-            }
-        }
+        render_tiles<uint8_t>(bg_color_[0], {off_on_colors_[0][0], off_on_colors_[1][0]}, min_display_event_ts,
+                              full_render);
+    } else if (frame_type == CV_8UC3 && bgr_order) {
+        render_tiles<cv::Vec3b>(detail::bgr(bg_color_), {detail::bgr(off_on_colors_[0]), detail::bgr(off_on_colors_[1])},
+                                min_display_event_ts, full_render);
+    } else if (frame_type == CV_8UC3) {
+        render_tiles<cv::Vec3b>(detail::rgb(bg_color_), {detail::rgb(off_on_colors_[0]), detail::rgb(off_on_colors_[1])},
+                                min_display_event_ts, full_render);
+    } else if (bgr_order) {
+        render_tiles<cv::Vec4b>(bg_color_, off_on_colors_, min_display_event_ts, full_render);
     } else {
-        for (size_t y = 0; y < height; ++y) {
-            const auto last_pix_data_ptr = &time_surface_[y * width];
-            auto img_ptr                 = frame_.ptr<cv::Vec4b>(flags_ & Parameters::FLIP_Y ? height - 1 - y : y);
-            for (size_t x = 0; x < width; ++x) {
-                img_ptr[x] = last_pix_data_ptr[x].first < min_display_event_ts ?
-                                 _bg_color4 :
-                                 _off_on_colors4[last_pix_data_ptr[x].second];
-            }
-        }
+        render_tiles<cv::Vec4b>(detail::rgba(bg_color_),
+                                {detail::rgba(off_on_colors_[0]), detail::rgba(off_on_colors_[1])},
+                                min_display_event_ts, full_render);
     }
 
+    canvas_valid_          = true;
+    canvas_min_display_ts_ = min_display_event_ts;
+    canvas_flags_          = flags_;
+    canvas_bg_color_       = bg_color_;
+    canvas_off_on_colors_  = off_on_colors_;
+
+    // The output frame is a copy of the canvas, as it may be modified or swapped in the output callback
+    canvas_.copyTo(frame_);
+
     // Return generate frame through the output callback
     output_cb_(processing_ts, frame_);
 
@@ -169,9 +155,39 @@ void PeriodicFrameGenerationAlgorithm::skip_frames_up_to(timestamp ts) {
 }
 
 void PeriodicFrameGenerationAlgorithm::reset_time_surface() {
-    time_surface_.resize(width_ * height_);
-    std::fill(time_surface_.begin(), time_surface_.end(), std::make_pair(std::numeric_limits<int32_t>::min(), false));
-    ts_offset_ = 0;
+    ts_surface_.assign(width_ * height_, std::numeric_limits<int32_t>::min());
+    pol_surface_.assign(width_ * height_, 0);
+    tile_last_ts_.assign(n_tiles_x_ * n_tiles_y_, std::numeric_limits<int32_t>::min());
+    ts_offset_    = 0;
+    canvas_valid_ = false;
+}
+
+template<typename PixelT>
+void PeriodicFrameGenerationAlgorithm::render_tiles(const PixelT &bg_color, const std::array<PixelT, 2> &off_on_colors,
+                                                    int32_t min_display_event_ts, bool full_render) {
+    const bool flip_y = flags_ & Parameters::FLIP_Y;
+    for (int tile_y = 0; tile_y < n_tiles_y_; ++tile_y) {
+        const int y_begin = tile_y * kTileSize;
+        const int y_end   = std::min(y_begin + kTileSize, height_);
+        for (int tile_x = 0; tile_x < n_tiles_x_; ++tile_x) {
+            // All the pixels of a tile whose events are older than the previous threshold were already displayed with
+            // the background color, and still are since the threshold did not decrease
+            if (!full_render && tile_last_ts_[tile_y * n_tiles_x_ + tile_x] < canvas_min_display_ts_) {
+                continue;
+            }
+
+            const int x_begin = tile_x * kTileSize;
+            const int x_end   = std::min(x_begin + kTileSize, width_);
+            for (int y = y_begin; y < y_end; ++y) {
+                const int32_t *ts_ptr  = &ts_surface_[y * width_];
+                const uint8_t *pol_ptr = &pol_surface_[y * width_];
+                PixelT *img_ptr        = canvas_.ptr<PixelT>(flip_y ? height_ - 1 - y : y);
+                for (int x = x_begin; x < x_end; ++x) {
+                    img_ptr[x] = ts_ptr[x] < min_display_event_ts ? bg_color : off_on_colors[pol_ptr[x]];
+                }
+            }
+        }
+    }
 }
 
 } // namespace Metavision
\ No newline at end of file
@@ -64,14 +64,22 @@ void CDFrameGenerator::add_events(const EventCD *begin, const EventCD *end) {
         return;
     }
 
-    std::lock_guard<std::mutex> lock(processing_mutex_);
-    // Note: one could call frame_generation_algorithm->process_events directly but it may have a high overhead
-    // depending on the inputs.and decreases the performance. Better ensure that bigger chunks of data are processed
-    events_back_.insert(events_back_.end(), begin, end);
-    if (std::prev(end)->t > next_notify_us_) {
-        events_available_ = true;
-        next_notify_us_   = notify_slice_us_ * (1 + begin->t / notify_slice_us_);
-        events_available_cond_.notify_all();
+    bool schedule_generation = false;
+    {
+        std::lock_guard<std::mutex> lock(processing_mutex_);
+        // Note: one could call frame_generation_algorithm->process_events directly but it may have a high overhead
+        // depending on the inputs.and decreases the performance. Better ensure that bigger chunks of data are
+        // processed
+        events_back_.insert(events_back_.end(), begin, end);
+        if (std::prev(end)->t > next_notify_us_) {
+            next_notify_us_ = notify_slice_us_ * (1 + begin->t / notify_slice_us_);
+            // only one generation is scheduled at a time, it processes all the events available when it runs
+            schedule_generation = !events_available_;
+            events_available_   = true;
+        }
+    }
+    if (schedule_generation) {
+        processing_thread_.add_task([this]() { generate(false); });
     }
 }
 
@@ -81,10 +89,9 @@ void CDFrameGenerator::set_display_accumulation_time_us(timestamp display_accumu
     notify_slice_us_      = std::max(timestamp(100), display_accumulation_time_us / 3);
 }
 
-bool CDFrameGenerator::generate() {
+void CDFrameGenerator::generate(bool flush) {
     {
         std::unique_lock<std::mutex> lock(processing_mutex_);
-        events_available_cond_.wait(lock, [this]() { return events_available_ || stop_; });
         events_front_.clear();
         events_front_.swap(events_back_);
         events_available_ = false;
@@ -99,7 +106,7 @@ bool CDFrameGenerator::generate() {
     }
 
     frame_generation_algo_->process_events(events_front_.cbegin(), events_front_.cend());
-    if (stop_) {
+    if (flush) {
         frame_generation_algo_->force_generate();
     }
 
@@ -108,8 +115,6 @@ bool CDFrameGenerator::generate() {
         frame_cb_(frames_[i].ts_us_, frames_[i].frame_);
     }
     frames_count_ = 0;
-
-    return !stop_;
 }
 
 bool CDFrameGenerator::start(std::uint16_t fps, const PeriodicFrameGenerationAlgorithm::OutputCb &cb) {
@@ -134,18 +139,24 @@ bool CDFrameGenerator::start(std::uint16_t fps, const PeriodicFrameGenerationAlg
 
     stop_ = false;
 
-    processing_thread_.add_repeating_task(std::bind(&CDFrameGenerator::generate, this));
-
     return true;
 }
 
 bool CDFrameGenerator::stop() {
-    stop_ = true;
-    events_available_cond_.notify_all();
+    const bool was_started = !stop_.exchange(true);
     if (process_all_frames_) {
+        // last generation, processing the remaining events and forcing the generation of the last frame
+        if (was_started) {
+            processing_thread_.add_task([this]() { generate(true); });
+        }
         processing_thread_.stop();
     } else {
+        // the pending generation is dropped, its events are still buffered and only the latest frame is generated
+        // from them, here, once the processing thread is idle
         processing_thread_.abort();
+        if (was_started) {
+            generate(true);
+        }
     }
 
     frames_.clear();
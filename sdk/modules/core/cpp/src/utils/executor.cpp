@@ -0,0 +1,203 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "metavision/sdk/core/utils/executor.h"
+
+namespace Metavision {
+
+namespace {
+
+// Worker of the executor the calling thread belongs to, if any
+thread_local const Executor *current_executor = nullptr;
+thread_local std::size_t current_worker_index = 0;
+
+// Maximum number of tasks a strand runs before giving the worker back to the executor
+constexpr int kMaxStrandTasksPerRun = 16;
+
+std::mutex default_executor_mutex;
+std::size_t default_num_workers = 0;
+Executor *default_executor      = nullptr;
+
+std::size_t get_num_workers_or_default(std::size_t num_workers) {
+    if (num_workers == 0) {
+        num_workers = std::max(2u, std::thread::hardware_concurrency());
+    }
+    return num_workers;
+}
+
+} // namespace
+
+Executor::Executor(std::size_t num_workers) {
+    num_workers = get_num_workers_or_default(num_workers);
+    for (std::size_t i = 0; i < num_workers; ++i) {
+        queues_.emplace_back(std::make_unique<WorkerQueue>());
+    }
+    for (std::size_t i = 0; i < num_workers; ++i) {
+        workers_.emplace_back(&Executor::worker_loop, this, i);
+    }
+}
+
+Executor::~Executor() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_ = true;
+    }
+    sleep_cond_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+}
+
+void Executor::post(Task task) {
+    const std::size_t index =
+        (current_executor == this) ? current_worker_index : next_queue_.fetch_add(1) % queues_.size();
+
+    // the counter is incremented first so that a worker never misses a task when going to sleep
+    ++pending_tasks_;
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+    sleep_cond_.notify_one();
+}
+
+std::size_t Executor::get_num_workers() const {
+    return workers_.size();
+}
+
+Executor &Executor::get_default() {
+    std::lock_guard<std::mutex> lock(default_executor_mutex);
+    if (!default_executor) {
+        std::size_t num_workers = default_num_workers;
+        if (num_workers == 0) {
+            if (const char *env = std::getenv("MV_EXECUTOR_NUM_WORKERS")) {
+                num_workers = static_cast<std::size_t>(std::max(0, std::atoi(env)));
+            }
+        }
+        default_executor = new Executor(num_workers);
+    }
+    return *default_executor;
+}
+
+bool Executor::set_default_num_workers(std::size_t num_workers) {
+    std::lock_guard<std::mutex> lock(default_executor_mutex);
+    if (default_executor) {
+        return false;
+    }
+    default_num_workers = num_workers;
+    return true;
+}
+
+bool Executor::pop_task(std::size_t index, Task &task) {
+    // tasks are taken from the worker's own queue first, then stolen from the other queues
+    for (std::size_t i = 0; i < queues_.size(); ++i) {
+        auto &queue = *queues_[(index + i) % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            --pending_tasks_;
+            return true;
+        }
+    }
+    return false;
+}
+
+void Executor::worker_loop(std::size_t index) {
+    current_executor     = this;
+    current_worker_index = index;
+
+    Task task;
+    while (true) {
+        if (pop_task(index, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleep_cond_.wait(lock, [this]() { return stop_ || pending_tasks_ > 0; });
+        if (stop_ && pending_tasks_ == 0) {
+            break;
+        }
+    }
+}
+
+Executor::Strand::Strand(Executor &executor) : executor_(executor) {}
+
+Executor::Strand::~Strand() {
+    wait();
+}
+
+void Executor::Strand::post(Task task) {
+    bool schedule = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push(std::move(task));
+        if (!scheduled_) {
+            scheduled_ = true;
+            schedule   = true;
+        }
+    }
+    if (schedule) {
+        executor_.post([this]() { run(); });
+    }
+}
+
+void Executor::Strand::clear() {
+    std::queue<Task> dropped_tasks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        dropped_tasks.swap(tasks_);
+    }
+    // the dropped tasks are destroyed out of the lock, in case their destruction posts new tasks
+}
+
+void Executor::Strand::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cond_.wait(lock, [this]() { return !scheduled_; });
+}
+
+bool Executor::Strand::running_in_this_thread() const {
+    return running_thread_id_ == std::this_thread::get_id();
+}
+
+void Executor::Strand::run() {
+    running_thread_id_ = std::this_thread::get_id();
+    for (int i = 0; i < kMaxStrandTasksPerRun; ++i) {
+        Task task;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (tasks_.empty()) {
+                // the strand may be destroyed as soon as it is notified as idle, it must not be accessed afterwards
+                running_thread_id_ = std::thread::id();
+                scheduled_         = false;
+                idle_cond_.notify_all();
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop();
+        }
+        task();
+    }
+
+    // gives the worker back to the executor, the remaining tasks are run when the strand is scheduled again
+    running_thread_id_ = std::thread::id();
+    executor_.post([this]() { run(); });
+}
+
+} // namespace Metavision
@@ -9,22 +9,67 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <future>
+
 #include "metavision/sdk/core/utils/threaded_process.h"
 
 namespace Metavision {
 
+ThreadedProcess::ThreadedProcess(Executor &executor) : executor_(executor) {}
+
 ThreadedProcess::~ThreadedProcess() {
     stop();
 }
 
 void ThreadedProcess::add_task(Task task) {
-    if (abort_) {
-        return;
+    post(std::move(task));
+}
+
+bool ThreadedProcess::add_task_and_wait(Task task) {
+    if (task_thread_id_ == std::this_thread::get_id()) {
+        task();
+        return true;
     }
 
-    std::lock_guard<std::mutex> lock(process_mutex_);
-    tasks_.push(task);
-    process_cond_.notify_all();
+    // If the task is dropped by abort, the promise is destroyed with it and the wait returns with a broken promise
+    auto done   = std::make_shared<std::promise<void>>();
+    auto future = done->get_future();
+    if (!post([task = std::move(task), done]() {
+            task();
+            done->set_value();
+        })) {
+        return false;
+    }
+    try {
+        future.get();
+    } catch (const std::future_error &) {
+        return false;
+    }
+    return true;
+}
+
+bool ThreadedProcess::post(Task task) {
+    if (!active_) {
+        return false;
+    }
+
+    // A task may add tasks while stop is waiting for the pending ones, it must not lock the process then. This is
+    // safe as the strand is only reset once no more task is running.
+    std::unique_lock<std::mutex> lock(process_mutex_, std::defer_lock);
+    if (task_thread_id_ != std::this_thread::get_id()) {
+        lock.lock();
+        if (!active_ || !strand_) {
+            return false;
+        }
+    }
+    strand_->post([this, task = std::move(task)]() {
+        if (!abort_) {
+            task_thread_id_ = std::this_thread::get_id();
+            task();
+            task_thread_id_ = std::thread::id();
+        }
+    });
+    return true;
 }
 
 void ThreadedProcess::add_repeating_task(RepeatingTask task) {
@@ -36,18 +81,15 @@ void ThreadedProcess::add_repeating_task(RepeatingTask task) {
 }
 
 bool ThreadedProcess::start() {
-    std::unique_lock<std::mutex> lock(process_mutex_);
-    if (processing_thread_.joinable()) {
+    std::lock_guard<std::mutex> lock(process_mutex_);
+    if (strand_) {
         // If already active, do not start the thread
         return false;
     }
 
-    // Clears tasks list
-    std::queue<Task> tasks;
-    tasks.swap(tasks_);
-
-    processing_thread_ = std::thread(&ThreadedProcess::processing_thread, this);
-    process_cond_.wait(lock, [this]() { return !stop_ && !abort_; });
+    strand_ = std::make_unique<Executor::Strand>(executor_);
+    abort_  = false;
+    active_ = true;
     return true;
 }
 
@@ -60,56 +102,26 @@ void ThreadedProcess::abort() {
 }
 
 void ThreadedProcess::stop(bool abort) {
-    {
-        std::lock_guard<std::mutex> lock(process_mutex_);
-        if (!processing_thread_.joinable()) {
-            return;
-        }
-
-        stop_  = true;
-        abort_ = abort;
-        process_cond_.notify_all();
+    std::lock_guard<std::mutex> lock(process_mutex_);
+    if (!strand_) {
+        return;
     }
 
-    if (processing_thread_.joinable()) {
-        processing_thread_.join();
+    if (abort) {
+        active_ = false;
+        abort_  = true;
+        strand_->clear();
+    } else {
+        // Pending tasks, and the tasks they add, are processed before leaving
+        strand_->wait();
+        active_ = false;
     }
+    strand_->wait();
+    strand_.reset();
 }
 
 bool ThreadedProcess::is_active() {
-    std::lock_guard<std::mutex> lock(process_mutex_);
-    return processing_thread_.joinable();
-}
-
-void ThreadedProcess::processing_thread() {
-    {
-        std::lock_guard<std::mutex> lock(process_mutex_);
-        stop_  = false;
-        abort_ = false;
-        process_cond_.notify_all();
-    }
-
-    while (!abort_) {
-        std::queue<Task> tasks;
-        {
-            std::unique_lock<std::mutex> lock(process_mutex_);
-            // Waits for tasks
-            process_cond_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
-            if (tasks_.empty()) {
-                // Stop call and no pending tasks
-                break;
-            }
-
-            // Swap tasks
-            tasks.swap(tasks_);
-        }
-
-        // Run tasks
-        while (!tasks.empty() && !abort_) {
-            tasks.front()();
-            tasks.pop();
-        }
-    }
+    return active_;
 }
 
 } // namespace Metavision
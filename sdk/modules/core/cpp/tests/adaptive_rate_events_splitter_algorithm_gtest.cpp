@@ -0,0 +1,208 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <map>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/core/algorithms/adaptive_rate_events_splitter_algorithm.h"
+#include "metavision/sdk/core/algorithms/adaptive_rate_events_splitter_group.h"
+#include "metavision/sdk/core/utils/executor.h"
+
+using namespace Metavision;
+
+namespace {
+
+constexpr int kWidth  = 128;
+constexpr int kHeight = 96;
+
+// Vertical edges crossing the sensor, plus some noise
+std::vector<EventCD> make_events(std::size_t n) {
+    std::mt19937 gen(7);
+    std::vector<EventCD> events;
+    for (std::size_t i = 0; i < n; ++i) {
+        const int edge_x = (i / 50) % kWidth;
+        const bool noise = gen() % 10 == 0;
+        const int x      = noise ? gen() % kWidth : std::min<int>(kWidth - 1, edge_x + gen() % 3);
+        events.emplace_back(x, gen() % kHeight, noise ? gen() % 2 : 1, static_cast<timestamp>(i));
+    }
+    return events;
+}
+
+std::vector<std::vector<EventCD>> split_with_copies(AdaptiveRateEventsSplitterAlgorithm &splitter,
+                                                    const std::vector<EventCD> &events, std::size_t buffer_size) {
+    std::vector<std::vector<EventCD>> slices;
+    for (std::size_t i = 0; i < events.size(); i += buffer_size) {
+        const std::size_t end = std::min(events.size(), i + buffer_size);
+        if (splitter.process_events(events.data() + i, events.data() + end)) {
+            slices.emplace_back();
+            splitter.retrieve_events(slices.back());
+        }
+    }
+    return slices;
+}
+
+std::vector<std::vector<EventCD>> split_with_views(AdaptiveRateEventsSplitterAlgorithm &splitter,
+                                                   const std::vector<EventCD> &events, std::size_t buffer_size,
+                                                   std::size_t check_interval) {
+    std::vector<std::vector<EventCD>> slices;
+    for (std::size_t i = 0; i < events.size(); i += buffer_size) {
+        const std::size_t end = std::min(events.size(), i + buffer_size);
+        // the events are processed from a temporary buffer to check that the views don't outlive it
+        std::vector<EventCD> buffer(events.data() + i, events.data() + end);
+        splitter.process_events(
+            buffer.data(), buffer.data() + buffer.size(),
+            [&](const AdaptiveRateEventsSplitterAlgorithm::SliceView &slice) {
+                slices.emplace_back();
+                slice.copy_to(slices.back());
+                EXPECT_EQ(slice.size(), slices.back().size());
+            },
+            check_interval);
+    }
+    return slices;
+}
+
+} // namespace
+
+TEST(AdaptiveRateEventsSplitterAlgorithm_GTest, views_give_same_slices_as_copies) {
+    const auto events = make_events(200000);
+    AdaptiveRateEventsSplitterAlgorithm copying_splitter(kHeight, kWidth, 5e-4f, 0);
+    AdaptiveRateEventsSplitterAlgorithm viewing_splitter(kHeight, kWidth, 5e-4f, 0);
+
+    const auto expected_slices = split_with_copies(copying_splitter, events, 500);
+    const auto slices          = split_with_views(viewing_splitter, events, 500, 0);
+
+    ASSERT_LT(2u, expected_slices.size());
+    ASSERT_EQ(expected_slices, slices);
+}
+
+TEST(AdaptiveRateEventsSplitterAlgorithm_GTest, same_slices_after_reset) {
+    // GIVEN a splitter that already produced slices, whose state was reset after each of them
+    const auto events = make_events(100000);
+    AdaptiveRateEventsSplitterAlgorithm used_splitter(kHeight, kWidth, 5e-4f, 1);
+    split_with_copies(used_splitter, events, 300);
+    std::vector<EventCD> remainder;
+    used_splitter.retrieve_events(remainder);
+
+    // WHEN splitting the stream again, THEN the slices are the same as with a new splitter
+    AdaptiveRateEventsSplitterAlgorithm new_splitter(kHeight, kWidth, 5e-4f, 1);
+    ASSERT_EQ(split_with_copies(new_splitter, events, 300), split_with_copies(used_splitter, events, 300));
+}
+
+TEST(AdaptiveRateEventsSplitterAlgorithm_GTest, slices_inside_buffers_cover_the_stream) {
+    const auto events = make_events(100000);
+    AdaptiveRateEventsSplitterAlgorithm splitter(kHeight, kWidth, 5e-4f, 0);
+
+    const auto slices = split_with_views(splitter, events, 5000, 200);
+    ASSERT_LT(2u, slices.size());
+
+    std::vector<EventCD> remainder, all_events;
+    splitter.retrieve_events(remainder);
+    for (const auto &slice : slices) {
+        ASSERT_FALSE(slice.empty());
+        all_events.insert(all_events.end(), slice.cbegin(), slice.cend());
+    }
+    all_events.insert(all_events.end(), remainder.cbegin(), remainder.cend());
+    ASSERT_EQ(events, all_events);
+}
+
+TEST(AdaptiveRateEventsSplitterAlgorithm_GTest, group_same_slices_as_individual_splitters) {
+    const auto events = make_events(100000);
+
+    std::vector<AdaptiveRateEventsSplitterAlgorithm::StatisticsFilter> filters(3);
+    filters[0].polarity = 1;
+    filters[1].polarity = 0;
+    filters[2].x0       = 32;
+    filters[2].x1       = 95;
+
+    Executor executor(4);
+    AdaptiveRateEventsSplitterGroup group(executor);
+    for (const auto &filter : filters) {
+        group.add_splitter(kHeight, kWidth, filter, 5e-4f, 0);
+    }
+    ASSERT_EQ(filters.size(), group.size());
+
+    std::mutex mutex;
+    std::map<std::size_t, std::vector<std::vector<EventCD>>> slices;
+    group.set_slice_callback([&](std::size_t index, const AdaptiveRateEventsSplitterAlgorithm::SliceView &slice) {
+        std::vector<EventCD> events;
+        slice.copy_to(events);
+        std::lock_guard<std::mutex> lock(mutex);
+        slices[index].push_back(std::move(events));
+    });
+    for (std::size_t i = 0; i < events.size(); i += 1000) {
+        std::vector<EventCD> buffer(events.data() + i, events.data() + std::min(events.size(), i + 1000));
+        group.process_events(buffer.data(), buffer.data() + buffer.size(), 100);
+    }
+
+    for (std::size_t i = 0; i < filters.size(); ++i) {
+        AdaptiveRateEventsSplitterAlgorithm splitter(kHeight, kWidth, 5e-4f, 0);
+        splitter.set_statistics_filter(filters[i]);
+        ASSERT_EQ(split_with_views(splitter, events, 1000, 100), slices[i]);
+    }
+}
+
+TEST(AdaptiveRateEventsSplitterAlgorithm_GTest, group_rethrows_callback_exception_once_all_splitters_are_done) {
+    const auto events = make_events(100000);
+
+    Executor executor(2);
+    AdaptiveRateEventsSplitterGroup group(executor);
+    for (int i = 0; i < 4; ++i) {
+        group.add_splitter(kHeight, kWidth, AdaptiveRateEventsSplitterAlgorithm::StatisticsFilter(), 5e-4f, 0);
+    }
+
+    // the callback throws for all the splitters but one, which is slow
+    std::atomic<int> num_running{0}, num_slow_done{0};
+    group.set_slice_callback([&](std::size_t index, const AdaptiveRateEventsSplitterAlgorithm::SliceView &) {
+        ++num_running;
+        if (index != 2) {
+            --num_running;
+            throw std::runtime_error("slice callback failure");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ++num_slow_done;
+        --num_running;
+    });
+
+    ASSERT_THROW(group.process_events(events.data(), events.data() + events.size(), 100), std::runtime_error);
+    EXPECT_EQ(0, num_running);
+    EXPECT_LT(0, num_slow_done);
+}
+
+TEST(AdaptiveRateEventsSplitterAlgorithm_GTest, group_can_process_events_from_a_task_of_its_executor) {
+    const auto events = make_events(100000);
+
+    Executor executor(1);
+    AdaptiveRateEventsSplitterGroup group(executor);
+    for (int i = 0; i < 3; ++i) {
+        group.add_splitter(kHeight, kWidth, AdaptiveRateEventsSplitterAlgorithm::StatisticsFilter(), 5e-4f, 0);
+    }
+    std::atomic<int> num_slices{0};
+    group.set_slice_callback(
+        [&](std::size_t, const AdaptiveRateEventsSplitterAlgorithm::SliceView &) { ++num_slices; });
+
+    // the only worker of the executor is busy with the call, which must process all the splitters itself
+    std::promise<void> done;
+    executor.post([&]() {
+        group.process_events(events.data(), events.data() + events.size(), 100);
+        done.set_value();
+    });
+    ASSERT_EQ(std::future_status::ready, done.get_future().wait_for(std::chrono::seconds(10)));
+    EXPECT_LT(0, num_slices);
+}
@@ -187,3 +187,36 @@ TEST_F(CDFrameGenerator_GTest, generate_all_frames) {
     ASSERT_TRUE(std::equal(expected_cd_frames.back().begin<uint8_t>(), expected_cd_frames.back().end<uint8_t>(),
                            cd_frames.back().begin<uint8_t>()));
 }
+
+TEST_F(CDFrameGenerator_GTest, stop_aborts_pending_generations_when_dropping_frames) {
+    int width         = 100;
+    int height        = 50;
+    std::uint16_t fps = 100;
+
+    Metavision::CDFrameGenerator cd_frame_generator(width, height, false);
+    cd_frame_generator.set_display_accumulation_time_us(10000);
+
+    // the frames are slower to display than the events are added
+    std::atomic<int> cb_count{0};
+    std::vector<Metavision::timestamp> time_cb;
+    cd_frame_generator.start(fps, [&](const Metavision::timestamp &ts, const cv::Mat &) {
+        time_cb.push_back(ts);
+        ++cb_count;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    });
+
+    constexpr int num_frames = 100;
+    for (int i = 0; i < num_frames; ++i) {
+        const Metavision::EventCD event(5, 10, 0, i * 10000 + 5000);
+        cd_frame_generator.add_events(&event, &event + 1);
+    }
+    while (cb_count == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    cd_frame_generator.stop();
+
+    // the pending generation is not waited for, and the last frame holds the last events
+    ASSERT_LE(2, time_cb.size());
+    EXPECT_GT(10, time_cb.size());
+    EXPECT_EQ((num_frames - 1) * 10000 + 5000, time_cb.back());
+}
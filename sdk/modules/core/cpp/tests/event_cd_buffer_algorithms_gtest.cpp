@@ -0,0 +1,115 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <opencv2/core.hpp>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_cd_buffer.h"
+#include "metavision/sdk/core/algorithms/base_frame_generation_algorithm.h"
+#include "metavision/sdk/core/algorithms/polarity_filter_algorithm.h"
+#include "metavision/sdk/core/algorithms/roi_filter_algorithm.h"
+#include "metavision/sdk/core/preprocessors/histo_processor.h"
+
+using namespace Metavision;
+
+namespace {
+
+constexpr int kWidth  = 320;
+constexpr int kHeight = 240;
+
+std::vector<EventCD> make_events(std::size_t n) {
+    std::mt19937 gen(42);
+    std::vector<EventCD> events;
+    timestamp t = 1000;
+    for (std::size_t i = 0; i < n; ++i) {
+        t += gen() % 5;
+        events.emplace_back(gen() % kWidth, gen() % kHeight, gen() % 2, t);
+    }
+    return events;
+}
+
+void assert_same_events(const std::vector<EventCD> &expected, const EventCDBuffer &buffer) {
+    ASSERT_EQ(expected.size(), buffer.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i], buffer[i]);
+    }
+}
+
+} // namespace
+
+TEST(EventCDBufferAlgorithms_GTest, roi_filter_same_events_as_aos) {
+    const auto events = make_events(5000);
+    for (bool relative_timestamps : {false, true}) {
+        EventCDBuffer buffer(relative_timestamps);
+        buffer.append(events.cbegin(), events.cend());
+        for (bool relative_coordinates : {false, true}) {
+            RoiFilterAlgorithm algo(37, 20, 201, 180, relative_coordinates);
+
+            std::vector<EventCD> expected;
+            algo.process_events(events.cbegin(), events.cend(), std::back_inserter(expected));
+
+            EventCDBuffer filtered(relative_timestamps);
+            algo.process_events(buffer, filtered);
+            assert_same_events(expected, filtered);
+        }
+    }
+}
+
+TEST(EventCDBufferAlgorithms_GTest, polarity_filter_same_events_as_aos) {
+    const auto events = make_events(5000);
+    EventCDBuffer buffer(true);
+    buffer.append(events.cbegin(), events.cend());
+    for (std::int16_t polarity : {0, 1}) {
+        PolarityFilterAlgorithm algo(polarity);
+
+        std::vector<EventCD> expected;
+        algo.process_events(events.cbegin(), events.cend(), std::back_inserter(expected));
+
+        EventCDBuffer filtered;
+        algo.process_events(buffer, filtered);
+        assert_same_events(expected, filtered);
+    }
+}
+
+TEST(EventCDBufferAlgorithms_GTest, histo_processor_same_tensor_as_aos) {
+    const auto events = make_events(5000);
+    EventCDBuffer buffer(true);
+    buffer.append(events.cbegin(), events.cend());
+    for (bool use_CHW : {true, false}) {
+        HistoProcessor<const EventCD *> events_processor(kWidth, kHeight, 4.f, 1.f, use_CHW);
+        HistoProcessor<EventCDBuffer::const_iterator> buffer_processor(kWidth, kHeight, 4.f, 1.f, use_CHW);
+
+        Tensor expected, tensor;
+        expected.create(events_processor.get_output_shape(), events_processor.get_output_type());
+        tensor.create(buffer_processor.get_output_shape(), buffer_processor.get_output_type());
+        events_processor.process_events(0, events.data(), events.data() + events.size(), expected);
+        buffer_processor.process_events(0, buffer.begin(), buffer.end(), tensor);
+
+        ASSERT_EQ(expected.byte_size(), tensor.byte_size());
+        ASSERT_EQ(0, std::memcmp(expected.data(), tensor.data(), expected.byte_size()));
+    }
+}
+
+TEST(EventCDBufferAlgorithms_GTest, generate_frame_from_events_same_frame_as_aos) {
+    const auto events = make_events(5000);
+    EventCDBuffer buffer;
+    buffer.append(events.cbegin(), events.cend());
+
+    cv::Mat expected(kHeight, kWidth, CV_8UC3), frame(kHeight, kWidth, CV_8UC3);
+    BaseFrameGenerationAlgorithm::generate_frame_from_events(events.cbegin(), events.cend(), expected, 2000);
+    BaseFrameGenerationAlgorithm::generate_frame_from_events(buffer.begin(), buffer.end(), frame, 2000);
+    ASSERT_EQ(0, cv::norm(expected, frame, cv::NORM_INF));
+}
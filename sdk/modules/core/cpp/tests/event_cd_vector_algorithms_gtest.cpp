@@ -0,0 +1,180 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <opencv2/core.hpp>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_cd_vector.h"
+#include "metavision/sdk/core/algorithms/on_demand_frame_generation_algorithm.h"
+#include "metavision/sdk/core/algorithms/periodic_frame_generation_algorithm.h"
+#include "metavision/sdk/core/algorithms/roi_filter_algorithm.h"
+#include "metavision/sdk/core/preprocessors/histo_processor.h"
+
+using namespace Metavision;
+
+namespace {
+
+constexpr int kWidth  = 320;
+constexpr int kHeight = 240;
+
+// Vectors with increasing timestamps, some of them overlapping the right border of the sensor
+std::vector<EventCDVector> make_vectors(std::size_t n) {
+    std::mt19937 gen(42);
+    std::vector<EventCDVector> vectors;
+    timestamp t = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        t += gen() % 50;
+        const uint16_t base_x = static_cast<uint16_t>(gen() % kWidth);
+        uint32_t mask         = static_cast<uint32_t>(gen()) | 1;
+        if (base_x + 32 > kWidth) {
+            mask &= (1u << (kWidth - base_x)) - 1;
+        }
+        vectors.emplace_back(base_x, static_cast<uint16_t>(gen() % kHeight), gen() % 2, mask, t);
+    }
+    return vectors;
+}
+
+std::vector<EventCD> expand(const std::vector<EventCDVector> &vectors) {
+    std::vector<EventCD> events;
+    for (const auto &v : vectors) {
+        v.for_each_x([&](uint16_t x) { events.emplace_back(x, v.y, v.p, v.t); });
+    }
+    return events;
+}
+
+void assert_same_frames(const cv::Mat &expected, const cv::Mat &frame) {
+    ASSERT_EQ(expected.size(), frame.size());
+    ASSERT_EQ(expected.type(), frame.type());
+    ASSERT_EQ(0, cv::norm(expected, frame, cv::NORM_INF));
+}
+
+} // namespace
+
+TEST(EventCDVectorAlgorithms_GTest, for_each_x_and_size) {
+    const EventCDVector v(10, 2, true, (1u << 31) | (1u << 4) | 1u, 5);
+    std::vector<uint16_t> xs;
+    v.for_each_x([&](uint16_t x) { xs.push_back(x); });
+    EXPECT_EQ(std::vector<uint16_t>({10, 14, 41}), xs);
+    EXPECT_EQ(3, v.size());
+}
+
+TEST(EventCDVectorAlgorithms_GTest, roi_filter_same_events_as_expanded) {
+    const auto vectors = make_vectors(2000);
+    for (bool relative : {false, true}) {
+        RoiFilterAlgorithm algo(37, 20, 201, 180, relative);
+
+        std::vector<EventCD> expected;
+        const auto events = expand(vectors);
+        algo.process_events(events.cbegin(), events.cend(), std::back_inserter(expected));
+
+        std::vector<EventCDVector> filtered_vectors;
+        algo.process_events(vectors.cbegin(), vectors.cend(), std::back_inserter(filtered_vectors));
+        for (const auto &v : filtered_vectors) {
+            ASSERT_NE(0u, v.vector_mask);
+        }
+
+        const auto filtered_events = expand(filtered_vectors);
+        ASSERT_EQ(expected.size(), filtered_events.size());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_EQ(expected[i], filtered_events[i]);
+        }
+    }
+}
+
+TEST(EventCDVectorAlgorithms_GTest, histo_processor_same_tensor_as_expanded) {
+    const auto vectors = make_vectors(2000);
+    const auto events  = expand(vectors);
+    for (bool use_CHW : {true, false}) {
+        HistoProcessor<const EventCD *> events_processor(kWidth, kHeight, 4.f, 1.f, use_CHW);
+        HistoProcessor<const EventCDVector *> vectors_processor(kWidth, kHeight, 4.f, 1.f, use_CHW);
+
+        Tensor expected, tensor;
+        expected.create(events_processor.get_output_shape(), events_processor.get_output_type());
+        tensor.create(vectors_processor.get_output_shape(), vectors_processor.get_output_type());
+        events_processor.process_events(0, events.data(), events.data() + events.size(), expected);
+        vectors_processor.process_events(0, vectors.data(), vectors.data() + vectors.size(), tensor);
+
+        ASSERT_EQ(expected.byte_size(), tensor.byte_size());
+        ASSERT_EQ(0, std::memcmp(expected.data(), tensor.data(), expected.byte_size()));
+    }
+}
+
+TEST(EventCDVectorAlgorithms_GTest, generate_frame_from_events_same_frame_as_expanded) {
+    const auto vectors = make_vectors(2000);
+    const auto events  = expand(vectors);
+
+    cv::Mat expected(kHeight, kWidth, CV_8UC3), frame(kHeight, kWidth, CV_8UC3);
+    BaseFrameGenerationAlgorithm::generate_frame_from_events(events.cbegin(), events.cend(), expected, 10000);
+    BaseFrameGenerationAlgorithm::generate_frame_from_events(vectors.cbegin(), vectors.cend(), frame, 10000);
+    assert_same_frames(expected, frame);
+}
+
+TEST(EventCDVectorAlgorithms_GTest, periodic_frame_generation_same_frames_as_expanded) {
+    const auto vectors = make_vectors(20000);
+    const auto events  = expand(vectors);
+
+    std::vector<cv::Mat> expected_frames, frames;
+    PeriodicFrameGenerationAlgorithm events_algo(kWidth, kHeight, 5000, 100.);
+    events_algo.set_output_callback([&](timestamp, cv::Mat &frame) { expected_frames.push_back(frame.clone()); });
+    PeriodicFrameGenerationAlgorithm vectors_algo(kWidth, kHeight, 5000, 100.);
+    vectors_algo.set_output_callback([&](timestamp, cv::Mat &frame) { frames.push_back(frame.clone()); });
+
+    events_algo.process_events(events.cbegin(), events.cend());
+    vectors_algo.process_events(vectors.cbegin(), vectors.cend());
+
+    ASSERT_FALSE(expected_frames.empty());
+    ASSERT_EQ(expected_frames.size(), frames.size());
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        assert_same_frames(expected_frames[i], frames[i]);
+    }
+}
+
+TEST(EventCDVectorAlgorithms_GTest, on_demand_frame_generation_same_frames_as_expanded) {
+    const auto vectors = make_vectors(20000);
+    const auto events  = expand(vectors);
+
+    OnDemandFrameGenerationAlgorithm events_algo(kWidth, kHeight, 5000);
+    OnDemandFrameGenerationAlgorithm vectors_algo(kWidth, kHeight, 5000);
+    events_algo.process_events(events.cbegin(), events.cend());
+    vectors_algo.process_events(vectors.cbegin(), vectors.cend());
+
+    cv::Mat expected, frame;
+    for (timestamp ts = 10000; ts <= vectors.back().t; ts += 10000) {
+        events_algo.generate(ts, expected);
+        vectors_algo.generate(ts, frame);
+        assert_same_frames(expected, frame);
+    }
+}
+
+TEST(EventCDVectorAlgorithms_GTest, deprecated_field_names_alias_the_new_ones) {
+    EventCDVector vector(64, 12, true, 0x5, 1234);
+
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+    EXPECT_TRUE(vector.polarity);
+    EXPECT_EQ(1234, vector.event_timestamp);
+    vector.polarity        = false;
+    vector.event_timestamp = 5678;
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+    EXPECT_EQ(EventCDVector(64, 12, false, 0x5, 5678), vector);
+    EXPECT_FALSE(vector.p);
+    EXPECT_EQ(5678, vector.t);
+}
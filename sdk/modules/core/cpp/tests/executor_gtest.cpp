@@ -0,0 +1,145 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/core/utils/executor.h"
+
+using namespace Metavision;
+
+TEST(Executor_GTest, runs_all_posted_tasks_before_destruction) {
+    // GIVEN an executor
+    std::atomic<int> count{0};
+    {
+        Executor executor(4);
+        ASSERT_EQ(4u, executor.get_num_workers());
+
+        // WHEN we post many tasks, some of them posting other tasks
+        for (int i = 0; i < 1000; ++i) {
+            executor.post([&]() {
+                ++count;
+                executor.post([&]() { ++count; });
+            });
+        }
+    }
+
+    // THEN all the tasks are run before the executor is destroyed
+    ASSERT_EQ(2000, count);
+}
+
+TEST(Executor_GTest, runs_tasks_on_several_workers) {
+    // GIVEN an executor with several workers
+    Executor executor(4);
+
+    // WHEN we post tasks that block until they all run concurrently
+    std::atomic<int> running{0};
+    std::mutex mutex;
+    std::set<std::thread::id> thread_ids;
+    for (int i = 0; i < 4; ++i) {
+        executor.post([&]() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                thread_ids.insert(std::this_thread::get_id());
+            }
+            ++running;
+            while (running < 4) {
+                std::this_thread::yield();
+            }
+        });
+    }
+    while (running < 4) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // THEN each task ran on a different worker
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(4u, thread_ids.size());
+}
+
+TEST(Executor_GTest, strand_runs_tasks_in_order_one_at_a_time) {
+    // GIVEN a strand on an executor with several workers
+    Executor executor(4);
+    Executor::Strand strand(executor);
+
+    // WHEN we post many tasks, checking that no other task of the strand runs concurrently
+    std::vector<int> order;
+    std::atomic<bool> running{false};
+    std::atomic<bool> overlap{false};
+    for (int i = 0; i < 1000; ++i) {
+        strand.post([&, i]() {
+            if (running.exchange(true)) {
+                overlap = true;
+            }
+            EXPECT_TRUE(strand.running_in_this_thread());
+            order.push_back(i);
+            running = false;
+        });
+    }
+    strand.wait();
+
+    // THEN the tasks ran one at a time, in the order they were posted
+    ASSERT_FALSE(overlap);
+    ASSERT_FALSE(strand.running_in_this_thread());
+    ASSERT_EQ(1000u, order.size());
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(i, order[i]);
+    }
+}
+
+TEST(Executor_GTest, strand_clear_drops_pending_tasks) {
+    // GIVEN a strand whose first task blocks
+    Executor executor(2);
+    Executor::Strand strand(executor);
+    std::atomic<bool> started{false}, release{false};
+    std::atomic<int> count{0};
+    strand.post([&]() {
+        started = true;
+        while (!release) {
+            std::this_thread::yield();
+        }
+    });
+    for (int i = 0; i < 10; ++i) {
+        strand.post([&]() { ++count; });
+    }
+
+    // WHEN we clear the strand while the first task is running
+    while (!started) {
+        std::this_thread::yield();
+    }
+    strand.clear();
+    release = true;
+    strand.wait();
+
+    // THEN the pending tasks are not run
+    ASSERT_EQ(0, count);
+
+    // AND the strand can still be used
+    strand.post([&]() { ++count; });
+    strand.wait();
+    ASSERT_EQ(1, count);
+}
+
+TEST(Executor_GTest, default_executor_num_workers_can_not_be_changed_once_created) {
+    // GIVEN the default executor
+    Executor &executor = Executor::get_default();
+
+    // WHEN we try to change its number of workers
+    // THEN it fails
+    ASSERT_FALSE(Executor::set_default_num_workers(3));
+    ASSERT_EQ(&executor, &Executor::get_default());
+    ASSERT_LE(1u, executor.get_num_workers());
+}
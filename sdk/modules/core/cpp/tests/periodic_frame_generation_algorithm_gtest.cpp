@@ -701,6 +701,61 @@ TEST(PeriodicFrameGenerationAlgorithm_GTest, skip_frames_to) {
                            generated_frames.back().frame_.begin<cv::Vec3b>()));
 }
 
+TEST(PeriodicFrameGenerationAlgorithm_GTest, incremental_rendering_of_distant_tiles) {
+    const int sensor_width               = 100;
+    const int sensor_height              = 80;
+    const timestamp period_us            = 10000;
+    const double fps                     = 1.e6 / period_us;
+    const timestamp accumulation_time_us = 10000;
+    const bool colored                   = true;
+    PeriodicFrameGenerationAlgorithm frame_generation(sensor_width, sensor_height);
+    frame_generation.set_accumulation_time_us(accumulation_time_us);
+    frame_generation.set_colors(bg_color, on_color, off_color, colored);
+    frame_generation.set_fps(fps);
+
+    // GIVEN events in distant tiles of the sensor, appearing and expiring in consecutive frames
+    std::vector<EventCD> events{{EventCD{3, 3, 0, 1000}, EventCD{90, 70, 1, 5000}, EventCD{50, 40, 1, 15000},
+                                 EventCD{90, 70, 0, 35000}}};
+
+    // WHEN we process the events, modifying the output frame in the callback
+    std::vector<FrameData> generated_frames;
+    frame_generation.set_output_callback([&](timestamp ts, cv::Mat &frame) {
+        generated_frames.push_back({ts, frame.clone()});
+        frame.setTo(cv::Scalar(1, 2, 3));
+    });
+    frame_generation.process_events(events.cbegin(), events.cend());
+    frame_generation.force_generate();
+
+    // THEN each frame only holds the events of its accumulation window, regardless of the tiles rendered for the
+    // previous frames and of the modifications done in the callback
+    std::vector<cv::Mat> expected_frames(4);
+    for (auto &expected_frame : expected_frames) {
+        expected_frame = cv::Mat(sensor_height, sensor_width, CV_8UC3, bg_color);
+    }
+    expected_frames[0].at<cv::Vec3b>(3, 3)   = off_color;
+    expected_frames[0].at<cv::Vec3b>(70, 90) = on_color;
+    expected_frames[1].at<cv::Vec3b>(40, 50) = on_color;
+    expected_frames[3].at<cv::Vec3b>(70, 90) = off_color;
+
+    ASSERT_EQ(expected_frames.size(), generated_frames.size());
+    for (size_t i = 0; i < expected_frames.size(); ++i) {
+        ASSERT_EQ(i < 3 ? timestamp((i + 1) * period_us) : events.back().t, generated_frames[i].ts_us_);
+        ASSERT_EQ(expected_frames[i].size(), generated_frames[i].frame_.size());
+        ASSERT_TRUE(std::equal(expected_frames[i].begin<cv::Vec3b>(), expected_frames[i].end<cv::Vec3b>(),
+                               generated_frames[i].frame_.begin<cv::Vec3b>()));
+    }
+
+    // WHEN we change the colors and generate a new frame
+    frame_generation.set_colors(bg_color, off_color, on_color, colored);
+    frame_generation.force_generate();
+
+    // THEN the whole frame is rendered with the new colors
+    expected_frames[3].at<cv::Vec3b>(70, 90) = on_color;
+    ASSERT_EQ(size_t(5), generated_frames.size());
+    ASSERT_TRUE(std::equal(expected_frames[3].begin<cv::Vec3b>(), expected_frames[3].end<cv::Vec3b>(),
+                           generated_frames.back().frame_.begin<cv::Vec3b>()));
+}
+
 TEST(PeriodicFrameGenerationAlgorithm_GTest, test_doc_example_output) {
     // Initializes a frame generation algorithm that generates frames of size 5x1 every 5000 microseconds of events.
     // Each frame accumulating the last 10 milliseconds.
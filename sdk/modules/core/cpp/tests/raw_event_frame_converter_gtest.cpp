@@ -0,0 +1,128 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <cstdint>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/core/utils/raw_event_frame_converter.h"
+
+using namespace Metavision;
+
+namespace {
+// Expected value of a converted histogram, computed independently of the converter
+std::vector<int> expected_histo(const RawEventFrameHisto &h, HistogramFormat format) {
+    const auto &cfg         = h.get_config();
+    const unsigned neg_bits = cfg.channel_bit_size[HistogramChannel::NEGATIVE];
+    const unsigned pos_bits = cfg.channel_bit_size[HistogramChannel::POSITIVE];
+    const unsigned n        = cfg.width * cfg.height;
+    std::vector<int> output(2 * n);
+    for (unsigned i = 0; i < n; ++i) {
+        int neg, pos;
+        if (cfg.packed) {
+            neg = h.get_data()[i] & ((1 << neg_bits) - 1);
+            pos = (h.get_data()[i] >> neg_bits) & ((1 << pos_bits) - 1);
+        } else {
+            neg = h.get_data()[2 * i] & ((1 << neg_bits) - 1);
+            pos = h.get_data()[2 * i + 1] & ((1 << pos_bits) - 1);
+        }
+        if (format == HistogramFormat::HWC) {
+            output[2 * i]     = neg;
+            output[2 * i + 1] = pos;
+        } else {
+            output[i]     = neg;
+            output[n + i] = pos;
+        }
+    }
+    return output;
+}
+} // namespace
+
+TEST(RawEventFrameConverter_GTest, convert_histo_all_layouts_and_bit_sizes) {
+    const unsigned width = 37, height = 5;
+    for (bool packed : {true, false}) {
+        for (unsigned neg_bits = 1; neg_bits < 8; ++neg_bits) {
+            for (unsigned pos_bits = 1; neg_bits + pos_bits <= 8; ++pos_bits) {
+                // GIVEN a histogram filled with values overflowing the channel bit sizes
+                RawEventFrameHisto h(height, width, neg_bits, pos_bits, packed);
+                for (std::size_t i = 0; i < h.get_data().size(); ++i) {
+                    h.get_data()[i] = static_cast<std::uint8_t>(i * 37 + 11);
+                }
+
+                for (auto format : {HistogramFormat::HWC, HistogramFormat::CHW}) {
+                    RawEventFrameConverter converter(height, width, 2, format);
+                    const auto expected = expected_histo(h, format);
+
+                    // WHEN converting it into a new frame or into caller-owned buffers
+                    auto frame = converter.convert<float>(h);
+                    std::vector<std::uint8_t> output_u8(3, 42);
+                    converter.convert(h, output_u8);
+                    std::vector<int> output_int(converter.get_histo_size(), -1);
+                    converter.convert(h, output_int.data());
+
+                    // THEN all the outputs match the expected unpacked histogram
+                    ASSERT_EQ(expected.size(), frame->get_size());
+                    ASSERT_EQ(expected.size(), output_u8.size());
+                    for (std::size_t i = 0; i < expected.size(); ++i) {
+                        ASSERT_EQ(expected[i], frame->get_data()[i]);
+                        ASSERT_EQ(expected[i], output_u8[i]);
+                        ASSERT_EQ(expected[i], output_int[i]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(RawEventFrameConverter_GTest, convert_histo_pixel_accessor) {
+    // GIVEN a 3x2 packed histogram with distinct values per channel
+    RawEventFrameHisto h(2, 3, 4, 4, true);
+    for (unsigned i = 0; i < 6; ++i) {
+        h.get_data()[i] = static_cast<std::uint8_t>(((i + 1) << 4) | i);
+    }
+
+    for (auto format : {HistogramFormat::HWC, HistogramFormat::CHW}) {
+        // WHEN we convert it
+        RawEventFrameConverter converter(2, 3, 2, format);
+        auto frame = converter.convert<std::uint8_t>(h);
+
+        // THEN each pixel holds the expected channels
+        for (int y = 0; y < 2; ++y) {
+            for (int x = 0; x < 3; ++x) {
+                EXPECT_EQ(x + 3 * y, (*frame)(x, y, HistogramChannel::NEGATIVE));
+                EXPECT_EQ(x + 3 * y + 1, (*frame)(x, y, HistogramChannel::POSITIVE));
+            }
+        }
+    }
+}
+
+TEST(RawEventFrameConverter_GTest, convert_diff) {
+    // GIVEN a diff frame with negative and positive values
+    const unsigned width = 19, height = 3;
+    RawEventFrameDiff d(height, width, 8);
+    for (std::size_t i = 0; i < d.get_data().size(); ++i) {
+        d.get_data()[i] = static_cast<std::int8_t>(static_cast<int>(i) - 20);
+    }
+    RawEventFrameConverter converter(height, width, 1);
+
+    // WHEN we convert it into a new frame and into a caller-owned buffer
+    auto frame = converter.convert<float>(d);
+    std::vector<std::int16_t> output;
+    converter.convert(d, output);
+
+    // THEN the values are preserved, including their sign
+    ASSERT_EQ(width * height, frame->get_size());
+    ASSERT_EQ(width * height, output.size());
+    for (std::size_t i = 0; i < output.size(); ++i) {
+        EXPECT_EQ(static_cast<int>(i) - 20, frame->get_data()[i]);
+        EXPECT_EQ(static_cast<int>(i) - 20, output[i]);
+    }
+}
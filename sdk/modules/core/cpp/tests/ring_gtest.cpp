@@ -18,15 +18,12 @@
 #include <vector>
 #include <atomic>
 #include <iostream>
+#include <string>
 
 #include "metavision/sdk/core/utils/detail/ring.h"
+#include "metavision/sdk/core/utils/detail/arena_ring.h"
 #include "metavision/sdk/base/utils/timestamp.h"
 
-template<typename EVENT>
-using RingTest = Metavision::detail::Ring<EVENT>;
-
-class Ring_GTest : public ::testing::Test {};
-
 namespace {
 struct Event_Gtest {
     long t;
@@ -36,17 +33,26 @@ typedef std::vector<Event_Gtest> type_buffer;
 
 } // namespace
 
-TEST_F(Ring_GTest, test_ctr_empty) {
-    RingTest<Event_Gtest> r;
+template<typename RingType>
+class Ring_GTest : public ::testing::Test {};
+
+// All the scenarios are run on both ring implementations, which must behave the same
+typedef ::testing::Types<Metavision::detail::Ring<Event_Gtest>, Metavision::detail::ArenaRing<Event_Gtest>>
+    TestingTypes;
+
+TYPED_TEST_CASE(Ring_GTest, TestingTypes);
+
+TYPED_TEST(Ring_GTest, test_ctr_empty) {
+    TypeParam r;
     EXPECT_FALSE(r.data_available());
     EXPECT_EQ(size_t(0), r.size());
     EXPECT_EQ(Metavision::timestamp(-1), r.get_first_time());
     EXPECT_EQ(Metavision::timestamp(-1), r.get_last_time());
 }
 
-TEST_F(Ring_GTest, test_add1_one_elem) {
-    RingTest<Event_Gtest> r;
-    RingTest<Event_Gtest>::type_eventsadd vevents;
+TYPED_TEST(Ring_GTest, test_add1_one_elem) {
+    TypeParam r;
+    typename TypeParam::type_eventsadd vevents;
     vevents.push_back(Event_Gtest{1});
     r.add(vevents);
     EXPECT_TRUE(r.data_available());
@@ -55,9 +61,9 @@ TEST_F(Ring_GTest, test_add1_one_elem) {
     EXPECT_EQ(Metavision::timestamp(1), r.get_last_time());
 }
 
-TEST_F(Ring_GTest, test_add1_not_empty) {
-    RingTest<Event_Gtest> r;
-    RingTest<Event_Gtest>::type_eventsadd vevents;
+TYPED_TEST(Ring_GTest, test_add1_not_empty) {
+    TypeParam r;
+    typename TypeParam::type_eventsadd vevents;
     vevents.push_back(Event_Gtest{1});
     vevents.push_back(Event_Gtest{10});
     vevents.push_back(Event_Gtest{20});
@@ -68,8 +74,8 @@ TEST_F(Ring_GTest, test_add1_not_empty) {
     EXPECT_EQ(Metavision::timestamp(1), r.get_first_time());
     EXPECT_EQ(Metavision::timestamp(100), r.get_last_time());
 }
-TEST_F(Ring_GTest, test_get_data_nodata_available) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_get_data_nodata_available) {
+    TypeParam r;
     type_buffer buf;
     auto inserter = std::back_inserter(buf);
     r.fill_buffer_to(inserter, 10);
@@ -78,10 +84,10 @@ TEST_F(Ring_GTest, test_get_data_nodata_available) {
     EXPECT_EQ(Metavision::timestamp(-1), r.get_first_time());
     EXPECT_EQ(Metavision::timestamp(-1), r.get_last_time());
 }
-TEST_F(Ring_GTest, test_get_all_data) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_get_all_data) {
+    TypeParam r;
     type_buffer buf;
-    RingTest<Event_Gtest>::type_eventsadd vevents;
+    typename TypeParam::type_eventsadd vevents;
     vevents.push_back(Event_Gtest{1});
     vevents.push_back(Event_Gtest{10});
     vevents.push_back(Event_Gtest{20});
@@ -96,10 +102,10 @@ TEST_F(Ring_GTest, test_get_all_data) {
     EXPECT_FALSE(r.data_available());
     EXPECT_EQ(size_t(0), r.size());
 }
-TEST_F(Ring_GTest, test_get_all_data_but1) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_get_all_data_but1) {
+    TypeParam r;
     type_buffer buf;
-    RingTest<Event_Gtest>::type_eventsadd vevents;
+    typename TypeParam::type_eventsadd vevents;
     vevents.push_back(Event_Gtest{1});
     vevents.push_back(Event_Gtest{10});
     vevents.push_back(Event_Gtest{20});
@@ -114,10 +120,10 @@ TEST_F(Ring_GTest, test_get_all_data_but1) {
     EXPECT_TRUE(r.data_available());
     EXPECT_EQ(size_t(1), r.size());
 }
-TEST_F(Ring_GTest, test_get_all_data_eq) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_get_all_data_eq) {
+    TypeParam r;
     type_buffer buf;
-    RingTest<Event_Gtest>::type_eventsadd vevents;
+    typename TypeParam::type_eventsadd vevents;
     vevents.push_back(Event_Gtest{1});
     vevents.push_back(Event_Gtest{10});
     vevents.push_back(Event_Gtest{20});
@@ -132,10 +138,10 @@ TEST_F(Ring_GTest, test_get_all_data_eq) {
     EXPECT_TRUE(r.data_available());
     EXPECT_EQ(size_t(1), r.size());
 }
-TEST_F(Ring_GTest, test_get_partial_data) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_get_partial_data) {
+    TypeParam r;
     type_buffer buf;
-    RingTest<Event_Gtest>::type_eventsadd vevents;
+    typename TypeParam::type_eventsadd vevents;
     vevents.push_back(Event_Gtest{1});
     vevents.push_back(Event_Gtest{10});
     vevents.push_back(Event_Gtest{20});
@@ -150,10 +156,10 @@ TEST_F(Ring_GTest, test_get_partial_data) {
     EXPECT_TRUE(r.data_available());
     EXPECT_EQ(size_t(1), r.size());
 }
-TEST_F(Ring_GTest, test_get_partial_data_eq) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_get_partial_data_eq) {
+    TypeParam r;
     type_buffer buf;
-    RingTest<Event_Gtest>::type_eventsadd vevents;
+    typename TypeParam::type_eventsadd vevents;
     vevents.push_back(Event_Gtest{1});
     vevents.push_back(Event_Gtest{10});
     vevents.push_back(Event_Gtest{20});
@@ -169,10 +175,10 @@ TEST_F(Ring_GTest, test_get_partial_data_eq) {
     EXPECT_EQ(size_t(2), r.size());
 }
 
-TEST_F(Ring_GTest, test_2buf_get_partial_data) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_2buf_get_partial_data) {
+    TypeParam r;
     type_buffer buf;
-    RingTest<Event_Gtest>::type_eventsadd vevents;
+    typename TypeParam::type_eventsadd vevents;
     vevents.push_back(Event_Gtest{1});
     vevents.push_back(Event_Gtest{10});
     vevents.push_back(Event_Gtest{20});
@@ -194,10 +200,10 @@ TEST_F(Ring_GTest, test_2buf_get_partial_data) {
     EXPECT_EQ(size_t(1), r.size());
 }
 
-TEST_F(Ring_GTest, test_get_sparse_data_not_after_TS) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_get_sparse_data_not_after_TS) {
+    TypeParam r;
     type_buffer buf;
-    RingTest<Event_Gtest>::type_eventsadd vevents;
+    typename TypeParam::type_eventsadd vevents;
     vevents.push_back(Event_Gtest{99});
     r.add(vevents);
     EXPECT_EQ(Metavision::timestamp(99), r.get_first_time());
@@ -214,8 +220,8 @@ TEST_F(Ring_GTest, test_get_sparse_data_not_after_TS) {
     EXPECT_EQ(static_cast<size_t>(1), buf.size());
 }
 
-TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_nodata_available) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_fill_buffer_to_drop_max_events_nodata_available) {
+    TypeParam r;
     type_buffer buf;
     auto inserter = std::back_inserter(buf);
     r.fill_buffer_to_drop_max_events(inserter, 10, 1);
@@ -225,10 +231,10 @@ TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_nodata_available) {
     EXPECT_EQ(Metavision::timestamp(-1), r.get_last_time());
 }
 
-TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_gt_ts_max5) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_fill_buffer_to_drop_max_events_gt_ts_max5) {
+    TypeParam r;
     type_buffer buf;
-    RingTest<Event_Gtest>::type_eventsadd vevents;
+    typename TypeParam::type_eventsadd vevents;
     vevents.push_back(Event_Gtest{1});
     vevents.push_back(Event_Gtest{10});
     vevents.push_back(Event_Gtest{20});
@@ -244,10 +250,10 @@ TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_gt_ts_max5) {
     EXPECT_EQ(size_t(0), r.size());
 }
 
-TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_gt_ts_max2) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_fill_buffer_to_drop_max_events_gt_ts_max2) {
+    TypeParam r;
     type_buffer buf;
-    RingTest<Event_Gtest>::type_eventsadd vevents;
+    typename TypeParam::type_eventsadd vevents;
     vevents.push_back(Event_Gtest{1});
     vevents.push_back(Event_Gtest{10});
     vevents.push_back(Event_Gtest{20});
@@ -263,10 +269,10 @@ TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_gt_ts_max2) {
     EXPECT_EQ(size_t(0), r.size());
 }
 
-TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_lt_ts_max5) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_fill_buffer_to_drop_max_events_lt_ts_max5) {
+    TypeParam r;
     type_buffer buf;
-    RingTest<Event_Gtest>::type_eventsadd vevents;
+    typename TypeParam::type_eventsadd vevents;
     vevents.push_back(Event_Gtest{1});
     vevents.push_back(Event_Gtest{10});
     vevents.push_back(Event_Gtest{20});
@@ -282,10 +288,10 @@ TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_lt_ts_max5) {
     EXPECT_EQ(size_t(1), r.size());
 }
 
-TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_lt_ts_max2) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_fill_buffer_to_drop_max_events_lt_ts_max2) {
+    TypeParam r;
     type_buffer buf;
-    RingTest<Event_Gtest>::type_eventsadd vevents;
+    typename TypeParam::type_eventsadd vevents;
     vevents.push_back(Event_Gtest{1});
     vevents.push_back(Event_Gtest{10});
     vevents.push_back(Event_Gtest{20});
@@ -301,10 +307,10 @@ TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_lt_ts_max2) {
     EXPECT_EQ(size_t(1), r.size());
 }
 
-TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_eq_ts_max5) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_fill_buffer_to_drop_max_events_eq_ts_max5) {
+    TypeParam r;
     type_buffer buf;
-    RingTest<Event_Gtest>::type_eventsadd vevents;
+    typename TypeParam::type_eventsadd vevents;
     vevents.push_back(Event_Gtest{1});
     vevents.push_back(Event_Gtest{10});
     vevents.push_back(Event_Gtest{20});
@@ -320,10 +326,10 @@ TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_eq_ts_max5) {
     EXPECT_EQ(size_t(1), r.size());
 }
 
-TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_eq_ts_max2) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_fill_buffer_to_drop_max_events_eq_ts_max2) {
+    TypeParam r;
     type_buffer buf;
-    RingTest<Event_Gtest>::type_eventsadd vevents;
+    typename TypeParam::type_eventsadd vevents;
     vevents.push_back(Event_Gtest{1});
     vevents.push_back(Event_Gtest{10});
     vevents.push_back(Event_Gtest{20});
@@ -339,8 +345,8 @@ TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_eq_ts_max2) {
     EXPECT_EQ(size_t(1), r.size());
 }
 
-TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_max100) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_max100) {
+    TypeParam r;
     type_buffer buf;
 
     for (int i = 0; i < 100; ++i) {
@@ -364,8 +370,8 @@ TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_max100) {
     EXPECT_EQ(Metavision::timestamp(99), r.get_last_time());
 }
 
-TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_max10) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_max10) {
+    TypeParam r;
     type_buffer buf;
 
     for (int i = 0; i < 100; ++i) {
@@ -390,8 +396,8 @@ TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_max10) {
 }
 
 // similar test to large_ring_max but we take some events of the last vector
-TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_ts99_max99) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_ts99_max99) {
+    TypeParam r;
     type_buffer buf;
 
     for (int i = 0; i < 100; ++i) {
@@ -416,8 +422,8 @@ TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_ts99_max99) {
 }
 
 // similar test to large_ring_max but we take some events of the last vector
-TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_ts99_max98) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_ts99_max98) {
+    TypeParam r;
     type_buffer buf;
 
     for (int i = 0; i < 100; ++i) {
@@ -442,8 +448,8 @@ TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_ts99_max98) {
 }
 
 // similar test to large_ring_max but we take some events of the last vector
-TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_ts98_max99) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_ts98_max99) {
+    TypeParam r;
     type_buffer buf;
 
     for (int i = 0; i < 100; ++i) {
@@ -467,8 +473,8 @@ TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_ts98_max99) {
     EXPECT_EQ(Metavision::timestamp(99), r.get_last_time());
 }
 
-TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_no_zero_idx) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_no_zero_idx) {
+    TypeParam r;
     type_buffer buf;
 
     for (int i = 0; i < 100; ++i) {
@@ -495,8 +501,8 @@ TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_no_zero_idx) {
     EXPECT_EQ(Metavision::timestamp(-1), r.get_last_time());
 }
 
-TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_no_zero_idx_max_10) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_no_zero_idx_max_10) {
+    TypeParam r;
     type_buffer buf;
 
     for (int i = 0; i < 100; ++i) {
@@ -523,8 +529,8 @@ TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_no_zero_idx_ma
     EXPECT_EQ(Metavision::timestamp(-1), r.get_last_time());
 }
 
-TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_no_zero_idx_max_10_not_all) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_no_zero_idx_max_10_not_all) {
+    TypeParam r;
     type_buffer buf;
 
     for (int i = 0; i < 100; ++i) {
@@ -551,8 +557,8 @@ TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_large_ring_no_zero_idx_ma
     EXPECT_EQ(Metavision::timestamp(99), r.get_last_time());
 }
 
-TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_single_buffer) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_fill_buffer_to_drop_max_events_single_buffer) {
+    TypeParam r;
     type_buffer buf;
 
     for (int i = 0; i < 100; ++i) {
@@ -574,8 +580,8 @@ TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_single_buffer) {
     EXPECT_EQ(Metavision::timestamp(-1), r.get_last_time());
 }
 
-TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_single_buffer_no_zero_idx) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_fill_buffer_to_drop_max_events_single_buffer_no_zero_idx) {
+    TypeParam r;
     type_buffer buf;
 
     for (int i = 0; i < 100; ++i) {
@@ -598,8 +604,8 @@ TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_single_buffer_no_zero_idx
     EXPECT_EQ(Metavision::timestamp(-1), r.get_last_time());
 }
 
-TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_single_buffer_no_zero_idx_max_10) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_fill_buffer_to_drop_max_events_single_buffer_no_zero_idx_max_10) {
+    TypeParam r;
     type_buffer buf;
 
     for (int i = 0; i < 100; ++i) {
@@ -622,8 +628,8 @@ TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_single_buffer_no_zero_idx
     EXPECT_EQ(Metavision::timestamp(-1), r.get_last_time());
 }
 
-TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_single_buffer_no_zero_idx_max_10_not_all) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_fill_buffer_to_drop_max_events_single_buffer_no_zero_idx_max_10_not_all) {
+    TypeParam r;
     type_buffer buf;
 
     for (int i = 0; i < 100; ++i) {
@@ -646,8 +652,8 @@ TEST_F(Ring_GTest, test_fill_buffer_to_drop_max_events_single_buffer_no_zero_idx
     EXPECT_EQ(Metavision::timestamp(99), r.get_last_time());
 }
 
-TEST_F(Ring_GTest, test_drop_max_events_large_ring) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_drop_max_events_large_ring) {
+    TypeParam r;
     type_buffer buf;
 
     for (int i = 0; i < 100; ++i) {
@@ -671,8 +677,8 @@ TEST_F(Ring_GTest, test_drop_max_events_large_ring) {
     EXPECT_EQ(Metavision::timestamp(-1), r.get_last_time());
 }
 
-TEST_F(Ring_GTest, test_drop_max_events_large_ring_no_zero_idx) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_drop_max_events_large_ring_no_zero_idx) {
+    TypeParam r;
     type_buffer buf;
 
     for (int i = 0; i < 100; ++i) {
@@ -700,8 +706,8 @@ TEST_F(Ring_GTest, test_drop_max_events_large_ring_no_zero_idx) {
     EXPECT_EQ(Metavision::timestamp(-1), r.get_last_time());
 }
 
-TEST_F(Ring_GTest, test_drop_max_events_single_buffer) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_drop_max_events_single_buffer) {
+    TypeParam r;
     type_buffer buf;
 
     for (int i = 0; i < 100; ++i) {
@@ -723,8 +729,8 @@ TEST_F(Ring_GTest, test_drop_max_events_single_buffer) {
     EXPECT_EQ(Metavision::timestamp(-1), r.get_last_time());
 }
 
-TEST_F(Ring_GTest, test_drop_max_events_single_buffer_no_zero_idx) {
-    RingTest<Event_Gtest> r;
+TYPED_TEST(Ring_GTest, test_drop_max_events_single_buffer_no_zero_idx) {
+    TypeParam r;
     type_buffer buf;
 
     for (int i = 0; i < 100; ++i) {
@@ -751,6 +757,7 @@ TEST_F(Ring_GTest, test_drop_max_events_single_buffer_no_zero_idx) {
 }
 
 namespace {
+template<typename RingType>
 class TestThread {
 public:
     TestThread(long stepproduce, long stepconsume) : stepproduce_(stepproduce), stepconsume_(stepconsume) {
@@ -770,7 +777,7 @@ public:
     }
     void produce_only_one() {
         //                std::cerr << "produce\n";
-        RingTest<Event_Gtest>::type_eventsadd vevents;
+        typename RingType::type_eventsadd vevents;
         for (int i = 0; i < stepproduce_; ++i) {
             ++lastproduce_;
             vevents.push_back(Event_Gtest{lastproduce_});
@@ -818,7 +825,7 @@ public:
 private:
     std::atomic<bool> run_produce_;
     std::atomic<bool> run_consume_;
-    RingTest<Event_Gtest> r_;
+    RingType r_;
     long stepproduce_ = 1;
     long stepconsume_ = 1;
 
@@ -830,16 +837,16 @@ private:
 };
 } // namespace
 
-TEST_F(Ring_GTest, test_thread_notrhead) {
-    TestThread threadtest(3, 1);
+TYPED_TEST(Ring_GTest, test_thread_notrhead) {
+    TestThread<TypeParam> threadtest(3, 1);
     threadtest.produce_only_one();
     threadtest.consume_only_one();
     threadtest.consume_only_one();
     EXPECT_EQ(static_cast<long>(3), threadtest.get_next_to_consume());
 }
 
-TEST_F(Ring_GTest, test_thread) {
-    TestThread threadtest(1, 3);
+TYPED_TEST(Ring_GTest, test_thread) {
+    TestThread<TypeParam> threadtest(1, 3);
     std::thread thread_produce([&] { threadtest.produce(); });
     std::thread thread_consume([&] { threadtest.consume(); });
 
@@ -852,3 +859,163 @@ TEST_F(Ring_GTest, test_thread) {
     std::cout << "prod " << threadtest.get_produced() << " cons " << threadtest.get_next_to_consume() << std::endl;
     threadtest.stat_ring();
 }
+
+namespace {
+// Runs the scenarios of the tests above on a larger scale, to compare the ring implementations
+template<typename RingType>
+double benchmark_ring(RingType &r, int num_buffers, int events_per_buffer, bool with_drop) {
+    type_buffer buf(events_per_buffer), res;
+    long t        = 0;
+    auto inserter = std::back_inserter(res);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_buffers; ++i) {
+        for (auto &ev : buf) {
+            ev.t = t++;
+        }
+        r.add(buf.cbegin(), buf.cend());
+        if (i % 4 == 3) {
+            // consumes a few buffers at once, in the middle of the last one as in the partial data scenarios
+            res.clear();
+            if (with_drop) {
+                r.fill_buffer_to_drop_max_events(inserter, t - events_per_buffer / 2, events_per_buffer);
+            } else {
+                r.fill_buffer_to(inserter, t - events_per_buffer / 2);
+            }
+        }
+    }
+    res.clear();
+    r.fill_buffer_remaining(inserter);
+    const auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / (double(num_buffers) * events_per_buffer);
+}
+} // namespace
+
+// Disabled as it only measures the cost per event of the ring, run it with --gtest_also_run_disabled_tests. The timings
+// are recorded as properties of the test, in the XML or JSON report.
+TYPED_TEST(Ring_GTest, DISABLED_benchmark_produce_consume) {
+    for (int events_per_buffer : {16, 1024, 16384}) {
+        const int num_buffers = (1 << 22) / events_per_buffer;
+        for (bool with_drop : {false, true}) {
+            TypeParam r(256, false);
+            const double ns_per_event = benchmark_ring(r, num_buffers, events_per_buffer, with_drop);
+            ::testing::Test::RecordProperty("ns_per_event_" + std::to_string(events_per_buffer) + "_ev_per_buffer" +
+                                                (with_drop ? "_drop_max_events" : ""),
+                                            std::to_string(ns_per_event));
+            EXPECT_FALSE(r.data_available());
+        }
+    }
+}
+
+TEST(ArenaRing_GTest, test_wrapped_spans) {
+    Metavision::detail::ArenaRing<Event_Gtest> r(8, false);
+    type_buffer buf;
+    for (int i = 0; i < 6; ++i) {
+        buf.push_back(Event_Gtest{i});
+    }
+    r.add(buf);
+    auto inserter = std::back_inserter(buf);
+    buf.clear();
+    r.fill_buffer_to(inserter, 4);
+    EXPECT_EQ(size_t(4), buf.size());
+
+    // the next events wrap around the end of the arena, which does not grow
+    buf.clear();
+    for (int i = 6; i < 12; ++i) {
+        buf.push_back(Event_Gtest{i});
+    }
+    r.add(buf);
+    EXPECT_EQ(size_t(8), r.capacity());
+    EXPECT_EQ(size_t(8), r.size());
+
+    std::vector<size_t> span_sizes;
+    long expected_t = 4;
+    r.for_each_span([&](const Event_Gtest *begin, const Event_Gtest *end) {
+        span_sizes.push_back(end - begin);
+        for (auto it = begin; it != end; ++it) {
+            EXPECT_EQ(expected_t++, it->t);
+        }
+    });
+    EXPECT_EQ((std::vector<size_t>{4, 4}), span_sizes);
+
+    // searches on both sides of the wrap
+    buf.clear();
+    r.fill_buffer_to(inserter, 7);
+    ASSERT_EQ(size_t(3), buf.size());
+    EXPECT_EQ(6, buf.back().t);
+    buf.clear();
+    r.fill_buffer_to_drop_max_events(inserter, 11, 2);
+    ASSERT_EQ(size_t(2), buf.size());
+    EXPECT_EQ(9, buf.front().t);
+    EXPECT_EQ(10, buf.back().t);
+    EXPECT_EQ(Metavision::timestamp(11), r.get_first_time());
+}
+
+TEST(ArenaRing_GTest, test_grow_keeps_order) {
+    Metavision::detail::ArenaRing<Event_Gtest> r(4, false);
+    type_buffer buf;
+    auto inserter = std::back_inserter(buf);
+    long t        = 0;
+    for (int i = 0; i < 3; ++i) {
+        buf.push_back(Event_Gtest{t++});
+    }
+    r.add(buf);
+    buf.clear();
+    r.fill_buffer_to(inserter, 2);
+    buf.clear();
+
+    // the stored events wrap when the arena grows
+    for (int i = 0; i < 10; ++i) {
+        buf.push_back(Event_Gtest{t++});
+    }
+    r.add(buf);
+    EXPECT_EQ(size_t(16), r.capacity());
+    EXPECT_EQ(size_t(11), r.size());
+
+    buf.clear();
+    r.fill_buffer_remaining(inserter);
+    ASSERT_EQ(size_t(11), buf.size());
+    for (size_t i = 0; i < buf.size(); ++i) {
+        EXPECT_EQ(long(i + 2), buf[i].t);
+    }
+}
+
+TEST(ArenaRing_GTest, test_max_size_drops_oldest) {
+    Metavision::detail::ArenaRing<Event_Gtest> r(4, false);
+    r.set_max_events_stored(8);
+    type_buffer buf;
+    for (int i = 0; i < 6; ++i) {
+        buf.push_back(Event_Gtest{i});
+    }
+    r.add(buf);
+    r.add(buf.cbegin(), buf.cend());
+    EXPECT_EQ(size_t(8), r.size());
+    EXPECT_EQ(Metavision::timestamp(4), r.get_first_time());
+
+    buf.clear();
+    for (int i = 10; i < 20; ++i) {
+        buf.push_back(Event_Gtest{i});
+    }
+    r.add(buf);
+    EXPECT_EQ(size_t(8), r.size());
+    EXPECT_EQ(size_t(8), r.capacity());
+    EXPECT_EQ(Metavision::timestamp(12), r.get_first_time());
+    EXPECT_EQ(Metavision::timestamp(19), r.get_last_time());
+}
+
+TEST(ArenaRing_GTest, test_auto_shrink) {
+    Metavision::detail::ArenaRing<Event_Gtest> r(4, true);
+    type_buffer buf;
+    for (int i = 0; i < 64; ++i) {
+        buf.push_back(Event_Gtest{i});
+    }
+    r.add(buf);
+    EXPECT_EQ(size_t(64), r.capacity());
+    r.drop();
+
+    buf.resize(2);
+    r.add(buf);
+    EXPECT_EQ(size_t(4), r.capacity());
+    EXPECT_EQ(size_t(2), r.size());
+}
@@ -11,6 +11,8 @@
 
 #include <vector>
 #include <atomic>
+#include <chrono>
+#include <thread>
 #include <fstream>
 #include <gtest/gtest.h>
 
@@ -390,3 +392,36 @@ TEST_F(ThreadedProcess_GTest, calling_stop_without_abort_wait_end_of_repeating_t
     // THEN The request to not abort repeating task using stop waits the end of the repeating process.
     ASSERT_EQ(3, task_processed_count);
 }
+
+TEST_F(ThreadedProcess_GTest, add_task_and_wait_returns_once_the_task_is_done) {
+    // GIVEN a started threaded process, running on an executor with a single worker
+    Metavision::Executor executor(1);
+    Metavision::ThreadedProcess threaded_process(executor);
+    ASSERT_TRUE(threaded_process.start());
+
+    // WHEN a task is added and waited for, from the calling thread and from a task of the process
+    int task_processed_count = 0;
+    ASSERT_TRUE(threaded_process.add_task_and_wait([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ++task_processed_count;
+    }));
+    ASSERT_EQ(1, task_processed_count);
+    ASSERT_TRUE(threaded_process.add_task_and_wait(
+        [&]() { ASSERT_TRUE(threaded_process.add_task_and_wait([&]() { ++task_processed_count; })); }));
+
+    // THEN the tasks are done when the calls return, without waiting for the only worker running the waiting task
+    ASSERT_EQ(2, task_processed_count);
+}
+
+TEST_F(ThreadedProcess_GTest, add_task_and_wait_does_not_run_the_task_if_process_not_active) {
+    // GIVEN a stopped threaded process
+    int task_processed_count = 0;
+    Metavision::ThreadedProcess threaded_process;
+    threaded_process.start();
+    threaded_process.stop();
+
+    // WHEN a task is added and waited for
+    // THEN the call returns without running it
+    ASSERT_FALSE(threaded_process.add_task_and_wait([&]() { ++task_processed_count; }));
+    ASSERT_EQ(0, task_processed_count);
+}
@@ -44,6 +44,7 @@
 #include "metavision/sdk/stream/erc_counter.h"
 
 // Metavision SDK Stream External Trigger handler class
+#include "metavision/sdk/stream/cd_vector.h"
 #include "metavision/sdk/stream/ext_trigger.h"
 
 // Metavision SDK Stream FrameDiff handler class
@@ -63,6 +64,8 @@
 
 // Metavision device generation
 #include "metavision/sdk/stream/camera_generation.h"
+#include "metavision/sdk/stream/camera_latency_statistics.h"
+#include "metavision/sdk/stream/camera_overload_policy.h"
 
 // Metavision SDK Stream camera exceptions
 #include "metavision/sdk/stream/camera_exception.h"
@@ -246,6 +249,17 @@ public:
     /// @return @ref Camera instance initialized from the input file
     static Camera from_file(const std::filesystem::path &file_path, const FileConfigHints &hints = FileConfigHints());
 
+    /// @brief Initializes a camera instance from a URI
+    ///
+    /// URIs of the form "file://<path>" open a file, as with @ref from_file. Any other URI, for instance
+    /// "tcp://<host>:<port>" for a RAW stream sent over the network or "shm:<name>" for a RAW stream published in shared
+    /// memory, is used as the serial of the camera to open, as with @ref from_serial.
+    /// @throw CameraException in case of initialization failure.
+    /// @param uri URI of the source to open
+    /// @param config Configuration used to open the camera, unused for files
+    /// @return @ref Camera instance initialized from the source
+    static Camera from_uri(const std::string &uri, const DeviceConfig &config = DeviceConfig());
+
     /// @brief Returns facility
     template<typename FacilityType>
     FacilityType &get_facility() {
@@ -276,6 +290,10 @@ public:
     /// @throw CameraException if the camera has not been initialized.
     CD &cd();
 
+    /// @brief Gets class to handle vectorized CD events
+    /// @throw CameraException if the camera has not been initialized or if its CD events are not decoded as vectors.
+    CDVector &cd_vector();
+
     /// @brief Gets class to handle External Triggers events
     /// @throw CameraException if the camera has not been initialized.
     ExtTrigger &ext_trigger();
@@ -420,6 +438,45 @@ public:
     /// @warning If no event decoding callback has been set, this functions returns -1
     timestamp get_last_timestamp() const;
 
+    /// @brief Enables or disables the collection of latency statistics
+    ///
+    /// When enabled, each buffer received from a live camera is stamped on arrival, and the time spent waiting to be
+    /// decoded, decoding and calling the callbacks is recorded, along with the lag of the decoded events with respect
+    /// to the wall-clock. Statistics are disabled by default, and are not collected for files.
+    /// @param enable true to enable the collection of latency statistics, false to disable it
+    void enable_latency_statistics(bool enable);
+
+    /// @brief Checks if the collection of latency statistics is enabled
+    /// @return true if latency statistics are collected, false otherwise
+    bool is_latency_statistics_enabled() const;
+
+    /// @brief Gets a snapshot of the latency statistics collected so far
+    /// @return @ref CameraLatencyStatistics of the buffers processed since the statistics were last reset
+    CameraLatencyStatistics get_latency_statistics() const;
+
+    /// @brief Removes all the samples from the latency statistics
+    void reset_latency_statistics();
+
+    /// @brief Sets the policy applied when the buffers are received faster than they are processed
+    ///
+    /// By default, the buffers received from a live camera are queued without limit until they are processed. With an
+    /// overload policy, data is shed once the queue reaches a given depth, either by dropping whole buffers, or by
+    /// keeping only a subsampled grid of pixels or a region of interest. The policy is not applied to files.
+    /// @param policy Overload policy to apply
+    /// @throw CameraException if the policy is not valid
+    void set_overload_policy(const CameraOverloadPolicy &policy);
+
+    /// @brief Gets the policy applied when the buffers are received faster than they are processed
+    /// @return The current @ref CameraOverloadPolicy
+    CameraOverloadPolicy get_overload_policy() const;
+
+    /// @brief Gets a snapshot of the statistics of the data shed according to the overload policy
+    /// @return @ref CameraOverloadStatistics of the data shed since the statistics were last reset
+    CameraOverloadStatistics get_overload_statistics() const;
+
+    /// @brief Resets the statistics of the data shed according to the overload policy
+    void reset_overload_statistics();
+
     /// @brief Saves the camera settings to a given file
     /// @param path The path of the file to save the camera settings to
     /// @return true on success
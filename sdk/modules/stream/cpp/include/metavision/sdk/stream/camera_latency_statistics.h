@@ -0,0 +1,106 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_STREAM_CAMERA_LATENCY_STATISTICS_H
+#define METAVISION_SDK_STREAM_CAMERA_LATENCY_STATISTICS_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Metavision {
+
+/// @brief Histogram of durations with logarithmic (power of two) buckets
+///
+/// Bucket 0 counts null durations, bucket i > 0 counts durations in [2^(i-1), 2^i) nanoseconds. Adding a sample is
+/// constant time and does not allocate, so that it can be done for every buffer processed by a camera.
+class LatencyHistogram {
+public:
+    /// @brief Number of buckets of the histogram
+    static constexpr std::size_t NumBuckets = 64;
+
+    /// @brief Adds a sample to the histogram
+    /// @param duration Duration to add, negative durations are counted as null durations
+    void add(std::chrono::nanoseconds duration);
+
+    /// @brief Removes all the samples from the histogram
+    void reset();
+
+    /// @brief Gets the number of samples added to the histogram
+    /// @return Number of samples
+    std::uint64_t count() const;
+
+    /// @brief Gets the smallest sample added to the histogram
+    /// @return Smallest sample, or 0 if the histogram is empty
+    std::chrono::nanoseconds min() const;
+
+    /// @brief Gets the largest sample added to the histogram
+    /// @return Largest sample, or 0 if the histogram is empty
+    std::chrono::nanoseconds max() const;
+
+    /// @brief Gets the mean of the samples added to the histogram
+    /// @return Mean of the samples, or 0 if the histogram is empty
+    std::chrono::nanoseconds mean() const;
+
+    /// @brief Gets an upper bound of the given percentile of the samples
+    ///
+    /// The returned value is the upper bound of the bucket containing the percentile, clamped to the largest sample.
+    /// It is thus at most twice as large as the exact percentile.
+    /// @param p Percentile to compute, in [0, 100]
+    /// @return Upper bound of the percentile, or 0 if the histogram is empty
+    std::chrono::nanoseconds percentile(double p) const;
+
+    /// @brief Gets the number of samples in each bucket
+    /// @return Counts of the buckets
+    const std::array<std::uint64_t, NumBuckets> &buckets() const;
+
+    /// @brief Gets the exclusive upper bound of the durations counted in a bucket
+    /// @param bucket Index of the bucket
+    /// @return Upper bound of the bucket
+    static std::chrono::nanoseconds bucket_upper_bound(std::size_t bucket);
+
+private:
+    std::array<std::uint64_t, NumBuckets> buckets_{};
+    std::uint64_t count_{0};
+    std::int64_t sum_ns_{0};
+    std::int64_t min_ns_{0};
+    std::int64_t max_ns_{0};
+};
+
+/// @brief Per-stage latency statistics of the buffers processed by a @ref Camera
+///
+/// Each histogram holds one sample per processed buffer.
+struct CameraLatencyStatistics {
+    /// @brief Time between the reception of a buffer from the data transfer and the start of its decoding, i.e. the
+    /// time spent waiting in the events stream queue
+    LatencyHistogram arrival_to_decode;
+
+    /// @brief Time spent decoding a buffer, excluding the time spent in the events callbacks
+    LatencyHistogram decode;
+
+    /// @brief Time spent in the user callbacks (events, frames and RAW data callbacks) for a buffer
+    LatencyHistogram callbacks;
+
+    /// @brief Lag between the wall-clock and the timestamp of the last event of a buffer, once it is decoded
+    ///
+    /// Sensor and host clocks do not share an origin, so the lag is measured relative to the smallest lag observed
+    /// since the camera was started. It thus shows how much later than usual the events are delivered, rather than an
+    /// absolute latency.
+    LatencyHistogram event_lag;
+
+    /// @brief Removes all the samples from the histograms
+    void reset();
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_STREAM_CAMERA_LATENCY_STATISTICS_H
@@ -0,0 +1,98 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_STREAM_CAMERA_OVERLOAD_POLICY_H
+#define METAVISION_SDK_STREAM_CAMERA_OVERLOAD_POLICY_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Metavision {
+
+/// @brief Policy applied by a live @ref Camera when the buffers are received faster than they are processed
+///
+/// The buffers received from the camera wait in a queue until they are decoded. When the queue reaches
+/// @ref max_queued_buffers_, the camera is considered overloaded, and some data is shed until the queue is empty again,
+/// according to the @ref mode_ of the policy.
+struct CameraOverloadPolicy {
+    /// @brief Way of shedding data when the camera is overloaded
+    enum class Mode {
+        /// The queue is unbounded, no data is shed
+        None,
+        /// The oldest buffers of the queue are dropped, so that it never holds more than @ref max_queued_buffers_
+        DropBuffers,
+        /// Only the CD events of one pixel out of @ref subsampling_factor_ in each direction are kept
+        Subsample,
+        /// Only the CD events inside the region of interest are kept
+        RoiOnly
+    };
+
+    /// Way of shedding data when the camera is overloaded
+    Mode mode_ = Mode::None;
+
+    /// Number of queued buffers above which the camera is overloaded
+    ///
+    /// When subsampling or keeping only a region of interest does not reduce the load enough, the oldest buffers are
+    /// dropped as a last resort once the queue holds 4 times this number of buffers.
+    std::size_t max_queued_buffers_ = 64;
+
+    /// Subsampling factor in each direction, used by the @ref Mode::Subsample mode
+    std::uint16_t subsampling_factor_ = 2;
+
+    /// Region of interest, used by the @ref Mode::RoiOnly mode
+    std::uint16_t roi_x_      = 0;
+    std::uint16_t roi_y_      = 0;
+    std::uint16_t roi_width_  = 0;
+    std::uint16_t roi_height_ = 0;
+
+    /// @brief Checks if the events of a pixel are kept while data is shed
+    /// @param x Column of the pixel
+    /// @param y Row of the pixel
+    /// @return true if the events of the pixel are kept, false if they are dropped
+    bool keeps(std::uint16_t x, std::uint16_t y) const {
+        switch (mode_) {
+        case Mode::Subsample:
+            return x % subsampling_factor_ == 0 && y % subsampling_factor_ == 0;
+        case Mode::RoiOnly:
+            return x >= roi_x_ && x - roi_x_ < roi_width_ && y >= roi_y_ && y - roi_y_ < roi_height_;
+        default:
+            return true;
+        }
+    }
+};
+
+/// @brief Statistics of the data shed by a @ref Camera according to its @ref CameraOverloadPolicy
+struct CameraOverloadStatistics {
+    /// @brief Number of buffers dropped from the queue
+    std::uint64_t dropped_buffers{0};
+
+    /// @brief Number of bytes of the dropped buffers
+    std::uint64_t dropped_bytes{0};
+
+    /// @brief Number of dropped events
+    ///
+    /// This is the number of CD events removed by subsampling or by keeping only the region of interest, plus the
+    /// number of RAW events in the dropped buffers, which is an estimate of the number of events they held.
+    std::uint64_t dropped_events{0};
+
+    /// @brief Number of events dropped per second, over the last second of processing
+    double dropped_events_rate{0};
+
+    /// @brief True while the camera is overloaded and sheds data
+    bool shedding{false};
+
+    /// @brief Resets the counters and the rate of dropped data
+    void reset();
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_STREAM_CAMERA_OVERLOAD_POLICY_H
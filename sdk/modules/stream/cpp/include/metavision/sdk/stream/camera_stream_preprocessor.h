@@ -0,0 +1,96 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+
+#ifndef METAVISION_SDK_STREAM_CAMERA_STREAM_PREPROCESSOR_H
+#define METAVISION_SDK_STREAM_CAMERA_STREAM_PREPROCESSOR_H
+
+#include <cstddef>
+#include <memory>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/core/preprocessors/event_preprocessor.h"
+#include "metavision/sdk/core/preprocessors/tensor.h"
+#include "metavision/sdk/stream/camera.h"
+#include "metavision/sdk/stream/camera_stream_slicer.h"
+
+namespace Metavision {
+
+/// @brief Structure representing a tensor computed from a slice of events
+struct TensorSlice {
+    timestamp start_ts;   ///< Timestamp of the beginning of the slice (i.e. end of the previous slice)
+    timestamp t;          ///< Timestamp of the end of the slice
+    std::size_t n_events; ///< Number of CD events in the slice
+    Tensor tensor;        ///< Tensor computed from the CD events of the slice
+};
+
+/// @brief Class that slices the stream of a camera and computes a tensor from each slice in the background
+///
+/// A thread reads the slices produced by a @ref CameraStreamSlicer, and the tensors are computed in parallel by the
+/// workers of the default @ref Executor, using an @ref EventPreprocessor. The tensors are then retrieved in the order
+/// of the slices with @ref next.
+///
+/// At most @p max_queue_size slices are being processed or waiting to be retrieved at any time. This bounds the memory
+/// usage, while letting the pipeline prefetch the next tensors when the caller is busy with the previous ones (e.g.
+/// when training a neural network).
+class CameraStreamPreprocessor {
+public:
+    using SliceCondition = CameraStreamSlicer::SliceCondition;
+
+    /// @brief Constructor, starts the camera and the computation of the first tensors
+    /// @param camera Camera instance to slice, the ownership of the camera is transferred to the pipeline
+    /// @param preprocessor Preprocessor computing the tensors, it is shared by the workers and must thus not be
+    /// modified while the pipeline is running
+    /// @param slice_condition Slicing parameters
+    /// @param max_queue_size Maximum number of slices being processed or waiting to be retrieved
+    CameraStreamPreprocessor(Camera &&camera, std::shared_ptr<const EventPreprocessor<const EventCD *>> preprocessor,
+                             const SliceCondition &slice_condition, std::size_t max_queue_size = 8);
+
+    /// @brief Constructor, starts the camera and the computation of the first tensors
+    /// @param camera Camera instance to slice, the ownership of the camera is transferred to the pipeline
+    /// @param preprocessor Preprocessor computing the tensors, it is shared by the workers and must thus not be
+    /// modified while the pipeline is running
+    /// @param slice_condition Slicing parameters
+    /// @param max_queue_size Maximum number of slices being processed or waiting to be retrieved
+    CameraStreamPreprocessor(Camera &&camera, std::shared_ptr<const EventPreprocessor<EventCD *>> preprocessor,
+                             const SliceCondition &slice_condition, std::size_t max_queue_size = 8);
+
+    CameraStreamPreprocessor(const CameraStreamPreprocessor &)            = delete;
+    CameraStreamPreprocessor &operator=(const CameraStreamPreprocessor &) = delete;
+
+    /// @brief Destructor
+    ///
+    /// Stops the pipeline and waits for the completion of the slices being processed.
+    ~CameraStreamPreprocessor();
+
+    /// @brief Retrieves the next tensor, waiting for it to be computed if needed
+    /// @param slice Slice in which the next tensor is moved
+    /// @return true if a tensor was retrieved, false if the end of the stream was reached
+    /// @throw The exceptions raised while reading the camera stream or computing the tensor
+    bool next(TensorSlice &slice);
+
+    /// @brief Gets the shape of the computed tensors
+    /// @return Shape of the tensors
+    const TensorShape &get_output_shape() const;
+
+    /// @brief Gets the type of the data of the computed tensors
+    /// @return Type of the tensors
+    BaseType get_output_type() const;
+
+private:
+    struct Private;
+    std::unique_ptr<Private> pimpl_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_STREAM_CAMERA_STREAM_PREPROCESSOR_H
@@ -81,6 +81,10 @@ public:
     /// @brief Returns an iterator to the end of the stream
     SliceIterator end();
 
+    /// @brief Stops the slicing, the iteration ends once the slices already in the queue are retrieved
+    /// @note This method can be called from another thread, to unblock the one waiting for the next slice
+    void stop();
+
     /// @brief Returns the underlying camera instance
     [[nodiscard]] const Camera &camera() const;
 
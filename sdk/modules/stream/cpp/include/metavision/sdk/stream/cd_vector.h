@@ -0,0 +1,69 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_STREAM_CD_VECTOR_H
+#define METAVISION_SDK_STREAM_CD_VECTOR_H
+
+#include <memory>
+#include <functional>
+
+// Metavision SDK Base CD vector event
+#include "metavision/sdk/base/events/event_cd_vector.h"
+
+// Definition of CallbackId
+#include "metavision/sdk/base/utils/callback_id.h"
+
+namespace Metavision {
+
+/// @brief Type alias for a callback on a buffer of @ref EventCDVector
+using EventsCDVectorCallback = std::function<void(const EventCDVector *begin, const EventCDVector *end)>;
+
+/// @brief Facility class to handle vectorized CD events
+///
+/// This facility is only available when the events of the camera are decoded as vectors of CD events, i.e. for an
+/// EVT2.1 stream when the option evt21_keep_vectors is set in the device configuration, or for an EVT2.1 file when
+/// @ref FileConfigHints::cd_vectors is enabled. In that case, the @ref CD facility is not available: the buffers can be
+/// processed as is by the algorithms accepting @ref EventCDVector, without expanding them.
+class CDVector {
+public:
+    /// @brief Destructor
+    ///
+    /// Deletes a CDVector class instance.
+    virtual ~CDVector();
+
+    /// @brief Subscribes to vectorized CD events
+    ///
+    /// Registers a callback that will be called each time a buffer of vectorized CD events has been decoded.
+    ///
+    /// @param cb Callback to call each time a buffer of vectorized CD events has been decoded
+    /// @sa @ref EventsCDVectorCallback
+    /// @return ID of the added callback
+    CallbackId add_callback(const EventsCDVectorCallback &cb);
+
+    /// @brief Removes a previously registered callback
+    /// @param callback_id Callback ID
+    /// @return true if the callback has been unregistered correctly, false otherwise.
+    /// @sa @ref add_callback
+    bool remove_callback(CallbackId callback_id);
+
+    /// @brief For internal use
+    class Private;
+    /// @brief For internal use
+    Private &get_pimpl();
+
+private:
+    CDVector(Private *);
+    std::unique_ptr<Private> pimpl_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_STREAM_CD_VECTOR_H
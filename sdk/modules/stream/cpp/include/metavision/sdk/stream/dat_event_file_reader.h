@@ -20,9 +20,17 @@ namespace Metavision {
 
 class Device;
 
+/// @brief Reader of DAT files
+///
+/// The files are memory mapped and their fixed size records are decoded by time slices into pooled buffers. Seeking
+/// is done by a binary search over the records, so that no index is needed.
 class DATEventFileReader : public EventFileReader {
 public:
-    DATEventFileReader(const std::filesystem::path &path);
+    /// @brief Constructor
+    /// @param path Path of the DAT file, or common prefix of the _cd.dat, _td.dat and _trigger.dat files to read
+    /// @param decode_ahead If true, the next time slice is decoded by a worker of the default @ref Executor while the
+    /// current one is processed
+    DATEventFileReader(const std::filesystem::path &path, bool decode_ahead = false);
     ~DATEventFileReader();
 
     bool seekable() const override;
@@ -17,6 +17,7 @@
 #include <memory>
 #include <unordered_map>
 #include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_cd_vector.h"
 #include "metavision/sdk/base/events/event_erc_counter.h"
 #include "metavision/sdk/base/events/event_ext_trigger.h"
 #include "metavision/sdk/base/events/event_monitoring.h"
@@ -62,6 +63,10 @@ public:
     /// @return Id of the added callback, see @ref remove_callback
     size_t add_read_callback(const EventsBufferReadCallback<EventCD> &cb);
 
+    /// @brief Adds a "reading callback" called when a buffer of vectorized CD events has been read
+    /// @overload
+    size_t add_read_callback(const EventsBufferReadCallback<EventCDVector> &cb);
+
     /// @brief Adds a "reading callback" called when a buffer of events has been read
     /// @overload
     size_t add_read_callback(const EventsBufferReadCallback<EventExtTrigger> &cb);
@@ -144,6 +149,7 @@ public:
 
 protected:
     void notify_events_buffer(const EventCD *, const EventCD *);
+    void notify_events_buffer(const EventCDVector *, const EventCDVector *);
     void notify_events_buffer(const EventExtTrigger *, const EventExtTrigger *);
     void notify_events_buffer(const EventERCCounter *, const EventERCCounter *);
     void notify_events_buffer(const EventMonitoring *, const EventMonitoring *);
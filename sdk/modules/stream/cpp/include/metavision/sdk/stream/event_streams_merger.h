@@ -0,0 +1,149 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_STREAM_EVENT_STREAMS_MERGER_H
+#define METAVISION_SDK_STREAM_EVENT_STREAMS_MERGER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+class EventFileWriter;
+
+/// @brief Class merging several streams of events into a single chronologically ordered one, for instance to write the
+/// CD and trigger events of one or several cameras in a single file
+///
+/// Each stream is fed by a single thread, with chronologically ordered buffers of events, through its own lock-free
+/// queue, so that the threads feeding different streams never wait for each other. A background thread merges the
+/// queued events of all the streams (k-way merge) and calls the merge callbacks with the merged events, in order.
+///
+/// The events of a stream can only be merged once it is known that no older event will be added to the other
+/// streams: each stream has a watermark, the timestamp before which no more event will be added to it. It is raised
+/// to the timestamp of the last added event, and can be raised explicitly with @ref set_watermark, for instance so
+/// that a stream with few events (such as external triggers) does not hold back the others. The events older than the
+/// smallest watermark of the streams are merged. Events with the same timestamp are merged in the order of the ids of
+/// their streams.
+///
+/// If a merge callback throws, the merging stops and the exception is rethrown by @ref flush and @ref close.
+class EventStreamsMerger {
+public:
+    /// @brief Identifier of a stream, given in the order the streams are added, starting from 0
+    using StreamId = std::size_t;
+
+    /// @brief Alias for a callback receiving merged CD events, all from the same stream
+    using EventsCDCallback = std::function<void(StreamId stream_id, const EventCD *begin, const EventCD *end)>;
+
+    /// @brief Alias for a callback receiving merged external trigger events, all from the same stream
+    using EventsExtTriggerCallback =
+        std::function<void(StreamId stream_id, const EventExtTrigger *begin, const EventExtTrigger *end)>;
+
+    /// @brief Constructor
+    /// @param cd_callback Callback called from the merging thread with the merged CD events
+    /// @param ext_trigger_callback Callback called from the merging thread with the merged external trigger events
+    /// @param max_latency Maximum delay, in event time, between the most advanced stream and the merged events.
+    /// By default there is no limit, and the merging waits for the watermarks of all the streams. Otherwise, the
+    /// streams whose watermark is older than the one of the most advanced stream minus @p max_latency are assumed to
+    /// have no event before this time: the events added later to those streams with a timestamp older than the
+    /// merged events are dropped (see @ref get_num_dropped_events).
+    /// @param queue_capacity Number of buffers of events that can be queued in each stream, adding events to a stream
+    /// whose queue is full blocks until the merging thread consumes a buffer
+    EventStreamsMerger(const EventsCDCallback &cd_callback, const EventsExtTriggerCallback &ext_trigger_callback,
+                       timestamp max_latency = std::numeric_limits<timestamp>::max(),
+                       std::size_t queue_capacity = 64);
+
+    /// @brief Constructor merging the streams into a file writer
+    ///
+    /// The merged events of all the CD streams, and of all the external trigger streams, are added to @p writer.
+    /// @param writer Writer to add the merged events to, it must outlive the merger
+    /// @param max_latency Maximum delay, in event time, between the most advanced stream and the merged events
+    /// @param queue_capacity Number of buffers of events that can be queued in each stream
+    EventStreamsMerger(EventFileWriter &writer, timestamp max_latency = std::numeric_limits<timestamp>::max(),
+                       std::size_t queue_capacity = 64);
+
+    /// @brief Destructor
+    ///
+    /// Closes the merger, see @ref close
+    ~EventStreamsMerger();
+
+    EventStreamsMerger(const EventStreamsMerger &)            = delete;
+    EventStreamsMerger &operator=(const EventStreamsMerger &) = delete;
+
+    /// @brief Adds a stream of CD events
+    /// @return The id of the added stream
+    /// @throw std::runtime_error if the merger is already started
+    StreamId add_cd_stream();
+
+    /// @brief Adds a stream of external trigger events
+    /// @return The id of the added stream
+    /// @throw std::runtime_error if the merger is already started
+    StreamId add_ext_trigger_stream();
+
+    /// @brief Gets the number of streams
+    std::size_t get_num_streams() const;
+
+    /// @brief Starts the merging thread, once all the streams have been added
+    void start();
+
+    /// @brief Adds a buffer of CD events to a stream
+    ///
+    /// This function must always be called from the same thread for a given stream.
+    /// @param stream_id Id of the stream, added with @ref add_cd_stream
+    /// @param begin Pointer to the beginning of the buffer
+    /// @param end Pointer to the end of the buffer
+    /// @return false if the merger is not started, the stream is closed or the merging failed, true otherwise
+    /// @throw std::runtime_error if the stream is not a CD stream, or if the events are not chronologically ordered or
+    /// older than the watermark of the stream
+    bool add_events(StreamId stream_id, const EventCD *begin, const EventCD *end);
+
+    /// @brief Adds a buffer of external trigger events to a stream
+    /// @overload
+    bool add_events(StreamId stream_id, const EventExtTrigger *begin, const EventExtTrigger *end);
+
+    /// @brief Raises the watermark of a stream, i.e. notifies that no event older than @p ts will be added to it
+    ///
+    /// This function must be called from the thread adding the events of the stream. Lower watermarks than the
+    /// current one are ignored.
+    /// @param stream_id Id of the stream
+    /// @param ts Timestamp before which no more event will be added to the stream
+    void set_watermark(StreamId stream_id, timestamp ts);
+
+    /// @brief Closes a stream, i.e. notifies that no more event will be added to it
+    /// @param stream_id Id of the stream
+    void close_stream(StreamId stream_id);
+
+    /// @brief Waits for all the events that can be merged to be passed to the merge callbacks
+    /// @throw std::exception Any exception thrown by a merge callback, if the merging failed
+    void flush();
+
+    /// @brief Closes all the streams, waits for all their events to be merged, and stops the merging thread
+    /// @throw std::exception Any exception thrown by a merge callback, if the merging failed
+    void close();
+
+    /// @brief Gets the number of events dropped because they were added after younger events had been merged
+    /// @sa The max_latency parameter of @ref EventStreamsMerger
+    uint64_t get_num_dropped_events() const;
+
+private:
+    class Private;
+    std::unique_ptr<Private> pimpl_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_STREAM_EVENT_STREAMS_MERGER_H
@@ -40,6 +40,14 @@ public:
         return "max_read_per_op";
     }
 
+    static std::string get_cd_vectors_key() {
+        return "cd_vectors";
+    }
+
+    static std::string get_decode_ahead_key() {
+        return "decode_ahead";
+    }
+
     /// @brief Constructor
     ///
     /// By default, if applicable, the file will be read using a maximum memory footprint of 12Mo,
@@ -107,6 +115,40 @@ public:
         return *this;
     }
 
+    /// @brief Gets the vectorized CD events status
+    /// @return true if enabled, false otherwise
+    bool cd_vectors() const {
+        return get<bool>(get_cd_vectors_key(), false);
+    }
+
+    /// @brief Named constructor for the vectorized CD events status
+    ///
+    /// When enabled, the CD events of an EVT2.1 RAW file are decoded as @ref EventCDVector and delivered by the
+    /// @ref CDVector facility of the camera instead of the @ref CD one.
+    /// @param enabled true if the setting should be enabled, false otherwise
+    /// @return FileConfigHints& Reference to the modified config
+    FileConfigHints &cd_vectors(bool enabled) {
+        map[get_cd_vectors_key()] = std::to_string(enabled);
+        return *this;
+    }
+
+    /// @brief Gets the decode ahead status
+    /// @return true if enabled, false otherwise
+    bool decode_ahead() const {
+        return get<bool>(get_decode_ahead_key(), false);
+    }
+
+    /// @brief Named constructor for the decode ahead status
+    ///
+    /// When enabled, the events of a DAT file are decoded on a worker thread one time slice ahead of the one being
+    /// processed.
+    /// @param enabled true if the setting should be enabled, false otherwise
+    /// @return FileConfigHints& Reference to the modified config
+    FileConfigHints &decode_ahead(bool enabled) {
+        map[get_decode_ahead_key()] = std::to_string(enabled);
+        return *this;
+    }
+
     /// @brief Sets a value for a named key in the config dictionary
     /// @param key Key of the config
     /// @param value Value of the config
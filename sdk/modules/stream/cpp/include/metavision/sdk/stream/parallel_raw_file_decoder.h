@@ -0,0 +1,110 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_STREAM_PARALLEL_RAW_FILE_DECODER_H
+#define METAVISION_SDK_STREAM_PARALLEL_RAW_FILE_DECODER_H
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+#include "metavision/sdk/stream/cd.h"
+#include "metavision/sdk/stream/ext_trigger.h"
+
+namespace Metavision {
+
+/// @brief Class decoding a whole RAW file with several threads, by splitting it into time ranges
+///
+/// The file is split into consecutive time ranges of the same duration, which are decoded concurrently by a pool of
+/// workers, each range by a decoder primed from the bookmark of the index preceding it (see @ref RawRangeReader). The
+/// decoded ranges are then either delivered in order to events callbacks, as a @ref Camera would do, or handed as they
+/// are decoded to a callback run by the workers, so that the processing of the ranges is parallelized as well.
+///
+/// The timestamps are in the same time reference as the events of a @ref Camera opened from the file with the default
+/// @ref FileConfigHints (i.e. with time shifting enabled).
+class ParallelRawFileDecoder {
+public:
+    /// @brief Time range of the file, with its decoded events
+    struct Range {
+        /// Position of the range in the file, the first range having index 0
+        std::size_t index = 0;
+
+        /// Timestamp of the beginning of the range
+        timestamp start_ts = 0;
+
+        /// Timestamp of the end of the range (excluded)
+        timestamp end_ts = 0;
+
+        /// CD events of the range
+        std::vector<EventCD> cd_events;
+
+        /// External trigger events of the range
+        std::vector<EventExtTrigger> ext_trigger_events;
+    };
+
+    /// @brief Alias for a callback processing a decoded range
+    using RangeCallback = std::function<void(Range &range)>;
+
+    /// @brief Constructor
+    ///
+    /// Blocks until the index of the file is available.
+    /// @param raw_file_path Path of the RAW file to decode
+    /// @param range_duration_us Duration of the ranges decoded by each worker, in us
+    /// @param num_workers Number of decoding threads, if 0 the number of hardware threads is used (at least 2)
+    /// @throw CameraException if the file can not be opened or indexed, or if the range duration is not positive
+    ParallelRawFileDecoder(const std::filesystem::path &raw_file_path, timestamp range_duration_us = 100000,
+                           std::size_t num_workers = 0);
+
+    /// @brief Destructor
+    ~ParallelRawFileDecoder();
+
+    ParallelRawFileDecoder(const ParallelRawFileDecoder &)            = delete;
+    ParallelRawFileDecoder &operator=(const ParallelRawFileDecoder &) = delete;
+
+    /// @brief Gets the number of decoding threads
+    std::size_t get_num_workers() const;
+
+    /// @brief Gets the number of time ranges the file is split into
+    std::size_t get_num_ranges() const;
+
+    /// @brief Decodes the file and delivers its events in order
+    ///
+    /// The ranges are decoded concurrently, at most 2 ranges per worker ahead of the range being delivered, and their
+    /// events are passed to the callbacks from the calling thread, in the order of the file. The function returns once
+    /// all the events have been delivered.
+    /// @param cd_callback Callback called with the CD events of the file
+    /// @param ext_trigger_callback Optional callback called with the external trigger events of the file
+    /// @throw The exceptions raised by the decoding or by the callbacks
+    void decode(const EventsCDCallback &cd_callback,
+                const EventsExtTriggerCallback &ext_trigger_callback = EventsExtTriggerCallback());
+
+    /// @brief Decodes the file and passes each range to a callback run by the workers
+    ///
+    /// The ranges are processed concurrently, in no particular order: the callback must be thread safe. The range passed
+    /// to the callback is only valid during the call. The function returns once all the ranges have been processed.
+    /// @param range_callback Callback processing a decoded range
+    /// @throw The first exception raised by the decoding or by the callback, in which case the ranges that are not yet
+    /// decoded are skipped
+    void process_ranges(const RangeCallback &range_callback);
+
+private:
+    class Private;
+    std::unique_ptr<Private> pimpl_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_STREAM_PARALLEL_RAW_FILE_DECODER_H
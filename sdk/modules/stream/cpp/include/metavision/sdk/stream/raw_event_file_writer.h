@@ -0,0 +1,101 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_STREAM_RAW_EVENT_FILE_WRITER_H
+#define METAVISION_SDK_STREAM_RAW_EVENT_FILE_WRITER_H
+
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "metavision/hal/utils/raw_file_header.h"
+#include "metavision/sdk/stream/event_file_writer.h"
+
+namespace Metavision {
+
+/// @brief Base class of the EventFileWriter classes writing events to a RAW file
+///
+/// The CD and Trigger events are buffered and merged in chronological order, then written by the @ref Encoder of the
+/// RAW format.
+/// @note This class only supports writing CD and Trigger events
+class RAWEventFileWriter : public EventFileWriter {
+public:
+    /// @brief Encoder of the events in a RAW format
+    class Encoder {
+    public:
+        virtual ~Encoder() = default;
+
+        /// @brief Encodes a CD event and writes it to the output stream
+        virtual void encode_event_cd(std::ofstream &ofs, const EventCD &ev) = 0;
+
+        /// @brief Encodes a trigger event and writes it to the output stream
+        virtual void encode_event_trigger(std::ofstream &ofs, const EventExtTrigger &ev) = 0;
+
+        /// @brief Writes the events held by the encoder, if any
+        virtual void flush(std::ofstream &ofs) {}
+    };
+
+    /// @brief Destructor
+    ~RAWEventFileWriter() override;
+
+protected:
+    /// @brief Constructor
+    /// @param format Name of the RAW format, written in the header of the file
+    /// @param stream_width Width of the stream
+    /// @param stream_height Height of the stream
+    /// @param path Path to the file to write to
+    /// @param enable_trigger_support If true, the writer will merge CD and Trigger event streams before writing them to
+    /// the file, leading to some encoding latency. If false, CD event will be written as soon as they are added to the
+    /// writer, and Trigger events will not be supported.
+    /// @param metadata_map Map of metadata to add in the header of the written file
+    /// @param max_events_add_latency Maximum latency for the addition of events, in camera time, beyond which the
+    /// writer will assume it can safely encode early buffered events
+    /// @param encoder Encoder of the events
+    RAWEventFileWriter(const std::string &format, int stream_width, int stream_height,
+                       const std::filesystem::path &path, bool enable_trigger_support,
+                       const std::unordered_map<std::string, std::string> &metadata_map,
+                       timestamp max_events_add_latency, std::unique_ptr<Encoder> encoder);
+
+private:
+    void open_impl(const std::filesystem::path &path) override;
+    void close_impl() override;
+    bool is_open_impl() const override;
+    void flush_impl() override;
+
+    void add_metadata_impl(const std::string &key, const std::string &value) override;
+    void add_metadata_map_from_camera_impl(const Camera &camera) override;
+    void remove_metadata_impl(const std::string &key) override;
+
+    bool add_events_impl(const EventCD *begin, const EventCD *end) override;
+    bool add_events_impl(const EventExtTrigger *begin, const EventExtTrigger *end) override;
+
+    void encode_buffered_events(bool flush_all_queued_events);
+    void merge_encode_buffered_events(bool flush_all_queued_events);
+
+    const std::string log_prefix_;
+    const bool exttrigger_support_enabled_;
+    const timestamp max_events_add_latency_;
+    RawFileHeader header_;
+    bool header_written_ = false;
+    std::ofstream ofs_;
+    std::deque<EventExtTrigger> events_trigger_;
+    std::deque<EventCD> events_cd_;
+    timestamp ts_last_cd_      = std::numeric_limits<timestamp>::min(),
+              ts_last_trigger_ = std::numeric_limits<timestamp>::min();
+    std::unique_ptr<Encoder> encoder_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_STREAM_RAW_EVENT_FILE_WRITER_H
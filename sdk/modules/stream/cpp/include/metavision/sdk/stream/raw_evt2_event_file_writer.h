@@ -12,22 +12,17 @@
 #ifndef METAVISION_SDK_STREAM_RAW_EVT2_EVENT_FILE_WRITER_H
 #define METAVISION_SDK_STREAM_RAW_EVT2_EVENT_FILE_WRITER_H
 
-#include <deque>
 #include <filesystem>
-#include <fstream>
-#include <memory>
+#include <limits>
 #include <string>
 #include <unordered_map>
-#include "metavision/hal/utils/raw_file_header.h"
-#include "metavision/sdk/stream/event_file_writer.h"
+#include "metavision/sdk/stream/raw_event_file_writer.h"
 
 namespace Metavision {
 
-class Evt2Encoder;
-
 /// @brief EventFileWriter specialized class to write events to a RAW EVT2 file
 /// @note This class only supports writing CD and Trigger events
-class RAWEvt2EventFileWriter : public EventFileWriter {
+class RAWEvt2EventFileWriter : public RAWEventFileWriter {
 public:
     /// @brief Constructor
     /// @param stream_width Width of the stream
@@ -49,36 +44,6 @@ public:
                            const std::unordered_map<std::string, std::string> &metadata_map =
                                std::unordered_map<std::string, std::string>(),
                            timestamp max_events_add_latency = std::numeric_limits<timestamp>::max());
-
-    /// @brief Destructor
-    ~RAWEvt2EventFileWriter() override;
-
-private:
-    void open_impl(const std::filesystem::path &path) override;
-    void close_impl() override;
-    bool is_open_impl() const override;
-    void flush_impl() override;
-
-    void add_metadata_impl(const std::string &key, const std::string &value) override;
-    void add_metadata_map_from_camera_impl(const Camera &camera) override;
-    void remove_metadata_impl(const std::string &key) override;
-
-    bool add_events_impl(const EventCD *begin, const EventCD *end) override;
-    bool add_events_impl(const EventExtTrigger *begin, const EventExtTrigger *end) override;
-
-    void encode_buffered_events(bool flush_all_queued_events);
-    void merge_encode_buffered_events(bool flush_all_queued_events);
-
-    const bool exttrigger_support_enabled_;
-    const timestamp max_events_add_latency_;
-    RawFileHeader header_;
-    bool header_written_ = false;
-    std::ofstream ofs_;
-    std::deque<EventExtTrigger> events_trigger_;
-    std::deque<EventCD> events_cd_;
-    timestamp ts_last_cd_      = std::numeric_limits<timestamp>::min(),
-              ts_last_trigger_ = std::numeric_limits<timestamp>::min();
-    std::unique_ptr<Evt2Encoder> encoder_;
 };
 
 } // namespace Metavision
@@ -0,0 +1,55 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_STREAM_RAW_EVT3_EVENT_FILE_WRITER_H
+#define METAVISION_SDK_STREAM_RAW_EVT3_EVENT_FILE_WRITER_H
+
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include "metavision/sdk/stream/raw_event_file_writer.h"
+
+namespace Metavision {
+
+/// @brief EventFileWriter specialized class to write events to a RAW EVT3 file
+///
+/// Compared to @ref RAWEvt2EventFileWriter, runs of CD events on a row sharing the same timestamp are encoded as
+/// vectors, which makes files of bursty scenes significantly smaller. The CD events of a timestamp are written once
+/// the events of a later timestamp are added, or when the writer is flushed or closed.
+/// @note This class only supports writing CD and Trigger events
+class RAWEvt3EventFileWriter : public RAWEventFileWriter {
+public:
+    /// @brief Constructor
+    /// @param stream_width Width of the stream
+    /// @param stream_height Height of the stream
+    /// @param path Path to the file to write to
+    /// @param enable_trigger_support If true, the writer will merge CD and Trigger event streams before writing them to
+    /// the file, leading to some encoding latency. If false, CD event will be written as soon as they are added to the
+    /// writer, and Trigger events will not be supported.
+    /// @param metadata_map Map of metadata to add in the header of the written file
+    /// @param max_events_add_latency Maximum latency for the addition of events, in camera time, beyond which the
+    /// writer will assume it can safely encode early buffered events. By default, there is no limit, meaning the writer
+    /// will buffer CD events until a least one trigger event is received, which may in certain cases lead to memory
+    /// issues. Alternatively, a finite positive latency value can be specified, the writer will then assume absence of
+    /// triggers if CD events have been buffered for a larger time, hence avoiding memory issues but with the risk of
+    /// EVT3 encoding errors if trigger events are actually received with a higher latency.
+    RAWEvt3EventFileWriter(int stream_width, int stream_height,
+                           const std::filesystem::path &path = std::filesystem::path(),
+                           bool enable_trigger_support       = false,
+                           const std::unordered_map<std::string, std::string> &metadata_map =
+                               std::unordered_map<std::string, std::string>(),
+                           timestamp max_events_add_latency = std::numeric_limits<timestamp>::max());
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_STREAM_RAW_EVT3_EVENT_FILE_WRITER_H
@@ -0,0 +1,79 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#ifndef METAVISION_SDK_STREAM_RAW_RANGE_READER_H
+#define METAVISION_SDK_STREAM_RAW_RANGE_READER_H
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "metavision/sdk/base/events/event_cd.h"
+#include "metavision/sdk/base/events/event_ext_trigger.h"
+#include "metavision/sdk/base/utils/timestamp.h"
+
+namespace Metavision {
+
+/// @brief Class reading the events of a RAW file in arbitrary time ranges, possibly from several threads at once
+///
+/// The index of the file is loaded (or built if needed) once, at construction. Each call to @ref read then decodes the
+/// data following the bookmark preceding the requested range, with positional reads in the file and a decoder taken
+/// from a pool: concurrent calls share neither a file position nor a decoder state, so that many threads (e.g. the
+/// workers of a data loader sampling random windows) can read the same file in parallel.
+///
+/// The timestamps are in the same time reference as the events of a @ref Camera opened from the file with the default
+/// @ref FileConfigHints (i.e. with time shifting enabled).
+class RawRangeReader {
+public:
+    /// @brief Constructor
+    ///
+    /// Blocks until the index of the file is available.
+    /// @param raw_file_path Path of the RAW file to read
+    /// @throw CameraException if the file can not be opened or indexed
+    explicit RawRangeReader(const std::filesystem::path &raw_file_path);
+
+    /// @brief Destructor
+    ~RawRangeReader();
+
+    RawRangeReader(const RawRangeReader &)            = delete;
+    RawRangeReader &operator=(const RawRangeReader &) = delete;
+
+    /// @brief Gets the range of timestamps covered by the index of the file
+    /// @param start_ts Timestamp of the first event of the file
+    /// @param end_ts Timestamp of the last bookmark of the index, the events after it can still be read
+    void get_range(timestamp &start_ts, timestamp &end_ts) const;
+
+    /// @brief Reads the CD events of the file in the range [@p start_ts, @p end_ts)
+    ///
+    /// This function is thread safe.
+    /// @param start_ts Timestamp of the beginning of the range
+    /// @param end_ts Timestamp of the end of the range (excluded)
+    /// @param cd_events Vector filled with the CD events of the range, it is cleared first
+    void read(timestamp start_ts, timestamp end_ts, std::vector<EventCD> &cd_events);
+
+    /// @brief Reads the CD and external trigger events of the file in the range [@p start_ts, @p end_ts)
+    ///
+    /// This function is thread safe.
+    /// @param start_ts Timestamp of the beginning of the range
+    /// @param end_ts Timestamp of the end of the range (excluded)
+    /// @param cd_events Vector filled with the CD events of the range, it is cleared first
+    /// @param ext_trigger_events Vector filled with the external trigger events of the range, it is cleared first
+    void read(timestamp start_ts, timestamp end_ts, std::vector<EventCD> &cd_events,
+              std::vector<EventExtTrigger> &ext_trigger_events);
+
+private:
+    class Private;
+    std::unique_ptr<Private> pimpl_;
+};
+
+} // namespace Metavision
+
+#endif // METAVISION_SDK_STREAM_RAW_RANGE_READER_H
@@ -14,6 +14,7 @@
 #include <thread>
 #include <boost/program_options.hpp>
 #include <metavision/sdk/base/utils/log.h>
+#include <metavision/hal/utils/raw_file_cutter.h>
 #include <metavision/sdk/stream/camera.h>
 #include <metavision/sdk/stream/raw_event_file_logger.h>
 #include <metavision/sdk/stream/hdf5_event_file_writer.h>
@@ -24,6 +25,7 @@ int main(int argc, char *argv[]) {
     std::string in_file_path;
     std::string out_file_path;
     double start, end;
+    bool decode_all = false;
 
     const std::string program_desc("Cuts a file between <start> and <end> seconds where <start> and <end> are "
                                    "offsets from the beginning of the file, expressed as floating point numbers.\n");
@@ -36,6 +38,7 @@ int main(int argc, char *argv[]) {
         ("output-file,o",      po::value<std::string>(&out_file_path)->required(), "Path to output file.")
         ("start,s",   po::value<double>(&start)->required(), "The start of the required sequence in seconds.")
         ("end,e",     po::value<double>(&end)->required(), "The end of the required sequence in seconds.")
+        ("decode-all", po::bool_switch(&decode_all)->default_value(false), "Decode all the events of a RAW file instead of copying the data between the cut points.")
         ;
     // clang-format on
 
@@ -78,6 +81,21 @@ int main(int argc, char *argv[]) {
     if (std::regex_search(in_file_path, ext_match, std::regex("\\.[^.]*$"))) {
         out_file_ext = ext_match.str();
     }
+    if (out_file_ext == ".raw" && !decode_all) {
+        // Copies the data between the cut points found with the index of the file, if its format is supported
+        switch (Metavision::cut_raw_file(camera.get_device(), out_file_path, start_ts, end_ts)) {
+        case Metavision::RawFileCutStatus::Success:
+            MV_LOG_INFO() << "Output saved in file" << out_file_path;
+            return 0;
+        case Metavision::RawFileCutStatus::NothingToCut:
+            MV_LOG_WARNING() << "No file saved because the start time provided is after the end of the input file";
+            return 0;
+        default:
+            break;
+        }
+        MV_LOG_INFO() << "Unable to cut the RAW file from its index, decoding all the events instead";
+    }
+
     if (out_file_ext == ".raw") {
         try {
             camera.raw_data();
@@ -16,7 +16,7 @@ import re
 from metavision_utils import os_tools, pytest_tools
 
 
-def cut_and_check_info(input, start, end, expected_output_info=None):
+def cut_and_check_info(input, start, end, expected_output_info=None, extra_args=""):
     """"Runs metavision_file_cutter on input file and checks the output
 
     Args:
@@ -25,6 +25,7 @@ def cut_and_check_info(input, start, end, expected_output_info=None):
         expected_output_info : expected output on running metavision_file_info on the output file
                                If none is provided, we assume that we have to get the same info as
                                the input file (which is the case when the range covers all the input file)
+        extra_args (str): additional command line arguments
     """
 
     # Before launching the app, check the dataset file exists
@@ -36,8 +37,8 @@ def cut_and_check_info(input, start, end, expected_output_info=None):
     output_file_name = "cut_{}_{}{}".format(start, end, ext)
     output_file_path = os.path.join(tmp_dir.temporary_directory(), output_file_name)
 
-    cmd = "./metavision_file_cutter -i \"{}\" --start {} --end {} -o {}".format(input, start, end,
-                                                                                output_file_path)
+    cmd = "./metavision_file_cutter -i \"{}\" --start {} --end {} -o {} {}".format(input, start, end, output_file_path,
+                                                                                   extra_args)
     output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
 
     # Check app exited without error
@@ -151,6 +152,12 @@ def pytestcase_test_metavision_file_cutter_invalid_range(dataset_dir):
     assert re.search("End time {} is less than or equal to start {}".format(end, start), output)
 
 
+# The RAW files are cut from their index, at the exact cut times: the cuts hold the same events as the cuts of the HDF5
+# conversions of the recordings. The timestamps of the events are shifted by the time base of the first copied event,
+# so they are equal to the ones of the HDF5 cuts modulo 64us in EVT2 and modulo 4096us, plus 4096us, in EVT3 (they are
+# unchanged when the cut starts at 0). In EVT2, the duration includes the time high event preceding the first event
+# after the cut.
+# With --decode-all, the events are decoded and cut at the boundaries of the RAW buffers instead.
 def pytestcase_test_metavision_file_cutter_on_raw_gen31_recording_full_cut(dataset_dir):
     """
     Checks output of metavision_file_cutter application when the range given spans through the whole file
@@ -179,6 +186,39 @@ def pytestcase_test_metavision_file_cutter_on_raw_gen31_recording_from_0s_to_6s(
     expected_output_info = r"""
 ====================================================================================================
 
+Name                {}
+Path                {}
+Duration            6s 0ms 0us
+Integrator          Prophesee
+Plugin name         hal_plugin_gen31_fx3
+Data encoding       EVT2
+Camera generation   3.1
+Camera serial       00001621
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  14067262            16                  5999996             2.3 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info)
+
+
+def pytestcase_test_metavision_file_cutter_on_raw_gen31_recording_from_0s_to_6s_decoding_all_events(dataset_dir):
+    """
+    Checks output of metavision_file_cutter on dataset gen31_timer.raw, cutting from 0s to 6s, decoding
+    all the events
+    """
+
+    filename = "gen31_timer.raw"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 0
+    end = 6
+
+    expected_output_info = r"""
+====================================================================================================
+
 Name                {}
 Path                {}
 Duration            5s 999ms 281us
@@ -194,7 +234,7 @@ Type of event       Number of events    First timestamp     Last timestamp
 ----------------------------------------------------------------------------------------------------
 CD                  14066479            16                  5999281             2.3 Mev/s
 """
-    cut_and_check_info(filename_full, start, end, expected_output_info)
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
 
 
 def pytestcase_test_metavision_file_cutter_on_raw_gen31_recording_from_8s_to_11s(dataset_dir):
@@ -211,6 +251,39 @@ def pytestcase_test_metavision_file_cutter_on_raw_gen31_recording_from_8s_to_11s
     expected_output_info = r"""
 ====================================================================================================
 
+Name                {}
+Path                {}
+Duration            3s 0ms 0us
+Integrator          Prophesee
+Plugin name         hal_plugin_gen31_fx3
+Data encoding       EVT2
+Camera generation   3.1
+Camera serial       00001621
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  5590599             2                   2999999             1.9 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info)
+
+
+def pytestcase_test_metavision_file_cutter_on_raw_gen31_recording_from_8s_to_11s_decoding_all_events(dataset_dir):
+    """
+    Checks output of metavision_file_cutter on dataset gen31_timer.raw, cutting from 8s to 11s, decoding
+    all the events
+    """
+
+    filename = "gen31_timer.raw"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 8
+    end = 11
+
+    expected_output_info = r"""
+====================================================================================================
+
 Name                {}
 Path                {}
 Duration            3s 0ms 200us
@@ -226,7 +299,7 @@ Type of event       Number of events    First timestamp     Last timestamp
 ----------------------------------------------------------------------------------------------------
 CD                  5590889             48                  3000200             1.9 Mev/s
 """
-    cut_and_check_info(filename_full, start, end, expected_output_info)
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
 
 
 def pytestcase_test_metavision_file_cutter_on_raw_gen4_evt2_recording_full_cut(dataset_dir):
@@ -275,6 +348,39 @@ def pytestcase_test_metavision_file_cutter_on_raw_gen4_evt2_recording_from_2s_to
     expected_output_info = r"""
 ====================================================================================================
 
+Name                {}
+Path                {}
+Duration            1s 0ms 0us
+Integrator          Prophesee
+Plugin name         hal_plugin_gen41_evk3
+Data encoding       EVT2
+Camera generation   4.0
+Camera serial       00001495
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  1985546             0                   999999              2.0 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info)
+
+
+def pytestcase_test_metavision_file_cutter_on_raw_gen4_evt2_recording_from_2s_to_3s_decoding_all_events(dataset_dir):
+    """
+    Checks output of metavision_file_cutter on dataset gen4_evt2_hand.raw, cutting from 2s to 3s, decoding
+    all the events
+    """
+
+    filename = "gen4_evt2_hand.raw"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 2
+    end = 3
+
+    expected_output_info = r"""
+====================================================================================================
+
 Name                {}
 Path                {}
 Duration            999ms 995us
@@ -290,7 +396,7 @@ Type of event       Number of events    First timestamp     Last timestamp
 ----------------------------------------------------------------------------------------------------
 CD                  1985443             32                  999995              2.0 Mev/s
 """
-    cut_and_check_info(filename_full, start, end, expected_output_info)
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
 
 
 def pytestcase_test_metavision_file_cutter_on_raw_gen4_evt2_recording_from_4s_to_10s(dataset_dir):
@@ -307,6 +413,39 @@ def pytestcase_test_metavision_file_cutter_on_raw_gen4_evt2_recording_from_4s_to
     expected_output_info = r"""
 ====================================================================================================
 
+Name                {}
+Path                {}
+Duration            6s 0ms 0us
+Integrator          Prophesee
+Plugin name         hal_plugin_gen41_evk3
+Data encoding       EVT2
+Camera generation   4.0
+Camera serial       00001495
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  9468511             0                   5999998             1.6 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info)
+
+
+def pytestcase_test_metavision_file_cutter_on_raw_gen4_evt2_recording_from_4s_to_10s_decoding_all_events(dataset_dir):
+    """
+    Checks output of metavision_file_cutter on dataset gen4_evt2_hand.raw, cutting from 4s to 10s, decoding
+    all the events
+    """
+
+    filename = "gen4_evt2_hand.raw"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 4
+    end = 10
+
+    expected_output_info = r"""
+====================================================================================================
+
 Name                {}
 Path                {}
 Duration            5s 999ms 686us
@@ -322,7 +461,7 @@ Type of event       Number of events    First timestamp     Last timestamp
 ----------------------------------------------------------------------------------------------------
 CD                  9468485             48                  5999686             1.6 Mev/s
 """
-    cut_and_check_info(filename_full, start, end, expected_output_info)
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
 
 
 def pytestcase_test_metavision_file_cutter_on_raw_gen4_evt3_recording_full_cut(dataset_dir):
@@ -371,6 +510,39 @@ def pytestcase_test_metavision_file_cutter_on_raw_gen4_evt3_recording_from_3s_to
     expected_output_info = r"""
 ====================================================================================================
 
+Name                {}
+Path                {}
+Duration            4s 5ms 822us
+Integrator          Prophesee
+Plugin name         hal_plugin_gen41_evk3
+Data encoding       EVT3
+Camera generation   4.0
+Camera serial       00001495
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  4884485             5824                4005822             1.2 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info)
+
+
+def pytestcase_test_metavision_file_cutter_on_raw_gen4_evt3_recording_from_3s_to_7s_decoding_all_events(dataset_dir):
+    """
+    Checks output of metavision_file_cutter on dataset gen4_evt3_hand.raw, cutting from 3s to 7s, decoding
+    all the events
+    """
+
+    filename = "gen4_evt3_hand.raw"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 3
+    end = 7
+
+    expected_output_info = r"""
+====================================================================================================
+
 Name                {}
 Path                {}
 Duration            4s 5ms 779us
@@ -386,7 +558,7 @@ Type of event       Number of events    First timestamp     Last timestamp
 ----------------------------------------------------------------------------------------------------
 CD                  4884780             5424                4005779             1.2 Mev/s
 """
-    cut_and_check_info(filename_full, start, end, expected_output_info)
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
 
 
 def pytestcase_test_metavision_file_cutter_on_raw_gen4_evt3_recording_from_8s_to_9s(dataset_dir):
@@ -403,6 +575,39 @@ def pytestcase_test_metavision_file_cutter_on_raw_gen4_evt3_recording_from_8s_to
     expected_output_info = r"""
 ====================================================================================================
 
+Name                {}
+Path                {}
+Duration            1s 4ms 607us
+Integrator          Prophesee
+Plugin name         hal_plugin_gen41_evk3
+Data encoding       EVT3
+Camera generation   4.0
+Camera serial       00001495
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  1319961             4608                1004607             1.3 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info)
+
+
+def pytestcase_test_metavision_file_cutter_on_raw_gen4_evt3_recording_from_8s_to_9s_decoding_all_events(dataset_dir):
+    """
+    Checks output of metavision_file_cutter on dataset gen4_evt3_hand.raw, cutting from 8s to 9s, decoding
+    all the events
+    """
+
+    filename = "gen4_evt3_hand.raw"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 8
+    end = 9
+
+    expected_output_info = r"""
+====================================================================================================
+
 Name                {}
 Path                {}
 Duration            1s 4ms 384us
@@ -418,7 +623,7 @@ Type of event       Number of events    First timestamp     Last timestamp
 ----------------------------------------------------------------------------------------------------
 CD                  1319849             4432                1004384             1.3 Mev/s
 """
-    cut_and_check_info(filename_full, start, end, expected_output_info)
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
 
 
 def pytestcase_test_metavision_file_cutter_on_raw_gen4_evt3_recording_from_4s_to_15s(dataset_dir):
@@ -437,7 +642,7 @@ def pytestcase_test_metavision_file_cutter_on_raw_gen4_evt3_recording_from_4s_to
 
 Name                {}
 Path                {}
-Duration            11s 6ms 181us
+Duration            11s 6ms 397us
 Integrator          Prophesee
 Plugin name         hal_plugin_gen41_evk3
 Data encoding       EVT3
@@ -448,7 +653,7 @@ Camera serial       00001495
 
 Type of event       Number of events    First timestamp     Last timestamp      Average event rate
 ----------------------------------------------------------------------------------------------------
-CD                  12759075            6064                11006181            1.2 Mev/s
+CD                  12759018            6400                11006397            1.2 Mev/s
 """
     cut_and_check_info(filename_full, start, end, expected_output_info)
 
@@ -754,3 +959,369 @@ Type of event       Number of events    First timestamp     Last timestamp
 CD                  12759018            0                   10999997            1.2 Mev/s
 """
     cut_and_check_info(filename_full, start, end, expected_output_info)
+
+
+def pytestcase_test_metavision_file_cutter_on_raw_gen4_evt3_recording_from_4s_to_15s_decoding_all_events(dataset_dir):
+    """
+    Checks output of metavision_file_cutter on dataset gen4_evt3_hand.raw, cutting from 4s to 15s, decoding
+    all the events
+    """
+
+    filename = "gen4_evt3_hand.raw"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 4
+    end = 15
+
+    expected_output_info = r"""
+====================================================================================================
+
+Name                {}
+Path                {}
+Duration            11s 6ms 181us
+Integrator          Prophesee
+Plugin name         hal_plugin_gen41_evk3
+Data encoding       EVT3
+Camera generation   4.0
+Camera serial       00001495
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  12759075            6064                11006181            1.2 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
+
+
+@pytest.mark.skipif("HAS_HDF5" not in os.environ or os.environ["HAS_HDF5"] != "TRUE", reason="hdf5 not available")
+def pytestcase_test_metavision_file_cutter_on_hdf5_gen31_recording_full_cut(dataset_dir):
+    """
+    Checks output of metavision_file_cutter application when the range given spans through the whole file
+    """
+
+    filename = "gen31_timer.hdf5"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 0
+    end = 15  # This recording is ~13s, so 15 is well after its end
+
+    cut_and_check_info(filename_full, start, end)
+
+
+@pytest.mark.skipif("HAS_HDF5" not in os.environ or os.environ["HAS_HDF5"] != "TRUE", reason="hdf5 not available")
+def pytestcase_test_metavision_file_cutter_on_hdf5_gen31_recording_from_0s_to_6s(dataset_dir):
+    """
+    Checks output of metavision_file_cutter on dataset gen31_timer.hdf5, cutting from 0s to 6s, decoding
+    all the events
+    """
+
+    filename = "gen31_timer.hdf5"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 0
+    end = 6
+
+    expected_output_info = r"""
+====================================================================================================
+
+Name                {}
+Path                {}
+Duration            5s 999ms 996us
+Integrator          Prophesee
+Data encoding       ECF
+Camera generation   3.1
+Camera serial       00001621
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  14067262            16                  5999996             2.3 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
+
+
+@pytest.mark.skipif("HAS_HDF5" not in os.environ or os.environ["HAS_HDF5"] != "TRUE", reason="hdf5 not available")
+def pytestcase_test_metavision_file_cutter_on_hdf5_gen31_recording_from_8s_to_11s(dataset_dir):
+    """
+    Checks output of metavision_file_cutter on dataset gen31_timer.hdf5, cutting from 8s to 11s, decoding
+    all the events
+    """
+
+    filename = "gen31_timer.hdf5"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 8
+    end = 11
+
+    expected_output_info = r"""
+====================================================================================================
+
+Name                {}
+Path                {}
+Duration            2s 999ms 999us
+Integrator          Prophesee
+Data encoding       ECF
+Camera generation   3.1
+Camera serial       00001621
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  5590599             2                   2999999             1.9 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
+
+
+@pytest.mark.skipif("HAS_HDF5" not in os.environ or os.environ["HAS_HDF5"] != "TRUE", reason="hdf5 not available")
+def pytestcase_test_metavision_file_cutter_on_hdf5_gen4_evt2_recording_full_cut(dataset_dir):
+    """
+    Checks output of metavision_file_cutter application when the range given spans throws all the file
+    """
+
+    filename = "gen4_evt2_hand.hdf5"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 0
+    end = 11
+
+    expected_output_info = r"""
+====================================================================================================
+
+Name                {}
+Path                {}
+Duration            10s 442ms 743us
+Integrator          Prophesee
+Data encoding       ECF
+Camera generation   4.0
+Camera serial       00001495
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  17025195            49                  10442743            1.6 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
+
+
+@pytest.mark.skipif("HAS_HDF5" not in os.environ or os.environ["HAS_HDF5"] != "TRUE", reason="hdf5 not available")
+def pytestcase_test_metavision_file_cutter_on_hdf5_gen4_evt2_recording_from_2s_to_3s(dataset_dir):
+    """
+    Checks output of metavision_file_cutter on dataset gen4_evt2_hand.hdf5, cutting from 2s to 3s, decoding
+    all the events
+    """
+
+    filename = "gen4_evt2_hand.hdf5"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 2
+    end = 3
+
+    expected_output_info = r"""
+====================================================================================================
+
+Name                {}
+Path                {}
+Duration            999ms 999us
+Integrator          Prophesee
+Data encoding       ECF
+Camera generation   4.0
+Camera serial       00001495
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  1985546             0                   999999              2.0 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
+
+
+@pytest.mark.skipif("HAS_HDF5" not in os.environ or os.environ["HAS_HDF5"] != "TRUE", reason="hdf5 not available")
+def pytestcase_test_metavision_file_cutter_on_hdf5_gen4_evt2_recording_from_4s_to_10s(dataset_dir):
+    """
+    Checks output of metavision_file_cutter on dataset gen4_evt2_hand.hdf5, cutting from 4s to 10s, decoding
+    all the events
+    """
+
+    filename = "gen4_evt2_hand.hdf5"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 4
+    end = 10
+
+    expected_output_info = r"""
+====================================================================================================
+
+Name                {}
+Path                {}
+Duration            5s 999ms 998us
+Integrator          Prophesee
+Data encoding       ECF
+Camera generation   4.0
+Camera serial       00001495
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  9468511             0                   5999998             1.6 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
+
+
+@pytest.mark.skipif("HAS_HDF5" not in os.environ or os.environ["HAS_HDF5"] != "TRUE", reason="hdf5 not available")
+def pytestcase_test_metavision_file_cutter_on_hdf5_gen4_evt3_recording_full_cut(dataset_dir):
+    """
+    Checks output of metavision_file_cutter application when the range given spans throws all the file
+    """
+
+    filename = "gen4_evt3_hand.hdf5"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 0
+    end = 16
+
+    expected_output_info = r"""
+====================================================================================================
+
+Name                {}
+Path                {}
+Duration            15s 0ms 125us
+Integrator          Prophesee
+Data encoding       ECF
+Camera generation   4.0
+Camera serial       00001495
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  18094969            5714                15000125            1.2 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
+
+
+@pytest.mark.skipif("HAS_HDF5" not in os.environ or os.environ["HAS_HDF5"] != "TRUE", reason="hdf5 not available")
+def pytestcase_test_metavision_file_cutter_on_hdf5_gen4_evt3_recording_from_3s_to_7s(dataset_dir):
+    """
+    Checks output of metavision_file_cutter on dataset gen4_evt3_hand.hdf5, cutting from 3s to 7s, decoding
+    all the events
+    """
+
+    filename = "gen4_evt3_hand.hdf5"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 3
+    end = 7
+
+    expected_output_info = r"""
+====================================================================================================
+
+Name                {}
+Path                {}
+Duration            3s 999ms 998us
+Integrator          Prophesee
+Data encoding       ECF
+Camera generation   4.0
+Camera serial       00001495
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  4884485             0                   3999998             1.2 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
+
+
+@pytest.mark.skipif("HAS_HDF5" not in os.environ or os.environ["HAS_HDF5"] != "TRUE", reason="hdf5 not available")
+def pytestcase_test_metavision_file_cutter_on_hdf5_gen4_evt3_recording_from_8s_to_9s(dataset_dir):
+    """
+    Checks output of metavision_file_cutter on dataset gen4_evt3_hand.hdf5, cutting from 8s to 9s, decoding
+    all the events
+    """
+
+    filename = "gen4_evt3_hand.hdf5"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 8
+    end = 9
+
+    expected_output_info = r"""
+====================================================================================================
+
+Name                {}
+Path                {}
+Duration            999ms 999us
+Integrator          Prophesee
+Data encoding       ECF
+Camera generation   4.0
+Camera serial       00001495
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  1319961             0                   999999              1.3 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
+
+
+@pytest.mark.skipif("HAS_HDF5" not in os.environ or os.environ["HAS_HDF5"] != "TRUE", reason="hdf5 not available")
+def pytestcase_test_metavision_file_cutter_on_hdf5_gen4_evt3_recording_from_4s_to_15s(dataset_dir):
+    """
+    Checks output of metavision_file_cutter on dataset gen4_evt3_hand.hdf5, cutting from 4s to 15s, decoding
+    all the events
+    """
+
+    filename = "gen4_evt3_hand.hdf5"
+    filename_full = os.path.realpath(os.path.join(dataset_dir, "openeb", filename))
+
+    start = 4
+    end = 15
+
+    expected_output_info = r"""
+====================================================================================================
+
+Name                {}
+Path                {}
+Duration            10s 999ms 997us
+Integrator          Prophesee
+Data encoding       ECF
+Camera generation   4.0
+Camera serial       00001495
+
+====================================================================================================
+
+Type of event       Number of events    First timestamp     Last timestamp      Average event rate
+----------------------------------------------------------------------------------------------------
+CD                  12759018            0                   10999997            1.2 Mev/s
+"""
+    cut_and_check_info(filename_full, start, end, expected_output_info, extra_args="--decode-all")
+
+
+def pytestcase_test_metavision_file_cutter_start_after_the_end_of_the_file(dataset_dir):
+    """
+    Checks that metavision_file_cutter does not write any file when the cut starts after the end of the input file
+    """
+
+    input_raw_file = os.path.join(dataset_dir, "openeb", "gen4_evt3_hand.raw")
+    assert os.path.exists(input_raw_file)
+
+    # Create temporary directory for output RAW file
+    tmp_dir = os_tools.TemporaryDirectoryHandler()
+    output_raw_file = os.path.join(tmp_dir.temporary_directory(), "data_out.raw")
+
+    # This recording is ~15s, so 20 is after its end
+    cmd = "./metavision_file_cutter -i {} --start {} --end {} -o {}".format(input_raw_file, 20, 25, output_raw_file)
+    output, error_code = pytest_tools.run_cmd_setting_mv_log_file(cmd)
+
+    # Check app exited without error
+    assert error_code == 0, "******\nError while executing cmd '{}':{}\n******".format(cmd, output)
+
+    assert "No file saved because the start time provided is after the end of the input file" in output
+    assert not os.path.exists(output_raw_file)
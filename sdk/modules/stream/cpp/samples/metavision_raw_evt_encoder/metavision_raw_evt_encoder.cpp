@@ -10,17 +10,19 @@
  **********************************************************************************************************************/
 
 // This application demonstrates how to use Metavision SDK Stream module to decode an event recording, process it and
-// encode it back to RAW EVT2 format.
+// encode it back to RAW EVT2 or EVT3 format.
 
 #include <chrono>
 #include <filesystem>
 #include <iostream>
+#include <memory>
 #include <thread>
 #include <boost/program_options.hpp>
 #include <metavision/sdk/base/utils/log.h>
 #include <metavision/sdk/core/algorithms/flip_y_algorithm.h>
 #include <metavision/sdk/stream/camera.h>
 #include <metavision/sdk/stream/raw_evt2_event_file_writer.h>
+#include <metavision/sdk/stream/raw_evt3_event_file_writer.h>
 
 namespace po = boost::program_options;
 
@@ -29,8 +31,9 @@ int main(int argc, char *argv[]) {
     std::filesystem::path out_path;
     bool encode_triggers                    = false;
     Metavision::timestamp max_event_latency = -1;
+    std::string format;
 
-    const std::string program_desc("Sample application to process a decoded event stream and encode it to RAW EVT2.\n");
+    const std::string program_desc("Sample application to process a decoded event stream and encode it to RAW EVT2 or EVT3.\n");
 
     po::options_description options_desc("Options");
     // clang-format off
@@ -40,6 +43,7 @@ int main(int argc, char *argv[]) {
         ("output-path,o", po::value<std::filesystem::path>(&out_path)->default_value(""), "Path to output file. If not specified, will use a modified version of the input path.")
         ("encode-triggers", po::bool_switch(&encode_triggers), "Flag to activate encoding of external trigger events.")
         ("max-event-latency", po::value<Metavision::timestamp>(&max_event_latency)->default_value(-1), "Maximum latency in camera time for the reception of events, infinite by default.")
+        ("format,f", po::value<std::string>(&format)->default_value("evt2"), "Output encoding format, either evt2 or evt3.")
     ;
     // clang-format on
 
@@ -60,6 +64,11 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
+    if (format != "evt2" && format != "evt3") {
+        MV_LOG_ERROR() << "Unsupported output format:" << format;
+        return 1;
+    }
+
     // Get the output filename
     if (out_path.empty()) {
         out_path = in_path.parent_path() / in_path.stem();
@@ -75,7 +84,16 @@ int main(int argc, char *argv[]) {
     Metavision::FlipYAlgorithm yflipper(height - 1);
 
     // Instantiate the RAW encoder
-    Metavision::RAWEvt2EventFileWriter writer(width, height, out_path.string(), encode_triggers, {}, max_event_latency);
+    std::unique_ptr<Metavision::EventFileWriter> writer;
+    if (format == "evt3") {
+        writer = std::make_unique<Metavision::RAWEvt3EventFileWriter>(width, height, out_path.string(), encode_triggers,
+                                                                      std::unordered_map<std::string, std::string>(),
+                                                                      max_event_latency);
+    } else {
+        writer = std::make_unique<Metavision::RAWEvt2EventFileWriter>(width, height, out_path.string(), encode_triggers,
+                                                                      std::unordered_map<std::string, std::string>(),
+                                                                      max_event_latency);
+    }
 
     // Setup console feedback to be provided on processing progression
     using namespace std::chrono_literals;
@@ -100,13 +118,13 @@ int main(int argc, char *argv[]) {
     camera.cd().add_callback([&](const Metavision::EventCD *begin, const Metavision::EventCD *end) {
         events.clear();
         yflipper.process_events(begin, end, std::back_inserter(events));
-        writer.add_events(events.data(), events.data() + events.size());
+        writer->add_events(events.data(), events.data() + events.size());
         progress_feedback_fct();
     });
     if (encode_triggers) {
         camera.ext_trigger().add_callback(
             [&](const Metavision::EventExtTrigger *begin, const Metavision::EventExtTrigger *end) {
-                writer.add_events(begin, end);
+                writer->add_events(begin, end);
             });
     }
 
@@ -14,6 +14,7 @@
 #include "metavision/hal/device/device_discovery.h"
 #include "metavision/hal/facilities/i_geometry.h"
 #include "metavision/hal/utils/hal_connection_exception.h"
+#include "metavision/sdk/base/utils/trace_recorder.h"
 #include "metavision/sdk/stream/internal/camera_internal.h"
 #include "metavision/sdk/stream/internal/camera_live_internal.h"
 #include "metavision/sdk/stream/internal/camera_offline_generic_internal.h"
@@ -232,6 +233,14 @@ CD &Camera::Private::cd() {
     return *cd_;
 }
 
+CDVector &Camera::Private::cd_vector() {
+    check_initialization();
+    if (!cd_vector_) {
+        throw CameraException(UnsupportedFeatureErrors::CDVectorUnavailable);
+    }
+    return *cd_vector_;
+}
+
 ExtTrigger &Camera::Private::ext_trigger() {
     check_initialization();
     if (!ext_trigger_) {
@@ -284,6 +293,60 @@ timestamp Camera::Private::get_last_timestamp() const {
     throw CameraException(CameraErrorCode::CameraNotInitialized);
 }
 
+void Camera::Private::enable_latency_statistics(bool enable) {
+    latency_statistics_enabled_ = enable;
+}
+
+bool Camera::Private::is_latency_statistics_enabled() const {
+    return latency_statistics_enabled_;
+}
+
+CameraLatencyStatistics Camera::Private::get_latency_statistics() const {
+    std::lock_guard<std::mutex> lock(latency_statistics_mutex_);
+    return latency_statistics_;
+}
+
+void Camera::Private::reset_latency_statistics() {
+    std::lock_guard<std::mutex> lock(latency_statistics_mutex_);
+    latency_statistics_.reset();
+}
+
+void Camera::Private::set_overload_policy(const CameraOverloadPolicy &policy) {
+    using Mode = CameraOverloadPolicy::Mode;
+    if (policy.mode_ != Mode::None && policy.max_queued_buffers_ == 0) {
+        throw CameraException(CameraErrorCode::InvalidArgument,
+                              "The maximum number of queued buffers of an overload policy must be positive.");
+    }
+    if (policy.mode_ == Mode::Subsample && policy.subsampling_factor_ == 0) {
+        throw CameraException(CameraErrorCode::InvalidArgument, "The subsampling factor must be positive.");
+    }
+    if (policy.mode_ == Mode::RoiOnly && (policy.roi_width_ == 0 || policy.roi_height_ == 0)) {
+        throw CameraException(CameraErrorCode::InvalidArgument, "The region of interest must not be empty.");
+    }
+    {
+        std::lock_guard<std::mutex> lock(overload_mutex_);
+        overload_policy_ = policy;
+    }
+    apply_overload_policy(policy);
+}
+
+CameraOverloadPolicy Camera::Private::get_overload_policy() const {
+    std::lock_guard<std::mutex> lock(overload_mutex_);
+    return overload_policy_;
+}
+
+CameraOverloadStatistics Camera::Private::get_overload_statistics() const {
+    std::lock_guard<std::mutex> lock(overload_mutex_);
+    return overload_statistics_;
+}
+
+void Camera::Private::reset_overload_statistics() {
+    std::lock_guard<std::mutex> lock(overload_mutex_);
+    overload_statistics_.reset();
+}
+
+void Camera::Private::apply_overload_policy(const CameraOverloadPolicy &) {}
+
 void Camera::Private::start_impl() {
     throw CameraException(CameraErrorCode::CameraNotInitialized);
 }
@@ -402,6 +465,10 @@ void Camera::Private::run() {
     // notifies that this thread can now be stopped if needed
     run_thread_cond_.notify_one();
 
+    if (TraceRecorder::is_enabled()) {
+        TraceRecorder::instance().set_thread_name("Camera");
+    }
+
     try {
         start_impl();
     } catch (const HalConnectionException &e) {
@@ -598,6 +665,14 @@ Camera Camera::from_file(const std::filesystem::path &file_path, const FileConfi
                           "Unsupported extension for the provided input file " + file_path.string() + ".");
 }
 
+Camera Camera::from_uri(const std::string &uri, const DeviceConfig &config) {
+    const std::string file_scheme("file://");
+    if (uri.rfind(file_scheme, 0) == 0) {
+        return from_file(uri.substr(file_scheme.size()));
+    }
+    return from_serial(uri, config);
+}
+
 RawData &Camera::raw_data() {
     return pimpl_->raw_data();
 }
@@ -606,6 +681,10 @@ CD &Camera::cd() {
     return pimpl_->cd();
 }
 
+CDVector &Camera::cd_vector() {
+    return pimpl_->cd_vector();
+}
+
 ExtTrigger &Camera::ext_trigger() {
     return pimpl_->ext_trigger();
 }
@@ -704,6 +783,38 @@ Metavision::timestamp Camera::get_last_timestamp() const {
     return pimpl_->get_last_timestamp();
 }
 
+void Camera::enable_latency_statistics(bool enable) {
+    pimpl_->enable_latency_statistics(enable);
+}
+
+bool Camera::is_latency_statistics_enabled() const {
+    return pimpl_->is_latency_statistics_enabled();
+}
+
+CameraLatencyStatistics Camera::get_latency_statistics() const {
+    return pimpl_->get_latency_statistics();
+}
+
+void Camera::reset_latency_statistics() {
+    pimpl_->reset_latency_statistics();
+}
+
+void Camera::set_overload_policy(const CameraOverloadPolicy &policy) {
+    pimpl_->set_overload_policy(policy);
+}
+
+CameraOverloadPolicy Camera::get_overload_policy() const {
+    return pimpl_->get_overload_policy();
+}
+
+CameraOverloadStatistics Camera::get_overload_statistics() const {
+    return pimpl_->get_overload_statistics();
+}
+
+void Camera::reset_overload_statistics() {
+    pimpl_->reset_overload_statistics();
+}
+
 bool Camera::save(const std::filesystem::path &path) const {
     std::ofstream ofs(path);
     if (!ofs.is_open()) {
@@ -0,0 +1,98 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "metavision/sdk/stream/camera_latency_statistics.h"
+
+namespace Metavision {
+
+namespace {
+std::size_t get_bucket(std::uint64_t ns) {
+    std::size_t bucket = 0;
+    while (ns != 0 && bucket < LatencyHistogram::NumBuckets - 1) {
+        ns >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+} // namespace
+
+void LatencyHistogram::add(std::chrono::nanoseconds duration) {
+    const std::int64_t ns = std::max<std::int64_t>(0, duration.count());
+    ++buckets_[get_bucket(static_cast<std::uint64_t>(ns))];
+    if (count_ == 0) {
+        min_ns_ = max_ns_ = ns;
+    } else {
+        min_ns_ = std::min(min_ns_, ns);
+        max_ns_ = std::max(max_ns_, ns);
+    }
+    ++count_;
+    sum_ns_ += ns;
+}
+
+void LatencyHistogram::reset() {
+    *this = LatencyHistogram();
+}
+
+std::uint64_t LatencyHistogram::count() const {
+    return count_;
+}
+
+std::chrono::nanoseconds LatencyHistogram::min() const {
+    return std::chrono::nanoseconds(min_ns_);
+}
+
+std::chrono::nanoseconds LatencyHistogram::max() const {
+    return std::chrono::nanoseconds(max_ns_);
+}
+
+std::chrono::nanoseconds LatencyHistogram::mean() const {
+    return std::chrono::nanoseconds(count_ == 0 ? 0 : sum_ns_ / static_cast<std::int64_t>(count_));
+}
+
+std::chrono::nanoseconds LatencyHistogram::percentile(double p) const {
+    if (count_ == 0) {
+        return std::chrono::nanoseconds(0);
+    }
+    const double clamped_p = std::min(100., std::max(0., p));
+    const auto rank        = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(clamped_p / 100. * count_)));
+    std::uint64_t cumulated_count = 0;
+    for (std::size_t i = 0; i < NumBuckets; ++i) {
+        cumulated_count += buckets_[i];
+        if (cumulated_count >= rank) {
+            return std::min(std::max(bucket_upper_bound(i), min()), max());
+        }
+    }
+    return max();
+}
+
+const std::array<std::uint64_t, LatencyHistogram::NumBuckets> &LatencyHistogram::buckets() const {
+    return buckets_;
+}
+
+std::chrono::nanoseconds LatencyHistogram::bucket_upper_bound(std::size_t bucket) {
+    if (bucket >= NumBuckets - 1) {
+        return std::chrono::nanoseconds(std::numeric_limits<std::int64_t>::max());
+    }
+    return std::chrono::nanoseconds(std::int64_t(1) << bucket);
+}
+
+void CameraLatencyStatistics::reset() {
+    arrival_to_decode.reset();
+    decode.reset();
+    callbacks.reset();
+    event_lag.reset();
+}
+
+} // namespace Metavision
@@ -9,6 +9,9 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <algorithm>
+#include <iterator>
+
 #include "metavision/hal/device/device_discovery.h"
 #include "metavision/hal/facilities/i_events_stream_decoder.h"
 #include "metavision/hal/facilities/i_events_stream.h"
@@ -18,12 +21,14 @@
 #include "metavision/hal/facilities/i_ll_biases.h"
 #include "metavision/hal/facilities/i_plugin_software_info.h"
 #include "metavision/sdk/base/events/event_pointcloud.h"
+#include "metavision/sdk/base/utils/trace_recorder.h"
 #include "metavision/sdk/stream/internal/callback_tag_ids.h"
 #include "metavision/sdk/stream/internal/camera_error_code_internal.h"
 #include "metavision/sdk/stream/internal/camera_generation_internal.h"
 #include "metavision/sdk/stream/internal/camera_live_internal.h"
 #include "metavision/sdk/stream/internal/camera_serialization.h"
 #include "metavision/sdk/stream/internal/cd_internal.h"
+#include "metavision/sdk/stream/internal/cd_vector_internal.h"
 #include "metavision/sdk/stream/internal/ext_trigger_internal.h"
 #include "metavision/sdk/stream/internal/erc_counter_internal.h"
 #include "metavision/sdk/stream/internal/frame_diff_internal.h"
@@ -110,6 +115,9 @@ void LivePrivate::start_impl() {
         // decoded using the current state (which is probably wrong : i.e wrong time base, etc.)
         i_events_stream_decoder_->reset_last_timestamp(-1);
     }
+    // the sensor time base may have been reset, the event lag must be measured from a new reference
+    has_min_event_clock_offset_ = false;
+    shedding_                   = false;
     if (i_events_stream_) {
         i_events_stream_->start();
     }
@@ -121,6 +129,17 @@ void LivePrivate::stop_impl() {
     }
 }
 
+template<typename Dispatcher>
+void LivePrivate::dispatch_callbacks(const Dispatcher &dispatcher) {
+    if (!measure_latency_) {
+        dispatcher();
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    dispatcher();
+    callbacks_duration_ += std::chrono::steady_clock::now() - start;
+}
+
 bool LivePrivate::process_impl() {
     if (config_.print_timings) {
         return process_impl(timing_profiler_tuple_.get_profiler<true>());
@@ -135,6 +154,7 @@ bool LivePrivate::process_impl(TimingProfilerType *profiler) {
 
     {
         typename TimingProfilerType::TimedOperation t("Polling", profiler);
+        MV_TRACE_SCOPE("Camera::wait_next_buffer");
         res = i_events_stream_->wait_next_buffer();
     }
 
@@ -142,25 +162,181 @@ bool LivePrivate::process_impl(TimingProfilerType *profiler) {
         return false;
     } else if (res > 0) {
         typename TimingProfilerType::TimedOperation t("Processing", profiler);
+        MV_TRACE_SCOPE("Camera::process_buffer");
         auto ev_buffer = i_events_stream_->get_latest_raw_data();
+        if (i_events_stream_->latest_raw_data_follows_dropped_data() && i_events_stream_decoder_) {
+            // the decoder state refers to the dropped data, it must synchronize again on the new data
+            i_events_stream_decoder_->reset_last_timestamp(-1);
+        }
+        update_shedding_state();
+
+        measure_latency_    = latency_statistics_enabled_;
+        callbacks_duration_ = std::chrono::steady_clock::duration::zero();
+        std::chrono::steady_clock::time_point decode_start, decode_end;
+        if (measure_latency_) {
+            decode_start = decode_end = std::chrono::steady_clock::now();
+        }
+        bool decoded = false;
 
         const bool has_decode_callbacks = index_manager_.counter_map_.tag_count(CallbackTagIds::DECODE_CALLBACK_TAG_ID);
         // Pointcloud is not handled by Camera object. Always do decoding for pointclouds.
         if (has_decode_callbacks || device_->get_facility<I_EventFrameDecoder<PointCloud>>()) {
             i_decoder_->decode(ev_buffer.data(), ev_buffer.end());
             t.setNumProcessedElements(ev_buffer.size() / i_decoder_->get_raw_event_size_bytes());
+            decoded = true;
+            if (measure_latency_) {
+                decode_end = std::chrono::steady_clock::now();
+            }
         }
+        const auto decode_callbacks_duration = callbacks_duration_;
 
         // ... then we call the raw buffer callback so that a user has access to some info (e.g last
         // decoded timestamp) when the raw callback is called
-        for (auto &cb : raw_data_->get_pimpl().get_cbs()) {
-            cb(ev_buffer.data(), ev_buffer.size());
+        dispatch_callbacks([&]() {
+            for (auto &cb : raw_data_->get_pimpl().get_cbs()) {
+                cb(ev_buffer.data(), ev_buffer.size());
+            }
+        });
+
+        if (measure_latency_) {
+            record_latency_statistics(decode_start, decode_end, decode_end - decode_start - decode_callbacks_duration,
+                                      decoded);
+        }
+
+        if (active_overload_policy_.mode_ != CameraOverloadPolicy::Mode::None) {
+            record_overload_statistics();
+        }
+
+        if (TraceRecorder::is_enabled()) {
+            trace_event_rate();
         }
     }
 
     return true;
 }
 
+void LivePrivate::apply_overload_policy(const CameraOverloadPolicy &policy) {
+    switch (policy.mode_) {
+    case CameraOverloadPolicy::Mode::None:
+        i_events_stream_->set_max_queued_buffers(0);
+        break;
+    case CameraOverloadPolicy::Mode::DropBuffers:
+        i_events_stream_->set_max_queued_buffers(policy.max_queued_buffers_);
+        break;
+    default:
+        // buffers are only dropped if shedding events does not let the processing catch up
+        i_events_stream_->set_max_queued_buffers(4 * policy.max_queued_buffers_);
+        break;
+    }
+}
+
+void LivePrivate::update_shedding_state() {
+    {
+        std::lock_guard<std::mutex> lock(overload_mutex_);
+        active_overload_policy_ = overload_policy_;
+    }
+    if (active_overload_policy_.mode_ == CameraOverloadPolicy::Mode::None) {
+        shedding_ = false;
+        return;
+    }
+
+    // the camera is overloaded when the queue, including the buffer being processed, reaches its maximum depth, and
+    // until it has been emptied
+    const std::size_t num_queued_buffers = i_events_stream_->get_num_queued_buffers();
+    if (num_queued_buffers + 1 >= active_overload_policy_.max_queued_buffers_) {
+        shedding_ = true;
+    } else if (num_queued_buffers == 0) {
+        shedding_ = false;
+    }
+}
+
+void LivePrivate::record_overload_statistics() {
+    const auto dropped_data             = i_events_stream_->get_dropped_data();
+    const std::uint64_t dropped_buffers = dropped_data.buffers_ - last_dropped_data_.buffers_;
+    const std::uint64_t dropped_bytes   = dropped_data.bytes_ - last_dropped_data_.bytes_;
+    last_dropped_data_                  = dropped_data;
+
+    const std::uint64_t raw_event_size = i_decoder_ ? i_decoder_->get_raw_event_size_bytes() : 1;
+    const std::uint64_t dropped_events = shed_cd_events_count_ + dropped_bytes / raw_event_size;
+    shed_cd_events_count_              = 0;
+
+    // the rate is computed over periods of 1s
+    const auto now = std::chrono::steady_clock::now();
+    if (dropped_events_window_start_ == std::chrono::steady_clock::time_point()) {
+        dropped_events_window_start_ = now;
+    }
+    dropped_events_in_window_ += dropped_events;
+    const auto elapsed_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(now - dropped_events_window_start_).count();
+    const bool window_elapsed = elapsed_us >= 1000000;
+    const double rate         = window_elapsed ? dropped_events_in_window_ * 1e6 / elapsed_us : 0;
+    if (window_elapsed) {
+        dropped_events_window_start_ = now;
+        dropped_events_in_window_    = 0;
+        MV_TRACE_COUNTER("Camera dropped events/s", static_cast<std::int64_t>(rate));
+    }
+
+    std::lock_guard<std::mutex> lock(overload_mutex_);
+    overload_statistics_.dropped_buffers += dropped_buffers;
+    overload_statistics_.dropped_bytes += dropped_bytes;
+    overload_statistics_.dropped_events += dropped_events;
+    overload_statistics_.shedding = shedding_;
+    if (window_elapsed) {
+        overload_statistics_.dropped_events_rate = rate;
+    }
+}
+
+void LivePrivate::trace_event_rate() {
+    // the rate is averaged over periods of 100ms to be readable in the trace
+    const auto now = std::chrono::steady_clock::now();
+    if (traced_cd_events_rate_start_ == std::chrono::steady_clock::time_point()) {
+        traced_cd_events_rate_start_ = now;
+        traced_cd_events_count_      = 0;
+        return;
+    }
+    const auto elapsed_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(now - traced_cd_events_rate_start_).count();
+    if (elapsed_us >= 100000) {
+        MV_TRACE_COUNTER("Camera CD events/s", traced_cd_events_count_ * 1000000 / elapsed_us);
+        traced_cd_events_rate_start_ = now;
+        traced_cd_events_count_      = 0;
+    }
+}
+
+void LivePrivate::record_latency_statistics(const std::chrono::steady_clock::time_point &decode_start,
+                                            const std::chrono::steady_clock::time_point &decode_end,
+                                            const std::chrono::steady_clock::duration &decode_duration, bool decoded) {
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    using std::chrono::nanoseconds;
+
+    // the event lag is the offset between the host and the sensor clocks, relative to the smallest offset observed
+    bool has_event_lag      = false;
+    nanoseconds event_lag   = nanoseconds::zero();
+    const timestamp last_ts =
+        (decoded && i_events_stream_decoder_) ? i_events_stream_decoder_->get_last_timestamp() : -1;
+    if (last_ts >= 0) {
+        const std::int64_t offset_us = duration_cast<microseconds>(decode_end.time_since_epoch()).count() - last_ts;
+        if (!has_min_event_clock_offset_ || offset_us < min_event_clock_offset_us_) {
+            min_event_clock_offset_us_  = offset_us;
+            has_min_event_clock_offset_ = true;
+        }
+        event_lag     = microseconds(offset_us - min_event_clock_offset_us_);
+        has_event_lag = true;
+    }
+
+    std::lock_guard<std::mutex> lock(latency_statistics_mutex_);
+    latency_statistics_.arrival_to_decode.add(
+        duration_cast<nanoseconds>(decode_start - i_events_stream_->get_latest_raw_data_arrival_time()));
+    if (decoded) {
+        latency_statistics_.decode.add(duration_cast<nanoseconds>(decode_duration));
+    }
+    latency_statistics_.callbacks.add(duration_cast<nanoseconds>(callbacks_duration_));
+    if (has_event_lag) {
+        latency_statistics_.event_lag.add(event_lag);
+    }
+}
+
 bool LivePrivate::start_recording_impl(const std::filesystem::path &file_path) {
     auto *biases = device_->get_facility<I_LL_Biases>();
     if (biases) {
@@ -214,21 +390,48 @@ void LivePrivate::init() {
     I_EventDecoder<EventCD> *i_cd_events_decoder = device_->get_facility<I_EventDecoder<EventCD>>();
     if (i_cd_events_decoder) {
         i_cd_events_decoder->add_event_buffer_callback([this](const EventCD *begin, const EventCD *end) {
-            for (auto &&cb : cd_->get_pimpl().get_cbs()) {
-                cb(begin, end);
+            traced_cd_events_count_ += std::distance(begin, end);
+            if (shedding_ && active_overload_policy_.mode_ != CameraOverloadPolicy::Mode::DropBuffers) {
+                kept_cd_events_.clear();
+                std::copy_if(begin, end, std::back_inserter(kept_cd_events_), [this](const EventCD &ev) {
+                    return active_overload_policy_.keeps(ev.x, ev.y);
+                });
+                shed_cd_events_count_ += std::distance(begin, end) - kept_cd_events_.size();
+                begin = kept_cd_events_.data();
+                end   = begin + kept_cd_events_.size();
             }
+            dispatch_callbacks([&]() {
+                for (auto &&cb : cd_->get_pimpl().get_cbs()) {
+                    cb(begin, end);
+                }
+            });
         });
     }
 
+    I_EventDecoder<EventCDVector> *i_cd_vector_events_decoder = device_->get_facility<I_EventDecoder<EventCDVector>>();
+    if (i_cd_vector_events_decoder) {
+        cd_vector_.reset(CDVector::Private::build(index_manager_));
+        i_cd_vector_events_decoder->add_event_buffer_callback(
+            [this](const EventCDVector *begin, const EventCDVector *end) {
+                dispatch_callbacks([&]() {
+                    for (auto &&cb : cd_vector_->get_pimpl().get_cbs()) {
+                        cb(begin, end);
+                    }
+                });
+            });
+    }
+
     I_EventDecoder<EventExtTrigger> *i_ext_trigger_events_decoder =
         device_->get_facility<I_EventDecoder<EventExtTrigger>>();
     if (i_ext_trigger_events_decoder) {
         ext_trigger_.reset(ExtTrigger::Private::build(index_manager_));
         i_ext_trigger_events_decoder->add_event_buffer_callback(
             [this](const EventExtTrigger *begin, const EventExtTrigger *end) {
-                for (auto &&cb : ext_trigger_->get_pimpl().get_cbs()) {
-                    cb(begin, end);
-                }
+                dispatch_callbacks([&]() {
+                    for (auto &&cb : ext_trigger_->get_pimpl().get_cbs()) {
+                        cb(begin, end);
+                    }
+                });
             });
     }
 
@@ -238,9 +441,11 @@ void LivePrivate::init() {
         erc_counter_.reset(ERCCounter::Private::build(index_manager_));
         i_erc_count_events_decoder->add_event_buffer_callback(
             [this](const EventERCCounter *begin, const EventERCCounter *end) {
-                for (auto &&cb : erc_counter_->get_pimpl().get_cbs()) {
-                    cb(begin, end);
-                }
+                dispatch_callbacks([&]() {
+                    for (auto &&cb : erc_counter_->get_pimpl().get_cbs()) {
+                        cb(begin, end);
+                    }
+                });
             });
     }
 
@@ -249,9 +454,11 @@ void LivePrivate::init() {
     if (i_histogram_decoder) {
         frame_histo_.reset(FrameHisto::Private::build(index_manager_));
         i_histogram_decoder->add_event_frame_callback([this](const RawEventFrameHisto &h) {
-            for (auto &&cb : frame_histo_->get_pimpl().get_cbs()) {
-                cb(h);
-            }
+            dispatch_callbacks([&]() {
+                for (auto &&cb : frame_histo_->get_pimpl().get_cbs()) {
+                    cb(h);
+                }
+            });
         });
     }
 
@@ -260,9 +467,11 @@ void LivePrivate::init() {
     if (i_diff_decoder) {
         frame_diff_.reset(FrameDiff::Private::build(index_manager_));
         i_diff_decoder->add_event_frame_callback([this](const RawEventFrameDiff &h) {
-            for (auto &&cb : frame_diff_->get_pimpl().get_cbs()) {
-                cb(h);
-            }
+            dispatch_callbacks([&]() {
+                for (auto &&cb : frame_diff_->get_pimpl().get_cbs()) {
+                    cb(h);
+                }
+            });
         });
     }
 
@@ -272,9 +481,11 @@ void LivePrivate::init() {
         monitoring_.reset(Monitoring::Private::build(index_manager_));
         i_monitoring_events_decoder->add_event_buffer_callback(
             [this](const EventMonitoring *begin, const EventMonitoring *end) {
-                for (auto &&cb : monitoring_->get_pimpl().get_cbs()) {
-                    cb(begin, end);
-                }
+                dispatch_callbacks([&]() {
+                    for (auto &&cb : monitoring_->get_pimpl().get_cbs()) {
+                        cb(begin, end);
+                    }
+                });
             });
     }
 
@@ -45,7 +45,7 @@ OfflineGenericPrivate::OfflineGenericPrivate(const std::filesystem::path &file_p
         if (file_path.extension().string() == ".hdf5" || file_path.extension().string() == ".h5") {
             file_reader_ = std::make_unique<HDF5EventFileReader>(file_path, hints.time_shift());
         } else {
-            file_reader_ = std::make_unique<DATEventFileReader>(file_path);
+            file_reader_ = std::make_unique<DATEventFileReader>(file_path, hints.decode_ahead());
         }
     } catch (const CameraException &) {
         throw;
@@ -23,6 +23,7 @@
 #include "metavision/sdk/stream/internal/camera_generation_internal.h"
 #include "metavision/sdk/stream/internal/camera_offline_raw_internal.h"
 #include "metavision/sdk/stream/internal/cd_internal.h"
+#include "metavision/sdk/stream/internal/cd_vector_internal.h"
 #include "metavision/sdk/stream/internal/ext_trigger_internal.h"
 #include "metavision/sdk/stream/internal/erc_counter_internal.h"
 #include "metavision/sdk/stream/internal/frame_diff_internal.h"
@@ -42,6 +43,7 @@ OfflineRawPrivate::OfflineRawPrivate(const std::filesystem::path &rawfile, const
     raw_file_stream_config.n_read_buffers_   = hints.max_memory() / hints.max_read_per_op();
     raw_file_stream_config.do_time_shifting_ = hints.time_shift();
     raw_file_stream_config.build_index_      = hints.get<bool>("index", raw_file_stream_config.build_index_);
+    raw_file_stream_config.evt21_keep_vectors_ = hints.cd_vectors();
 
     device_ = DeviceDiscovery::open_raw_file(rawfile, raw_file_stream_config);
     if (!device_) {
@@ -192,6 +194,17 @@ void OfflineRawPrivate::init() {
         });
     }
 
+    I_EventDecoder<EventCDVector> *i_cd_vector_events_decoder = device_->get_facility<I_EventDecoder<EventCDVector>>();
+    if (i_cd_vector_events_decoder) {
+        cd_vector_.reset(CDVector::Private::build(index_manager_));
+        file_reader_->add_read_callback([this](const EventCDVector *begin, const EventCDVector *end) {
+            for (auto &&cb : cd_vector_->get_pimpl().get_cbs()) {
+                cb(begin, end);
+            }
+            last_ts_ = std::prev(end)->t;
+        });
+    }
+
     I_EventDecoder<EventExtTrigger> *i_ext_trigger_events_decoder =
         device_->get_facility<I_EventDecoder<EventExtTrigger>>();
     if (i_ext_trigger_events_decoder) {
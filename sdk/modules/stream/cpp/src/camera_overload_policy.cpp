@@ -0,0 +1,23 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include "metavision/sdk/stream/camera_overload_policy.h"
+
+namespace Metavision {
+
+void CameraOverloadStatistics::reset() {
+    dropped_buffers     = 0;
+    dropped_bytes       = 0;
+    dropped_events      = 0;
+    dropped_events_rate = 0;
+}
+
+} // namespace Metavision
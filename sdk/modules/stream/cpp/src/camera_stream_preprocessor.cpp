@@ -0,0 +1,190 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "metavision/sdk/base/utils/trace_recorder.h"
+#include "metavision/sdk/core/utils/executor.h"
+#include "metavision/sdk/stream/camera_stream_preprocessor.h"
+
+namespace Metavision {
+
+struct CameraStreamPreprocessor::Private {
+    using ProcessFunction = std::function<void(timestamp, const EventCD *, const EventCD *, Tensor &)>;
+
+    struct Job {
+        TensorSlice slice;
+        std::shared_ptr<const EventBuffer> events;
+        std::exception_ptr error;
+        bool done = false;
+    };
+
+    Private(Camera &&camera, ProcessFunction process, const TensorShape &shape, BaseType type,
+            const SliceCondition &slice_condition, std::size_t max_queue_size) :
+        slicer_(std::move(camera), slice_condition),
+        process_(std::move(process)),
+        shape_(shape),
+        type_(type),
+        max_queue_size_(std::max<std::size_t>(1, max_queue_size)) {
+        reader_ = std::thread([this]() { read_slices(); });
+    }
+
+    ~Private() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cond_.notify_all();
+        // the reader may be waiting for the next slice of the slicer
+        slicer_.stop();
+        reader_.join();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this]() { return running_jobs_ == 0; });
+    }
+
+    void read_slices() {
+        try {
+            timestamp start_ts = 0;
+            for (const auto &slice : slicer_) {
+                auto job            = std::make_shared<Job>();
+                job->slice.start_ts = start_ts;
+                job->slice.t        = slice.t;
+                job->slice.n_events = slice.n_events;
+                job->events         = slice.events;
+                start_ts            = slice.t;
+
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    cond_.wait(lock, [this]() { return stop_ || jobs_.size() < max_queue_size_; });
+                    if (stop_) {
+                        break;
+                    }
+                    jobs_.push_back(job);
+                    ++running_jobs_;
+                }
+                Executor::get_default().post([this, job]() { process(*job); });
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            reader_error_ = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        end_of_stream_ = true;
+        cond_.notify_all();
+    }
+
+    void process(Job &job) {
+        MV_TRACE_SCOPE("CameraStreamPreprocessor::process");
+        Tensor tensor(shape_, type_);
+        std::exception_ptr error;
+        try {
+            const EventCD *begin = job.events->data();
+            process_(job.slice.start_ts, begin, begin + job.events->size(), tensor);
+        } catch (...) { error = std::current_exception(); }
+        // the events buffer goes back to the slicer pool
+        job.events.reset();
+
+        // the notification is done under the lock, as the destructor may return as soon as running_jobs_ is null
+        std::lock_guard<std::mutex> lock(mutex_);
+        job.slice.tensor = std::move(tensor);
+        job.error        = error;
+        job.done         = true;
+        --running_jobs_;
+        cond_.notify_all();
+    }
+
+    bool next(TensorSlice &slice) {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_.wait(lock, [this]() { return jobs_.empty() ? end_of_stream_ : jobs_.front()->done; });
+            if (jobs_.empty()) {
+                if (reader_error_) {
+                    std::rethrow_exception(std::exchange(reader_error_, nullptr));
+                }
+                return false;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+            // wakes the reader up, as there is room for a new slice
+            cond_.notify_all();
+        }
+
+        if (job->error) {
+            std::rethrow_exception(job->error);
+        }
+        slice = std::move(job->slice);
+        return true;
+    }
+
+    CameraStreamSlicer slicer_;
+    const ProcessFunction process_;
+    const TensorShape shape_;
+    const BaseType type_;
+    const std::size_t max_queue_size_;
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<std::shared_ptr<Job>> jobs_;
+    std::size_t running_jobs_ = 0;
+    bool end_of_stream_       = false;
+    bool stop_                = false;
+    std::exception_ptr reader_error_;
+    std::thread reader_;
+};
+
+CameraStreamPreprocessor::CameraStreamPreprocessor(
+    Camera &&camera, std::shared_ptr<const EventPreprocessor<const EventCD *>> preprocessor,
+    const SliceCondition &slice_condition, std::size_t max_queue_size) :
+    pimpl_(std::make_unique<Private>(
+        std::move(camera),
+        [preprocessor](timestamp ts, const EventCD *begin, const EventCD *end, Tensor &tensor) {
+            preprocessor->process_events(ts, begin, end, tensor);
+        },
+        preprocessor->get_output_shape(), preprocessor->get_output_type(), slice_condition, max_queue_size)) {}
+
+CameraStreamPreprocessor::CameraStreamPreprocessor(Camera &&camera,
+                                                   std::shared_ptr<const EventPreprocessor<EventCD *>> preprocessor,
+                                                   const SliceCondition &slice_condition,
+                                                   std::size_t max_queue_size) :
+    pimpl_(std::make_unique<Private>(
+        std::move(camera),
+        [preprocessor](timestamp ts, const EventCD *begin, const EventCD *end, Tensor &tensor) {
+            // the preprocessors only read the events, the iterators are non const for the Python bindings
+            preprocessor->process_events(ts, const_cast<EventCD *>(begin), const_cast<EventCD *>(end), tensor);
+        },
+        preprocessor->get_output_shape(), preprocessor->get_output_type(), slice_condition, max_queue_size)) {}
+
+CameraStreamPreprocessor::~CameraStreamPreprocessor() = default;
+
+bool CameraStreamPreprocessor::next(TensorSlice &slice) {
+    return pimpl_->next(slice);
+}
+
+const TensorShape &CameraStreamPreprocessor::get_output_shape() const {
+    return pimpl_->shape_;
+}
+
+BaseType CameraStreamPreprocessor::get_output_type() const {
+    return pimpl_->type_;
+}
+
+} // namespace Metavision
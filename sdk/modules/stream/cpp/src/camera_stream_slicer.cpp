@@ -14,6 +14,7 @@
 #include "metavision/hal/facilities/i_events_stream_decoder.h"
 #include "metavision/sdk/stream/camera_stream_slicer.h"
 #include "metavision/hal/facilities/i_camera_synchronization.h"
+#include "metavision/sdk/base/utils/trace_recorder.h"
 
 namespace Metavision {
 bool Slice::operator==(const Slice &other) const {
@@ -73,12 +74,19 @@ CameraStreamSlicer::SliceIterator CameraStreamSlicer::end() {
     return SliceIterator();
 }
 
+void CameraStreamSlicer::stop() {
+    if (queue_) {
+        queue_->close();
+    }
+}
+
 const Camera &CameraStreamSlicer::camera() const {
     return camera_;
 }
 
 void CameraStreamSlicer::init_slicing() {
     camera_.cd().add_callback([this](const auto &begin, const auto &end) {
+        MV_TRACE_SCOPE("CameraStreamSlicer::process_events");
         slicer_.process_events(begin, end, [this](const auto &slice_begin, const auto &slice_end) {
             curt_event_buffer_->insert(curt_event_buffer_->end(), slice_begin, slice_end);
         });
@@ -103,6 +111,7 @@ void CameraStreamSlicer::init_slicing() {
 
     slicer_.set_on_new_slice_callback([this](auto status, auto t, auto nevents) {
         const bool new_slice_added = queue_->emplace({status, t, nevents, curt_event_buffer_, curt_trigger_buffer_});
+        MV_TRACE_COUNTER("CameraStreamSlicer queue size", queue_->size());
         if (new_slice_added) {
             curt_event_buffer_   = event_buffer_pool_.acquire();
             curt_trigger_buffer_ = trigger_buffer_pool_.acquire();
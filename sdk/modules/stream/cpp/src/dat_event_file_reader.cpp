@@ -9,22 +9,139 @@
  * See the License for the specific language governing permissions and limitations under the License.                 *
  **********************************************************************************************************************/
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <future>
 #include <memory>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include "metavision/sdk/base/events/event_cd.h"
 #include "metavision/sdk/base/events/event_ext_trigger.h"
 #include "metavision/sdk/base/utils/log.h"
 #include "metavision/sdk/base/utils/generic_header.h"
+#include "metavision/sdk/base/utils/object_pool.h"
+#include "metavision/sdk/core/utils/executor.h"
 #include "metavision/sdk/stream/camera.h"
 #include "metavision/sdk/stream/internal/event_file_reader_internal.h"
 #include "metavision/sdk/stream/dat_event_file_reader.h"
 
 namespace Metavision {
 
+namespace {
+
+// Read-only mapping of a whole file in memory
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path &path) {
+#ifdef _WIN32
+        file_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        LARGE_INTEGER size;
+        if (file_ == INVALID_HANDLE_VALUE || !GetFileSizeEx(file_, &size) || size.QuadPart == 0) {
+            return;
+        }
+        mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_) {
+            return;
+        }
+        data_ = static_cast<const char *>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (data_) {
+            size_ = static_cast<std::size_t>(size.QuadPart);
+        }
+#else
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        struct stat st;
+        if (fd_ < 0 || ::fstat(fd_, &st) != 0 || st.st_size == 0) {
+            return;
+        }
+        void *data = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd_, 0);
+        if (data == MAP_FAILED) {
+            return;
+        }
+        // the records are mostly read in order, the kernel can read ahead aggressively
+        ::madvise(data, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+        data_ = static_cast<const char *>(data);
+        size_ = static_cast<std::size_t>(st.st_size);
+#endif
+    }
+
+    MappedFile(MappedFile &&other) noexcept {
+        swap(other);
+    }
+
+    MappedFile &operator=(MappedFile &&other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    MappedFile(const MappedFile &)            = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data_) {
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_) {
+            CloseHandle(mapping_);
+        }
+        if (file_ != INVALID_HANDLE_VALUE) {
+            CloseHandle(file_);
+        }
+#else
+        if (data_) {
+            ::munmap(const_cast<char *>(data_), size_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+#endif
+    }
+
+    const char *data() const {
+        return data_;
+    }
+
+    std::size_t size() const {
+        return size_;
+    }
+
+private:
+    void swap(MappedFile &other) {
+#ifdef _WIN32
+        std::swap(file_, other.file_);
+        std::swap(mapping_, other.mapping_);
+#else
+        std::swap(fd_, other.fd_);
+#endif
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+    }
+
+#ifdef _WIN32
+    HANDLE file_    = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+    const char *data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+} // namespace
+
 class DATEventFileReader::Private {
 public:
-    Private(DATEventFileReader &reader) : reader_(reader), data_stream_(reader.get_path()) {
+    Private(DATEventFileReader &reader, bool decode_ahead) : reader_(reader), decode_ahead_(decode_ahead) {
         metadata_["generation"] = "3.0";
 
         if (std::filesystem::exists(reader.get_path())) {
@@ -66,7 +183,20 @@ public:
     }
 
     bool get_seek_range_impl(timestamp &min_t, timestamp &max_t) const {
-        return false;
+        min_t = -1;
+        max_t = -1;
+        if (cd_stream_) {
+            min_t = cd_stream_->get_first_evt_ts();
+            max_t = cd_stream_->get_last_evt_ts();
+        }
+        if (ext_trig_stream_) {
+            const timestamp first_ts = ext_trig_stream_->get_first_evt_ts();
+            if (first_ts >= 0) {
+                min_t = (min_t >= 0 ? std::min(min_t, first_ts) : first_ts);
+            }
+            max_t = std::max(max_t, ext_trig_stream_->get_last_evt_ts());
+        }
+        return min_t >= 0;
     }
 
     timestamp get_duration_impl() const {
@@ -83,11 +213,36 @@ public:
     }
 
     bool seek_impl(timestamp t) {
-        return false;
+        timestamp ts = -1;
+        if (cd_stream_) {
+            ts = cd_stream_->seek(t);
+        }
+        if (ext_trig_stream_) {
+            const timestamp trigger_ts = ext_trig_stream_->seek(t);
+            if (trigger_ts >= 0) {
+                ts = (ts >= 0 ? std::min(ts, trigger_ts) : trigger_ts);
+            }
+        }
+
+        if (ts < 0) {
+            return false;
+        }
+
+        // the next slice ends at the first time step boundary after the reached event
+        const timestamp next_time = (ts / kTimeStepUs + 1) * kTimeStepUs;
+        if (cd_stream_) {
+            cd_stream_->set_next_time(next_time);
+        }
+        if (ext_trig_stream_) {
+            ext_trig_stream_->set_next_time(next_time);
+        }
+        reader_.notify_seek(ts);
+
+        return true;
     }
 
     bool seekable() {
-        return false;
+        return true;
     }
 
     std::unordered_map<std::string, std::string> get_metadata_map_impl() const {
@@ -103,73 +258,163 @@ public:
     }
 
 private:
+    static constexpr timestamp kTimeStepUs = 1000;
+
+    // Stream of events of one DAT file, whose fixed size records are decoded in place from the mapped file
     template<typename Event_Type>
     class DATStream {
     public:
-        DATStream(DATEventFileReader &reader, std::ifstream &&ifs, const std::filesystem::path &path) :
-            reader_(reader), data_stream_(std::move(ifs)), path_(path) {}
+        DATStream(DATEventFileReader &reader, MappedFile &&file, std::size_t data_offset, bool decode_ahead) :
+            reader_(reader),
+            file_(std::move(file)),
+            data_(file_.data() + std::min(data_offset, file_.size())),
+            num_events_((file_.size() - std::min(data_offset, file_.size())) / kEvtSize),
+            decode_ahead_(decode_ahead),
+            buffer_pool_(BufferPool::make_unbounded(4)) {}
+
+        ~DATStream() {
+            // the slice being decoded ahead refers to this stream
+            cancel_decode_ahead();
+        }
 
         bool read_events() {
-            std::vector<Event_Type> evt_buff;
-            do {
-                if (pos_ptr_ == end_ptr_) {
-                    if (data_stream_.eof()) {
-                        break;
-                    }
-                    data_stream_.read(reinterpret_cast<char *>(raw_events_), kEvtChunk * kEvtSize);
-                    pos_ptr_ = raw_events_;
-                    end_ptr_ = raw_events_ + data_stream_.gcount() / kEvtSize;
-                }
+            Slice slice;
+            if (pending_slice_.valid()) {
+                slice = pending_slice_.get();
+            } else {
+                slice = decode_slice(pos_, next_time_);
+            }
+
+            pos_ = slice.end;
+            next_time_ += kTimeStepUs;
+            if (decode_ahead_ && pos_ < num_events_) {
+                start_decode_ahead();
+            }
 
-                auto next_ptr =
-                    std::lower_bound(pos_ptr_, end_ptr_, next_time_, [](uint64_t &ev, const timestamp &val) {
-                        return Event_Type::read_event(&ev).t < val;
-                    });
+            if (!slice.events->empty() && reader_.has_read_callbacks()) {
+                reader_.notify_events_buffer(slice.events->data(), slice.events->data() + slice.events->size());
+            }
 
-                for (; pos_ptr_ < next_ptr; ++pos_ptr_) {
-                    evt_buff.push_back(Event_Type::read_event(pos_ptr_));
-                }
-            } while (pos_ptr_ == end_ptr_);
+            return pos_ < num_events_;
+        }
 
-            if (!evt_buff.empty() && reader_.has_read_callbacks()) {
-                reader_.notify_events_buffer(evt_buff.data(), evt_buff.data() + evt_buff.size());
+        /// @brief Moves the reading position to the first event with a timestamp >= t
+        /// @return Timestamp of that event, or -1 if there is none
+        timestamp seek(timestamp t) {
+            cancel_decode_ahead();
+            pos_ = lower_bound(0, num_events_, t);
+            if (pos_ == num_events_) {
+                return -1;
             }
+            return get_ts(pos_);
+        }
 
-            next_time_ += kTimeStepUs;
+        void set_next_time(timestamp t) {
+            next_time_ = t;
+        }
 
-            return !data_stream_.eof() || pos_ptr_ != end_ptr_;
+        timestamp get_first_evt_ts() const {
+            return num_events_ > 0 ? get_ts(0) : -1;
         }
 
         timestamp get_last_evt_ts() const {
-            std::ifstream data(path_, std::ios::binary);
+            return num_events_ > 0 ? get_ts(num_events_ - 1) : -1;
+        }
 
-            if (!data) {
-                return -1;
-            }
+    private:
+        using BufferPool = SharedObjectPool<std::vector<Event_Type>>;
+        using BufferPtr  = typename BufferPool::ptr_type;
+
+        struct Slice {
+            BufferPtr events;
+            std::size_t end; // index of the record following the slice
+        };
+
+        timestamp get_ts(std::size_t i) const {
+            uint64_t raw;
+            std::memcpy(&raw, data_ + i * kEvtSize, kEvtSize);
+            return Event_Type::read_event(&raw).t;
+        }
 
-            timestamp last_ts = -1;
+        // Index of the first record in [first, last) with a timestamp >= t, or last if there is none
+        std::size_t lower_bound(std::size_t first, std::size_t last, timestamp t) const {
+            std::size_t count = last - first;
+            while (count > 0) {
+                const std::size_t step = count / 2;
+                const std::size_t mid  = first + step;
+                if (get_ts(mid) < t) {
+                    first = mid + 1;
+                    count -= step + 1;
+                } else {
+                    count = step;
+                }
+            }
+            return first;
+        }
 
-            if (data.seekg(-8, std::ios::end)) {
-                uint64_t ev;
-                if (data.read(reinterpret_cast<char *>(&ev), sizeof(ev))) {
-                    last_ts = Event_Type::read_event(&ev).t;
+        // Same as lower_bound(first, num_events_, t), but the searched range is first bracketed by exponentially
+        // growing steps, so that reading a slice only touches the pages close to it
+        std::size_t next_slice_end(std::size_t first, timestamp t) const {
+            std::size_t low = first, step = 1;
+            while (low < num_events_ && get_ts(low) < t) {
+                const std::size_t high = std::min(num_events_, low + step);
+                if (high == num_events_ || get_ts(high - 1) >= t) {
+                    return lower_bound(low, high, t);
                 }
+                low = high;
+                step *= 2;
             }
+            return low;
+        }
 
-            return last_ts;
+        // Decodes the records from first up to the first one with a timestamp >= until
+        Slice decode_slice(std::size_t first, timestamp until) {
+            Slice slice{buffer_pool_.acquire(), next_slice_end(first, until)};
+            auto &events = *slice.events;
+            events.resize(slice.end - first);
+
+            // the records are not aligned in the mapped file, they are copied before being unpacked so that the
+            // compiler can turn the loop into plain loads, shifts and masks
+            const char *src   = data_ + first * kEvtSize;
+            Event_Type *dst   = events.data();
+            const std::size_t n = events.size();
+            for (std::size_t i = 0; i < n; ++i, src += kEvtSize) {
+                uint64_t raw;
+                std::memcpy(&raw, src, kEvtSize);
+                dst[i] = Event_Type::read_event(&raw);
+            }
+            return slice;
         }
 
-    private:
-        static constexpr size_t kEvtChunk      = 512;
-        static constexpr size_t kEvtSize       = sizeof(uint64_t);
-        static constexpr timestamp kTimeStepUs = 1000;
-        timestamp next_time_                   = kTimeStepUs;
+        void start_decode_ahead() {
+            auto promise     = std::make_shared<std::promise<Slice>>();
+            pending_slice_   = promise->get_future();
+            const auto first = pos_;
+            const auto until = next_time_;
+            Executor::get_default().post([this, promise, first, until]() {
+                try {
+                    promise->set_value(decode_slice(first, until));
+                } catch (...) { promise->set_exception(std::current_exception()); }
+            });
+        }
+
+        void cancel_decode_ahead() {
+            if (pending_slice_.valid()) {
+                pending_slice_.wait();
+                pending_slice_ = std::future<Slice>();
+            }
+        }
+
+        static constexpr std::size_t kEvtSize = sizeof(uint64_t);
+        timestamp next_time_                  = kTimeStepUs;
         DATEventFileReader &reader_;
-        std::ifstream data_stream_;
-        uint64_t raw_events_[kEvtChunk];
-        uint64_t *pos_ptr_ = nullptr;
-        uint64_t *end_ptr_ = nullptr;
-        const std::filesystem::path path_;
+        MappedFile file_;
+        const char *data_;
+        const std::size_t num_events_;
+        std::size_t pos_ = 0;
+        const bool decode_ahead_;
+        BufferPool buffer_pool_;
+        std::future<Slice> pending_slice_;
     };
 
     void setup_dat_stream(const std::filesystem::path &path) {
@@ -201,24 +446,28 @@ private:
         if (ev_size != 0x8)
             MV_LOG_ERROR() << "Invalid data size: " << ev_size << std::endl;
 
+        const std::size_t data_offset = static_cast<std::size_t>(data.tellg());
+        data.close();
+
         if (ev_type == get_event_id<EventCD>() || ev_type == get_event_id<Event2d>()) {
-            cd_stream_ = std::make_unique<DATStream<EventCD>>(reader_, std::move(data), path);
+            cd_stream_ = std::make_unique<DATStream<EventCD>>(reader_, MappedFile(path), data_offset, decode_ahead_);
         } else if (ev_type == get_event_id<EventExtTrigger>()) {
-            ext_trig_stream_ = std::make_unique<DATStream<EventExtTrigger>>(reader_, std::move(data), path);
+            ext_trig_stream_ =
+                std::make_unique<DATStream<EventExtTrigger>>(reader_, MappedFile(path), data_offset, decode_ahead_);
         } else {
             MV_LOG_ERROR() << "Invalid event type: " << ev_type << std::endl;
         }
     }
 
-    std::ifstream data_stream_;
     std::unordered_map<std::string, std::string> metadata_;
     DATEventFileReader &reader_;
+    const bool decode_ahead_;
     std::unique_ptr<DATStream<EventCD>> cd_stream_;
     std::unique_ptr<DATStream<EventExtTrigger>> ext_trig_stream_;
 };
 
-DATEventFileReader::DATEventFileReader(const std::filesystem::path &path) :
-    EventFileReader(path), pimpl_(new Private(*this)) {}
+DATEventFileReader::DATEventFileReader(const std::filesystem::path &path, bool decode_ahead) :
+    EventFileReader(path), pimpl_(new Private(*this, decode_ahead)) {}
 
 DATEventFileReader::~DATEventFileReader() {}
 
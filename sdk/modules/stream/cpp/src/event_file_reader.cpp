@@ -18,6 +18,7 @@ EventFileReader::Private::Private(EventFileReader &reader, const std::filesystem
     reader_(reader),
     seeking_(false),
     cd_buffer_cb_mgr_(cb_id_mgr_, CallbackTagIds::READ_CALLBACK_TAG_ID),
+    cd_vector_buffer_cb_mgr_(cb_id_mgr_, CallbackTagIds::READ_CALLBACK_TAG_ID),
     ext_trigger_buffer_cb_mgr_(cb_id_mgr_, CallbackTagIds::READ_CALLBACK_TAG_ID),
     erc_counter_buffer_cb_mgr_(cb_id_mgr_, CallbackTagIds::READ_CALLBACK_TAG_ID),
     monitoring_buffer_cb_mgr_(cb_id_mgr_, CallbackTagIds::READ_CALLBACK_TAG_ID),
@@ -38,6 +39,10 @@ size_t EventFileReader::Private::add_read_callback(const EventsBufferReadCallbac
     return cd_buffer_cb_mgr_.add_callback(cb);
 }
 
+size_t EventFileReader::Private::add_read_callback(const EventsBufferReadCallback<EventCDVector> &cb) {
+    return cd_vector_buffer_cb_mgr_.add_callback(cb);
+}
+
 size_t EventFileReader::Private::add_read_callback(const EventsBufferReadCallback<EventExtTrigger> &cb) {
     return ext_trigger_buffer_cb_mgr_.add_callback(cb);
 }
@@ -69,6 +74,13 @@ void EventFileReader::Private::notify_events_buffer(const EventCD *begin, const
     }
 }
 
+void EventFileReader::Private::notify_events_buffer(const EventCDVector *begin, const EventCDVector *end) {
+    auto cbs = cd_vector_buffer_cb_mgr_.get_cbs();
+    for (auto &cb : cbs) {
+        cb(begin, end);
+    }
+}
+
 void EventFileReader::Private::notify_events_buffer(const EventExtTrigger *begin, const EventExtTrigger *end) {
     auto cbs = ext_trigger_buffer_cb_mgr_.get_cbs();
     for (auto &cb : cbs) {
@@ -130,6 +142,9 @@ void EventFileReader::Private::remove_callback(size_t id) {
     if (cd_buffer_cb_mgr_.remove_callback(id)) {
         return;
     }
+    if (cd_vector_buffer_cb_mgr_.remove_callback(id)) {
+        return;
+    }
     if (ext_trigger_buffer_cb_mgr_.remove_callback(id)) {
         return;
     }
@@ -198,6 +213,10 @@ size_t EventFileReader::add_read_callback(const EventsBufferReadCallback<EventCD
     return pimpl_->add_read_callback(cb);
 }
 
+size_t EventFileReader::add_read_callback(const EventsBufferReadCallback<EventCDVector> &cb) {
+    return pimpl_->add_read_callback(cb);
+}
+
 size_t EventFileReader::add_read_callback(const EventsBufferReadCallback<EventExtTrigger> &cb) {
     return pimpl_->add_read_callback(cb);
 }
@@ -238,6 +257,10 @@ void EventFileReader::notify_events_buffer(const EventCD *begin, const EventCD *
     return pimpl_->notify_events_buffer(begin, end);
 }
 
+void EventFileReader::notify_events_buffer(const EventCDVector *begin, const EventCDVector *end) {
+    return pimpl_->notify_events_buffer(begin, end);
+}
+
 void EventFileReader::notify_events_buffer(const EventExtTrigger *begin, const EventExtTrigger *end) {
     return pimpl_->notify_events_buffer(begin, end);
 }
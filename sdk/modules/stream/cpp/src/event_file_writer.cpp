@@ -13,6 +13,7 @@
 #include <string>
 #include <unordered_map>
 
+#include "metavision/sdk/base/utils/trace_recorder.h"
 #include "metavision/sdk/stream/camera.h"
 #include "metavision/sdk/stream/internal/event_file_writer_internal.h"
 
@@ -59,28 +60,21 @@ bool EventFileWriter::Private::is_open() const {
 void EventFileWriter::Private::flush() {
     std::unique_lock<std::mutex> lock(mutex_);
     if (cd_buffer_ptr_ && !cd_buffer_ptr_->empty()) {
-        std::atomic<bool> done{false};
-        writer_thread_.add_task([&done, this] {
+        writer_thread_.add_task_and_wait([this] {
+            MV_TRACE_SCOPE("EventFileWriter::add_events");
             writer_.add_events_impl(cd_buffer_ptr_->data(), cd_buffer_ptr_->data() + cd_buffer_ptr_->size());
-            done = true;
         });
-        while (!done) {
-            std::this_thread::yield();
-        }
         cd_buffer_ptr_->clear();
     }
     if (ext_trigger_buffer_ptr_ && !ext_trigger_buffer_ptr_->empty()) {
-        std::atomic<bool> done{false};
-        writer_thread_.add_task([&done, this] {
+        writer_thread_.add_task_and_wait([this] {
+            MV_TRACE_SCOPE("EventFileWriter::add_events");
             writer_.add_events_impl(ext_trigger_buffer_ptr_->data(),
                                     ext_trigger_buffer_ptr_->data() + ext_trigger_buffer_ptr_->size());
-            done = true;
         });
-        while (!done) {
-            std::this_thread::yield();
-        }
         ext_trigger_buffer_ptr_->clear();
     }
+    MV_TRACE_SCOPE("EventFileWriter::flush");
     writer_.flush_impl();
 }
 
@@ -106,8 +100,10 @@ bool EventFileWriter::Private::add_events(const EventCD *begin, const EventCD *e
 
     cd_buffer_ptr_->insert(cd_buffer_ptr_->end(), begin, end);
     if (cd_buffer_ptr_->size() > max_event_cd_buffer_size_) {
-        writer_thread_.add_task(
-            [this, buf = cd_buffer_ptr_]() { writer_.add_events_impl(buf->data(), buf->data() + buf->size()); });
+        writer_thread_.add_task([this, buf = cd_buffer_ptr_]() {
+            MV_TRACE_SCOPE("EventFileWriter::add_events");
+            writer_.add_events_impl(buf->data(), buf->data() + buf->size());
+        });
         cd_buffer_ptr_ = cd_buffer_pool_.acquire();
         cd_buffer_ptr_->clear();
     }
@@ -134,6 +130,7 @@ bool EventFileWriter::Private::add_events(const EventExtTrigger *begin, const Ev
     ext_trigger_buffer_ptr_->insert(ext_trigger_buffer_ptr_->end(), begin, end);
     if (ext_trigger_buffer_ptr_->size() > max_event_trigger_buffer_size_) {
         writer_thread_.add_task([this, buf = ext_trigger_buffer_ptr_]() {
+            MV_TRACE_SCOPE("EventFileWriter::add_events");
             writer_.add_events_impl(buf->data(), buf->data() + buf->size());
         });
         ext_trigger_buffer_ptr_ = ext_trigger_buffer_pool_.acquire();
@@ -169,20 +166,15 @@ void EventFileWriter::Private::add_metadata_map_from_camera(const Camera &camera
                            std::to_string(camera.generation().version_minor())},
         {"geometry", std::to_string(width) + "x" + std::to_string(height)}};
 
-    std::atomic<bool> done{false};
-    writer_thread_.add_task([this, metadata_map, &camera, &done] {
+    // we add a task to synchronize accesses to the writer_ on the writer thread, but we actually
+    // don't want the task to be run asynchroneously because the camera (ref) variable will be invalid
+    // outside this scope, so we wait for the task to be completed before exiting the function
+    writer_thread_.add_task_and_wait([this, &metadata_map, &camera] {
         for (auto &p : metadata_map) {
             writer_.add_metadata_impl(p.first, p.second);
         }
         writer_.add_metadata_map_from_camera_impl(camera);
-        done = true;
     });
-    // we add a task to synchronize accesses to the writer_ on the writer thread, but we actually
-    // don't want the task to be run asynchroneously because the camera (ref) variable will be invalid
-    // outside this scope, so we wait for the task to be completed before exiting the function
-    while (!done) {
-        std::this_thread::yield();
-    }
 }
 
 void EventFileWriter::Private::remove_metadata(const std::string &key) {
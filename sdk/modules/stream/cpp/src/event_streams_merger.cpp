@@ -0,0 +1,461 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "metavision/sdk/base/utils/trace_recorder.h"
+#include "metavision/sdk/stream/event_file_writer.h"
+#include "metavision/sdk/stream/event_streams_merger.h"
+
+namespace Metavision {
+
+namespace {
+
+using StreamId = EventStreamsMerger::StreamId;
+
+// Longest time the merging thread sleeps without being notified of new events
+constexpr std::chrono::milliseconds max_idle_duration(100);
+
+// Stream of events, fed by a single producer thread and consumed by the merging thread through a lock-free ring of
+// buffers of events
+class Stream {
+public:
+    Stream(StreamId id, std::size_t capacity) : id_(id), capacity_(capacity) {}
+    virtual ~Stream() = default;
+
+    // Consumer side: checks if an event is available at the head of the queue
+    bool has_head() const {
+        return head_.load(std::memory_order_relaxed) != tail_.load(std::memory_order_acquire);
+    }
+
+    // Consumer side: gets the timestamp of the event at the head of the queue, which must be available
+    virtual timestamp head_ts() const = 0;
+
+    // Consumer side: passes to the callback the events at the head of the queue, which are younger than drop_before
+    // (the older ones are dropped), older than horizon and ordered before the event of timestamp limit_ts in stream
+    // limit_id. Returns the timestamp of the last passed event, or drop_before if none was passed
+    virtual timestamp merge(timestamp horizon, timestamp limit_ts, StreamId limit_id, timestamp drop_before,
+                            uint64_t &num_dropped_events) = 0;
+
+    const StreamId id_;
+    const std::size_t capacity_;
+    // written by the producer only (and when closing the merger, once the producer is done)
+    std::atomic<timestamp> watermark_{std::numeric_limits<timestamp>::min()};
+    std::atomic<bool> closed_{false};
+    // positions in the ring, the head is written by the consumer and the tail by the producer
+    std::atomic<std::size_t> head_{0}, tail_{0};
+};
+
+template<typename Event>
+class TypedStream : public Stream {
+public:
+    using Callback = std::function<void(StreamId, const Event *, const Event *)>;
+
+    TypedStream(StreamId id, std::size_t capacity, const Callback &callback) :
+        Stream(id, capacity), slots_(capacity), callback_(callback) {}
+
+    // Producer side: copies the events in the ring, waiting for a free slot if it is full. The wait function is
+    // called with a predicate checking if a slot is free, it returns false if the wait is aborted
+    template<typename Wait>
+    bool push(const Event *begin, const Event *end, const Wait &wait) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) >= capacity_ &&
+            !wait([this, tail] { return tail - head_.load(std::memory_order_acquire) < capacity_; })) {
+            return false;
+        }
+        slots_[tail % capacity_].assign(begin, end);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    timestamp head_ts() const override {
+        const auto &slot = slots_[head_.load(std::memory_order_relaxed) % capacity_];
+        return slot[pos_].t;
+    }
+
+    timestamp merge(timestamp horizon, timestamp limit_ts, StreamId limit_id, timestamp drop_before,
+                    uint64_t &num_dropped_events) override {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        const auto &slot       = slots_[head % capacity_];
+        const Event *begin = slot.data() + pos_, *end = slot.data() + slot.size();
+        const auto older_than = [](const Event &ev, timestamp ts) { return ev.t < ts; };
+        const auto younger_than = [](timestamp ts, const Event &ev) { return ts < ev.t; };
+
+        // events added after younger events have been merged can only be dropped
+        const Event *first = std::lower_bound(begin, end, drop_before, older_than);
+        num_dropped_events += std::distance(begin, first);
+
+        // events with the same timestamp are merged in the order of their streams
+        const Event *last;
+        if (limit_ts < horizon) {
+            last = id_ < limit_id ? std::upper_bound(first, end, limit_ts, younger_than) :
+                                    std::lower_bound(first, end, limit_ts, older_than);
+        } else {
+            last = std::lower_bound(first, end, horizon, older_than);
+        }
+
+        timestamp last_ts = drop_before;
+        if (first != last) {
+            callback_(id_, first, last);
+            last_ts = std::prev(last)->t;
+        }
+
+        pos_ = std::distance(slot.data(), last);
+        if (pos_ == slot.size()) {
+            pos_ = 0;
+            head_.store(head + 1, std::memory_order_release);
+        }
+        return last_ts;
+    }
+
+    // producer-side timestamp of the last added event
+    timestamp last_added_ts_ = std::numeric_limits<timestamp>::min();
+
+private:
+    std::vector<std::vector<Event>> slots_;
+    std::size_t pos_ = 0; // position of the first unmerged event in the head slot
+    const Callback callback_;
+};
+
+} // namespace
+
+class EventStreamsMerger::Private {
+public:
+    Private(const EventsCDCallback &cd_callback, const EventsExtTriggerCallback &ext_trigger_callback,
+            timestamp max_latency, std::size_t queue_capacity) :
+        cd_callback_(cd_callback),
+        ext_trigger_callback_(ext_trigger_callback),
+        max_latency_(max_latency),
+        queue_capacity_(std::max<std::size_t>(queue_capacity, 1)) {}
+
+    ~Private() {
+        close(false);
+    }
+
+    template<typename Event, typename Callback>
+    StreamId add_stream(const Callback &callback) {
+        if (started_) {
+            throw std::runtime_error("Unable to add a stream to an already started merger");
+        }
+        const StreamId id = streams_.size();
+        streams_.push_back(std::make_unique<TypedStream<Event>>(id, queue_capacity_, callback));
+        return id;
+    }
+
+    void start() {
+        if (started_ || stop_) {
+            return;
+        }
+        started_ = true;
+        thread_  = std::thread([this] { run(); });
+    }
+
+    template<typename Event>
+    bool add_events(StreamId stream_id, const Event *begin, const Event *end) {
+        auto &stream = get_typed_stream<Event>(stream_id);
+        if (!started_ || stop_ || failed_ || stream.closed_) {
+            return false;
+        }
+        if (begin == end) {
+            return false;
+        }
+        if (std::prev(end)->t < begin->t) {
+            throw std::runtime_error("Invalid event buffer, the events are not chronologically ordered");
+        }
+        if (begin->t < stream.last_added_ts_ || begin->t < stream.watermark_.load(std::memory_order_relaxed)) {
+            throw std::runtime_error("Invalid event buffer, the events are older than the watermark of the stream");
+        }
+        const auto wait_for_free_slot = [this](const auto &slot_is_free) {
+            wake_up();
+            return wait_for_progress([&] { return slot_is_free() || stop_; }) && slot_is_free();
+        };
+        if (!stream.push(begin, end, wait_for_free_slot)) {
+            return false;
+        }
+        stream.last_added_ts_ = std::prev(end)->t;
+        if (stream.last_added_ts_ > stream.watermark_.load(std::memory_order_relaxed)) {
+            stream.watermark_.store(stream.last_added_ts_, std::memory_order_release);
+        }
+        notify_update();
+        return true;
+    }
+
+    void set_watermark(StreamId stream_id, timestamp ts) {
+        raise_watermark(get_stream(stream_id), ts);
+    }
+
+    void close_stream(StreamId stream_id) {
+        auto &stream   = get_stream(stream_id);
+        stream.closed_ = true;
+        raise_watermark(stream, std::numeric_limits<timestamp>::max());
+    }
+
+    void flush() {
+        if (!started_ || !thread_.joinable()) {
+            return;
+        }
+        const uint64_t version = version_.load();
+        wake_up();
+        if (!wait_for_progress([&] { return merged_version_.load() >= version; })) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+    void close(bool rethrow = true) {
+        if (!thread_.joinable()) {
+            stop_ = true;
+            return;
+        }
+        for (const auto &stream : streams_) {
+            stream->closed_ = true;
+            raise_watermark(*stream, std::numeric_limits<timestamp>::max());
+        }
+        stop_ = true;
+        wake_up();
+        notify_progress();
+        thread_.join();
+        if (rethrow && failed_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+    // Waits until the predicate is true, or the merging thread fails. Returns false in the latter case
+    template<typename Predicate>
+    bool wait_for_progress(const Predicate &predicate) {
+        std::unique_lock<std::mutex> lock(progress_mutex_);
+        ++num_progress_waiters_;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        progress_cond_.wait(lock, [&] { return failed_.load() || predicate(); });
+        --num_progress_waiters_;
+        return !failed_.load();
+    }
+
+    // Wakes up the threads waiting for free slots or for the events to be merged
+    void notify_progress() {
+        // pairs with the increment of the number of waiters, before they check their predicate
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (num_progress_waiters_.load() > 0) {
+            std::lock_guard<std::mutex> lock(progress_mutex_);
+            progress_cond_.notify_all();
+        }
+    }
+
+    Stream &get_stream(StreamId stream_id) {
+        if (stream_id >= streams_.size()) {
+            throw std::runtime_error("Invalid stream id " + std::to_string(stream_id));
+        }
+        return *streams_[stream_id];
+    }
+
+    template<typename Event>
+    TypedStream<Event> &get_typed_stream(StreamId stream_id) {
+        auto *stream = dynamic_cast<TypedStream<Event> *>(&get_stream(stream_id));
+        if (!stream) {
+            throw std::runtime_error("Invalid event type for stream " + std::to_string(stream_id));
+        }
+        return *stream;
+    }
+
+    void raise_watermark(Stream &stream, timestamp ts) {
+        if (ts > stream.watermark_.load(std::memory_order_relaxed)) {
+            stream.watermark_.store(ts, std::memory_order_release);
+            notify_update();
+        }
+    }
+
+    void notify_update() {
+        version_.fetch_add(1);
+        if (sleeping_.load()) {
+            wake_up();
+        }
+    }
+
+    void wake_up() {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        wake_cond_.notify_one();
+    }
+
+    void run() {
+        while (true) {
+            const bool stopping    = stop_.load();
+            const uint64_t version = version_.load();
+            try {
+                merge();
+            } catch (...) {
+                // the merging stops, the error is rethrown to the threads flushing or closing the merger
+                error_  = std::current_exception();
+                failed_ = true;
+                std::lock_guard<std::mutex> lock(progress_mutex_);
+                progress_cond_.notify_all();
+                break;
+            }
+            merged_version_.store(version);
+            notify_progress();
+            if (stopping) {
+                break;
+            }
+
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            sleeping_ = true;
+            if (version_.load() == version && !stop_) {
+                wake_cond_.wait_for(lock, max_idle_duration);
+            }
+            sleeping_ = false;
+        }
+    }
+
+    // Merges the queued events of all the streams, up to the smallest watermark
+    void merge() {
+        // the watermarks are read before the queues, so that all the events older than them are available
+        timestamp horizon = std::numeric_limits<timestamp>::max(), most_advanced = std::numeric_limits<timestamp>::min();
+        for (const auto &stream : streams_) {
+            const timestamp watermark = stream->watermark_.load(std::memory_order_acquire);
+            horizon                   = std::min(horizon, watermark);
+            if (!stream->closed_) {
+                most_advanced = std::max(most_advanced, watermark);
+            }
+        }
+        if (max_latency_ != std::numeric_limits<timestamp>::max() &&
+            most_advanced > std::numeric_limits<timestamp>::min() + max_latency_) {
+            horizon = std::max(horizon, most_advanced - max_latency_);
+        }
+
+        using Head = std::pair<timestamp, StreamId>;
+        std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+        for (const auto &stream : streams_) {
+            if (stream->has_head() && stream->head_ts() < horizon) {
+                heads.emplace(stream->head_ts(), stream->id_);
+            }
+        }
+        if (heads.empty()) {
+            return;
+        }
+
+        MV_TRACE_SCOPE("EventStreamsMerger::merge");
+        uint64_t num_dropped_events = 0;
+        while (!heads.empty()) {
+            auto &stream = *streams_[heads.top().second];
+            heads.pop();
+            // the events of the stream are merged up to the next event of the other streams
+            const Head limit = heads.empty() ? Head(std::numeric_limits<timestamp>::max(), streams_.size()) :
+                                               heads.top();
+            last_merged_ts_ = stream.merge(horizon, limit.first, limit.second, last_merged_ts_, num_dropped_events);
+            if (stream.has_head() && stream.head_ts() < horizon) {
+                heads.emplace(stream.head_ts(), stream.id_);
+            }
+        }
+        if (num_dropped_events > 0) {
+            num_dropped_events_ += num_dropped_events;
+            MV_TRACE_COUNTER("EventStreamsMerger dropped events", num_dropped_events_.load());
+        }
+    }
+
+    const EventsCDCallback cd_callback_;
+    const EventsExtTriggerCallback ext_trigger_callback_;
+    const timestamp max_latency_;
+    const std::size_t queue_capacity_;
+    std::vector<std::unique_ptr<Stream>> streams_;
+
+    std::atomic<bool> started_{false}, stop_{false}, failed_{false};
+    // incremented each time events are added or a watermark is raised, to detect new events to merge
+    std::atomic<uint64_t> version_{0}, merged_version_{0};
+    std::atomic<uint64_t> num_dropped_events_{0};
+    timestamp last_merged_ts_ = std::numeric_limits<timestamp>::min();
+
+    // only used to put the merging thread to sleep when there is nothing to merge
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cond_;
+    std::atomic<bool> sleeping_{false};
+    std::thread thread_;
+
+    // used by the threads waiting for a free slot in the queue of a stream or for the events to be merged, notified
+    // by the merging thread when it has consumed events
+    std::mutex progress_mutex_;
+    std::condition_variable progress_cond_;
+    std::atomic<int> num_progress_waiters_{0};
+    // exception thrown by a merge callback, set before failed_
+    std::exception_ptr error_;
+};
+
+EventStreamsMerger::EventStreamsMerger(const EventsCDCallback &cd_callback,
+                                       const EventsExtTriggerCallback &ext_trigger_callback, timestamp max_latency,
+                                       std::size_t queue_capacity) :
+    pimpl_(new Private(cd_callback, ext_trigger_callback, max_latency, queue_capacity)) {}
+
+EventStreamsMerger::EventStreamsMerger(EventFileWriter &writer, timestamp max_latency, std::size_t queue_capacity) :
+    EventStreamsMerger([&writer](StreamId, const EventCD *begin, const EventCD *end) { writer.add_events(begin, end); },
+                       [&writer](StreamId, const EventExtTrigger *begin, const EventExtTrigger *end) {
+                           writer.add_events(begin, end);
+                       },
+                       max_latency, queue_capacity) {}
+
+EventStreamsMerger::~EventStreamsMerger() {}
+
+EventStreamsMerger::StreamId EventStreamsMerger::add_cd_stream() {
+    return pimpl_->add_stream<EventCD>(pimpl_->cd_callback_);
+}
+
+EventStreamsMerger::StreamId EventStreamsMerger::add_ext_trigger_stream() {
+    return pimpl_->add_stream<EventExtTrigger>(pimpl_->ext_trigger_callback_);
+}
+
+std::size_t EventStreamsMerger::get_num_streams() const {
+    return pimpl_->streams_.size();
+}
+
+void EventStreamsMerger::start() {
+    pimpl_->start();
+}
+
+bool EventStreamsMerger::add_events(StreamId stream_id, const EventCD *begin, const EventCD *end) {
+    return pimpl_->add_events(stream_id, begin, end);
+}
+
+bool EventStreamsMerger::add_events(StreamId stream_id, const EventExtTrigger *begin, const EventExtTrigger *end) {
+    return pimpl_->add_events(stream_id, begin, end);
+}
+
+void EventStreamsMerger::set_watermark(StreamId stream_id, timestamp ts) {
+    pimpl_->set_watermark(stream_id, ts);
+}
+
+void EventStreamsMerger::close_stream(StreamId stream_id) {
+    pimpl_->close_stream(stream_id);
+}
+
+void EventStreamsMerger::flush() {
+    pimpl_->flush();
+}
+
+void EventStreamsMerger::close() {
+    pimpl_->close();
+}
+
+uint64_t EventStreamsMerger::get_num_dropped_events() const {
+    return pimpl_->num_dropped_events_;
+}
+
+} // namespace Metavision
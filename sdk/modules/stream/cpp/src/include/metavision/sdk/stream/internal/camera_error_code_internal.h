@@ -45,6 +45,7 @@ enum : CameraErrorCodeType {
     FrameDiffUnavailable               = CameraErrorCode::UnsupportedFeature | 0x18,
     SerializationUnsupported           = CameraErrorCode::UnsupportedFeature | 0x19,
     MonitoringUnavailable              = CameraErrorCode::UnsupportedFeature | 0x20,
+    CDVectorUnavailable                = CameraErrorCode::UnsupportedFeature | 0x21,
 };
 }
 
@@ -54,6 +54,7 @@ public:
     bool stop_recording(const std::filesystem::path &file_path = std::filesystem::path());
 
     CD &cd();
+    CDVector &cd_vector();
     ExtTrigger &ext_trigger();
     RawData &raw_data();
     ERCCounter &erc_counter();
@@ -67,9 +68,21 @@ public:
     virtual OfflineStreamingControl &offline_streaming_control();
 
     virtual timestamp get_last_timestamp() const;
+
+    void enable_latency_statistics(bool enable);
+    bool is_latency_statistics_enabled() const;
+    CameraLatencyStatistics get_latency_statistics() const;
+    void reset_latency_statistics();
+
+    void set_overload_policy(const CameraOverloadPolicy &policy);
+    CameraOverloadPolicy get_overload_policy() const;
+    CameraOverloadStatistics get_overload_statistics() const;
+    void reset_overload_statistics();
+
     virtual void start_impl();
     virtual void stop_impl();
     virtual bool process_impl();
+    virtual void apply_overload_policy(const CameraOverloadPolicy &policy);
     virtual bool start_recording_impl(const std::filesystem::path &file_path);
     virtual bool stop_recording_impl(const std::filesystem::path &file_path);
     virtual I_Geometry &get_geometry();
@@ -91,6 +104,14 @@ public:
     std::unordered_map<std::string, std::string> metadata_map_;
     TimingProfilerPair<> timing_profiler_tuple_;
 
+    std::atomic<bool> latency_statistics_enabled_{false};
+    mutable std::mutex latency_statistics_mutex_;
+    CameraLatencyStatistics latency_statistics_;
+
+    mutable std::mutex overload_mutex_;
+    CameraOverloadPolicy overload_policy_;
+    CameraOverloadStatistics overload_statistics_;
+
     bool is_init_ = false;
     std::atomic<bool> is_running_{false};
 
@@ -103,6 +124,7 @@ public:
 
     IndexManager index_manager_;
     std::unique_ptr<CD> cd_;
+    std::unique_ptr<CDVector> cd_vector_;
     std::unique_ptr<ExtTrigger> ext_trigger_;
     std::unique_ptr<ERCCounter> erc_counter_;
     std::unique_ptr<FrameHisto> frame_histo_;
@@ -12,7 +12,13 @@
 #ifndef METAVISION_SDK_STREAM_CAMERA_LIVE_INTERNAL_H
 #define METAVISION_SDK_STREAM_CAMERA_LIVE_INTERNAL_H
 
+#include <chrono>
+#include <cstdint>
 #include <filesystem>
+#include <vector>
+
+#include "metavision/hal/facilities/i_events_stream.h"
+#include "metavision/sdk/base/events/event_cd.h"
 
 #include "metavision/sdk/stream/internal/camera_internal.h"
 
@@ -22,7 +28,6 @@ class Device;
 class I_CameraSynchronization;
 class I_Decoder;
 class I_EventsStreamDecoder;
-class I_EventsStream;
 
 namespace detail {
 
@@ -48,6 +53,16 @@ private:
     template<typename TimingProfilerType>
     bool process_impl(TimingProfilerType *);
 
+    template<typename Dispatcher>
+    void dispatch_callbacks(const Dispatcher &dispatcher);
+    void trace_event_rate();
+    void update_shedding_state();
+    void record_overload_statistics();
+    void apply_overload_policy(const CameraOverloadPolicy &policy) override;
+    void record_latency_statistics(const std::chrono::steady_clock::time_point &decode_start,
+                                   const std::chrono::steady_clock::time_point &decode_end,
+                                   const std::chrono::steady_clock::duration &decode_duration, bool decoded);
+
     bool start_recording_impl(const std::filesystem::path &file_path) override;
 
     void save(std::ostream &) const override;
@@ -57,6 +72,25 @@ private:
     I_EventsStream *i_events_stream_                   = nullptr;
     I_EventsStreamDecoder *i_events_stream_decoder_    = nullptr;
     I_Decoder *i_decoder_                              = nullptr;
+
+    // latency statistics state, only accessed from the processing thread
+    bool measure_latency_                                   = false;
+    std::chrono::steady_clock::duration callbacks_duration_ = std::chrono::steady_clock::duration::zero();
+    bool has_min_event_clock_offset_                        = false;
+    std::int64_t min_event_clock_offset_us_                 = 0;
+
+    // overload state, only accessed from the processing thread
+    CameraOverloadPolicy active_overload_policy_;
+    std::vector<EventCD> kept_cd_events_;
+    I_EventsStream::DroppedData last_dropped_data_;
+    std::chrono::steady_clock::time_point dropped_events_window_start_;
+    bool shedding_                          = false;
+    std::uint64_t shed_cd_events_count_     = 0;
+    std::uint64_t dropped_events_in_window_ = 0;
+
+    // tracing state, only accessed from the processing thread
+    std::int64_t traced_cd_events_count_ = 0;
+    std::chrono::steady_clock::time_point traced_cd_events_rate_start_;
 };
 
 } // namespace detail
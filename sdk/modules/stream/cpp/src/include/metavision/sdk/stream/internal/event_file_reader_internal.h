@@ -31,6 +31,7 @@ public:
     const std::filesystem::path &get_path() const;
 
     size_t add_read_callback(const EventsBufferReadCallback<EventCD> &cb);
+    size_t add_read_callback(const EventsBufferReadCallback<EventCDVector> &cb);
     size_t add_read_callback(const EventsBufferReadCallback<EventExtTrigger> &cb);
     size_t add_read_callback(const EventsBufferReadCallback<EventERCCounter> &cb);
     size_t add_read_callback(const EventsBufferReadCallback<EventMonitoring> &cb);
@@ -45,6 +46,7 @@ public:
     void remove_callback(size_t id);
 
     void notify_events_buffer(const EventCD *begin, const EventCD *end);
+    void notify_events_buffer(const EventCDVector *begin, const EventCDVector *end);
     void notify_events_buffer(const EventExtTrigger *begin, const EventExtTrigger *end);
     void notify_events_buffer(const EventERCCounter *begin, const EventERCCounter *end);
     void notify_events_buffer(const EventMonitoring *begin, const EventMonitoring *end);
@@ -66,6 +68,7 @@ public:
     mutable std::condition_variable cond_;
     IndexManager cb_id_mgr_;
     CallbackManager<EventsBufferReadCallback<EventCD>, size_t> cd_buffer_cb_mgr_;
+    CallbackManager<EventsBufferReadCallback<EventCDVector>, size_t> cd_vector_buffer_cb_mgr_;
     CallbackManager<EventsBufferReadCallback<EventExtTrigger>, size_t> ext_trigger_buffer_cb_mgr_;
     CallbackManager<EventsBufferReadCallback<EventERCCounter>, size_t> erc_counter_buffer_cb_mgr_;
     CallbackManager<EventsBufferReadCallback<EventMonitoring>, size_t> monitoring_buffer_cb_mgr_;
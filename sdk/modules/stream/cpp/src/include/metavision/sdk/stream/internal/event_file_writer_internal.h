@@ -15,6 +15,7 @@
 #include <filesystem>
 #include <mutex>
 #include "metavision/sdk/base/utils/object_pool.h"
+#include "metavision/sdk/core/utils/executor.h"
 #include "metavision/sdk/core/utils/threaded_process.h"
 #include "metavision/sdk/stream/event_file_writer.h"
 
@@ -56,7 +57,9 @@ public:
     EventCDBufferPtr cd_buffer_ptr_;
     EventExtTriggerBufferPool ext_trigger_buffer_pool_;
     EventExtTriggerBufferPtr ext_trigger_buffer_ptr_;
-    ThreadedProcess writer_thread_;
+    // The writing blocks on disk I/O, so it is run by a worker of its own rather than by the default executor
+    Executor writer_executor_{1};
+    ThreadedProcess writer_thread_{writer_executor_};
 };
 
 } // namespace Metavision
@@ -0,0 +1,241 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <limits>
+#include <mutex>
+
+#include "metavision/sdk/core/utils/executor.h"
+#include "metavision/sdk/stream/camera_error_code.h"
+#include "metavision/sdk/stream/camera_exception.h"
+#include "metavision/sdk/stream/parallel_raw_file_decoder.h"
+#include "metavision/sdk/stream/raw_range_reader.h"
+
+namespace Metavision {
+
+namespace {
+
+timestamp checked_range_duration(timestamp range_duration_us) {
+    if (range_duration_us <= 0) {
+        throw CameraException(CameraErrorCode::InvalidArgument, "The duration of the decoded ranges must be positive.");
+    }
+    return range_duration_us;
+}
+
+} // namespace
+
+class ParallelRawFileDecoder::Private {
+public:
+    Private(const std::filesystem::path &raw_file_path, timestamp range_duration_us, std::size_t num_workers) :
+        range_duration_us_(checked_range_duration(range_duration_us)),
+        reader_(raw_file_path),
+        executor_(num_workers) {
+        timestamp last_bookmark_ts;
+        reader_.get_range(start_ts_, last_bookmark_ts);
+        // the last range starts before the last bookmark and extends to the end of the file
+        num_ranges_ = static_cast<std::size_t>((last_bookmark_ts - start_ts_) / range_duration_us_) + 1;
+    }
+
+    std::size_t get_num_workers() const {
+        return executor_.get_num_workers();
+    }
+
+    std::size_t get_num_ranges() const {
+        return num_ranges_;
+    }
+
+    void decode(const EventsCDCallback &cd_callback, const EventsExtTriggerCallback &ext_trigger_callback) {
+        // the ranges are decoded in a sliding window of slots, where the slot of a range is reused by the range
+        // decoded window ranges later, once the former has been delivered
+        struct Slot {
+            Range range;
+            bool ready = false;
+            std::exception_ptr error;
+        };
+        const std::size_t window = std::min(num_ranges_, 2 * executor_.get_num_workers());
+        std::vector<Slot> slots(window);
+        TaskTracker tracker;
+
+        auto post_range = [&](std::size_t index) {
+            auto &slot = slots[index % window];
+            init_range(slot.range, index);
+            slot.ready = false;
+            slot.error = nullptr;
+            tracker.add();
+            executor_.post([this, &slot, &tracker]() {
+                std::exception_ptr error;
+                if (!tracker.aborted()) {
+                    try {
+                        read_range(slot.range);
+                    } catch (...) { error = std::current_exception(); }
+                }
+                tracker.done([&]() {
+                    slot.error = error;
+                    slot.ready = true;
+                });
+            });
+        };
+
+        for (std::size_t index = 0; index < window; ++index) {
+            post_range(index);
+        }
+        for (std::size_t index = 0; index < num_ranges_; ++index) {
+            auto &slot = slots[index % window];
+            tracker.wait_until([&slot]() { return slot.ready; });
+            if (slot.error) {
+                std::rethrow_exception(slot.error);
+            }
+
+            auto &range = slot.range;
+            if (cd_callback && !range.cd_events.empty()) {
+                cd_callback(range.cd_events.data(), range.cd_events.data() + range.cd_events.size());
+            }
+            if (ext_trigger_callback && !range.ext_trigger_events.empty()) {
+                ext_trigger_callback(range.ext_trigger_events.data(),
+                                     range.ext_trigger_events.data() + range.ext_trigger_events.size());
+            }
+
+            if (index + window < num_ranges_) {
+                post_range(index + window);
+            }
+        }
+    }
+
+    void process_ranges(const RangeCallback &range_callback) {
+        // each worker processes ranges until all of them are taken, reusing the memory of its range
+        std::atomic<std::size_t> next_index{0};
+        std::exception_ptr first_error;
+        TaskTracker tracker;
+
+        const std::size_t num_tasks = std::min(num_ranges_, executor_.get_num_workers());
+        for (std::size_t i = 0; i < num_tasks; ++i) {
+            tracker.add();
+            executor_.post([this, &range_callback, &next_index, &first_error, &tracker]() {
+                std::exception_ptr error;
+                try {
+                    Range range;
+                    std::size_t index;
+                    while (!tracker.aborted() && (index = next_index++) < num_ranges_) {
+                        init_range(range, index);
+                        read_range(range);
+                        range_callback(range);
+                    }
+                } catch (...) {
+                    error = std::current_exception();
+                    tracker.abort();
+                }
+                tracker.done([&]() {
+                    if (error && !first_error) {
+                        first_error = error;
+                    }
+                });
+            });
+        }
+        tracker.wait_until([]() { return false; });
+        if (first_error) {
+            std::rethrow_exception(first_error);
+        }
+    }
+
+private:
+    // Keeps track of the tasks posted to the executor, which reference the state of the calling function: the tracker
+    // waits for all of them to be done before being destroyed
+    class TaskTracker {
+    public:
+        ~TaskTracker() {
+            abort();
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_.wait(lock, [this]() { return num_tasks_ == 0; });
+        }
+
+        void add() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++num_tasks_;
+        }
+
+        // Marks a task as done, after having run the given function with the lock held
+        template<typename Function>
+        void done(const Function &function) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            function();
+            --num_tasks_;
+            // notified under the lock, as the waiting thread may destroy the tracker as soon as it is woken up
+            cond_.notify_all();
+        }
+
+        // Waits until the predicate is true, or until all the tasks are done
+        template<typename Predicate>
+        void wait_until(const Predicate &predicate) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_.wait(lock, [this, &predicate]() { return predicate() || num_tasks_ == 0; });
+        }
+
+        void abort() {
+            aborted_ = true;
+        }
+
+        bool aborted() const {
+            return aborted_;
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable cond_;
+        std::size_t num_tasks_ = 0;
+        std::atomic<bool> aborted_{false};
+    };
+
+    void init_range(Range &range, std::size_t index) const {
+        range.index    = index;
+        range.start_ts = start_ts_ + static_cast<timestamp>(index) * range_duration_us_;
+        range.end_ts   = index + 1 < num_ranges_ ? range.start_ts + range_duration_us_ :
+                                                   std::numeric_limits<timestamp>::max();
+    }
+
+    void read_range(Range &range) {
+        reader_.read(range.start_ts, range.end_ts, range.cd_events, range.ext_trigger_events);
+    }
+
+    const timestamp range_duration_us_;
+    RawRangeReader reader_;
+    timestamp start_ts_     = 0;
+    std::size_t num_ranges_ = 0;
+    // declared last, so that the workers are joined before the other members are destroyed
+    Executor executor_;
+};
+
+ParallelRawFileDecoder::ParallelRawFileDecoder(const std::filesystem::path &raw_file_path,
+                                               timestamp range_duration_us, std::size_t num_workers) :
+    pimpl_(std::make_unique<Private>(raw_file_path, range_duration_us, num_workers)) {}
+
+ParallelRawFileDecoder::~ParallelRawFileDecoder() = default;
+
+std::size_t ParallelRawFileDecoder::get_num_workers() const {
+    return pimpl_->get_num_workers();
+}
+
+std::size_t ParallelRawFileDecoder::get_num_ranges() const {
+    return pimpl_->get_num_ranges();
+}
+
+void ParallelRawFileDecoder::decode(const EventsCDCallback &cd_callback,
+                                    const EventsExtTriggerCallback &ext_trigger_callback) {
+    pimpl_->decode(cd_callback, ext_trigger_callback);
+}
+
+void ParallelRawFileDecoder::process_ranges(const RangeCallback &range_callback) {
+    pimpl_->process_ranges(range_callback);
+}
+
+} // namespace Metavision
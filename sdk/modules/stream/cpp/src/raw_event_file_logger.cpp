@@ -18,6 +18,7 @@
 
 #include "metavision/hal/facilities/i_hw_identification.h"
 #include "metavision/hal/utils/raw_file_header.h"
+#include "metavision/hal/utils/raw_index_trailer.h"
 #include "metavision/sdk/stream/camera.h"
 #include "metavision/sdk/stream/internal/event_file_writer_internal.h"
 #include "metavision/sdk/stream/raw_event_file_logger.h"
@@ -47,6 +48,7 @@ public:
             throw std::runtime_error("Unable to open " + path.string() + " for writing");
         }
         raw_data_buffer_ptr_ = raw_data_buffer_pool_.acquire();
+        index_trailer_writer_.reset();
     }
 
     void close_impl() {
@@ -54,6 +56,11 @@ public:
             ofs_ << header_;
             header_written_ = true;
         }
+        if (index_trailer_writer_) {
+            // makes the file seekable right away, without building its index
+            index_trailer_writer_->write(ofs_);
+            index_trailer_writer_.reset();
+        }
         ofs_.close();
     }
 
@@ -111,8 +118,15 @@ public:
         if (!header_written_) {
             ofs_ << header_;
             header_written_ = true;
+            index_trailer_writer_ = std::make_unique<RawIndexTrailerWriter>(header_, ofs_.tellp());
+            if (!index_trailer_writer_->is_supported()) {
+                index_trailer_writer_.reset();
+            }
         }
         ofs_.write(reinterpret_cast<const char *>(ptr), size);
+        if (index_trailer_writer_) {
+            index_trailer_writer_->add_data(ptr, ptr + size);
+        }
     }
 
     bool add_raw_data(const std::uint8_t *ptr, size_t size) {
@@ -136,6 +150,7 @@ public:
     RawFileHeader header_;
     std::ofstream ofs_;
     bool header_written_;
+    std::unique_ptr<RawIndexTrailerWriter> index_trailer_writer_;
 
     static constexpr size_t kMaxRawDataBufferSize = 1048576;
     using RawDataBufferPool                       = SharedObjectPool<std::vector<std::uint8_t>>;
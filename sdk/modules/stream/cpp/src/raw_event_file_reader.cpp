@@ -34,6 +34,14 @@ public:
                 [this](const EventCD *begin, const EventCD *end) { reader_.notify_events_buffer(begin, end); });
         }
 
+        I_EventDecoder<EventCDVector> *i_cd_vector_events_decoder = device.get_facility<I_EventDecoder<EventCDVector>>();
+        if (i_cd_vector_events_decoder) {
+            i_cd_vector_events_decoder->add_event_buffer_callback(
+                [this](const EventCDVector *begin, const EventCDVector *end) {
+                    reader_.notify_events_buffer(begin, end);
+                });
+        }
+
         I_EventDecoder<EventExtTrigger> *i_ext_trigger_events_decoder =
             device.get_facility<I_EventDecoder<EventExtTrigger>>();
         if (i_ext_trigger_events_decoder) {
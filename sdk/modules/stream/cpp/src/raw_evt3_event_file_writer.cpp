@@ -0,0 +1,50 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <memory>
+
+#include "metavision/hal/decoders/evt3/evt3_encoder.h"
+#include "metavision/sdk/stream/raw_evt3_event_file_writer.h"
+
+namespace Metavision {
+
+namespace {
+
+class RAWEvt3Encoder : public RAWEventFileWriter::Encoder {
+public:
+    explicit RAWEvt3Encoder(int stream_width) : encoder_(stream_width) {}
+
+    void encode_event_cd(std::ofstream &ofs, const EventCD &ev) override {
+        encoder_.encode_event_cd(ofs, ev);
+    }
+
+    void encode_event_trigger(std::ofstream &ofs, const EventExtTrigger &ev) override {
+        encoder_.encode_event_trigger(ofs, ev);
+    }
+
+    void flush(std::ofstream &ofs) override {
+        encoder_.flush(ofs);
+    }
+
+private:
+    Evt3Encoder encoder_;
+};
+
+} // namespace
+
+RAWEvt3EventFileWriter::RAWEvt3EventFileWriter(int stream_width, int stream_height, const std::filesystem::path &path,
+                                               bool enable_trigger_support,
+                                               const std::unordered_map<std::string, std::string> &metadata_map,
+                                               timestamp max_events_add_latency) :
+    RAWEventFileWriter("EVT3", stream_width, stream_height, path, enable_trigger_support, metadata_map,
+                       max_events_add_latency, std::make_unique<RAWEvt3Encoder>(stream_width)) {}
+
+} // namespace Metavision
@@ -0,0 +1,302 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "metavision/hal/device/device.h"
+#include "metavision/hal/device/device_discovery.h"
+#include "metavision/hal/facilities/i_event_decoder.h"
+#include "metavision/hal/facilities/i_events_stream.h"
+#include "metavision/hal/facilities/i_events_stream_decoder.h"
+#include "metavision/hal/utils/raw_file_config.h"
+#include "metavision/hal/utils/raw_index_trailer.h"
+#include "metavision/sdk/stream/camera_error_code.h"
+#include "metavision/sdk/stream/camera_exception.h"
+#include "metavision/sdk/stream/raw_range_reader.h"
+
+namespace Metavision {
+
+namespace {
+
+// Number of bytes read at once from the file, a multiple of the size of the RAW events of all formats
+constexpr std::size_t read_buffer_size = 1 << 18;
+
+template<typename Event>
+void append_events_in_range(const Event *begin, const Event *end, timestamp start_ts, timestamp end_ts,
+                            std::vector<Event> *events) {
+    if (events) {
+        std::copy_if(begin, end, std::back_inserter(*events),
+                     [start_ts, end_ts](const Event &ev) { return ev.t >= start_ts && ev.t < end_ts; });
+    }
+}
+
+} // namespace
+
+class RawRangeReader::Private {
+public:
+    Private(const std::filesystem::path &raw_file_path) : raw_file_path_(raw_file_path) {
+        RawFileConfig config;
+        config.build_index_ = true;
+        index_device_       = DeviceDiscovery::open_raw_file(raw_file_path, config);
+        if (!index_device_) {
+            throw CameraException(CameraErrorCode::InvalidRawfile,
+                                  "The RAW file at " + raw_file_path.string() + " could not be read.");
+        }
+
+        events_stream_ = index_device_->get_facility<I_EventsStream>();
+        auto *decoder  = index_device_->get_facility<I_EventsStreamDecoder>();
+        if (!events_stream_ || !decoder) {
+            throw CameraException(CameraErrorCode::UnsupportedFeature,
+                                  "The RAW file at " + raw_file_path.string() + " can not be decoded.");
+        }
+
+        auto index_status = events_stream_->get_seek_range(start_ts_, end_ts_);
+        while (index_status == I_EventsStream::IndexStatus::Building) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            index_status = events_stream_->get_seek_range(start_ts_, end_ts_);
+        }
+        if (index_status != I_EventsStream::IndexStatus::Good) {
+            throw CameraException(CameraErrorCode::InvalidRawfile,
+                                  "The RAW file at " + raw_file_path.string() + " could not be indexed.");
+        }
+
+        // the ranges are read by other decoders, which must shift the timestamps like the indexed one
+        if (!decoder->get_timestamp_shift(ts_shift_)) {
+            throw CameraException(CameraErrorCode::InvalidRawfile,
+                                  "The timestamp shift of the RAW file at " + raw_file_path.string() +
+                                      " could not be found.");
+        }
+        raw_event_size_ = decoder->get_raw_event_size_bytes();
+        data_end_       = std::filesystem::file_size(raw_file_path);
+        {
+            std::ifstream raw_file(raw_file_path, std::ios::binary);
+            RawIndexTrailer trailer;
+            if (read_raw_index_trailer(raw_file, trailer, false)) {
+                data_end_ = trailer.data_end_pos_;
+            }
+        }
+
+#ifndef _WIN32
+        fd_ = ::open(raw_file_path.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            throw CameraException(CameraErrorCode::CouldNotOpenFile,
+                                  "Could not open the RAW file at " + raw_file_path.string());
+        }
+#endif
+    }
+
+    ~Private() {
+#ifndef _WIN32
+        ::close(fd_);
+#endif
+    }
+
+    void get_range(timestamp &start_ts, timestamp &end_ts) const {
+        start_ts = start_ts_;
+        end_ts   = end_ts_;
+    }
+
+    void read(timestamp start_ts, timestamp end_ts, std::vector<EventCD> &cd_events,
+              std::vector<EventExtTrigger> *ext_trigger_events) {
+        cd_events.clear();
+        if (ext_trigger_events) {
+            ext_trigger_events->clear();
+        }
+
+        start_ts = std::max(start_ts, start_ts_);
+        if (start_ts >= end_ts) {
+            return;
+        }
+
+        // the events after the last bookmark are reached from it
+        I_EventsStream::Bookmark bookmark;
+        const timestamp bookmark_ts = std::min(start_ts, end_ts_);
+        if (events_stream_->get_bookmark(bookmark_ts, bookmark) != I_EventsStream::SeekStatus::Success) {
+            return;
+        }
+        // decoding starts from the previous bookmark, so that the state of the decoder that is not reset with the time
+        // base (e.g. the row address in EVT3) is known when reaching the first events of the range
+        I_EventsStream::Bookmark previous_bookmark;
+        if (bookmark.timestamp_ > start_ts_ &&
+            events_stream_->get_bookmark(bookmark.timestamp_ - 1, previous_bookmark) ==
+                I_EventsStream::SeekStatus::Success) {
+            bookmark = previous_bookmark;
+        }
+
+        auto context                = acquire_context();
+        context->start_ts           = start_ts;
+        context->end_ts             = end_ts;
+        context->cd_events          = &cd_events;
+        context->ext_trigger_events = ext_trigger_events;
+        try {
+            decode(*context, bookmark);
+        } catch (...) {
+            release_context(std::move(context));
+            throw;
+        }
+        release_context(std::move(context));
+    }
+
+private:
+    // Device providing a decoder, with the state of an ongoing read
+    struct DecodingContext {
+        std::unique_ptr<Device> device;
+        I_EventsStreamDecoder *decoder = nullptr;
+        std::vector<I_EventsStreamDecoder::RawData> buffer;
+#ifdef _WIN32
+        std::ifstream file;
+#endif
+        timestamp start_ts                                = 0;
+        timestamp end_ts                                  = 0;
+        std::vector<EventCD> *cd_events                   = nullptr;
+        std::vector<EventExtTrigger> *ext_trigger_events = nullptr;
+    };
+
+    std::unique_ptr<DecodingContext> acquire_context() {
+        std::lock_guard<std::mutex> lock(contexts_mutex_);
+        if (!free_contexts_.empty()) {
+            auto context = std::move(free_contexts_.back());
+            free_contexts_.pop_back();
+            return context;
+        }
+
+        // the index is shared, the devices of the contexts only provide decoders
+        auto context = std::make_unique<DecodingContext>();
+        RawFileConfig config;
+        config.build_index_ = false;
+        context->device     = DeviceDiscovery::open_raw_file(raw_file_path_, config);
+        context->decoder    = context->device ? context->device->get_facility<I_EventsStreamDecoder>() : nullptr;
+        if (!context->decoder) {
+            throw CameraException(CameraErrorCode::InvalidRawfile,
+                                  "The RAW file at " + raw_file_path_.string() + " could not be read.");
+        }
+        if (!context->decoder->reset_timestamp_shift(ts_shift_)) {
+            throw CameraException(CameraErrorCode::InvalidRawfile,
+                                  "The timestamp shift of the RAW file at " + raw_file_path_.string() +
+                                      " could not be applied.");
+        }
+        context->buffer.resize(read_buffer_size);
+#ifdef _WIN32
+        context->file.open(raw_file_path_, std::ios::binary);
+#endif
+
+        auto *ctx = context.get();
+        if (auto *cd_decoder = context->device->get_facility<I_EventDecoder<EventCD>>()) {
+            cd_decoder->add_event_buffer_callback([ctx](const EventCD *begin, const EventCD *end) {
+                append_events_in_range(begin, end, ctx->start_ts, ctx->end_ts, ctx->cd_events);
+            });
+        }
+        if (auto *ext_trigger_decoder = context->device->get_facility<I_EventDecoder<EventExtTrigger>>()) {
+            ext_trigger_decoder->add_event_buffer_callback(
+                [ctx](const EventExtTrigger *begin, const EventExtTrigger *end) {
+                    append_events_in_range(begin, end, ctx->start_ts, ctx->end_ts, ctx->ext_trigger_events);
+                });
+        }
+        return context;
+    }
+
+    void release_context(std::unique_ptr<DecodingContext> context) {
+        context->cd_events          = nullptr;
+        context->ext_trigger_events = nullptr;
+        std::lock_guard<std::mutex> lock(contexts_mutex_);
+        free_contexts_.push_back(std::move(context));
+    }
+
+    // Reads up to size bytes at offset in the buffer of the context, returns the number of bytes read
+    std::size_t read_at(DecodingContext &context, std::uint64_t offset, std::size_t size) {
+        char *data = reinterpret_cast<char *>(context.buffer.data());
+#ifdef _WIN32
+        context.file.clear();
+        if (!context.file.seekg(offset)) {
+            return 0;
+        }
+        context.file.read(data, size);
+        return static_cast<std::size_t>(context.file.gcount());
+#else
+        // pread does not use the position of the file, so that it can be called concurrently on the same descriptor
+        std::size_t read_size = 0;
+        while (read_size < size) {
+            const ssize_t res = ::pread(fd_, data + read_size, size - read_size, offset + read_size);
+            if (res < 0 && errno == EINTR) {
+                continue;
+            }
+            if (res <= 0) {
+                break;
+            }
+            read_size += res;
+        }
+        return read_size;
+#endif
+    }
+
+    void decode(DecodingContext &context, const I_EventsStream::Bookmark &bookmark) {
+        auto &decoder = *context.decoder;
+        decoder.reset_last_timestamp(bookmark.timestamp_);
+
+        std::uint64_t offset = bookmark.byte_offset_;
+        while (offset < data_end_ && decoder.get_last_timestamp() < context.end_ts) {
+            const std::size_t size =
+                static_cast<std::size_t>(std::min<std::uint64_t>(context.buffer.size(), data_end_ - offset));
+            std::size_t read_size = read_at(context, offset, size);
+            read_size -= read_size % raw_event_size_;
+            if (read_size == 0) {
+                break;
+            }
+            decoder.decode(context.buffer.data(), context.buffer.data() + read_size);
+            offset += read_size;
+        }
+    }
+
+    const std::filesystem::path raw_file_path_;
+    std::unique_ptr<Device> index_device_;
+    I_EventsStream *events_stream_ = nullptr;
+    timestamp start_ts_            = 0;
+    timestamp end_ts_              = 0;
+    timestamp ts_shift_            = 0;
+    std::size_t raw_event_size_    = 1;
+    std::uint64_t data_end_        = 0;
+#ifndef _WIN32
+    int fd_ = -1;
+#endif
+
+    std::mutex contexts_mutex_;
+    std::vector<std::unique_ptr<DecodingContext>> free_contexts_;
+};
+
+RawRangeReader::RawRangeReader(const std::filesystem::path &raw_file_path) :
+    pimpl_(std::make_unique<Private>(raw_file_path)) {}
+
+RawRangeReader::~RawRangeReader() = default;
+
+void RawRangeReader::get_range(timestamp &start_ts, timestamp &end_ts) const {
+    pimpl_->get_range(start_ts, end_ts);
+}
+
+void RawRangeReader::read(timestamp start_ts, timestamp end_ts, std::vector<EventCD> &cd_events) {
+    pimpl_->read(start_ts, end_ts, cd_events, nullptr);
+}
+
+void RawRangeReader::read(timestamp start_ts, timestamp end_ts, std::vector<EventCD> &cd_events,
+                          std::vector<EventExtTrigger> &ext_trigger_events) {
+    pimpl_->read(start_ts, end_ts, cd_events, &ext_trigger_events);
+}
+
+} // namespace Metavision
@@ -12,6 +12,7 @@
 #include "metavision/sdk/stream/synced_camera_streams_slicer.h"
 #include "metavision/hal/facilities/i_events_stream_decoder.h"
 #include "metavision/hal/facilities/i_camera_synchronization.h"
+#include "metavision/sdk/base/utils/trace_recorder.h"
 
 namespace Metavision {
 
@@ -168,6 +169,7 @@ public:
     void start_slicing() {
         // Setup master camera & slicer
         camera_.cd().add_callback([this](const auto &begin, const auto &end) {
+            MV_TRACE_SCOPE("SyncedCameraStreamsSlicer::process_events");
             std::unique_lock lock(mtx_);
             slicer_.process_events(begin, end, [this](const auto &slice_begin, const auto &slice_end) {
                 curt_event_buffer_master_->insert(curt_event_buffer_master_->end(), slice_begin, slice_end);
@@ -246,6 +248,7 @@ private:
         }
 
         queue_->emplace(std::move(slice));
+        MV_TRACE_COUNTER("SyncedCameraStreamsSlicer queue size", queue_->size());
 
         curt_event_buffer_master_ = event_buffer_pool_.acquire();
         curt_event_buffer_master_->clear();
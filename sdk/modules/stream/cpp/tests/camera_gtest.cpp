@@ -14,6 +14,7 @@
 #include <condition_variable>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
 #include <gtest/gtest.h>
 #include <mutex>
 #include <numeric> // std::iota
@@ -28,12 +29,14 @@
 #include "metavision/hal/facilities/i_erc_module.h"
 #include "metavision/hal/facilities/i_event_rate_activity_filter_module.h"
 #include "metavision/hal/facilities/i_event_trail_filter_module.h"
+#include "metavision/hal/facilities/i_events_stream.h"
 #include "metavision/hal/facilities/i_events_stream_decoder.h"
 #include "metavision/hal/facilities/i_hw_register.h"
 #include "metavision/hal/facilities/i_ll_biases.h"
 #include "metavision/hal/facilities/i_roi.h"
 #include "metavision/hal/facilities/i_trigger_in.h"
 #include "metavision/hal/facilities/i_trigger_out.h"
+#include "metavision/hal/utils/network_raw_stream_server.h"
 #include "metavision/hal/utils/raw_file_header.h"
 #include "metavision/sdk/base/utils/timestamp.h"
 #include "metavision/sdk/stream/camera_error_code.h"
@@ -758,6 +761,156 @@ TEST_F(Camera_Gtest, no_error_callbacks_called) {
     ASSERT_EQ(error_value, -1);
 }
 
+TEST_F(Camera_Gtest, overload_policy_drops_buffers_and_resynchronizes_the_decoder) {
+    // GIVEN a synthetic camera producing a buffer every ms, processed in 2 ms, and dropping buffers when overloaded
+    Camera camera = Camera::from_serial("synthetic:format=evt3,rate=1M,duration=1500000");
+    CameraOverloadPolicy policy;
+    policy.mode_               = CameraOverloadPolicy::Mode::DropBuffers;
+    policy.max_queued_buffers_ = 4;
+    camera.set_overload_policy(policy);
+    auto *events_stream = camera.get_device().get_facility<I_EventsStream>();
+    ASSERT_NE(nullptr, events_stream);
+    EXPECT_EQ(4, events_stream->get_max_queued_buffers());
+
+    std::size_t num_events = 0, num_buffers_following_drops = 0;
+    timestamp last_ts   = -1;
+    bool ordered_events = true;
+    camera.cd().add_callback([&](const EventCD *begin, const EventCD *end) {
+        for (auto ev = begin; ev != end; ++ev) {
+            ordered_events = ordered_events && ev->t >= last_ts;
+            last_ts        = ev->t;
+        }
+        num_events += std::distance(begin, end);
+    });
+    camera.raw_data().add_callback([&](const uint8_t *, size_t) {
+        num_buffers_following_drops += events_stream->latest_raw_data_follows_dropped_data();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    });
+
+    // WHEN streaming until the end of the data
+    camera.start();
+    while (camera.is_running()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    camera.stop();
+
+    // THEN buffers are dropped, and the decoder is reset after each drop so that the events are still decoded in order
+    const auto stats = camera.get_overload_statistics();
+    EXPECT_GT(stats.dropped_buffers, 0u);
+    EXPECT_GT(num_buffers_following_drops, 0u);
+    EXPECT_LE(num_buffers_following_drops, stats.dropped_buffers);
+    EXPECT_GT(num_events, 0u);
+    EXPECT_TRUE(ordered_events);
+
+    // AND the dropped events are the RAW events of the dropped buffers, 2 bytes each in EVT3, at a rate measured over
+    // the last second of processing
+    EXPECT_EQ(stats.dropped_bytes / 2, stats.dropped_events);
+    EXPECT_GT(stats.dropped_events_rate, 0);
+
+    // WHEN the overload policy is disabled
+    camera.set_overload_policy(CameraOverloadPolicy());
+
+    // THEN the queue is unbounded again
+    EXPECT_EQ(0, events_stream->get_max_queued_buffers());
+}
+
+TEST_F(Camera_Gtest, overload_policy_filters_events_and_falls_back_to_dropping_buffers) {
+    CameraOverloadPolicy subsample;
+    subsample.mode_               = CameraOverloadPolicy::Mode::Subsample;
+    subsample.subsampling_factor_ = 4;
+    CameraOverloadPolicy roi_only;
+    roi_only.mode_       = CameraOverloadPolicy::Mode::RoiOnly;
+    roi_only.roi_x_      = 100;
+    roi_only.roi_y_      = 200;
+    roi_only.roi_width_  = 300;
+    roi_only.roi_height_ = 100;
+
+    for (auto policy : {subsample, roi_only}) {
+        SCOPED_TRACE(static_cast<int>(policy.mode_));
+
+        // GIVEN a synthetic camera whose processing is slower than the data, always overloaded with a maximum of 1
+        // queued buffer
+        Camera camera = Camera::from_serial("synthetic:format=evt2,rate=1M,duration=300000");
+        policy.max_queued_buffers_ = 1;
+        camera.set_overload_policy(policy);
+        auto *events_stream = camera.get_device().get_facility<I_EventsStream>();
+        ASSERT_NE(nullptr, events_stream);
+        EXPECT_EQ(4, events_stream->get_max_queued_buffers());
+
+        std::size_t num_events = 0, num_dropped_pixels_events = 0;
+        camera.cd().add_callback([&](const EventCD *begin, const EventCD *end) {
+            for (auto ev = begin; ev != end; ++ev) {
+                num_dropped_pixels_events += !policy.keeps(ev->x, ev->y);
+            }
+            num_events += std::distance(begin, end);
+        });
+        camera.raw_data().add_callback(
+            [](const uint8_t *, size_t) { std::this_thread::sleep_for(std::chrono::milliseconds(2)); });
+
+        // WHEN streaming until the end of the data
+        camera.start();
+        while (camera.is_running()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        camera.stop();
+
+        // THEN only the events of the kept pixels are received
+        const auto stats = camera.get_overload_statistics();
+        EXPECT_TRUE(stats.shedding);
+        EXPECT_GT(num_events, 0u);
+        EXPECT_EQ(0u, num_dropped_pixels_events);
+
+        // AND as filtering the events does not let the processing catch up, the buffers are dropped once 4 times the
+        // maximum number of buffers are queued
+        EXPECT_GT(stats.dropped_buffers, 0u);
+
+        // AND the dropped events count both the filtered events and the RAW events of the dropped buffers, 4 bytes
+        // each in EVT2
+        EXPECT_GT(stats.dropped_events, stats.dropped_bytes / 4);
+    }
+}
+
+#ifndef _WIN32
+TEST_F(Camera_Gtest, from_uri_opens_a_network_stream) {
+    // GIVEN a network stream server, and the RAW data of a file
+    const auto expected_events = write_evt2_raw_data();
+    std::ifstream raw_file(tmp_file_, std::ios::binary);
+    const RawFileHeader header(raw_file);
+    const std::vector<uint8_t> raw_data((std::istreambuf_iterator<char>(raw_file)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(bytes_written_, raw_data.size());
+    NetworkRawStreamServerConfig config;
+    config.address_ = "127.0.0.1";
+    auto server     = std::make_unique<NetworkRawStreamServer>(header, config);
+
+    // WHEN a camera is opened from the URI of the stream, and the data is published
+    Camera camera = Camera::from_uri("tcp://127.0.0.1:" + std::to_string(server->get_port()));
+    std::vector<EventCD> received_events;
+    camera.cd().add_callback([&received_events](const EventCD *begin, const EventCD *end) {
+        received_events.insert(received_events.end(), begin, end);
+    });
+    ASSERT_TRUE(camera.start());
+    for (int i = 0; i < 5000 && server->get_num_clients() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(1, server->get_num_clients());
+    server->publish(raw_data.data(), raw_data.data() + raw_data.size());
+    server.reset();
+
+    // THEN the camera stops at the end of the stream, after decoding all the events
+    for (int i = 0; i < 5000 && camera.is_running(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_FALSE(camera.is_running());
+    ASSERT_EQ(expected_events.size(), received_events.size());
+    for (std::size_t i = 0; i < expected_events.size(); ++i) {
+        ASSERT_EQ(expected_events[i].x, received_events[i].x);
+        ASSERT_EQ(expected_events[i].y, received_events[i].y);
+        ASSERT_EQ(expected_events[i].p, received_events[i].p);
+        ASSERT_EQ(expected_events[i].t, received_events[i].t);
+    }
+}
+#endif
+
 TEST_F(Camera_Gtest, events_callbacks_add_remove_cd) {
     write_evt2_raw_data();
 
@@ -1339,6 +1492,43 @@ TEST_F_WITH_DATASET(Camera_Gtest, offline_streaming_control_seeks) {
     }
 }
 
+TEST_F_WITH_DATASET(Camera_Gtest, offline_streaming_control_seeks_cd_vectors) {
+    const auto dataset = std::filesystem::path(GtestsParameters::instance().dataset_dir) / "openeb" /
+                         "claque_doigt_evt21.raw";
+    const auto hints = Metavision::FileConfigHints().real_time_playback(false).cd_vectors(true);
+    Camera camera    = Camera::from_file(dataset, hints);
+
+    // the vectorized CD events are read by the file reader, like the CD events, so that seeking applies to them
+    std::atomic<bool> decoded{false};
+    Metavision::timestamp first_ts = -1;
+    camera.cd_vector().add_callback([&](const EventCDVector *begin, const EventCDVector *end) {
+        if (!decoded) {
+            first_ts = begin->t;
+            decoded  = true;
+        }
+    });
+
+    int max_trials = 1000;
+    for (int i = 0; i < max_trials; ++i) {
+        if (camera.offline_streaming_control().is_ready()) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    const timestamp target = (camera.offline_streaming_control().get_seek_start_time() +
+                              camera.offline_streaming_control().get_seek_end_time()) /
+                             2;
+    ASSERT_TRUE(camera.offline_streaming_control().seek(target));
+    camera.start();
+    while (!decoded) {}
+    camera.stop();
+
+    ASSERT_GE(target, first_ts);
+    ASSERT_LT(camera.offline_streaming_control().get_seek_start_time(), first_ts);
+    ASSERT_LE(first_ts, camera.get_last_timestamp());
+}
+
 #ifdef HAS_PROTOBUF
 TEST_F(Camera_Gtest, should_load_serialized_state) {
     const std::string dummy_plugin_test_path(HAL_DUMMY_TEST_PLUGIN);
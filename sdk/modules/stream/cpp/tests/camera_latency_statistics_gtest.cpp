@@ -0,0 +1,93 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <chrono>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/stream/camera_latency_statistics.h"
+
+using namespace Metavision;
+using namespace std::chrono_literals;
+
+TEST(LatencyHistogram_GTest, empty_histogram) {
+    // GIVEN an empty histogram
+    LatencyHistogram histo;
+
+    // THEN all the statistics are null
+    EXPECT_EQ(0u, histo.count());
+    EXPECT_EQ(0ns, histo.min());
+    EXPECT_EQ(0ns, histo.max());
+    EXPECT_EQ(0ns, histo.mean());
+    EXPECT_EQ(0ns, histo.percentile(50));
+}
+
+TEST(LatencyHistogram_GTest, samples_are_counted_in_power_of_two_buckets) {
+    // GIVEN a histogram
+    LatencyHistogram histo;
+
+    // WHEN adding samples
+    histo.add(0ns);
+    histo.add(1ns);
+    histo.add(3ns);
+    histo.add(4ns);
+    histo.add(1000ns);
+    histo.add(-5ns);
+
+    // THEN they are counted in the expected buckets, negative durations being null durations
+    const auto &buckets = histo.buckets();
+    EXPECT_EQ(2u, buckets[0]);
+    EXPECT_EQ(1u, buckets[1]);
+    EXPECT_EQ(1u, buckets[2]);
+    EXPECT_EQ(1u, buckets[3]);
+    EXPECT_EQ(1u, buckets[10]);
+    EXPECT_EQ(6u, histo.count());
+    EXPECT_EQ(1ns, LatencyHistogram::bucket_upper_bound(0));
+    EXPECT_EQ(1024ns, LatencyHistogram::bucket_upper_bound(10));
+}
+
+TEST(LatencyHistogram_GTest, statistics) {
+    // GIVEN a histogram with 100 samples from 1us to 100us
+    LatencyHistogram histo;
+    for (int i = 1; i <= 100; ++i) {
+        histo.add(std::chrono::microseconds(i));
+    }
+
+    // THEN the min, max and mean are exact
+    EXPECT_EQ(1us, histo.min());
+    EXPECT_EQ(100us, histo.max());
+    EXPECT_EQ(50500ns, histo.mean());
+
+    // AND the percentiles are upper bounds at most twice as large as the exact values
+    for (double p : {1., 50., 90., 99., 100.}) {
+        const auto exact = std::chrono::nanoseconds(std::chrono::microseconds(static_cast<int>(p)));
+        EXPECT_GE(histo.percentile(p), exact);
+        EXPECT_LE(histo.percentile(p), 2 * exact);
+    }
+    EXPECT_EQ(100us, histo.percentile(100));
+}
+
+TEST(CameraLatencyStatistics_GTest, reset) {
+    // GIVEN statistics with samples
+    CameraLatencyStatistics stats;
+    stats.arrival_to_decode.add(1us);
+    stats.decode.add(2us);
+    stats.callbacks.add(3us);
+    stats.event_lag.add(4us);
+
+    // WHEN resetting them
+    stats.reset();
+
+    // THEN all the histograms are empty
+    EXPECT_EQ(0u, stats.arrival_to_decode.count());
+    EXPECT_EQ(0u, stats.decode.count());
+    EXPECT_EQ(0u, stats.callbacks.count());
+    EXPECT_EQ(0u, stats.event_lag.count());
+}
@@ -0,0 +1,86 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/stream/camera_overload_policy.h"
+
+using namespace Metavision;
+
+TEST(CameraOverloadPolicy_GTest, keeps_all_pixels_without_shedding) {
+    // GIVEN policies that do not filter events
+    CameraOverloadPolicy policy;
+    for (const auto mode : {CameraOverloadPolicy::Mode::None, CameraOverloadPolicy::Mode::DropBuffers}) {
+        policy.mode_ = mode;
+
+        // THEN all the pixels are kept
+        EXPECT_TRUE(policy.keeps(0, 0));
+        EXPECT_TRUE(policy.keeps(1, 3));
+        EXPECT_TRUE(policy.keeps(1279, 719));
+    }
+}
+
+TEST(CameraOverloadPolicy_GTest, subsampling_keeps_one_pixel_out_of_factor_in_each_direction) {
+    // GIVEN a subsampling policy
+    CameraOverloadPolicy policy;
+    policy.mode_               = CameraOverloadPolicy::Mode::Subsample;
+    policy.subsampling_factor_ = 4;
+
+    // THEN one pixel out of 16 is kept
+    int num_kept = 0;
+    for (std::uint16_t y = 0; y < 64; ++y) {
+        for (std::uint16_t x = 0; x < 64; ++x) {
+            num_kept += policy.keeps(x, y);
+        }
+    }
+    EXPECT_EQ(64 * 64 / 16, num_kept);
+    EXPECT_TRUE(policy.keeps(8, 4));
+    EXPECT_FALSE(policy.keeps(8, 5));
+    EXPECT_FALSE(policy.keeps(2, 4));
+}
+
+TEST(CameraOverloadPolicy_GTest, roi_only_keeps_pixels_inside_the_roi) {
+    // GIVEN a policy keeping a region of interest
+    CameraOverloadPolicy policy;
+    policy.mode_       = CameraOverloadPolicy::Mode::RoiOnly;
+    policy.roi_x_      = 10;
+    policy.roi_y_      = 20;
+    policy.roi_width_  = 5;
+    policy.roi_height_ = 2;
+
+    // THEN only the pixels of the region are kept
+    EXPECT_TRUE(policy.keeps(10, 20));
+    EXPECT_TRUE(policy.keeps(14, 21));
+    EXPECT_FALSE(policy.keeps(9, 20));
+    EXPECT_FALSE(policy.keeps(15, 20));
+    EXPECT_FALSE(policy.keeps(10, 19));
+    EXPECT_FALSE(policy.keeps(10, 22));
+}
+
+TEST(CameraOverloadStatistics_GTest, reset) {
+    // GIVEN statistics of an overloaded camera
+    CameraOverloadStatistics stats;
+    stats.dropped_buffers     = 1;
+    stats.dropped_bytes       = 2;
+    stats.dropped_events      = 3;
+    stats.dropped_events_rate = 4;
+    stats.shedding            = true;
+
+    // WHEN resetting them
+    stats.reset();
+
+    // THEN the counters are cleared, but the current state is kept
+    EXPECT_EQ(0u, stats.dropped_buffers);
+    EXPECT_EQ(0u, stats.dropped_bytes);
+    EXPECT_EQ(0u, stats.dropped_events);
+    EXPECT_EQ(0, stats.dropped_events_rate);
+    EXPECT_TRUE(stats.shedding);
+}
@@ -0,0 +1,116 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/core/preprocessors/histo_processor.h"
+#include "metavision/sdk/stream/camera_stream_preprocessor.h"
+#include "metavision/sdk/stream/camera_stream_slicer.h"
+#include "metavision/utils/gtest/gtest_custom.h"
+
+using namespace Metavision;
+
+namespace fs = std::filesystem;
+
+class CameraStreamPreprocessorTest : public ::testing::Test {
+protected:
+    void SetUp() final {
+        dataset_dir_ = GtestsParameters::instance().dataset_dir;
+        record_path_ = (fs::path(dataset_dir_) / "openeb" / "gen4_evt3_hand.raw").string();
+    }
+
+    std::shared_ptr<const HistoProcessor<const EventCD *>> make_preprocessor() const {
+        auto camera = Camera::from_file(record_path_);
+        return std::make_shared<const HistoProcessor<const EventCD *>>(camera.geometry().get_width(),
+                                                                     camera.geometry().get_height(), 5.f, 1.f);
+    }
+
+    std::string dataset_dir_;
+    std::string record_path_;
+};
+
+TEST_F(CameraStreamPreprocessorTest, computes_same_tensors_as_sequential_processing) {
+    // GIVEN a record file and a preprocessor
+    static constexpr int kNus = 10000;
+    const auto preprocessor   = make_preprocessor();
+    const auto condition      = CameraStreamSlicer::SliceCondition::make_n_us(kNus);
+
+    // AND the tensors computed sequentially from the slices of the record
+    std::vector<Tensor> expected_tensors;
+    std::vector<timestamp> expected_ts;
+    {
+        CameraStreamSlicer slicer(Camera::from_file(record_path_), condition);
+        for (const auto &slice : slicer) {
+            Tensor tensor(preprocessor->get_output_shape(), preprocessor->get_output_type());
+            preprocessor->process_events(0, slice.events->data(), slice.events->data() + slice.events->size(),
+                                         tensor);
+            expected_tensors.emplace_back(std::move(tensor));
+            expected_ts.push_back(slice.t);
+        }
+    }
+    ASSERT_FALSE(expected_tensors.empty());
+
+    // WHEN the tensors are computed in the background with a small queue
+    CameraStreamPreprocessor pipeline(Camera::from_file(record_path_), preprocessor, condition, 3);
+
+    // THEN the same tensors are retrieved, in order
+    TensorSlice slice;
+    std::size_t n_slices = 0;
+    timestamp start_ts   = 0;
+    while (pipeline.next(slice)) {
+        ASSERT_LT(n_slices, expected_tensors.size());
+        EXPECT_EQ(expected_ts[n_slices], slice.t);
+        EXPECT_EQ(start_ts, slice.start_ts);
+        const auto &expected = expected_tensors[n_slices];
+        ASSERT_EQ(expected.shape(), slice.tensor.shape());
+        ASSERT_EQ(0, std::memcmp(expected.data(), slice.tensor.data(), expected.byte_size()));
+        start_ts = slice.t;
+        ++n_slices;
+    }
+    EXPECT_EQ(expected_tensors.size(), n_slices);
+    EXPECT_FALSE(pipeline.next(slice));
+}
+
+TEST_F(CameraStreamPreprocessorTest, can_be_destroyed_before_end_of_stream) {
+    // GIVEN a pipeline computing the tensors of a record
+    const auto condition = CameraStreamSlicer::SliceCondition::make_n_us(1000);
+    CameraStreamPreprocessor pipeline(Camera::from_file(record_path_), make_preprocessor(), condition, 2);
+
+    // WHEN only a few tensors are retrieved
+    TensorSlice slice;
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(pipeline.next(slice));
+    }
+
+    // THEN the pipeline stops cleanly when destroyed
+}
+
+TEST_F(CameraStreamPreprocessorTest, can_be_destroyed_while_waiting_for_a_slice) {
+    // GIVEN a pipeline on a live camera producing too few events to complete a slice
+    auto camera          = Camera::from_serial("synthetic:format=evt3,rate=1k");
+    const auto condition = CameraStreamSlicer::SliceCondition::make_n_events(1000000);
+    auto preprocessor    = std::make_shared<const HistoProcessor<const EventCD *>>(
+        camera.geometry().get_width(), camera.geometry().get_height(), 5.f, 1.f);
+    auto pipeline = std::make_unique<CameraStreamPreprocessor>(std::move(camera), preprocessor, condition, 2);
+
+    // WHEN the pipeline is destroyed while its reader waits for the first slice
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    pipeline.reset();
+
+    // THEN the destruction does not wait for a slice that never comes
+}
@@ -459,8 +459,11 @@ TEST_WITH_DATASET(DATEventFileReader_Gtest, get_seek_range) {
         "openeb" / "core" / "event_io" / "recording_td.dat";
 
     DATEventFileReader reader(dataset_file_path);
+    ASSERT_TRUE(reader.seekable());
     timestamp min_t, max_t;
-    ASSERT_FALSE(reader.get_seek_range(min_t, max_t));
+    ASSERT_TRUE(reader.get_seek_range(min_t, max_t));
+    EXPECT_LE(0, min_t);
+    EXPECT_EQ(7702845, max_t);
 }
 
 TEST_WITH_DATASET(DATEventFileReader_Gtest, get_duration) {
@@ -513,6 +516,83 @@ TEST_WITH_DATASET(DATEventFileReader_Gtest, read_delayed_recording) {
     EXPECT_EQ(0, num_ext_trigger_events);
 }
 
+class DATEventFileReaderGenerated_Gtest : public GTestWithTmpDir {
+protected:
+    virtual void SetUp() {
+        tmp_file_ = tmpdir_handler_->get_full_path("test_td.dat");
+
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> dt_dist(0, 30), x_dist(0, 639), y_dist(0, 479), p_dist(0, 1);
+        timestamp t = 1234;
+        for (int i = 0; i < 100000; ++i) {
+            t += dt_dist(gen);
+            events_.emplace_back(x_dist(gen), y_dist(gen), p_dist(gen), t);
+        }
+
+        GenericHeader header;
+        header.set_field("Width", "640");
+        header.set_field("Height", "480");
+        std::ofstream ofs(tmp_file_, std::ios::binary);
+        ofs << header;
+        ofs.put(static_cast<char>(get_event_id<EventCD>()));
+        ofs.put(8);
+        for (const auto &ev : events_) {
+            uint64_t raw;
+            ev.write_event(&raw, 0);
+            ofs.write(reinterpret_cast<const char *>(&raw), sizeof(raw));
+        }
+    }
+
+    std::vector<EventCD> read_all(DATEventFileReader &reader) {
+        std::vector<EventCD> events;
+        reader.add_read_callback(
+            [&events](const EventCD *begin, const EventCD *end) { events.insert(events.end(), begin, end); });
+        while (reader.read()) {}
+        return events;
+    }
+
+    std::filesystem::path tmp_file_;
+    std::vector<EventCD> events_;
+};
+
+TEST_F(DATEventFileReaderGenerated_Gtest, read) {
+    DATEventFileReader reader(tmp_file_);
+    EXPECT_EQ(events_, read_all(reader));
+    EXPECT_EQ(events_.back().t, reader.get_duration());
+}
+
+TEST_F(DATEventFileReaderGenerated_Gtest, read_with_decode_ahead) {
+    DATEventFileReader reader(tmp_file_, true);
+    EXPECT_EQ(events_, read_all(reader));
+}
+
+TEST_F(DATEventFileReaderGenerated_Gtest, seek) {
+    for (bool decode_ahead : {false, true}) {
+        DATEventFileReader reader(tmp_file_, decode_ahead);
+        timestamp min_t, max_t;
+        ASSERT_TRUE(reader.get_seek_range(min_t, max_t));
+        EXPECT_EQ(events_.front().t, min_t);
+        EXPECT_EQ(events_.back().t, max_t);
+
+        // reads a few slices first, so that a slice is being decoded ahead when seeking
+        for (int i = 0; i < 10; ++i) {
+            reader.read();
+        }
+
+        timestamp seek_ts = -1;
+        reader.add_seek_callback([&seek_ts](timestamp t) { seek_ts = t; });
+        const timestamp target = (min_t + max_t) / 2;
+        ASSERT_TRUE(reader.seek(target));
+
+        auto it = std::lower_bound(events_.begin(), events_.end(), target,
+                                   [](const EventCD &ev, timestamp t) { return ev.t < t; });
+        EXPECT_EQ(it->t, seek_ts);
+        EXPECT_EQ(std::vector<EventCD>(it, events_.end()), read_all(reader));
+
+        EXPECT_FALSE(reader.seek(max_t + 1));
+    }
+}
+
 class RAWEventFileLogger_Gtest : public GTestWithTmpDir {
 protected:
     virtual void SetUp() {
@@ -0,0 +1,254 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/stream/event_streams_merger.h"
+
+using namespace Metavision;
+
+namespace {
+
+// Merged event, with the id of its stream
+struct MergedEvent {
+    EventStreamsMerger::StreamId stream_id;
+    timestamp t;
+    bool is_trigger;
+};
+
+} // namespace
+
+class EventStreamsMerger_GTest : public ::testing::Test {
+protected:
+    std::unique_ptr<EventStreamsMerger> make_merger(timestamp max_latency = std::numeric_limits<timestamp>::max(),
+                                                    std::size_t queue_capacity = 64) {
+        return std::make_unique<EventStreamsMerger>(
+            [this](EventStreamsMerger::StreamId id, const EventCD *begin, const EventCD *end) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (auto it = begin; it != end; ++it) {
+                    merged_.push_back({id, it->t, false});
+                }
+            },
+            [this](EventStreamsMerger::StreamId id, const EventExtTrigger *begin, const EventExtTrigger *end) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (auto it = begin; it != end; ++it) {
+                    merged_.push_back({id, it->t, true});
+                }
+            },
+            max_latency, queue_capacity);
+    }
+
+    std::vector<MergedEvent> get_merged() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return merged_;
+    }
+
+    std::mutex mutex_;
+    std::vector<MergedEvent> merged_;
+};
+
+TEST_F(EventStreamsMerger_GTest, merges_streams_fed_by_several_threads_in_order) {
+    // GIVEN a merger of 3 CD streams and 1 trigger stream, with small queues
+    auto merger = make_merger(std::numeric_limits<timestamp>::max(), 4);
+    const auto cd_ids = std::vector<EventStreamsMerger::StreamId>{merger->add_cd_stream(), merger->add_cd_stream(),
+                                                                  merger->add_cd_stream()};
+    const auto trigger_id = merger->add_ext_trigger_stream();
+    ASSERT_EQ(4, merger->get_num_streams());
+    merger->start();
+
+    // WHEN each stream is fed by its own thread, with its own timestamps step
+    constexpr int num_buffers = 500, buffer_size = 20;
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < cd_ids.size(); ++i) {
+        threads.emplace_back([&, i] {
+            timestamp t = 0;
+            for (int b = 0; b < num_buffers; ++b) {
+                std::vector<EventCD> events;
+                for (int e = 0; e < buffer_size; ++e, t += i + 1) {
+                    events.emplace_back(0, 0, 0, t);
+                }
+                ASSERT_TRUE(merger->add_events(cd_ids[i], events.data(), events.data() + events.size()));
+            }
+            merger->close_stream(cd_ids[i]);
+        });
+    }
+    threads.emplace_back([&] {
+        for (timestamp t = 0; t < num_buffers * buffer_size; t += 100) {
+            const EventExtTrigger trigger(0, t, 0);
+            ASSERT_TRUE(merger->add_events(trigger_id, &trigger, &trigger + 1));
+        }
+        merger->close_stream(trigger_id);
+    });
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    merger->close();
+
+    // THEN all the events are merged, in chronological order then in the order of the streams
+    const auto merged = get_merged();
+    ASSERT_EQ(cd_ids.size() * num_buffers * buffer_size + num_buffers * buffer_size / 100, merged.size());
+    for (std::size_t i = 1; i < merged.size(); ++i) {
+        ASSERT_LE(merged[i - 1].t, merged[i].t);
+        if (merged[i - 1].t == merged[i].t) {
+            ASSERT_LE(merged[i - 1].stream_id, merged[i].stream_id);
+        }
+        ASSERT_EQ(merged[i].stream_id == trigger_id, merged[i].is_trigger);
+    }
+    EXPECT_EQ(0, merger->get_num_dropped_events());
+}
+
+TEST_F(EventStreamsMerger_GTest, waits_for_the_watermarks_of_all_the_streams) {
+    // GIVEN a merger of 2 streams
+    auto merger    = make_merger();
+    const auto id0 = merger->add_cd_stream();
+    const auto id1 = merger->add_ext_trigger_stream();
+    merger->start();
+
+    // WHEN only the first stream has events
+    const std::vector<EventCD> events{{0, 0, 0, 10}, {0, 0, 0, 20}, {0, 0, 0, 30}};
+    ASSERT_TRUE(merger->add_events(id0, events.data(), events.data() + events.size()));
+    merger->flush();
+
+    // THEN nothing is merged
+    EXPECT_TRUE(get_merged().empty());
+
+    // WHEN the watermark of the second stream is raised
+    merger->set_watermark(id1, 25);
+    merger->flush();
+
+    // THEN the events older than the watermark are merged
+    auto merged = get_merged();
+    ASSERT_EQ(2, merged.size());
+    EXPECT_EQ(20, merged.back().t);
+
+    // WHEN a lower watermark is set
+    merger->set_watermark(id1, 5);
+
+    // THEN it is ignored, and older events can not be added anymore
+    const EventExtTrigger trigger(0, 24, 0);
+    EXPECT_THROW(merger->add_events(id1, &trigger, &trigger + 1), std::runtime_error);
+
+    // WHEN the second stream is closed
+    merger->close_stream(id1);
+    merger->flush();
+
+    // THEN the last event is held back, as the first stream may still add events with the same timestamp
+    EXPECT_EQ(2, get_merged().size());
+
+    // WHEN the first stream is closed too
+    merger->close_stream(id0);
+    merger->flush();
+
+    // THEN all the events are merged, and no more event can be added to the closed streams
+    merged = get_merged();
+    ASSERT_EQ(3, merged.size());
+    EXPECT_EQ(30, merged.back().t);
+    const EventExtTrigger late_trigger(0, 100, 0);
+    EXPECT_FALSE(merger->add_events(id1, &late_trigger, &late_trigger + 1));
+}
+
+TEST_F(EventStreamsMerger_GTest, max_latency_bounds_the_wait_for_slow_streams) {
+    // GIVEN a merger with a maximum latency
+    auto merger    = make_merger(100);
+    const auto id0 = merger->add_cd_stream();
+    const auto id1 = merger->add_cd_stream();
+    merger->start();
+
+    // WHEN the first stream is ahead of the second one by more than the maximum latency
+    std::vector<EventCD> events{{0, 0, 0, 10}, {0, 0, 0, 150}, {0, 0, 0, 300}};
+    ASSERT_TRUE(merger->add_events(id0, events.data(), events.data() + events.size()));
+    merger->flush();
+
+    // THEN the events older than the maximum latency are merged without waiting for the second stream
+    auto merged = get_merged();
+    ASSERT_EQ(2, merged.size());
+    EXPECT_EQ(150, merged.back().t);
+
+    // WHEN the second stream adds older events
+    events = {{0, 0, 0, 100}, {0, 0, 0, 160}};
+    ASSERT_TRUE(merger->add_events(id1, events.data(), events.data() + events.size()));
+    merger->close();
+
+    // THEN the events older than the merged ones are dropped
+    merged = get_merged();
+    ASSERT_EQ(4, merged.size());
+    EXPECT_EQ(160, merged[2].t);
+    EXPECT_EQ(300, merged[3].t);
+    EXPECT_EQ(1, merger->get_num_dropped_events());
+}
+
+TEST_F(EventStreamsMerger_GTest, rejects_invalid_streams_and_events) {
+    auto merger    = make_merger();
+    const auto id0 = merger->add_cd_stream();
+    const std::vector<EventCD> events{{0, 0, 0, 10}, {0, 0, 0, 5}};
+
+    // events can not be added before the merger is started
+    EXPECT_FALSE(merger->add_events(id0, events.data(), events.data() + 1));
+
+    merger->start();
+    EXPECT_THROW(merger->add_cd_stream(), std::runtime_error);
+
+    // wrong stream id or type, unordered events
+    EXPECT_THROW(merger->add_events(id0 + 1, events.data(), events.data() + 1), std::runtime_error);
+    const EventExtTrigger trigger(0, 10, 0);
+    EXPECT_THROW(merger->add_events(id0, &trigger, &trigger + 1), std::runtime_error);
+    EXPECT_THROW(merger->add_events(id0, events.data(), events.data() + events.size()), std::runtime_error);
+
+    // events older than the last added ones
+    EXPECT_TRUE(merger->add_events(id0, events.data(), events.data() + 1));
+    EXPECT_THROW(merger->add_events(id0, events.data() + 1, events.data() + 2), std::runtime_error);
+
+    // no event can be added once the merger is closed
+    merger->close();
+    EXPECT_EQ(1, get_merged().size());
+    EXPECT_FALSE(merger->add_events(id0, events.data(), events.data() + 1));
+}
+
+TEST_F(EventStreamsMerger_GTest, rethrows_the_exceptions_of_the_merge_callbacks) {
+    // GIVEN a merger whose CD callback fails after some events, with small queues
+    EventStreamsMerger merger(
+        [](EventStreamsMerger::StreamId, const EventCD *, const EventCD *end) {
+            if (std::prev(end)->t >= 1000) {
+                throw std::logic_error("merge failure");
+            }
+        },
+        [](EventStreamsMerger::StreamId, const EventExtTrigger *, const EventExtTrigger *) {},
+        std::numeric_limits<timestamp>::max(), 2);
+    const auto id = merger.add_cd_stream();
+    merger.start();
+
+    // WHEN a thread keeps adding events, more than the queue can hold once the merging stopped
+    std::atomic<bool> rejected{false};
+    std::thread producer([&] {
+        for (timestamp t = 0; t < 100000; t += 10) {
+            const EventCD event(0, 0, 0, t);
+            if (!merger.add_events(id, &event, &event + 1)) {
+                rejected = true;
+                return;
+            }
+        }
+    });
+    producer.join();
+
+    // THEN the producer is not blocked, and the exception is rethrown when flushing and closing
+    EXPECT_TRUE(rejected);
+    EXPECT_THROW(merger.flush(), std::logic_error);
+    EXPECT_THROW(merger.close(), std::logic_error);
+}
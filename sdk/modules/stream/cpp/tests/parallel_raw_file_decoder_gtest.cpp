@@ -0,0 +1,131 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/stream/camera.h"
+#include "metavision/sdk/stream/parallel_raw_file_decoder.h"
+#include "metavision/utils/gtest/gtest_custom.h"
+
+using namespace Metavision;
+
+namespace fs = std::filesystem;
+
+class ParallelRawFileDecoder_GTest : public ::testing::Test {
+protected:
+    static fs::path get_record_path(const std::string &record_name) {
+        return fs::path(GtestsParameters::instance().dataset_dir) / "openeb" / record_name;
+    }
+
+    static std::vector<EventCD> decode_all(const fs::path &record_path) {
+        std::vector<EventCD> events;
+        Camera camera = Camera::from_file(record_path, FileConfigHints().real_time_playback(false));
+        camera.cd().add_callback(
+            [&events](const EventCD *begin, const EventCD *end) { events.insert(events.end(), begin, end); });
+        camera.start();
+        while (camera.is_running()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        camera.stop();
+        return events;
+    }
+
+    static void assert_same_events(const std::vector<EventCD> &expected, const std::vector<EventCD> &events) {
+        ASSERT_EQ(expected.size(), events.size());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_EQ(expected[i].x, events[i].x);
+            ASSERT_EQ(expected[i].y, events[i].y);
+            ASSERT_EQ(expected[i].p, events[i].p);
+            ASSERT_EQ(expected[i].t, events[i].t);
+        }
+    }
+
+    void decode_and_check(const std::string &record_name) {
+        // GIVEN a RAW file and its events decoded by a camera
+        const auto record_path = get_record_path(record_name);
+        const auto all_events  = decode_all(record_path);
+        ASSERT_FALSE(all_events.empty());
+
+        // WHEN decoding the file in parallel
+        ParallelRawFileDecoder decoder(record_path, 20000, 4);
+        ASSERT_LT(1u, decoder.get_num_ranges());
+        std::vector<EventCD> events;
+        decoder.decode([&events](const EventCD *begin, const EventCD *end) { events.insert(events.end(), begin, end); });
+
+        // THEN the events are delivered in the order of the file
+        assert_same_events(all_events, events);
+    }
+};
+
+TEST_F_WITH_DATASET(ParallelRawFileDecoder_GTest, decode_evt2) {
+    decode_and_check("gen4_evt2_hand.raw");
+}
+
+TEST_F_WITH_DATASET(ParallelRawFileDecoder_GTest, decode_evt3) {
+    decode_and_check("gen4_evt3_hand.raw");
+}
+
+TEST_F_WITH_DATASET(ParallelRawFileDecoder_GTest, process_ranges) {
+    // GIVEN a RAW file and its events decoded by a camera
+    const auto record_path = get_record_path("gen4_evt3_hand.raw");
+    const auto all_events  = decode_all(record_path);
+    ASSERT_FALSE(all_events.empty());
+
+    // WHEN processing the ranges of the file concurrently
+    ParallelRawFileDecoder decoder(record_path, 10000, 4);
+    std::mutex mutex;
+    std::vector<std::vector<EventCD>> range_events(decoder.get_num_ranges());
+    decoder.process_ranges([&](ParallelRawFileDecoder::Range &range) {
+        ASSERT_LT(range.start_ts, range.end_ts);
+        for (const auto &ev : range.cd_events) {
+            ASSERT_LE(range.start_ts, ev.t);
+            ASSERT_LT(ev.t, range.end_ts);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        range_events[range.index] = range.cd_events;
+    });
+
+    // THEN each range is processed once, and the ranges hold all the events of the file
+    std::vector<EventCD> events;
+    for (const auto &range : range_events) {
+        events.insert(events.end(), range.begin(), range.end());
+    }
+    assert_same_events(all_events, events);
+}
+
+TEST_F_WITH_DATASET(ParallelRawFileDecoder_GTest, exceptions_are_propagated) {
+    ParallelRawFileDecoder decoder(get_record_path("gen4_evt3_hand.raw"), 10000, 4);
+
+    // exceptions raised in the callbacks are rethrown to the caller, after all the workers are done
+    EXPECT_THROW(decoder.decode([](const EventCD *, const EventCD *) { throw std::runtime_error("error"); }),
+                 std::runtime_error);
+    const auto throwing_range_callback = [](ParallelRawFileDecoder::Range &range) {
+        if (range.index == 1) {
+            throw std::runtime_error("error");
+        }
+    };
+    EXPECT_THROW(decoder.process_ranges(throwing_range_callback), std::runtime_error);
+
+    // the decoder can still be used afterwards
+    std::atomic<std::size_t> num_ranges{0};
+    decoder.process_ranges([&num_ranges](ParallelRawFileDecoder::Range &) { ++num_ranges; });
+    EXPECT_EQ(decoder.get_num_ranges(), num_ranges.load());
+}
+
+TEST_F(ParallelRawFileDecoder_GTest, invalid_range_duration) {
+    EXPECT_THROW(ParallelRawFileDecoder("unused.raw", 0), CameraException);
+}
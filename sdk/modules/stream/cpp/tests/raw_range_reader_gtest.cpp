@@ -0,0 +1,139 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+#include <algorithm>
+#include <filesystem>
+#include <random>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "metavision/sdk/stream/camera.h"
+#include "metavision/sdk/stream/raw_range_reader.h"
+#include "metavision/utils/gtest/gtest_custom.h"
+
+using namespace Metavision;
+
+namespace fs = std::filesystem;
+
+class RawRangeReader_GTest : public ::testing::Test {
+protected:
+    static fs::path get_record_path(const std::string &record_name) {
+        return fs::path(GtestsParameters::instance().dataset_dir) / "openeb" / record_name;
+    }
+
+    static std::vector<EventCD> decode_all(const fs::path &record_path) {
+        std::vector<EventCD> events;
+        Camera camera = Camera::from_file(record_path, FileConfigHints().real_time_playback(false));
+        camera.cd().add_callback(
+            [&events](const EventCD *begin, const EventCD *end) { events.insert(events.end(), begin, end); });
+        camera.start();
+        while (camera.is_running()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        camera.stop();
+        return events;
+    }
+
+    static std::vector<EventCD> get_events_in_range(const std::vector<EventCD> &events, timestamp start_ts,
+                                                    timestamp end_ts) {
+        std::vector<EventCD> events_in_range;
+        std::copy_if(events.cbegin(), events.cend(), std::back_inserter(events_in_range),
+                     [&](const EventCD &ev) { return ev.t >= start_ts && ev.t < end_ts; });
+        return events_in_range;
+    }
+
+    static void assert_same_events(const std::vector<EventCD> &expected, const std::vector<EventCD> &events) {
+        ASSERT_EQ(expected.size(), events.size());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_EQ(expected[i].x, events[i].x);
+            ASSERT_EQ(expected[i].y, events[i].y);
+            ASSERT_EQ(expected[i].p, events[i].p);
+            ASSERT_EQ(expected[i].t, events[i].t);
+        }
+    }
+
+    void read_and_check(const std::string &record_name) {
+        const auto record_path = get_record_path(record_name);
+        const auto all_events  = decode_all(record_path);
+        ASSERT_FALSE(all_events.empty());
+
+        RawRangeReader reader(record_path);
+        timestamp start_ts, end_ts;
+        reader.get_range(start_ts, end_ts);
+        ASSERT_LE(start_ts, end_ts);
+
+        const timestamp first_ts = all_events.front().t, last_ts = all_events.back().t;
+        std::vector<EventCD> events;
+        for (const auto &range : {std::make_pair(first_ts - 1000, first_ts + 10000),
+                                  std::make_pair((first_ts + last_ts) / 2, (first_ts + last_ts) / 2 + 20017),
+                                  std::make_pair(last_ts - 5000, last_ts + 1000000)}) {
+            reader.read(range.first, range.second, events);
+            assert_same_events(get_events_in_range(all_events, range.first, range.second), events);
+        }
+    }
+};
+
+TEST_F_WITH_DATASET(RawRangeReader_GTest, read_evt2) {
+    read_and_check("gen4_evt2_hand.raw");
+}
+
+TEST_F_WITH_DATASET(RawRangeReader_GTest, read_evt3) {
+    read_and_check("gen4_evt3_hand.raw");
+}
+
+TEST_F_WITH_DATASET(RawRangeReader_GTest, read_empty_range) {
+    RawRangeReader reader(get_record_path("gen4_evt3_hand.raw"));
+    timestamp start_ts, end_ts;
+    reader.get_range(start_ts, end_ts);
+
+    std::vector<EventCD> events(10);
+    reader.read(start_ts + 1000, start_ts + 1000, events);
+    EXPECT_TRUE(events.empty());
+}
+
+TEST_F_WITH_DATASET(RawRangeReader_GTest, concurrent_reads) {
+    // GIVEN a RAW file and its events
+    const auto record_path = get_record_path("gen4_evt3_hand.raw");
+    const auto all_events  = decode_all(record_path);
+    ASSERT_FALSE(all_events.empty());
+    const timestamp first_ts = all_events.front().t, last_ts = all_events.back().t;
+
+    // WHEN random ranges are read from several threads with the same reader
+    RawRangeReader reader(record_path);
+    constexpr int kNumThreads = 4, kNumReadsPerThread = 20;
+    std::vector<std::vector<std::pair<timestamp, timestamp>>> ranges(kNumThreads);
+    std::vector<std::vector<std::vector<EventCD>>> results(kNumThreads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kNumThreads; ++i) {
+        threads.emplace_back([&, i]() {
+            std::mt19937 gen(i);
+            std::uniform_int_distribution<timestamp> start_dist(first_ts, last_ts), duration_dist(1, 50000);
+            for (int j = 0; j < kNumReadsPerThread; ++j) {
+                const timestamp start = start_dist(gen);
+                ranges[i].emplace_back(start, start + duration_dist(gen));
+                results[i].emplace_back();
+                reader.read(ranges[i].back().first, ranges[i].back().second, results[i].back());
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // THEN each read returns the events of its range
+    for (int i = 0; i < kNumThreads; ++i) {
+        for (int j = 0; j < kNumReadsPerThread; ++j) {
+            assert_same_events(get_events_in_range(all_events, ranges[i][j].first, ranges[i][j].second),
+                               results[i][j]);
+        }
+    }
+}
@@ -0,0 +1,125 @@
+/**********************************************************************************************************************
+ * Copyright (c) Prophesee S.A.                                                                                       *
+ *                                                                                                                    *
+ * Licensed under the Apache License, Version 2.0 (the "License");                                                    *
+ * you may not use this file except in compliance with the License.                                                   *
+ * You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0                                 *
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed   *
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.                      *
+ * See the License for the specific language governing permissions and limitations under the License.                 *
+ **********************************************************************************************************************/
+
+
+#include <memory>
+#include <vector>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include "metavision/sdk/stream/camera_stream_preprocessor.h"
+#include "pb_doc_stream.h"
+#include "rvalue_camera.h"
+
+namespace py = pybind11;
+
+namespace Metavision {
+
+namespace {
+
+py::dtype get_dtype(BaseType type) {
+    switch (type) {
+    case BaseType::BOOL:
+        return py::dtype::of<bool>();
+    case BaseType::UINT8:
+        return py::dtype::of<std::uint8_t>();
+    case BaseType::UINT16:
+        return py::dtype::of<std::uint16_t>();
+    case BaseType::UINT32:
+        return py::dtype::of<std::uint32_t>();
+    case BaseType::UINT64:
+        return py::dtype::of<std::uint64_t>();
+    case BaseType::INT8:
+        return py::dtype::of<std::int8_t>();
+    case BaseType::INT16:
+        return py::dtype::of<std::int16_t>();
+    case BaseType::INT32:
+        return py::dtype::of<std::int32_t>();
+    case BaseType::INT64:
+        return py::dtype::of<std::int64_t>();
+    case BaseType::FLOAT32:
+        return py::dtype::of<float>();
+    case BaseType::FLOAT64:
+        return py::dtype::of<double>();
+    default:
+        throw std::runtime_error("No numpy type available for type " + to_string(type));
+    }
+}
+
+std::vector<py::ssize_t> get_dims(const TensorShape &shape) {
+    std::vector<py::ssize_t> dims;
+    for (const auto &dim : shape.dimensions) {
+        dims.push_back(dim.dim);
+    }
+    return dims;
+}
+
+} // namespace
+
+void export_camera_stream_preprocessor(py::module &m) {
+    py::class_<TensorSlice>(m, "TensorSlice", pybind_doc_stream["Metavision::TensorSlice"])
+        .def_readonly("start_ts", &TensorSlice::start_ts, pybind_doc_stream["Metavision::TensorSlice::start_ts"])
+        .def_readonly("t", &TensorSlice::t, pybind_doc_stream["Metavision::TensorSlice::t"])
+        .def_readonly("n_events", &TensorSlice::n_events, pybind_doc_stream["Metavision::TensorSlice::n_events"])
+        .def_property_readonly(
+            "tensor",
+            [](py::object self) {
+                // the array is a view on the tensor, which is kept alive by the array
+                auto &slice = self.cast<TensorSlice &>();
+                return py::array(get_dtype(slice.tensor.type()), get_dims(slice.tensor.shape()),
+                                 slice.tensor.data(), self);
+            },
+            pybind_doc_stream["Metavision::TensorSlice::tensor"]);
+
+    py::class_<CameraStreamPreprocessor>(m, "CameraStreamPreprocessor",
+                                         pybind_doc_stream["Metavision::CameraStreamPreprocessor"])
+        .def(py::init([](RValueCamera &rvalue_camera, const EventPreprocessor<EventCD *> &preprocessor,
+                         const CameraStreamPreprocessor::SliceCondition &slice_condition,
+                         std::size_t max_queue_size) {
+                 if (!rvalue_camera.camera.has_value()) {
+                     throw std::runtime_error("RValue Camera was already moved");
+                 }
+
+                 Camera camera = std::move(*rvalue_camera.camera);
+                 rvalue_camera.camera.reset();
+
+                 // the preprocessor is owned by its Python object, which is kept alive by the pipeline
+                 std::shared_ptr<const EventPreprocessor<EventCD *>> shared_preprocessor(&preprocessor,
+                                                                                         [](const auto *) {});
+                 return std::make_unique<CameraStreamPreprocessor>(std::move(camera), shared_preprocessor,
+                                                                   slice_condition, max_queue_size);
+             }),
+             py::arg("rvalue_camera"), py::arg("preprocessor"), py::arg("slice_condition"),
+             py::arg("max_queue_size") = 8, py::keep_alive<1, 3>())
+        .def("__iter__", [](py::object self) { return self; })
+        .def(
+            "__next__",
+            [](CameraStreamPreprocessor &self) {
+                TensorSlice slice;
+                bool has_slice;
+                {
+                    // the tensors are computed without the GIL, so that Python threads can run meanwhile
+                    py::gil_scoped_release release;
+                    has_slice = self.next(slice);
+                }
+                if (!has_slice) {
+                    throw py::stop_iteration();
+                }
+                return slice;
+            },
+            pybind_doc_stream["Metavision::CameraStreamPreprocessor::next"])
+        .def(
+            "get_output_shape", [](const CameraStreamPreprocessor &self) { return get_dims(self.get_output_shape()); },
+            pybind_doc_stream["Metavision::CameraStreamPreprocessor::get_output_shape"]);
+}
+
+} // namespace Metavision
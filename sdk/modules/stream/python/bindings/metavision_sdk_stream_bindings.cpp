@@ -40,9 +40,11 @@ PythonBindingsDoc pybind_doc_stream;
 #endif
 
 void export_camera(py::module &);
+void export_camera_stream_preprocessor(py::module &);
 void export_camera_stream_slicer(py::module &);
 void export_hdf5_event_file_writer(py::module &);
 void export_raw_evt2_event_file_writer(py::module &);
+void export_raw_evt3_event_file_writer(py::module &);
 void export_synced_cameras_stream_slicer(py::module &);
 void export_synced_cameras_system_builder(py::module &m);
 void export_synced_cameras_system_factory(py::module &m);
@@ -70,9 +72,11 @@ PYBIND11_MODULE(MODULE_NAME, m) {
 #endif
 
     Metavision::export_camera(m);
+    Metavision::export_camera_stream_preprocessor(m);
     Metavision::export_camera_stream_slicer(m);
     Metavision::export_hdf5_event_file_writer(m);
     Metavision::export_raw_evt2_event_file_writer(m);
+    Metavision::export_raw_evt3_event_file_writer(m);
     Metavision::export_synced_cameras_stream_slicer(m);
     Metavision::export_synced_cameras_system_builder(m);
     Metavision::export_synced_cameras_system_factory(m);
@@ -122,6 +122,33 @@ def pytestcase_raw_evt2_file_writer_test(tmpdir, dataset_dir):
     file_writer.close()
 
 
+def pytestcase_raw_evt3_file_writer_test(tmpdir, dataset_dir):
+    camera = metavision_sdk_stream.Camera.from_file(os.path.join(dataset_dir,
+                                                                 "openeb", "gen4_evt3_hand.raw"))
+    file_writer = metavision_sdk_stream.RAWEvt3EventFileWriter(
+        camera.width(), camera.height(), "", True)
+    file_writer.open(os.path.join(tmpdir, "rawevt3_written_file.raw"))
+    buf = metavision_sdk_base.EventCDBuffer(10)
+    np_from_buf = buf.numpy()
+    for i in range(0, 10):
+        np_from_buf[i]["x"] = 1
+        np_from_buf[i]["y"] = 1
+        np_from_buf[i]["p"] = 1
+        np_from_buf[i]["t"] = i
+
+    file_writer.add_cd_events(np_from_buf)
+
+    buf = metavision_sdk_base.EventExtTriggerBuffer(1)
+    np_from_buf = buf.numpy()
+    np_from_buf[0]["p"] = 0
+    np_from_buf[0]["id"] = 6
+    np_from_buf[0]["t"] = 5
+    file_writer.add_ext_trigger_events(np_from_buf)
+
+    file_writer.flush()
+    file_writer.close()
+
+
 def pytestcase_hdf5_file_writer_pathlib_test(tmpdir, dataset_dir):
     import pathlib
     camera = metavision_sdk_stream.Camera.from_file(pathlib.Path(dataset_dir,
@@ -146,3 +173,32 @@ def pytestcase_hdf5_file_writer_pathlib_test(tmpdir, dataset_dir):
 
     file_writer.flush()
     file_writer.close()
+
+
+def pytestcase_camera_stream_preprocessor(dataset_dir):
+    import numpy as np
+    import metavision_sdk_core
+    record_path = os.path.join(dataset_dir, "openeb", "gen4_evt3_hand.raw")
+    slice_condition = metavision_sdk_stream.SliceCondition.make_n_us(10000)
+
+    # reference tensors, computed synchronously
+    preprocessor = metavision_sdk_core.EventPreprocessor.create_HistoProcessor(1280, 720)
+    expected_tensors = []
+    camera = metavision_sdk_stream.Camera.from_file(record_path)
+    for s in metavision_sdk_stream.CameraStreamSlicer(camera.move(), slice_condition):
+        tensor = preprocessor.init_output_tensor()
+        preprocessor.process_events(0, s.events, tensor)
+        expected_tensors.append((s.t, tensor))
+
+    camera = metavision_sdk_stream.Camera.from_file(record_path)
+    pipeline = metavision_sdk_stream.CameraStreamPreprocessor(camera.move(), preprocessor, slice_condition,
+                                                              max_queue_size=4)
+    assert pipeline.get_output_shape() == preprocessor.get_frame_shape()
+    n_slices = 0
+    for tensor_slice in pipeline:
+        expected_t, expected_tensor = expected_tensors[n_slices]
+        assert tensor_slice.t == expected_t
+        assert tensor_slice.tensor.dtype == expected_tensor.dtype
+        assert np.array_equal(tensor_slice.tensor, expected_tensor)
+        n_slices += 1
+    assert n_slices == len(expected_tensors)